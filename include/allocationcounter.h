@@ -0,0 +1,51 @@
+#pragma once
+#include "memtrace.h"
+
+#include <atomic>
+#include <cstddef>
+
+//the tests count through a replaced global operator new, memtrace counts by itself
+#if !defined(MEMTRACE) && ((defined(CPORTA) && !defined(BENCHMARK)) || defined(FRAME_ARENA_ASSERT))
+#define ALLOCATION_HOOK
+#endif
+
+/**
+ * @brief A program összes dinamikus memóriafoglalását számláló osztály.
+ *
+ * A számlálók a program indulása óta összegzik a foglalások számát és
+ * méretét, a felszabadítások nem csökkentik őket, így két lekérdezés
+ * különbsége a közben történt foglalásokat adja, bármelyik szálon történtek.
+ *
+ * `MEMTRACE` kapcsolóval a memtrace számlálóit adja vissza, a tesztek
+ * fordításakor és `FRAME_ARENA_ASSERT` kapcsolóval pedig a globális `new`
+ * operátor lecserélésével számol. Más fordításokban nem számol.
+ */
+class AllocationCounter
+{
+    private:
+    static std::atomic<size_t> count; ///< A foglalások száma.
+    static std::atomic<size_t> bytes; ///< A lefoglalt bájtok száma.
+
+    public:
+    /**
+     * @brief Feljegyez egy foglalást, a lecserélt `new` operátor hívja.
+     *
+     * @param size A foglalás mérete bájtban.
+     */
+    static void record(const size_t size);
+
+    /**
+     * @brief Megadja, hogy ebben a fordításban számlálódnak-e a foglalások.
+     */
+    static bool isAvailable();
+
+    /**
+     * @brief Visszaadja a foglalások számát a program indulása óta.
+     */
+    static size_t getCount();
+
+    /**
+     * @brief Visszaadja a lefoglalt bájtok számát a program indulása óta.
+     */
+    static size_t getBytes();
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * Teljesítménymérések futtatására szolgáló osztály.
+ * 
+ * A mérések a `CPORTA` (grafika nélküli) builddel együtt, a `BENCHMARK`
+ * makró definiálásával fordulnak le. Optimalizált (pl. `-O2`) fordítás ajánlott.
+*/
+class BenchmarkRunner
+{
+    public:
+    static void start();
+
+    static void runVector2Benchmarks();
+
+    static void runTransformBenchmarks();
+
+    static void runTeardownBenchmarks();
+
+    static void runMapScalingBenchmarks();
+
+    static void runTournamentBenchmarks();
+
+    static void runRollbackBenchmarks();
+
+    static void runColliderQueryBenchmarks();
+
+    static void runQueueBenchmarks();
+
+    static void runRenderSnapshotBenchmarks();
+
+    static void runUpdatePhaseBenchmarks();
+
+    static void runFrameArenaBenchmarks();
+
+    static void runLoggerBenchmarks();
+};
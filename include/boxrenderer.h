@@ -1,6 +1,9 @@
 #pragma once
 
 #include "renderer.h"
+#include "spatialgrid.h"
+
+#include <vector>
 
 /**
  * @brief Egy egyszínű téglalapot kirajzoló objektum.
@@ -34,9 +37,91 @@ class BoxRenderer : public Renderer
     /**
      * @brief Végrehatja a téglalap frissítését.
      * 
-     * A metódus kiszámítja a téglalap képernyőn megjelenő pozícióját és méretét
-     * a `Transform` adatai alapján, majd a megadott színnel kirajzolja azt az SDL
-     * renderelő segítségével.
+     * A metódus a `Transform` adatai alapján a megadott színnel felveszi a
+     * téglalapot a képkockába, amelyet a főszál rajzol ki. A képkockában nem
+     * látható téglalapot kihagyja.
      */
     void update() override;
+
+    /**
+     * @brief Kirajzol egy téglalapot a játék világában.
+     * 
+     * A téglalap az aktuális világ `getRenderTarget` képkockájába kerül,
+     * kirajzolás hiányában a hívás hatástalan.
+     * 
+     * @param position A téglalap középpontja.
+     * @param scale A téglalap mérete.
+     * @param color A téglalap színe.
+     */
+    static void drawRect(const Vector2& position, const Vector2& scale, const Color& color);
+};
+
+/**
+ * @brief Egy mozdulatlan, egyszínű téglalapot kirajzoló objektum.
+ * 
+ * A `StaticBoxRenderer` a `BoxRenderer` változata olyan objektumokhoz (például
+ * falakhoz), amelyek a létrehozásuk után nem mozognak. Nem frissül egyenként,
+ * hanem egy közös térbeli indexbe kerül, amelyből képkockánként egyetlen
+ * lekérdezés adja vissza a látható téglalapokat. Így a nem látható objektumok
+ * kihagyása nem jár az összes objektum bejárásával.
+ * 
+ * A téglalap helyzete és mérete a létrehozáskori globális `Transform` adatok
+ * szerint rögzül. Az index és a réteg a létrehozáskor aktuális világ (`World`)
+ * része.
+ */
+class StaticBoxRenderer : public Transform
+{
+    private:
+    /**
+     * @brief A statikus téglalapokat képkockánként kirajzoló renderelő.
+     */
+    class Layer : public Renderer
+    {
+        private:
+        std::vector<StaticBoxRenderer*> visible; ///< A képkockában látható téglalapok, a lekérdezések újra felhasználják.
+
+        public:
+        /**
+         * @brief Létrehozza a réteget a falak frissítési prioritásával.
+         */
+        Layer();
+
+        /**
+         * @brief Kirajzolja a képkockában látható statikus téglalapokat.
+         */
+        void update() override;
+    };
+
+    World* world; ///< A világ, amelynek indexében a téglalap szerepel.
+    Color color; ///< A téglalap színe.
+    SpatialGrid<StaticBoxRenderer>::Handle handle; ///< A téglalap azonosítója a térbeli indexben.
+
+    /**
+     * @brief Létrehozza a világ rétegét, ha még nem létezik.
+     */
+    static void createLayer(World& world);
+
+    /**
+     * @brief Másoló konstruktor tiltása, az index a címet tárolja.
+     */
+    StaticBoxRenderer(const StaticBoxRenderer& renderer);
+
+    /**
+     * @brief Értékadás tiltása, az index a címet tárolja.
+     */
+    StaticBoxRenderer& operator=(const StaticBoxRenderer& renderer);
+
+    public:
+    /**
+     * @brief Létrehoz egy statikus téglalapot, és felveszi a térbeli indexbe.
+     * 
+     * @param transform Az objektum helyzete és mérete.
+     * @param color Az objektum színe.
+     */
+    StaticBoxRenderer(const Transform& transform, const Color& color);
+
+    /**
+     * @brief Eltávolítja a téglalapot a térbeli indexből.
+     */
+    ~StaticBoxRenderer();
 };
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "framearena.h"
 #include "transform.h"
 
+class World;
+
+#include <cstdint>
 #include <vector>
 
 /**
@@ -30,6 +34,53 @@ enum class ColliderTag
     PLAYER
 };
 
+class Collider;
+
+/**
+ * @brief A colliderek lekérdezéseinek szűrője.
+ *
+ * Alapértelmezetten minden interaktív collidert elfogad, a passzívakat nem,
+ * ahogy az ütközésdetektálás is.
+ */
+struct ColliderFilter
+{
+    unsigned int requiredTags = 0; ///< A címkék bitmaszkja, amelyek mindegyikével rendelkeznie kell a collidernek.
+    unsigned int excludedTags = 0; ///< A címkék bitmaszkja, amelyek egyikével sem rendelkezhet a collider.
+    bool interactive = true; ///< Jelzi, hogy az interaktív colliderek szerepelhetnek-e.
+    bool passive = false; ///< Jelzi, hogy a passzív colliderek szerepelhetnek-e.
+    const Transform* ignored = nullptr; ///< Az objektum, amelynek collidereit (önmagát és a leszármazottait) a lekérdezés kihagyja, vagy nullptr.
+
+    /**
+     * @brief Előírja, hogy a collider rendelkezzen a címkével.
+     *
+     * @return A szűrő, hogy a hívások láncolhatók legyenek.
+     */
+    ColliderFilter& require(const ColliderTag tag);
+
+    /**
+     * @brief Kizárja a címkével rendelkező collidereket.
+     *
+     * @return A szűrő, hogy a hívások láncolhatók legyenek.
+     */
+    ColliderFilter& exclude(const ColliderTag tag);
+
+    /**
+     * @brief Megadja, hogy a collider átmegy-e a szűrőn.
+     */
+    bool accepts(const Collider& collider) const;
+};
+
+/**
+ * @brief Egy félegyenes vagy egy mozgatott téglalap első találata.
+ */
+struct ColliderHit
+{
+    Collider* collider = nullptr; ///< Az eltalált collider.
+    double distance = 0; ///< A találat távolsága a kezdőponttól az irány mentén.
+    Vector2 point; ///< Félegyenesnél a találat pontja, téglalapnál a téglalap középpontja a találatkor.
+    Vector2 normal; ///< Az eltalált oldal egységnyi normálvektora, kezdeti átfedésnél az irány ellentettje.
+};
+
 /**
  * @brief Meghatározza egy objektum fizikai határait.
  * 
@@ -37,34 +88,54 @@ enum class ColliderTag
  * és az ütközések detektálásáért. Az osztály a `Transform` osztályból származik,
  * így rendelkezik pozícióval és mérettel, amelyeket az ütközésdetektálás során használ.
  * 
- * A `Collider` osztály statikus listát tart fenn az összes colliderről, amely
- * lehetővé teszi az ütközések globális ellenőrzését.
+ * A colliderek a létrehozásukkor aktuális világ (`World`) listájába kerülnek,
+ * amely lehetővé teszi az ütközések ellenőrzését a világon belül.
  */
 class Collider : public Transform
 {
     private:
-    static std::vector<Collider*> colliders; ///< Az összes collider statikus listája az ütközések ellenőrzéséhez.
+    World* world; ///< A világ, amelynek listájában a collider szerepel.
 
     ColliderType type; ///< A collider típusa (interaktív vagy passzív).
     double bounciness; ///< Az ütközéskor visszapattanási együttható (0 = nincs visszapattanás, 1 = teljes visszapattanás).
-    std::vector<ColliderTag> tags; ///< A collider címkék, amelyek extra tulajdonságokat rendelnek a colliderhez.
+    unsigned int tagMask; ///< A collider címkék bitmaszkja, a címke sorszámának megfelelő bit jelzi a címkét.
+    size_t registryIndex; ///< A collider indexe a világ listájában, vagy `notRegistered`.
+
+    static constexpr size_t notRegistered = SIZE_MAX; ///< A listában nem szereplő colliderek indexe.
+
+    friend struct ColliderFilter;
+    friend class ColliderIndex;
 
     /**
-     * @brief Regisztrálja a collidert a statikus listába.
+     * @brief Regisztrálja a collidert a világ listájába.
      */
     void registerCollider();
 
     /**
-     * @brief Törli a collidert a statikus listából.
+     * @brief Törli a collidert a világ listájából.
+     * 
+     * A törlés konstans idejű: a lista utolsó eleme a törölt collider helyére kerül.
      */
     void unregisterCollider();
 
+    /**
+     * @brief Az eredményhez fűzi a világ azon nem passzív collidereit, amelyek metszik a collidert.
+     */
+    template <typename Vector>
+    void collectIntersections(Vector& result) const;
+
+    /**
+     * @brief Az eredményhez fűzi a lista collidereit metsző, a listán kívüli collidereket, mindegyiket egyszer.
+     */
+    template <typename Vector>
+    static void collectIntersectionsForList(const std::vector<Collider*>& collidersToCheck, Vector& result);
+
     public:
     /**
      * @brief Létrehoz egy Collider objektumot.
      * 
      * Létrehoz egy Collider objektumot a megadott pozícióval, mérettel és tulajdonságokkal.
-     * Az objektum automatikusan hozzáadódik a statikus collider listához, így részt vesz
+     * Az objektum automatikusan hozzáadódik a világ collider listájához, így részt vesz
      * az ütközésdetektálásban.
      * 
      * @param transform Az objektum pozíciója és mérete a játék világában.
@@ -78,7 +149,7 @@ class Collider : public Transform
      * @brief Másoló konstruktor.
      * 
      * Létrehoz egy új Collider objektumot egy meglévő Collider alapján.
-     * Az új objektum automatikusan hozzáadódik a statikus collider listához,
+     * Az új objektum automatikusan hozzáadódik a világ collider listájához,
      * így részt vesz az ütközésdetektálásban.
      * 
      * @param collider A másolandó Collider objektum.
@@ -89,17 +160,37 @@ class Collider : public Transform
      * @brief Értékadás operátor.
      * 
      * Egy meglévő Collider objektum adatait másolja egy másik Collider objektumba.
-     * Az értékadás nem módosítja a statikus collider listát.
+     * Az értékadás nem módosítja a világ collider listáját.
      * 
      * @param collider A másolandó Collider objektum.
      * @return Az aktuális Collider objektum referenciája.
      */
     Collider& operator=(const Collider& collider);
 
+    /**
+     * @brief Mozgató konstruktor.
+     * 
+     * Az új objektum konstans időben átveszi a régi helyét a világ collider
+     * listájában, a régi objektum kikerül az ütközésdetektálásból.
+     * 
+     * @param collider A mozgatandó Collider objektum.
+     */
+    Collider(Collider&& collider) noexcept;
+
+    /**
+     * @brief Mozgató értékadás operátor.
+     * 
+     * A másoló értékadáshoz hasonlóan nem módosítja a világ collider listáját.
+     * 
+     * @param collider A mozgatandó Collider objektum.
+     * @return Az aktuális Collider objektum referenciája.
+     */
+    Collider& operator=(Collider&& collider) noexcept;
+
     /**
      * @brief Megsemmisíti a Collider objektumot.
      * 
-     * Megsemmisíti a Collider objektumot és eltávolítja a satikus collider listából.
+     * Megsemmisíti a Collider objektumot és eltávolítja a világ collider listájából.
      */
     ~Collider();
 
@@ -116,21 +207,31 @@ class Collider : public Transform
     static bool checkColliders(const Collider& collider1, const Collider& collider2);
     
     /**
-     * @brief Ellenőrzi, hogy a collider metszi-e a statikus collider listában szereplő collidereket.
+     * @brief Ellenőrzi, hogy a collider metszi-e a világ collider listájában szereplő collidereket.
      * 
      * Az ütközésdetektálás során ellenőrzi, hogy az aktuális collider
-     * átfedi-e bármelyik collidert a statikus collider listában.
+     * átfedi-e bármelyik collidert a világ collider listájában.
      * 
      * @return Azok a colliderek, amelyek metszik az aktuális collidert.
      */
     std::vector<Collider*> checkIntersection() const;
 
+    /**
+     * @brief Ellenőrzi, hogy a collider metszi-e a világ collider listájában szereplő collidereket.
+     * 
+     * A lépésenként többször hívott ellenőrzésekhez készült, az eredmény a
+     * szál területéből foglal, így nem hívja az általános célú foglalót.
+     * 
+     * @param result Azok a colliderek, amelyek metszik az aktuális collidert, a korábbi tartalma törlődik.
+     */
+    void checkIntersection(ArenaVector<Collider*>& result) const;
+
     /**
      * @brief Ellenőrzi, hogy a megadott colliderek listájában lévő colliderek közül
-     * bármelyik metszi-e a statikus collider listában szereplő collidereket.
+     * bármelyik metszi-e a világ collider listájában szereplő collidereket.
      * 
      * Az ütközésdetektálás során minden megadott colliderhez megkeresi azokat a collidereket,
-     * amelyekkel ütköznek, és ezeket egy halmazba gyűjti, hogy az eredmény egyedi legyen.
+     * amelyekkel ütköznek, és mindegyiket egyszer adja vissza.
      * 
      * @param collidersToCheck A colliderek listája, amelyeket ellenőrizni kell.
      * 
@@ -138,6 +239,78 @@ class Collider : public Transform
      */
     static std::vector<Collider*> checkIntersectionForList(const std::vector<Collider*>& collidersToCheck);    
 
+    /**
+     * @brief Ellenőrzi, hogy a megadott colliderek listájában lévő colliderek közül
+     * bármelyik metszi-e a világ collider listájában szereplő collidereket.
+     * 
+     * Minden metsző collider egyszer, az első találat sorrendjében kerül az
+     * eredménybe, amely a szál területéből foglal.
+     * 
+     * @param collidersToCheck A colliderek listája, amelyeket ellenőrizni kell.
+     * @param result Azok a colliderek, amelyek metszik a vizsgált collidereket, a korábbi tartalma törlődik.
+     */
+    static void checkIntersectionForList(const std::vector<Collider*>& collidersToCheck, ArenaVector<Collider*>& result);
+
+    /**
+     * @brief Megkeresi az aktuális világ első colliderét, amelyet a félegyenes eltalál.
+     *
+     * A világ collidereinek térbeli indexét használja, és nem foglal memóriát.
+     * Az azonos távolságú találatok közül a világ listájában korábbi nyer,
+     * így az eredmény a futástól függetlenül ugyanaz.
+     *
+     * @param origin A félegyenes kezdőpontja.
+     * @param direction A félegyenes iránya, nem lehet nullvektor.
+     * @param maxDistance A vizsgált szakasz hossza.
+     * @param hit A találat, csak találat esetén módosul.
+     * @param filter A vizsgált colliderek szűrője.
+     * @return true, ha a félegyenes eltalált egy collidert.
+     * @throws std::invalid_argument Ha az irány nullvektor vagy a hossz negatív.
+     */
+    static bool raycast(const Vector2& origin, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter = ColliderFilter());
+
+    /**
+     * @brief Megkeresi az aktuális világ első colliderét, amelybe a mozgatott téglalap ütközik.
+     *
+     * A `raycast` megfelelője egy tengelyekkel párhuzamos téglalapra, amely a
+     * kezdeti helyéről az irány mentén halad.
+     *
+     * @param center A téglalap kezdeti középpontja.
+     * @param size A téglalap mérete.
+     * @param direction A mozgás iránya, nem lehet nullvektor.
+     * @param maxDistance A megtett út hossza.
+     * @param hit A találat, csak találat esetén módosul.
+     * @param filter A vizsgált colliderek szűrője.
+     * @return true, ha a téglalap collidernek ütközött.
+     * @throws std::invalid_argument Ha az irány nullvektor vagy a hossz negatív.
+     */
+    static bool boxcast(const Vector2& center, const Vector2& size, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter = ColliderFilter());
+
+    /**
+     * @brief Összegyűjti az aktuális világ collidereit, amelyek érintik vagy átfedik a téglalapot.
+     *
+     * A colliderek a világ listájának sorrendjében kerülnek az eredménybe. A
+     * lekérdezés csak akkor foglal memóriát, ha az eredmény nem fér el a
+     * vektor meglévő kapacitásában.
+     *
+     * @param min A téglalap bal alsó sarka.
+     * @param max A téglalap jobb felső sarka.
+     * @param result Az eredmény, a metódus előbb kiüríti.
+     * @param filter A vizsgált colliderek szűrője.
+     */
+    static void overlapBox(const Vector2& min, const Vector2& max, std::vector<Collider*>& result, const ColliderFilter& filter = ColliderFilter());
+
+    /**
+     * @brief Egyszerre törli a megadott collidereket a világ listájából.
+     * 
+     * Sok collider (például egy pálya összes fala) törlése előtt használatos:
+     * a világ listáját egyetlen bejárással tömöríti, a megmaradó colliderek
+     * sorrendje nem változik. A törölt colliderek destruktora már nem módosítja
+     * a listát.
+     * 
+     * @param collidersToRemove A törlendő colliderek.
+     */
+    static void unregisterColliders(const std::vector<Collider*>& collidersToRemove);
+
     /**
      * @brief Visszaadja a collider visszapattanási együtthatóját.
      * 
@@ -167,4 +340,16 @@ class Collider : public Transform
      * @return A collider címkéinek listája.
      */
     std::vector<ColliderTag> getTags() const;
+
+    /**
+     * @brief Visszaadja a collider címkéinek bitmaszkját foglalás nélkül.
+     * 
+     * @return A maszk, a címke sorszámának megfelelő bit jelzi a címkét.
+     */
+    unsigned int getTagMask() const;
+
+    /**
+     * @brief Visszaadja a címkéhez tartozó bitet.
+     */
+    static unsigned int getTagBit(const ColliderTag tag);
 };
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+#include "memtrace.h"
+
+#include "collider.h"
+#include "spatialgrid.h"
+#include "vector2.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Egy világ collidereinek térbeli indexe a sugár- és téglalaplekérdezésekhez.
+ *
+ * Az index a colliderek befoglaló téglalapjait egy `SpatialGrid`-ben tárolja,
+ * így egy lekérdezés csak az útjába eső cellákat járja be. Az indexet a
+ * lekérdezések frissítik, lustán: a colliderek listájának változása után
+ * újraépül, pozícióváltozás után (`World::countTransformChange`) csak az
+ * elmozdult colliderek cellái frissülnek. Két mozgatás közötti lekérdezések,
+ * például egy bot érzékelése egy lépésen belül, így csak a cellák bejárásába
+ * kerülnek, és nem foglalnak memóriát.
+ *
+ * A lekérdezések több szálon egyszerre is futhatnak: a változás utáni első
+ * lekérdezés zárolva frissíti az indexet, a többi csak olvassa. A collidereket
+ * mozgatni és regisztrálni a lekérdezésekkel egyidőben nem szabad.
+ */
+class ColliderIndex
+{
+    private:
+    /**
+     * @brief Egy collider adatai az indexben.
+     */
+    struct Entry
+    {
+        SpatialGrid<Collider>::Handle handle; ///< A collider azonosítója a rácsban.
+        Vector2 min; ///< Az indexelt befoglaló téglalap bal alsó sarka.
+        Vector2 max; ///< Az indexelt befoglaló téglalap jobb felső sarka.
+    };
+
+    static constexpr double cellSize = 2; ///< A rács celláinak oldalhossza.
+
+    const std::vector<Collider*>& colliders; ///< A világ collidereinek listája.
+    SpatialGrid<Collider> grid; ///< A colliderek térbeli indexe.
+    std::vector<Entry> entries; ///< A colliderek adatai, a lista sorrendjében.
+    const std::atomic<uint64_t>& changeCount; ///< A világ változásszámlálója.
+    std::atomic<bool> rebuildNeeded; ///< Jelzi, hogy a colliderek listája az utolsó frissítés óta változott.
+    std::atomic<uint64_t> syncedChangeCount; ///< A változásszámláló értéke az utolsó frissítéskor.
+    std::mutex syncMutex; ///< A frissítést zárolja, ha több szál egyszerre kérdez le.
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    ColliderIndex(const ColliderIndex& index);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    ColliderIndex& operator=(const ColliderIndex& index);
+
+    /**
+     * @brief Kiszámolja a collider befoglaló téglalapját.
+     */
+    static void getBounds(const Collider& collider, Vector2& min, Vector2& max);
+
+    /**
+     * @brief Megadja, hogy az index a colliderek aktuális listáját és helyét tárolja-e.
+     */
+    bool isSynchronized() const;
+
+    /**
+     * @brief Az index frissítése a colliderek aktuális listájához és helyéhez.
+     */
+    void synchronize();
+
+    /**
+     * @brief Egy félegyenes menti lekérdezés, a téglalap fél méretével megnövelt colliderekkel.
+     */
+    bool cast(const Vector2& origin, const Vector2& direction, const double maxDistance, const Vector2& halfExtent, ColliderHit& hit, const ColliderFilter& filter);
+
+    public:
+    /**
+     * @brief Létrehoz egy indexet.
+     *
+     * @param colliders A világ collidereinek listája, amelyet az index követ.
+     * @param changeCount A világ változásszámlálója.
+     */
+    ColliderIndex(const std::vector<Collider*>& colliders, const std::atomic<uint64_t>& changeCount);
+
+    /**
+     * @brief Jelzi, hogy a colliderek listája megváltozott, a következő lekérdezés újraépíti az indexet.
+     */
+    void invalidate();
+
+    /**
+     * @brief Megkeresi az első collidert, amelyet a félegyenes eltalál.
+     *
+     * @see Collider::raycast
+     */
+    bool raycast(const Vector2& origin, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter = ColliderFilter());
+
+    /**
+     * @brief Megkeresi az első collidert, amelybe a mozgatott téglalap ütközik.
+     *
+     * @see Collider::boxcast
+     */
+    bool boxcast(const Vector2& center, const Vector2& size, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter = ColliderFilter());
+
+    /**
+     * @brief Összegyűjti a téglalapot érintő vagy átfedő collidereket.
+     *
+     * @see Collider::overlapBox
+     */
+    void overlapBox(const Vector2& min, const Vector2& max, std::vector<Collider*>& result, const ColliderFilter& filter = ColliderFilter());
+};
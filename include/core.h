@@ -1,12 +1,27 @@
 #pragma once
 
+#include <cstdint>
 #include <set>
+#include <vector>
+
+#ifndef CPORTA
+#include "rendersnapshot.h"
+#include "triplebuffer.h"
+
+#include <atomic>
+#endif
+
+class World;
+class StateHasher;
 
 /**
  * @brief Az objektumok frissítési sorrendjét meghatározó prioritások.
  * 
  * Az `UpdatePriority` enum az objektumok frissítési sorrendjét határozza meg
- * a játék főciklusában. A kisebb értékű prioritások előbb kerülnek frissítésre.
+ * a játék főciklusában. Minden prioritás egy frissítési fázis, alapértelmezés
+ * szerint a kisebb értékű prioritások előbb kerülnek frissítésre. A fázisok
+ * közötti függőségeket és a fázisokon belüli párhuzamosságot a `World`
+ * osztály állítja be.
  * 
  * @var UpdatePriority::GAME_LOGIC
  *      A játék logikájának frissítése.
@@ -42,7 +57,20 @@ enum class UpdatePriority : int
 class Updatable
 {
     private:
+    World* world; ///< A világ, amelyben az objektum frissül.
     UpdatePriority priority; ///< Az updatelés prioritása.
+    unsigned long long registrationOrder; ///< A regisztráció sorszáma, az azonos prioritású objektumok sorrendjét adja.
+    bool registered; ///< Jelzi, hogy az objektum szerepel-e a frissítendők között.
+
+    /**
+     * @brief Új sorszámmal regisztrálja az objektumot az updateléshez.
+     */
+    void registerSelf();
+
+    /**
+     * @brief Eltávolítja az objektumot az updatelésből, ha regisztrálva van.
+     */
+    void unregisterSelf();
 
     public:
     /**
@@ -54,10 +82,45 @@ class Updatable
      * @brief Az Updatable osztály másoló konstruktora.
      */
     Updatable(const Updatable& updatable);
+    /**
+     * @brief Az Updatable osztály mozgató konstruktora.
+     *
+     * Az új objektum átveszi a régi helyét a frissítendők között, így nem kell
+     * újra regisztrálni. A régi objektum a továbbiakban nem frissül.
+     */
+    Updatable(Updatable&& updatable) noexcept;
     /**
      * @brief Az Updatable osztály értékadó operátora.
      */
     Updatable& operator=(const Updatable& updatable);
+    /**
+     * @brief Az Updatable osztály mozgató értékadó operátora.
+     *
+     * Az objektum megtartja a saját helyét, csak eltérő prioritás esetén regisztrál újra.
+     */
+    Updatable& operator=(Updatable&& updatable) noexcept;
+    /**
+     * @brief Egyszerre eltávolítja a megadott objektumokat az updatelésből.
+     *
+     * Sok objektum (például egy pálya összes fala) törlése előtt használatos:
+     * a frissítendők halmazát egyetlen bejárással tisztítja meg, és az objektumok
+     * destruktora már nem módosítja a halmazt.
+     *
+     * @param updatablesToRemove Az eltávolítandó objektumok.
+     */
+    static void unregisterUpdatables(const std::vector<Updatable*>& updatablesToRemove);
+    /**
+     * @brief Megadja, hogy az objektum szerepel-e a frissítendők között.
+     */
+    bool isRegistered() const;
+    /**
+     * @brief Visszaadja az updatelés prioritását, azaz a frissítési fázist.
+     */
+    UpdatePriority getPriority() const;
+    /**
+     * @brief Visszaadja a világot, amelyben az objektum frissül.
+     */
+    World& getWorld() const;
     /**
      * @brief Az Updatable osztály destruktora.
      */
@@ -88,6 +151,11 @@ class Updatable
  */
 class PhysicsUpdatable
 {
+    private:
+    World* world; ///< A világ, amelyben az objektum frissül.
+    unsigned long long registrationOrder; ///< A regisztráció sorszáma, a frissítés sorrendjét adja.
+    bool registered; ///< Jelzi, hogy az objektum szerepel-e a fizikai frissítést igénylők között.
+
     public:
     /**
      * @brief A PhysicsUpdatable osztály konstruktora.
@@ -97,15 +165,37 @@ class PhysicsUpdatable
      * @brief A PhysicsUpdatable osztály másoló konstruktora.
      */
     PhysicsUpdatable(const PhysicsUpdatable& updatable);
+    /**
+     * @brief A PhysicsUpdatable osztály mozgató konstruktora.
+     *
+     * Az új objektum átveszi a régi helyét a fizikai frissítést igénylők között.
+     */
+    PhysicsUpdatable(PhysicsUpdatable&& updatable) noexcept;
     /**
      * @brief A PhysicsUpdatable osztály értékadó operátora.
      */
     PhysicsUpdatable& operator=(const PhysicsUpdatable& updatable);
+    /**
+     * @brief A PhysicsUpdatable osztály mozgató értékadó operátora.
+     */
+    PhysicsUpdatable& operator=(PhysicsUpdatable&& updatable) noexcept;
+    /**
+     * @brief Visszaadja a világot, amelyben az objektum frissül.
+     */
+    World& getWorld() const;
     /**
      * @brief A PhysicsUpdatable osztály destruktora.
      */
     virtual ~PhysicsUpdatable();
 
+    /**
+     * @brief A fizikai lépés előtt, minden objektumon a lépés előtt meghívott metódus.
+     *
+     * Itt érvényesülnek az irányítások, így a lépés minden objektuma ugyanazt,
+     * a lépés előtti állapotot látja. Az alapértelmezett megvalósítás üres.
+     */
+    virtual void prePhysicsUpdate();
+
     /**
      * @brief A fizikai frissítést végző virtuális metódus.
      */
@@ -119,6 +209,25 @@ class PhysicsUpdatable
      * műveleteket, például a címkék eltűntetését.
      */
     virtual void postUpdate() = 0;
+
+    /**
+     * @brief Hozzáadja az objektum szimulációs állapotát a világ állapothasheléhez.
+     *
+     * Az alapértelmezett megvalósítás nem ad hozzá semmit, a dinamikus
+     * állapotú objektumok felüldefiniálják.
+     *
+     * @param hasher A hash, amelyhez az állapot hozzáadódik.
+     */
+    virtual void hashState(StateHasher& hasher) const;
+
+    /**
+     * @brief Két fizikai frissítést végző objektum regisztrációs sorrendjének összehasonlító osztálya.
+     */
+    class Compare
+    {
+        public:
+        bool operator()(const PhysicsUpdatable* updatable1, const PhysicsUpdatable* updatable2) const;
+    };
 }; 
 
 #ifndef CPORTA
@@ -135,7 +244,16 @@ struct SDL_Renderer;
  * eseményeket, és biztosítja a megjelenítést.
  * 
  * Az osztály statikus metódusokon keresztül kezeli a játék futását, például
- * az inicializálást, a főciklus indítását és a játék leállítását.
+ * az inicializálást, a főciklus indítását és a játék leállítását. A főciklus
+ * a hívó szálon aktuális `World`-öt futtatja, a regisztráló és az időket
+ * lekérdező metódusok is az aktuális világot használják.
+ * 
+ * A szimuláció (bemenet alkalmazása, fizikai lépések, frissítések) saját
+ * szálon fut, és minden képkocka végén egy `RenderSnapshot` képkockát tesz
+ * közzé egy hármas pufferben. A főszál csak az eseményeket kezeli, és a
+ * legutóbb közzétett képkockát rajzolja ki, így a képkockaidő a szimuláció
+ * és a kirajzolás idejének összege helyett a kettő közül a nagyobb. A főszál
+ * a szimuláció futása alatt a világhoz nem nyúl.
  */
 class GameRuntime
 {
@@ -143,27 +261,33 @@ class GameRuntime
     static SDL_Window* SDLWindow; ///< SDL ablak.
     static SDL_Renderer* SDLRenderer; ///< SDL renderer.
 
-    static bool running; ///< A játék futásának állapota.
+    static std::atomic<bool> running; ///< A játék futásának állapota, a főszál írja, a szimuláció szála olvassa.
+
+    static TripleBuffer<RenderSnapshot> renderSnapshots; ///< A szimuláció által közzétett képkockák a főszál számára.
 
     static unsigned long long lastFrameCounter; ///< Az utolsó képkocka frissítési ideje.
     static unsigned long long currentFrameCounter; ///< A jelenlegi képkocka frissítési ideje.
     
-    static double deltaTime; ///< A játék legutóbbi képkockájához kirajzolásához szükséges idő.
     static double physicsSimTime; ///< A fizikai szimulációk között eltelt idő.
-
-    static double targetFrameRate; ///< A maximális frissítési ráta.
-    static double targetPhysicsRate; ///< A fizikai szimulációk rátája.
-
-    static std::set<Updatable*, Updatable::Compare> updatables; ///< A képkockánként frissítendő objektumok.
-    static std::set<PhysicsUpdatable*> physicsUpdatables; ///< A fizikai frissítést igénylő objektumok.
+    static uint64_t physicsClock; ///< A következő fizikai lépés időpontja nanoszekundumban, a bemeneti események órája szerint.
 
     /**
-     * @brief A játék főciklusának futtatása.
+     * @brief A főszál ciklusának egy lépése.
      * 
-     * A főciklusban a játék frissítése, a fizikai frissítés, a felhasználói
-     * események kezelése, a megjelenítés és a frissítési idő számolása történik.
+     * Kezeli a felhasználói eseményeket, és ha a szimuláció közzétett egy új
+     * képkockát, kirajzolja és megjeleníti azt.
      */
     static void loop();
+
+    /**
+     * @brief A szimuláció szálának ciklusa.
+     * 
+     * Képkockánként kiszámolja a frissítési időt, elvégzi a fizikai lépéseket
+     * és a frissítéseket, közzéteszi a renderelők által összeállított
+     * képkockát, majd a képkockaráta szerint vár. A `running` állapot
+     * hamissá válásáig fut.
+     */
+    static void simulate();
     
     /**
      * @brief A játék frissítése.
@@ -197,9 +321,10 @@ class GameRuntime
     /**
      * @brief A játék főciklusának elindítása.
      * 
-     * A főciklus során a játék frissítése, a fizikai frissítés, a felhasználói
+     * Elindítja a szimuláció szálát, a hívó szálon pedig a felhasználói
      * események kezelése és a megjelenítés történik. A ciklus addig fut, amíg
-     * a `running` állapot igaz.
+     * a `running` állapot igaz, és a szimuláció szálának leállása után tér
+     * vissza.
      */
     static void startGameLoop();
 
@@ -229,6 +354,12 @@ class GameRuntime
      */
     static double getPhysicsDeltaTime();
 
+    /**
+     * @brief Az aktuális világ legutóbbi fizikai lépés utáni állapothashének lekérdezése.
+     * @return A legutóbbi fizikai lépés utáni állapothash.
+     */
+    static uint64_t getStateHash();
+
     /**
      * Maximális frissítési ráta beállítása.
      * @param targetRate A maximális frissítési ráta.
@@ -264,6 +395,34 @@ class GameRuntime
      * @param updatable A fizikai frissítést végző objektum.
      */
     static void unregisterForUpdate(PhysicsUpdatable* const updatable);
+
+    /**
+     * @brief Az updatelhető objektum helyét átadja egy másik objektumnak.
+     *
+     * Mozgatáskor használatos, a halmazban a régi objektum helyére az új kerül
+     * konstans időben, a halmaz átrendezése nélkül. A két objektum prioritásának
+     * és sorszámának meg kell egyeznie.
+     *
+     * @param oldUpdatable A régi objektum.
+     * @param newUpdatable Az új objektum.
+     */
+    static void replaceForUpdate(Updatable* const oldUpdatable, Updatable* const newUpdatable);
+
+    /**
+     * @brief A fizikai frissítést végző objektum helyét átadja egy másik objektumnak.
+     *
+     * @param oldUpdatable A régi objektum.
+     * @param newUpdatable Az új objektum.
+     */
+    static void replaceForUpdate(PhysicsUpdatable* const oldUpdatable, PhysicsUpdatable* const newUpdatable);
+
+    /**
+     * @brief Eltávolítja a frissítendők közül a már nem regisztrált objektumokat.
+     *
+     * Az `Updatable::unregisterUpdatables` használja, a halmazt egyetlen
+     * bejárással tisztítja meg.
+     */
+    static void removeUnregisteredUpdatables();
 };
 #endif // CPORTA
 
@@ -271,17 +430,11 @@ class GameRuntime
 
 /**
  * @brief A játék futását kezelő osztály tesztelési célokra.
+ *
+ * A metódusok a hívó szálon aktuális `World`-öt használják.
  */
 class GameRuntime
 {
-    static std::set<Updatable*, Updatable::Compare> updatables; ///< A képkockánként frissítendő objektumok.
-    static std::set<PhysicsUpdatable*> physicsUpdatables; ///< A fizikai frissítést igénylő objektumok.
-
-    static double deltaTime; ///< A játék legutóbbi képkockájához kirajzolásához szükséges idő.
-
-    static double targetFrameRate; ///< A maximális frissítési ráta.
-    static double targetPhysicsRate; ///< A fizikai szimulációk rátája.
-
     public:
     /**
      * * @brief A játék tesztelési célú inicializálása.
@@ -314,6 +467,12 @@ class GameRuntime
      */
     static double getPhysicsDeltaTime();
 
+    /**
+     * @brief Az aktuális világ legutóbbi fizikai lépés utáni állapothashének lekérdezése.
+     * @return A legutóbbi fizikai lépés utáni állapothash.
+     */
+    static uint64_t getStateHash();
+
     /**
      * Maximális frissítési ráta beállítása.
      * @param targetRate A maximális frissítési ráta.
@@ -349,6 +508,34 @@ class GameRuntime
      * @param updatable A fizikai frissítést végző objektum.
      */
     static void unregisterForUpdate(PhysicsUpdatable* const updatable);
+
+    /**
+     * @brief Az updatelhető objektum helyét átadja egy másik objektumnak.
+     *
+     * Mozgatáskor használatos, a halmazban a régi objektum helyére az új kerül
+     * konstans időben, a halmaz átrendezése nélkül. A két objektum prioritásának
+     * és sorszámának meg kell egyeznie.
+     *
+     * @param oldUpdatable A régi objektum.
+     * @param newUpdatable Az új objektum.
+     */
+    static void replaceForUpdate(Updatable* const oldUpdatable, Updatable* const newUpdatable);
+
+    /**
+     * @brief A fizikai frissítést végző objektum helyét átadja egy másik objektumnak.
+     *
+     * @param oldUpdatable A régi objektum.
+     * @param newUpdatable Az új objektum.
+     */
+    static void replaceForUpdate(PhysicsUpdatable* const oldUpdatable, PhysicsUpdatable* const newUpdatable);
+
+    /**
+     * @brief Eltávolítja a frissítendők közül a már nem regisztrált objektumokat.
+     *
+     * Az `Updatable::unregisterUpdatables` használja, a halmazt egyetlen
+     * bejárással tisztítja meg.
+     */
+    static void removeUnregisteredUpdatables();
 };
 
 #endif // CPORTA
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+#include "memtrace.h"
+
+#include "physicsObject.h"
+#include "playercontroller.h"
+
+/**
+ * @brief Egy játékos karakter megjelenítés nélküli fizikája és játéklogikája.
+ *
+ * A `Fighter` kezeli a karakter mozgását, ugrását, vetődését, a pálya széleinél
+ * való átjutást és a halálát. Az irányítást egy `PlayerController` adja, így
+ * a karaktert billentyűzet és bot is vezérelheti. Nem használ SDL-t, ezért
+ * megjelenítés nélküli mérkőzésekben is futtatható, a látható játékos a
+ * `Player` osztály.
+ */
+class Fighter : public PhysicsObject, Updatable
+{
+    public:
+    /**
+     * @brief A karakter szimulációs állapota.
+     */
+    struct State
+    {
+        PhysicsObject::State physics; ///< A fizikai állapot.
+        bool dead = false; ///< Jelzi, hogy a karakter halott-e.
+    };
+
+    private:
+    Collider collider; ///< A karakter fő collider objektuma, amely az ütközéseket kezeli.
+    Collider groundCheck; ///< A talajjal való érintkezés ellenőrzésére szolgáló collider.
+    Collider headCheck; ///< A fej fölötti ütközések ellenőrzésére szolgáló collider.
+
+    PlayerController* controller; ///< A karakter irányítója, vagy nullptr.
+    const Fighter* opponent; ///< Az ellenfél, vagy nullptr.
+
+    double arenaWidth; ///< A pálya fél szélessége, ezen túl a karakter a másik oldalra kerül.
+    double arenaHeight; ///< A pálya fél magassága, ez alá esve a karakter felülre kerül.
+
+    double jumpSpeed = 10.5; ///< Az ugrás sebessége.
+    double dashSpeed = 20; ///< A vetődés sebessége.
+    double moveAcceleration = 20; ///< A mozgás gyorsulása.
+    double turnAcceleration = 55; ///< Az irányváltás gyorsulása.
+    double maxSpeed = 8; ///< A maximális vízszintes sebesség.
+    double maxFallSpeed = 30; ///< A maximális esési sebesség.
+    double floatGravity = 1.2 * 9.81; ///< A gravitáció értéke lassú esés közben.
+    double fallGravity = 2.2 * 9.81; ///< A gravitáció értéke gyors esés közben.
+    double groundDrag = 30; ///< A talajon ható lassító erő.
+    double airDrag = 10; ///< A levegőben ható lassító erő.
+
+    bool hasDied; ///< Jelzi, hogy a karakter jelenleg halott állapotban van-e.
+
+    /**
+     * @brief A karakter irányításának kezelése.
+     *
+     * Az irányító döntése alapján beállítja a mozgást, ugrást, vetődést és gravitációt.
+     */
+    void controlFighter();
+
+    /**
+     * @brief Ellenőrzi, hogy a karakter a pálya határain belül van-e.
+     *
+     * Ha a karakter elhagyja a pálya határait, a pálya másik oldalára
+     * teleportálja, biztosítva a folyamatos játékmenetet.
+     */
+    void boundsCheck();
+
+    /**
+     * @brief Ellenőrzi, hogy a karakter meghalt-e.
+     *
+     * A karakter meghal, ha egy másik játékos a fejére ugrik, vagy halálos
+     * objektummal érintkezik.
+     *
+     * @return true, ha a karakter meghalt, különben false.
+     */
+    bool checkDeath() const;
+
+    /**
+     * @brief Ellenőrzi, hogy a karakter a talajon van-e.
+     *
+     * A halálos objektumok nem számítanak talajnak, mivel az ellenőrzés
+     * valamivel hamarabb történik, mint a tényleges ütközésdetektálás, így
+     * a karakter el tud ugrani a halálos objektumról, mielőtt az megölné.
+     *
+     * @return true, ha a karakter a talajon van, különben false.
+     */
+    bool isGrounded() const;
+
+    public:
+    /**
+     * @brief Létrehoz egy `Fighter` objektumot.
+     *
+     * @param controller A karakter irányítója, nullptr esetén a karakter áll.
+     */
+    explicit Fighter(PlayerController* const controller = nullptr);
+
+    /**
+     * @brief A karakter frissítése.
+     *
+     * Ellenőrzi a pálya határait és a karakter halálát.
+     */
+    void update() override;
+
+    /**
+     * @brief Lekéri és alkalmazza az irányítást a fizikai lépés előtt.
+     *
+     * Az irányítás így lépésenként érvényesül, a képkockák számától függetlenül.
+     */
+    void prePhysicsUpdate() override;
+
+    /**
+     * @brief A karakter állapotának visszaállítása.
+     *
+     * @param resetPosition A karakter új pozíciója.
+     */
+    void reset(const Vector2& resetPosition);
+
+    /**
+     * @brief Visszaadja, hogy a karakter meghalt-e.
+     */
+    bool isDead() const;
+
+    /**
+     * @brief Visszaadja a karakter irányításhoz látható állapotát.
+     */
+    PlayerView getView() const;
+
+    /**
+     * @brief Beállítja a karakter irányítóját.
+     *
+     * @param controller Az irányító, nullptr esetén a karakter áll.
+     */
+    void setController(PlayerController* const controller);
+
+    /**
+     * @brief Beállítja az ellenfelet, amelynek állapotát az irányító látja.
+     *
+     * @param opponent Az ellenfél, vagy nullptr.
+     */
+    void setOpponent(const Fighter* const opponent);
+
+    /**
+     * @brief Beállítja a pálya méretét a határok ellenőrzéséhez.
+     *
+     * @param width A pálya fél szélessége.
+     * @param height A pálya fél magassága.
+     */
+    void setArena(const double width, const double height);
+
+    /**
+     * @brief Elmenti a karakter állapotát.
+     *
+     * @param state A mentés helye.
+     */
+    void saveState(State& state) const;
+
+    /**
+     * @brief Visszaállítja a karakter korábban mentett állapotát.
+     *
+     * @param state A mentett állapot.
+     */
+    void loadState(const State& state);
+
+    /**
+     * @brief Hozzáadja a fizikai állapotot és a halál tényét a hashhez.
+     */
+    void hashState(StateHasher& hasher) const override;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include "memtrace.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Egy mappa file-jainak változását figyelő osztály.
+ *
+ * A `FileWatcher` Linuxon inotify segítségével értesül a mappában megírt,
+ * létrehozott vagy odamozgatott file-okról. A figyelés nem blokkol: a
+ * változások a `poll` hívásakor kerülnek kiolvasásra, így a játék főciklusából
+ * képkockánként meghívható. Más rendszereken a figyelés nem indul el.
+ */
+class FileWatcher
+{
+    private:
+    int inotifyDescriptor; ///< Az inotify példány leírója, vagy -1.
+    int watchDescriptor; ///< A figyelt mappa leírója, vagy -1.
+
+    /**
+     * @brief Másoló konstruktor tiltása, a leírók nem másolhatók.
+     */
+    FileWatcher(const FileWatcher& watcher);
+
+    /**
+     * @brief Értékadás tiltása, a leírók nem másolhatók.
+     */
+    FileWatcher& operator=(const FileWatcher& watcher);
+
+    public:
+    /**
+     * @brief Létrehoz egy `FileWatcher` objektumot, amely még nem figyel semmit.
+     */
+    FileWatcher();
+
+    /**
+     * @brief Leállítja a figyelést.
+     */
+    ~FileWatcher();
+
+    /**
+     * @brief Elkezdi a mappa figyelését.
+     *
+     * @param directory A figyelendő mappa.
+     * @return true, ha a figyelés elindult, különben false.
+     */
+    bool watch(const std::string& directory);
+
+    /**
+     * @brief Megadja, hogy a figyelés fut-e.
+     */
+    bool isWatching() const;
+
+    /**
+     * @brief Összegyűjti a legutóbbi hívás óta megváltozott file-ok nevét.
+     *
+     * Minden file legfeljebb egyszer szerepel az eredményben.
+     *
+     * @param changedFiles A megváltozott file-ok neve a mappán belül, a metódus előbb kiüríti.
+     */
+    void poll(std::vector<std::string>& changedFiles);
+};
@@ -0,0 +1,311 @@
+#pragma once
+#include "memtrace.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Képkockánként és fizikai lépésenként visszaállított lineáris memóriaterület.
+ *
+ * A foglalás csak egy mutatót léptet előre a lefoglalt blokkokban, a
+ * felszabadítás pedig a visszaállítási ponton egyszerre történik: a `Scope`
+ * megjegyzi a terület állapotát, és a megszűnésekor visszaállítja. A világ a
+ * fizikai lépések és a frissítési fázisok köré nyit ilyen pontot, így a
+ * lépésen belüli rövid életű tárolók a kezdeti bemelegedés után nem hívják az
+ * általános célú foglalót.
+ *
+ * Minden szálnak saját területe van, így a párhuzamos fázisok zárolás nélkül
+ * foglalhatnak. Ha a terület egy lépés alatt több blokkra nőtt, a teljes
+ * visszaállításkor a blokkok egyetlen, az összméretükkel egyező blokká
+ * olvadnak össze.
+ *
+ * `FRAME_ARENA_ASSERT` fordítási kapcsolóval a nyitott pontokon belül hívott
+ * `new` hibának számít: a program megszámolja, és pontonként az elsőt kiírja
+ * a szabványos hibakimenetre. A kapcsoló a `MEMTRACE` kapcsolóval együtt nem
+ * használható, mert mindkettő lecseréli a globális `new` operátort.
+ */
+class FrameArena
+{
+    public:
+    /**
+     * @brief A terület egy korábbi állapota, ahová vissza lehet állni.
+     */
+    struct Marker
+    {
+        size_t block; ///< Az aktuális blokk sorszáma.
+        size_t offset; ///< Az aktuális blokkban már lefoglalt bájtok száma.
+        size_t used; ///< Az összes lefoglalt bájt száma.
+    };
+
+    /**
+     * @brief Visszaállítási pont a szál saját területén.
+     *
+     * A létrehozáskor megjegyzi a terület állapotát, a megszűnéskor
+     * visszaállítja, így a közben lefoglalt memória újra felhasználható. A
+     * ponton belül létrehozott területhez kötött tárolók nem élhetik túl a
+     * pontot, és a pont előtt létrehozott tárolók a ponton belül nem nőhetnek.
+     */
+    class Scope
+    {
+        private:
+        FrameArena& arena; ///< A visszaállítandó terület.
+        Marker marker; ///< A terület állapota a pont létrehozásakor.
+        Marker previousFloor; ///< A külső pont kezdete, a megszűnéskor ez lesz újra az alsó határ.
+
+        /**
+         * @brief Másoló konstruktor tiltása.
+         */
+        Scope(const Scope& scope);
+
+        /**
+         * @brief Értékadás tiltása.
+         */
+        Scope& operator=(const Scope& scope);
+
+        public:
+        /**
+         * @brief Visszaállítási pontot nyit a hívó szál területén.
+         */
+        Scope();
+
+        /**
+         * @brief Visszaállítja a területet a pont létrehozásakori állapotára.
+         */
+        ~Scope();
+    };
+
+    private:
+    /**
+     * @brief Egy összefüggő memóriablokk.
+     */
+    struct Block
+    {
+        char* data; ///< A blokk kezdete.
+        size_t size; ///< A blokk mérete bájtban.
+    };
+
+    std::vector<Block> blocks; ///< A lefoglalt blokkok, a használat sorrendjében.
+    size_t blockIndex; ///< Az aktuális blokk sorszáma.
+    size_t offset; ///< Az aktuális blokkban már lefoglalt bájtok száma.
+    size_t initialSize; ///< Az első blokk mérete bájtban.
+    size_t used; ///< A lefoglalt bájtok száma az igazítással együtt.
+    size_t peak; ///< A lefoglalt bájtok legnagyobb száma a terület létrehozása óta.
+    size_t scopeDepth; ///< A területen nyitott visszaállítási pontok száma.
+    Marker floor; ///< A legbelső pont kezdete, az ez előtti foglalások csak a külső pontokkal szabadulnak fel.
+
+    static std::atomic<size_t> strayAllocations; ///< A pontokon belül hívott `new` operátorok száma.
+
+    /**
+     * @brief Új blokkra lép, amelybe a megadott méretű és igazítású foglalás belefér.
+     */
+    void grow(const size_t size, const size_t alignment);
+
+    /**
+     * @brief Felszabadítja az összes blokkot.
+     */
+    void releaseBlocks();
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    FrameArena(const FrameArena& arena);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    FrameArena& operator=(const FrameArena& arena);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres területet, az első blokkot csak az első foglalás foglalja le.
+     *
+     * @param initialSize Az első blokk mérete bájtban.
+     * @throws std::invalid_argument Ha a méret nulla.
+     */
+    explicit FrameArena(const size_t initialSize = 64 * 1024);
+
+    /**
+     * @brief Felszabadítja a blokkokat.
+     */
+    ~FrameArena();
+
+    /**
+     * @brief Lefoglal egy memóriaterületet.
+     *
+     * @param size A terület mérete bájtban.
+     * @param alignment A terület igazítása, kettő hatványa.
+     * @return A terület kezdete.
+     * @throws std::invalid_argument Ha az igazítás nem kettő hatványa.
+     */
+    void* allocate(const size_t size, const size_t alignment);
+
+    /**
+     * @brief Felszabadít egy memóriaterületet, ha az a legutóbbi foglalás.
+     *
+     * A többi terület, és a legbelső visszaállítási pont előtti foglalások
+     * csak a visszaállításkor szabadulnak fel.
+     *
+     * @param pointer A terület kezdete.
+     * @param size A terület mérete bájtban.
+     */
+    void deallocate(void* pointer, const size_t size);
+
+    /**
+     * @brief Visszaadja a terület jelenlegi állapotát.
+     */
+    Marker getMarker() const;
+
+    /**
+     * @brief Visszaállítja a területet egy korábbi állapotára.
+     *
+     * @param marker A korábbi állapot.
+     * @throws std::out_of_range Ha az állapot a jelenleginél későbbi.
+     */
+    void rewind(const Marker& marker);
+
+    /**
+     * @brief Visszaállítja a területet üres állapotára.
+     */
+    void reset();
+
+    /**
+     * @brief Visszaadja a lefoglalt bájtok számát.
+     */
+    size_t getUsed() const;
+
+    /**
+     * @brief Visszaadja a lefoglalt bájtok legnagyobb számát.
+     */
+    size_t getPeak() const;
+
+    /**
+     * @brief Visszaadja a blokkok összméretét bájtban.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Visszaadja a blokkok számát.
+     */
+    size_t getBlockCount() const;
+
+    /**
+     * @brief Visszaadja a területen nyitott visszaállítási pontok számát.
+     */
+    size_t getScopeDepth() const;
+
+    /**
+     * @brief Visszaadja a hívó szál területét.
+     */
+    static FrameArena& getThreadArena();
+
+    /**
+     * @brief Visszaadja a hívó szál területét, ha azon van nyitott visszaállítási pont.
+     *
+     * @return A terület, vagy nullptr, ha nincs nyitott pont.
+     */
+    static FrameArena* getActive();
+
+    /**
+     * @brief Feljegyez egy visszaállítási ponton belül hívott `new` operátort.
+     *
+     * Csak `FRAME_ARENA_ASSERT` kapcsolóval hívódik.
+     *
+     * @param size A foglalás mérete bájtban.
+     */
+    static void reportStrayAllocation(const size_t size);
+
+    /**
+     * @brief Visszaadja a visszaállítási pontokon belül hívott `new` operátorok számát.
+     *
+     * `FRAME_ARENA_ASSERT` kapcsoló nélkül mindig nulla.
+     */
+    static size_t getStrayAllocationCount();
+};
+
+/**
+ * @brief A szál területéből foglaló, a szabványos tárolókkal használható foglaló.
+ *
+ * A létrehozáskor megjegyzi a hívó szál területét, ha azon van nyitott
+ * visszaállítási pont, különben az általános célú foglalót használja. Így a
+ * pontokon kívül létrehozott tárolók a megszokott módon működnek.
+ *
+ * @tparam T A lefoglalt elemek típusa.
+ */
+template <typename T>
+class ArenaAllocator
+{
+    private:
+    FrameArena* arena; ///< A terület, amelyből foglal, vagy nullptr.
+
+    template <typename U>
+    friend class ArenaAllocator;
+
+    public:
+    typedef T value_type; ///< A lefoglalt elemek típusa.
+
+    /**
+     * @brief Létrehoz egy foglalót a hívó szál aktív területéhez.
+     */
+    ArenaAllocator() noexcept;
+
+    /**
+     * @brief Létrehoz egy foglalót a megadott területhez.
+     *
+     * @param arena A terület, vagy nullptr az általános célú foglalóhoz.
+     */
+    explicit ArenaAllocator(FrameArena* arena) noexcept;
+
+    /**
+     * @brief Létrehoz egy másik típusú foglalóval azonos területű foglalót.
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& allocator) noexcept;
+
+    /**
+     * @brief Lefoglal a megadott számú elemnek elegendő memóriát.
+     *
+     * @param count Az elemek száma.
+     * @return A terület kezdete.
+     */
+    T* allocate(const size_t count);
+
+    /**
+     * @brief Felszabadítja az `allocate` által lefoglalt memóriát.
+     *
+     * @param pointer A terület kezdete.
+     * @param count Az elemek száma.
+     */
+    void deallocate(T* pointer, const size_t count) noexcept;
+
+    /**
+     * @brief Visszaadja a területet, amelyből a foglaló foglal.
+     */
+    FrameArena* getArena() const noexcept;
+
+    /**
+     * @brief Megadja, hogy a két foglaló ugyanabból a területből foglal-e.
+     */
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& allocator) const noexcept;
+
+    /**
+     * @brief Megadja, hogy a két foglaló különböző területekből foglal-e.
+     */
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& allocator) const noexcept;
+};
+
+/**
+ * @brief A szál területéből foglaló vektor.
+ */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+/**
+ * @brief A szál területéből foglaló szöveg.
+ */
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>> ArenaString;
+
+#include "framearena.inl"
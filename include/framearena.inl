@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator() noexcept
+: arena(FrameArena::getActive())
+{
+
+}
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(FrameArena* arena) noexcept
+: arena(arena)
+{
+
+}
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& allocator) noexcept
+: arena(allocator.arena)
+{
+
+}
+
+template <typename T>
+T* ArenaAllocator<T>::allocate(const size_t count)
+{
+    if (arena == nullptr)
+        return std::allocator<T>().allocate(count);
+
+    return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T* pointer, const size_t count) noexcept
+{
+    if (arena == nullptr)
+    {
+        std::allocator<T>().deallocate(pointer, count);
+        return;
+    }
+
+    arena->deallocate(pointer, count * sizeof(T));
+}
+
+template <typename T>
+FrameArena* ArenaAllocator<T>::getArena() const noexcept { return arena; }
+
+template <typename T>
+template <typename U>
+bool ArenaAllocator<T>::operator==(const ArenaAllocator<U>& allocator) const noexcept
+{
+    return arena == allocator.arena;
+}
+
+template <typename T>
+template <typename U>
+bool ArenaAllocator<T>::operator!=(const ArenaAllocator<U>& allocator) const noexcept
+{
+    return arena != allocator.arena;
+}
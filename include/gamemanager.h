@@ -25,6 +25,7 @@ class GameManager : Updatable
     Color player2Color = makeColor(200, 0, 0); ///< A második játékos színe.
 
     double resetTime = 0.5; ///< A játékos halála után az újraindításig eltelt idő másodpercben.
+    size_t chunksPerFrame = 4; ///< Streamelt pályán képkockánként legfeljebb ennyi chunk töltődik be vagy törlődik.
 
     Player player1; ///< Az első játékos objektuma, amely a játékos állapotát és viselkedését reprezentálja.
     Player player2; ///< A második játékos objektuma, amely a játékos állapotát és viselkedését reprezentálja.
@@ -108,6 +109,21 @@ class GameManager : Updatable
      */
     void nextMap();
 
+    /**
+     * @brief Elkezdi a következő pálya előkészítését háttérszálon.
+     * 
+     * A győzelem után induló visszaszámlálás alatt fut, így a következő pálya
+     * betöltésekor már csak a falak létrehozása marad hátra.
+     */
+    void prepareNextMap();
+
+    /**
+     * @brief Streamelt pálya esetén a kamera és a játékosok köré tölti a pálya chunkjait.
+     * 
+     * @param maxChanges A betölthető vagy törölhető chunkok száma.
+     */
+    void streamMap(const size_t maxChanges);
+
     public:
     /**
      * @brief Singleton minta megvalósítása.
@@ -57,6 +57,7 @@
 #ifdef MEMTRACE
 # include "memtrace.h"
 #endif
+#include "allocationcounter.h"
 
 // Két makró az egyes tesztek elé és mögé:
 // A két makró a kapcsos zárójelekkel egy új blokkot hoz létre, amiben
@@ -167,6 +168,20 @@
 /// Környezeti változóhoz hasonlít -- ilyen nincs a gtest-ben (kisbetű/nagybetű azonos)
 #define EXPECT_ENVCASEEQ(expected, actual) gtest_lite::EXPECTSTR(std::getenv(expected), actual, gtest_lite::eqstrcase, __FILE__, __LINE__, "EXPECT_ENVCASEEQ(" #expected ", " #actual ")" )
 
+/// Legfeljebb count foglalást és bytes bájtot váró makró az utasításra -- ilyen nincs a gtest-ben
+/// A foglalásokat minden szálon számolja, ahol nem számlálhatók, ott sikeres.
+#define EXPECT_ALLOCATIONS_LE(count, bytes, statement) { gtest_lite::AllocationBudget gtest_lite_budget; statement; gtest_lite_budget.stop(); } \
+    gtest_lite::EXPECTALLOC(count, bytes, gtest_lite::test.acount, gtest_lite::test.abytes, __FILE__, __LINE__, "EXPECT_ALLOCATIONS_LE(" #count ", " #bytes ", " #statement ")")
+
+/// Foglalásmentes utasítást váró makró -- ilyen nincs a gtest-ben
+#define EXPECT_NO_ALLOCATIONS(statement) EXPECT_ALLOCATIONS_LE(0, 0, statement)
+
+/// Foglalási keret a blokk hátralevő részére -- ilyen nincs a gtest-ben
+/// A blokk végén ellenőrzi, hogy legfeljebb count foglalás és bytes bájt történt-e
+/// a makró óta, a később létrehozott lokális változók destruktoraival együtt.
+#define ALLOCATION_BUDGET(count, bytes) gtest_lite::AllocationBudget GTEST_LITE_CAT(gtest_lite_budget_, __LINE__) \
+    (count, bytes, __FILE__, __LINE__, "ALLOCATION_BUDGET(" #count ", " #bytes ")")
+
 #if __cplusplus >= 201103L
 /// Reguláris kifejezés illesztése
 # define EXPECT_REGEXP(expected, actual, match, err) gtest_lite::EXPECTREGEXP(expected, actual, match, err, __FILE__, __LINE__, "EXPECT_REGEXP(" #expected ", " #actual ", " #match ")" )
@@ -234,6 +249,10 @@ struct _Is_Types {
     << "** Az utasitas " << (act) \
     << "\n** Azt vartuk, hogy " << (exp) << std::endl; if (!gtest_lite::test.status) { gtest_lite::test.end(); break; }
 
+/// Egyedi változónév képzése a sorszámból
+#define GTEST_LITE_CAT_(a, b) a##b
+#define GTEST_LITE_CAT(a, b) GTEST_LITE_CAT_(a, b)
+
 #define ASSERT_(expected, actual, fn, op) EXPECT_(expected, actual, fn, __FILE__, __LINE__, #op "(" #expected ", " #actual ")" ); \
     if (!gtest_lite::test.status) { gtest_lite::test.end(); break; }
 
@@ -264,6 +283,8 @@ struct Test {
     int ablocks;        ///< allokált blokkok száma
     bool status;        ///< éppen futó teszt státusza
     bool tmp;           ///< temp a kivételkezeléshez;
+    size_t acount;      ///< az utoljára mért foglalások száma
+    size_t abytes;      ///< az utoljára mért foglalások mérete
     std::string name;   ///< éppen futó teszt neve
     std::fstream null;  ///< nyelő, ha nem kell kiírni semmit
     std::ostream& os;   ///< ide írunk
@@ -272,7 +293,7 @@ struct Test {
         return instance;
     }
 private:    /// singleton minta miatt
-    Test() :sum(0), failed(0), status(false), null("/dev/null"), os(std::cout) {}
+    Test() :sum(0), failed(0), status(false), acount(0), abytes(0), null("/dev/null"), os(std::cout) {}
     Test(const Test&);
     void operator=(const Test&);
 public:
@@ -410,6 +431,53 @@ std::ostream& EXPECTREGEXP(E exp, S str, int match, const char *err,  const char
 }
 #endif
 
+/// foglalási kerethez.
+/// Ha a foglalások nem számlálhatók, akkor sikeres.
+inline
+std::ostream& EXPECTALLOC(size_t maxCount, size_t maxBytes, size_t count, size_t bytes, const char *file, int line,
+                      const char *expr) {
+    return test.expect(!AllocationCounter::isAvailable() || (count <= maxCount && bytes <= maxBytes), file, line, expr)
+        << "** keret: " << maxCount << " foglalas, " << maxBytes << " bajt"
+        << "\n** aktual: " << count << " foglalas, " << bytes << " bajt" << std::endl;
+}
+
+/// Foglalásokat mérő osztály.
+/// A létrehozása óta történt foglalásokat méri. Ha kerettel hozták létre,
+/// a destruktora ellenőrzi, hogy nem lépték-e túl.
+class AllocationBudget {
+    size_t startCount;  ///< a foglalások száma a mérés kezdetén
+    size_t startBytes;  ///< a foglalások mérete a mérés kezdetén
+    size_t maxCount;    ///< megengedett foglalások száma
+    size_t maxBytes;    ///< megengedett bájtok száma
+    const char *file;   ///< a keret helye
+    int line;           ///< a keret sora
+    const char *expr;   ///< a keret szövege, NULL ha nincs keret
+    AllocationBudget(const AllocationBudget&);
+    void operator=(const AllocationBudget&);
+public:
+    /// Keret nélküli mérés, az eredményt a stop() adja át
+    AllocationBudget()
+        : startCount(AllocationCounter::getCount()), startBytes(AllocationCounter::getBytes()),
+          maxCount(0), maxBytes(0), file(NULL), line(0), expr(NULL) {}
+    /// Mérés kerettel
+    AllocationBudget(size_t maxCount, size_t maxBytes, const char *file, int line, const char *expr)
+        : startCount(AllocationCounter::getCount()), startBytes(AllocationCounter::getBytes()),
+          maxCount(maxCount), maxBytes(maxBytes), file(file), line(line), expr(expr) {}
+    /// A mérés óta történt foglalások száma
+    size_t count() const { return AllocationCounter::getCount() - startCount; }
+    /// A mérés óta lefoglalt bájtok száma
+    size_t bytes() const { return AllocationCounter::getBytes() - startBytes; }
+    /// A mérés eredményét a tesztállapotba írja
+    void stop() { test.acount = count(); test.abytes = bytes(); }
+    /// Kerettel létrehozva ellenőriz
+    ~AllocationBudget() {
+        if (expr != NULL) {
+            size_t c = count(), b = bytes();
+            EXPECTALLOC(maxCount, maxBytes, c, b, file, line, expr);
+        }
+    }
+};
+
 /// segéd sablonok a relációkhoz.
 /// azért nem STL (algorithm), mert csak a függvény lehet, hogy menjen a deduckció
 template <typename T>
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "inputqueue.h"
+
 #include <SDL3/SDL.h>
-#include <unordered_set>
+
+#include <cstdint>
 
 /**
  * @brief A felhasználói bemenetek kezelésére szolgáló osztály.
@@ -9,37 +12,43 @@
  * Az `InputHandler` osztály felelős a felhasználói bemenetek, például
  * billentyűleütések és billentyűfelengedések kezeléséért. Az osztály
  * nyomon követi a lenyomott billentyűket, és lehetővé teszi azok állapotának
- * gyors lekérdezését.
+ * gyors lekérdezését. A lenyomott billentyűk a hívó szálon aktuális `World`
+ * részei, így minden világ saját bemenetet kaphat.
+ *
+ * A billentyűesemények az SDL időbélyegükkel egy `InputQueue` sorba kerülnek,
+ * és csak a fizikai lépések előtt, a lépés időpontja szerint érvényesülnek.
+ * Az SDL eseményeket a fő szálon kell feldolgozni, ez a sor termelője.
  */
 class InputHandler
 {
     private:
-    /**
-     * @brief Az aktuálisan lenyomott billentyűk kódjait tároló halmaz.
-     * 
-     * A `pressedKeys` halmaz az SDL események alapján frissül, és tartalmazza
-     * az összes olyan billentyű kódját, amely jelenleg lenyomott állapotban van.
-     * Ez lehetővé teszi a billentyűk állapotának gyors és hatékony lekérdezését.
-     */
-    static std::unordered_set<SDL_Keycode> pressedKeys;
+    static InputQueue events; ///< A még nem alkalmazott billentyűesemények.
 
     public:
     /**
      * @brief Kezeli a felhasználói bemenetekhez tartozó SDL eseményeket.
      * 
-     * A metódus az SDL események alapján frissíti a `pressedKeys` halmazt.
-     * Billentyűleütés esetén hozzáadja a billentyű kódját a halmazhoz,
-     * míg billentyűfelengedés esetén eltávolítja azt.
+     * Billentyűleütés és billentyűfelengedés esetén az eseményt az
+     * időbélyegével a sorba teszi, az ismétlődő leütéseket kihagyja.
      * 
      * @param event Az SDL esemény, amely tartalmazza a felhasználói bemenetet.
      */
     static void handleEvent(SDL_Event& event);
 
+    /**
+     * @brief Alkalmazza az aktuális világ billentyűállapotára az időpontig történt eseményeket.
+     *
+     * A fizikai lépések előtt hívandó.
+     *
+     * @param time A lépés időpontja az `SDL_GetTicksNS` skáláján.
+     */
+    static void applyEvents(const uint64_t time);
+
     /**
      * @brief A billentyűk állapotának lekérdezése.
      * 
      * A metódus ellenőrzi, hogy a megadott billentyű kódja szerepel-e a
-     * `pressedKeys` halmazban. Ha a billentyű lenyomva van, igaz értéket ad
+     * lenyomott billentyűk halmazában. Ha a billentyű lenyomva van, igaz értéket ad
      * vissza, különben hamisat.
      * 
      * @param key A billentyű kódja, amelynek állapotát le kell kérdezni.
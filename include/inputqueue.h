@@ -0,0 +1,92 @@
+#pragma once
+#include "memtrace.h"
+
+#include "spscqueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class World;
+
+/**
+ * @brief Egy billentyű lenyomása vagy felengedése, az időpontjával.
+ */
+struct KeyEvent
+{
+    uint64_t time = 0; ///< Az esemény időpontja nanoszekundumban, a fizikai lépések órájával azonos skálán.
+    uint32_t key = 0; ///< A billentyű kódja.
+    bool pressed = false; ///< true lenyomáskor, false felengedéskor.
+};
+
+/**
+ * @brief Időbélyeges billentyűesemények sora a bemenet mintavételezése és a fizikai lépések között.
+ *
+ * A bemenetet mintavételező szál (termelő) a `record` metódussal teszi a
+ * sorba az eseményeket, a szimuláció (fogyasztó) minden fizikai lépés előtt
+ * az `apply` metódussal a lépés időpontjáig történt eseményeket alkalmazza
+ * a világ billentyűállapotára. Így egy képkockán belüli lépések is a saját
+ * időpontjuk szerinti bemenetet látják, és a bemenet ugyanarra a lépésre
+ * kerül, akármilyen gyorsan fut a megjelenítés.
+ *
+ * A sor rögzített méretű és zármentes (`SpscQueue`). Ha betelik, az
+ * esemény elveszik. Hogy egy elveszett felengedés miatt ne ragadjon be egy
+ * billentyű, a fogyasztó a sor kiürülésekor felengedi az összes billentyűt.
+ */
+class InputQueue
+{
+    private:
+    SpscQueue<KeyEvent> events; ///< A még nem alkalmazott események.
+    std::atomic<size_t> droppedCount; ///< A betelt sor miatt elveszett események száma.
+    std::atomic<bool> overflowed; ///< Jelzi, hogy az utolsó kiürülés óta veszett el esemény.
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    InputQueue(const InputQueue& queue);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    InputQueue& operator=(const InputQueue& queue);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres sort.
+     *
+     * @param capacity A sorban egyszerre várakozó események legkisebb száma.
+     */
+    explicit InputQueue(const size_t capacity = 256);
+
+    /**
+     * @brief A sorba teszi az eseményt. Csak a termelő szálról hívható.
+     *
+     * Az eseményeket időrendben kell a sorba tenni.
+     *
+     * @param event Az esemény.
+     * @return false, ha a sor tele volt, és az esemény elveszett.
+     */
+    bool record(const KeyEvent& event);
+
+    /**
+     * @brief Alkalmazza a világ billentyűállapotára az időpontig történt eseményeket.
+     *
+     * Csak a fogyasztó szálról hívható. A későbbi események a sorban maradnak
+     * a következő lépésekhez.
+     *
+     * @param world A világ, amelynek billentyűállapota frissül.
+     * @param time A fizikai lépés időpontja, az ennél nem későbbi események érvényesülnek.
+     * @return Az alkalmazott események száma.
+     */
+    size_t apply(World& world, const uint64_t time);
+
+    /**
+     * @brief Visszaadja a még nem alkalmazott események számát.
+     */
+    size_t getPendingCount() const;
+
+    /**
+     * @brief Visszaadja a betelt sor miatt elveszett események számát.
+     */
+    size_t getDroppedCount() const;
+};
@@ -0,0 +1,278 @@
+#pragma once
+#include "memtrace.h"
+
+#include "mpscqueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief A naplóbejegyzések szintjei, növekvő fontosság szerint.
+ */
+enum class LogLevel
+{
+    VERBOSE,
+    INFO,
+    WARNING,
+    ERROR
+};
+
+//the entries below this level are compiled out, e.g. LOG_MIN_LEVEL=1 drops the verbose ones
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Naplóbejegyzés a megadott szinten, printf formátummal.
+ *
+ * A fordítási idejű szint alatti bejegyzések kódja nem fordul le. A hívás
+ * helye saját ütemkorlátot kap, amely a figyelmeztetésekre és a hibákra vonatkozik.
+ */
+#define LOG_AT(level, ...) \
+    do \
+    { \
+        if ((int)(level) >= LOG_MIN_LEVEL && Logger::isEnabled(level)) \
+        { \
+            static Logger::Site logSite(__FILE__, __LINE__); \
+            Logger::write(logSite, level, __VA_ARGS__); \
+        } \
+    } while (false)
+
+#define LOG_VERBOSE(...) LOG_AT(LogLevel::VERBOSE, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(LogLevel::WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERROR, __VA_ARGS__)
+
+/**
+ * @brief Aszinkron napló, amely a bejegyzéseket egy háttérszálon formázza és írja ki.
+ *
+ * A hívó szál csak a formátum pointerét és a paraméterek bináris másolatát
+ * teszi egy több termelős, zármentes sorba, így a naplózás nem foglal
+ * memóriát, és nem vár a kimenetre. A formázást és a kiírást az író szál
+ * végzi (`start`). Ha az író szál nem fut, a bejegyzés a hívó szálon
+ * azonnal kiíródik, így a parancssori módok és a tesztek sorrendje változatlan.
+ *
+ * A formátum printf szintaxisú, és a program végéig élő szöveg (literál)
+ * kell legyen. A paraméterek egész és valós számok, C stringek,
+ * `std::string`, `std::string_view` és pointerek lehetnek, a szövegek
+ * legfeljebb a bejegyzés méretéig másolódnak. A hosszmódosítók (`%zu`,
+ * `%ld`) nem számítanak, a típust a tárolt paraméter adja.
+ *
+ * A figyelmeztetésekből és a hibákból hívási helyenként legfeljebb
+ * `setRateLimit` szerinti számú bejegyzés kerül a sorba egy időablakban, a
+ * többit a hely következő ablakának első bejegyzése összegzi. Tele sor esetén a bejegyzés elveszik, és az író szál
+ * jelzi a kimaradt bejegyzések számát.
+ */
+class Logger
+{
+    public:
+    /**
+     * @brief Egy naplózó hívás helye és ütemkorlátjának állapota.
+     *
+     * A `LOG_*` makrók hívási helyenként egy statikus példányt hoznak létre.
+     */
+    struct Site
+    {
+        const char* file; ///< A forrásfájl.
+        int line; ///< A sor.
+        std::atomic<uint64_t> windowStart; ///< Az aktuális időablak kezdete nanoszekundumban.
+        std::atomic<uint32_t> windowCount; ///< Az időablakban eddig érkezett bejegyzések száma.
+        std::atomic<uint32_t> suppressed; ///< Az ütemkorlát miatt kimaradt bejegyzések száma.
+
+        /**
+         * @brief Létrehozza a hely állapotát, fordítási időben kiértékelhető.
+         */
+        constexpr Site(const char* file, const int line)
+        : file(file), line(line), windowStart(0), windowCount(0), suppressed(0) {}
+    };
+
+    static constexpr size_t payloadSize = 192; ///< A paraméterek bináris másolatának legnagyobb mérete.
+    static constexpr size_t queueCapacity = 2048; ///< A sorban egyszerre várakozó bejegyzések száma.
+
+    /**
+     * @brief Egy kiírásra váró bejegyzés.
+     */
+    struct Entry
+    {
+        const Site* site; ///< A hívás helye.
+        LogLevel level; ///< A szint.
+        uint32_t suppressed; ///< A hely előző ablakában kimaradt bejegyzések száma.
+        uint64_t time; ///< A bejegyzés ideje nanoszekundumban.
+        const char* format; ///< A printf formátum.
+        uint16_t size; ///< A paraméterek által használt bájtok száma.
+        bool truncated; ///< Nem fért el minden paraméter.
+        char payload[payloadSize]; ///< A paraméterek típusjelzővel ellátott másolata.
+    };
+
+    private:
+    static std::atomic<int> level; ///< A futási idejű legkisebb kiírt szint.
+    static std::atomic<uint32_t> burstLimit; ///< Hívási helyenként egy ablakban kiírt bejegyzések száma, 0 esetén korlátlan.
+    static std::atomic<uint64_t> windowLength; ///< Az ütemkorlát ablakának hossza nanoszekundumban.
+
+    static std::atomic<bool> running; ///< Fut-e az író szál.
+    static std::atomic<size_t> queued; ///< A sorba tett bejegyzések száma.
+    static std::atomic<size_t> written; ///< Az író szál által kiírt bejegyzések száma.
+    static std::atomic<size_t> dropped; ///< A tele sor miatt elveszett bejegyzések száma.
+    static size_t reportedDrops; ///< A már jelzett elveszett bejegyzések száma.
+
+    static std::thread writer; ///< Az író szál.
+    static std::mutex outputMutex; ///< A kimenetet és a formázó puffert védi.
+    static FILE* output; ///< A kimenet, nullptr esetén az alapértelmezett.
+    static std::string text; ///< A formázó puffer.
+    static uint64_t startTime; ///< Az időbélyegek kezdete nanoszekundumban.
+
+    /**
+     * @brief Visszaadja a bejegyzések sorát.
+     */
+    static MpscQueue<Entry>& getQueue();
+
+    /**
+     * @brief Visszaadja a monoton órát nanoszekundumban.
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Az ütemkorlát alapján eldönti, hogy a bejegyzés kiírható-e.
+     *
+     * @param site A hívás helye.
+     * @param time A bejegyzés ideje.
+     * @param suppressed Új ablak kezdetén az előző ablakban kimaradt bejegyzések száma.
+     * @return true, ha a bejegyzés kiírható.
+     */
+    static bool allow(Site& site, const uint64_t time, uint32_t& suppressed);
+
+    /**
+     * @brief Sorba teszi, vagy ha az író szál nem fut, azonnal kiírja a bejegyzést.
+     */
+    static void submit(const Entry& entry);
+
+    /**
+     * @brief Az író szál ciklusa.
+     */
+    static void writerLoop();
+
+    /**
+     * @brief Kiírja a sorban várakozó bejegyzéseket.
+     *
+     * @return A kiírt bejegyzések száma.
+     */
+    static size_t drain();
+
+    /**
+     * @brief Formázza és kiírja a bejegyzést. A hívó tartja az `outputMutex`-et.
+     */
+    static void emit(const Entry& entry);
+
+    /**
+     * @brief Kiír egy kész sort a kimenetre. A hívó tartja az `outputMutex`-et.
+     */
+    static void emitLine(const LogLevel level, const uint64_t time, const char* line);
+
+    /**
+     * @brief A formátum és a tárolt paraméterek alapján előállítja a bejegyzés szövegét.
+     */
+    static void format(const Entry& entry, std::string& result);
+
+    /**
+     * @brief Helyet foglal a paraméternek a bejegyzésben.
+     *
+     * @return A hely, vagy nullptr, ha a paraméter nem fér el.
+     */
+    static char* reserve(Entry& entry, const char tag, const size_t size);
+
+    static void encode(Entry& entry, const long long value);
+    static void encode(Entry& entry, const unsigned long long value);
+    static void encode(Entry& entry, const double value);
+    static void encode(Entry& entry, const char* value);
+    static void encode(Entry& entry, const std::string& value);
+    static void encode(Entry& entry, const std::string_view value);
+    static void encode(Entry& entry, const void* value);
+
+    /**
+     * @brief Az egész típusú paramétereket előjel szerint tárolja.
+     */
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value>::type encode(Entry& entry, const T value);
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    Logger(const Logger& logger);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    Logger& operator=(const Logger& logger);
+
+    public:
+    /**
+     * @brief Elindítja az író szálat, ha még nem fut.
+     */
+    static void start();
+
+    /**
+     * @brief Kiírja a várakozó bejegyzéseket és leállítja az író szálat.
+     */
+    static void stop();
+
+    /**
+     * @brief Megvárja, hogy az eddig sorba tett bejegyzések kiíródjanak.
+     */
+    static void flush();
+
+    /**
+     * @brief Beállítja a futási idejű legkisebb kiírt szintet.
+     */
+    static void setLevel(const LogLevel level);
+
+    /**
+     * @brief Visszaadja a futási idejű legkisebb kiírt szintet.
+     */
+    static LogLevel getLevel();
+
+    /**
+     * @brief Megadja, hogy a szint bejegyzései kiíródnak-e.
+     */
+    static bool isEnabled(const LogLevel level) { return (int)level >= Logger::level.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Beállítja a figyelmeztetések és a hibák hívási helyenkénti ütemkorlátját.
+     *
+     * @param messages Egy ablakban kiírt bejegyzések száma, 0 esetén nincs korlát.
+     * @param windowMilliseconds Az ablak hossza ezredmásodpercben.
+     */
+    static void setRateLimit(const uint32_t messages, const uint64_t windowMilliseconds);
+
+    /**
+     * @brief Beállítja a kimenetet.
+     *
+     * @param file A fájl, vagy nullptr az alapértelmezett kimenethez (SDL napló,
+     * tesztekben a szabványos hibakimenet). A naplózó nem veszi át.
+     */
+    static void setOutput(FILE* const file);
+
+    /**
+     * @brief Visszaadja a tele sor miatt elveszett bejegyzések számát.
+     */
+    static size_t getDroppedCount();
+
+    /**
+     * @brief Naplóbejegyzés, a `LOG_*` makrók hívják.
+     *
+     * @param site A hívás helye.
+     * @param level A szint.
+     * @param format A printf formátum, literál.
+     * @param args A paraméterek.
+     */
+    template <typename... Args>
+    static void write(Site& site, const LogLevel level, const char* format, const Args&... args);
+};
+
+#include "logger.inl"
@@ -0,0 +1,35 @@
+#pragma once
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value>::type Logger::encode(Entry& entry, const T value)
+{
+    if (std::is_signed<T>::value)
+        encode(entry, (long long)value);
+    else
+        encode(entry, (unsigned long long)value);
+}
+
+template <typename... Args>
+void Logger::write(Site& site, const LogLevel level, const char* format, const Args&... args)
+{
+    const uint64_t time = now();
+    uint32_t suppressed = 0;
+    if (level >= LogLevel::WARNING && !allow(site, time, suppressed))
+        return;
+
+    //the payload is not cleared, the writer only reads its used part
+    Entry entry;
+    entry.site = &site;
+    entry.level = level;
+    entry.suppressed = suppressed;
+    entry.time = time;
+    entry.format = format;
+    entry.size = 0;
+    entry.truncated = false;
+
+    //the arguments are stored in order, the format is only parsed by the writer
+    int expand[] = {0, (encode(entry, args), 0)...};
+    (void)expand;
+
+    submit(entry);
+}
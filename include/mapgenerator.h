@@ -0,0 +1,87 @@
+#pragma once
+#include "memtrace.h"
+
+#include "vector2.h"
+#include "colors.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Paraméterek alapján véletlenszerű, `.gamemap` formátumú pályákat készítő osztály.
+ *
+ * A `MapGenerator` tetszőleges számú elemből álló terhelési (stress) pályákat
+ * készít a benchmarkokhoz és a hosszú futású tesztekhez. Ugyanazokkal a
+ * beállításokkal (a seedet is beleértve) minden platformon bitre ugyanazt a
+ * pályát adja: a véletlenszámokat a szabvány által rögzített `std::mt19937_64`
+ * állítja elő, az eloszlásokat pedig az osztály maga számolja egész és
+ * fixpontos aritmetikával. A méretek és a koordináták 1/8 egység
+ * pontosságúak, így a kiírásuk is pontos.
+ *
+ * A pálya két kezdő platformot tartalmaz a játékosok alatt, a többi elem
+ * a pálya területén egyenletesen szórva helyezkedik el.
+ */
+class MapGenerator
+{
+    public:
+    /**
+     * @brief A generált pálya paraméterei.
+     */
+    struct Settings
+    {
+        size_t elementCount = 1000; ///< Az elemek száma, a két kezdő platformmal együtt.
+        double density = 0.2; ///< Az elemek által lefedett terület aránya a pálya területéhez képest.
+        double minSize = 0.5; ///< Az elemek oldalhosszának alsó határa.
+        double maxSize = 4; ///< Az elemek oldalhosszának felső határa (legfeljebb 256), a méretek logaritmikusan egyenletes eloszlásúak.
+        double deadlyShare = 0.1; ///< A halálos elemek aránya.
+        double bouncyShare = 0.1; ///< A visszapattanó elemek aránya.
+        double bounciness = 0.8; ///< A visszapattanó elemek visszapattanási értéke.
+        uint64_t seed = 1; ///< A véletlenszám-generátor kezdőértéke.
+    };
+
+    /**
+     * @brief Egy generált pályaelem.
+     */
+    struct Element
+    {
+        Vector2 position; ///< Az elem pozíciója.
+        Vector2 scale; ///< Az elem mérete.
+        Color color; ///< Az elem színe.
+        bool deadly; ///< Meghatározza, hogy az elem halálos-e.
+        double bounciness; ///< Az elem visszapattanási értéke.
+    };
+
+    /**
+     * @brief Legenerálja a pálya elemeit.
+     *
+     * @param settings A pálya paraméterei.
+     * @return A pálya elemei, az első kettő a kezdő platform.
+     * @throws std::invalid_argument Ha a paraméterek érvénytelenek.
+     */
+    static std::vector<Element> generateElements(const Settings& settings);
+
+    /**
+     * @brief Legenerálja a pályát `.gamemap` formátumban.
+     *
+     * @param settings A pálya paraméterei.
+     * @return A pályafile tartalma.
+     * @throws std::invalid_argument Ha a paraméterek érvénytelenek.
+     */
+    static std::string generate(const Settings& settings);
+
+    /**
+     * @brief A parancssori pályagenerálás belépési pontja.
+     *
+     * Az első paraméter a kimeneti file neve, a többi `kulcs=érték` alakú:
+     * `count`, `density`, `min-size`, `max-size`, `deadly`, `bouncy`,
+     * `bounciness`, `seed`. A meg nem adott paraméterek az alapértelmezett
+     * értéküket kapják.
+     *
+     * @param argc A paraméterek száma.
+     * @param argv A paraméterek.
+     * @return 0 siker esetén, különben 1.
+     */
+    static int runCommandLine(const int argc, const char* const argv[]);
+};
@@ -1,9 +1,18 @@
 #pragma once
 
 #include "transform.h"
+#include "collider.h"
 #include "colors.h"
+#include "objectpool.h"
+#include "spatialgrid.h"
+#include "filewatcher.h"
+#include "textreader.h"
+#include <future>
+#include <string>
 #include <vector>
 
+class Wall;
+
 /**
  * @brief A játék pályáinak kezelésére szolgáló osztály.
  * 
@@ -60,6 +69,9 @@ class MapManager
         Vector2 player1Position; ///< Az első játékos kezdőpozíciója.
         Vector2 player2Position; ///< A második játékos kezdőpozíciója.
         std::vector<MapElement> elements; ///< A pályaelemek listája.
+        std::vector<MapElement> walls; ///< Az összevont pályaelemek, amelyekből a falak készülnek.
+        bool wallsReady; ///< Jelzi, hogy a `walls` lista elkészült-e.
+        std::string filename; ///< A file neve, amelyből a pálya betöltődött.
         
         /**
          * @brief Új elem hozzáadása a pályához.
@@ -74,9 +86,127 @@ class MapManager
         void addElement(const Vector2& position, const Vector2& scale, const Color& color, const bool deadly, const double bounciness, const Vector2& colliderRatio);
     };
 
+    /**
+     * @brief A pálya egy térbeli darabja (chunk) streamelt betöltéshez.
+     * 
+     * Egy falat az a chunk tartalmaz, amelynek a cellájába a középpontja esik.
+     * A chunk határai a falai által lefedett területet fogják közre, így
+     * a szomszédos chunkok határai átfedhetnek.
+     */
+    struct Chunk
+    {
+        Vector2 min; ///< A chunk falainak bal alsó határa.
+        Vector2 max; ///< A chunk falainak jobb felső határa.
+        std::vector<size_t> wallIds; ///< A chunk falainak indexe a pálya `walls` listájában.
+        std::vector<Wall*> walls; ///< A chunk létrehozott falai.
+        bool loaded; ///< Jelzi, hogy a chunk falai létre vannak-e hozva.
+    };
+
     std::vector<Map> mapCache; ///< A játékban elérhető pályák adatai.
-    std::vector<Transform*> mapInstance; ///< Az aktuálisan betöltött pálya elemei a játék világában.
+    ObjectPool<Wall> wallPool; ///< A falak tárhelye, a felszabadult helyeket a következő pályák újra felhasználják.
+    Transform::ChildListCache childLists; ///< A törölt falak gyermeklistái, a következő falak ezeket kapják meg.
+    std::vector<Wall*> mapInstance; ///< Az aktuálisan betöltött pálya falai.
+    std::vector<Collider*> mapColliders; ///< A betöltött pálya colliderei a tömeges törléshez.
     size_t loadedMapId; ///< Az aktuálisan betöltött pálya azonosítója.
+    bool mapLoaded; ///< Jelzi, hogy van-e pálya a játék világában.
+
+    static constexpr size_t defaultStreamingThreshold = 4096; ///< Az alapértelmezett fal szám, amelytől a pálya streamelve töltődik be.
+    static constexpr double defaultChunkSize = 16; ///< A chunkok cellájának alapértelmezett oldalhossza.
+    static constexpr double defaultStreamMargin = 8; ///< A fókusz körüli sáv alapértelmezett szélessége.
+
+    size_t streamingThreshold; ///< A falak száma, amelytől a pálya streamelve töltődik be.
+    double chunkSize; ///< A chunkok cellájának oldalhossza.
+    double streamMargin; ///< A fókusz körüli sáv, amelyben a chunkok betöltődnek.
+    bool streaming; ///< Jelzi, hogy a betöltött pálya streamelve van-e.
+    std::vector<Chunk> chunks; ///< A betöltött pálya chunkjai streamelés esetén.
+    SpatialGrid<Chunk> chunkGrid; ///< A chunkok térbeli indexe.
+    std::vector<Chunk*> loadedChunks; ///< A betöltött chunkok.
+    std::vector<Chunk*> chunkScratch; ///< Segédlista a chunkok lekérdezéséhez.
+
+    FileWatcher mapWatcher; ///< A pályafile-ok változásait figyelő objektum.
+    std::vector<std::string> changedFiles; ///< Segédlista a megváltozott file-ok nevéhez.
+
+    static constexpr size_t notMatched = SIZE_MAX; ///< Az új pályán nem szereplő falak jelölése.
+
+    std::future<std::vector<MapElement>> pendingWalls; ///< A háttérszálon készülő pálya összevont elemei.
+    size_t pendingMapId; ///< A háttérszálon készülő pálya azonosítója.
+
+    static constexpr size_t childListLimit = 1 << 16; ///< A megtartott gyermeklisták legnagyobb száma.
+
+    /**
+     * @brief Összevonja az egymással érintkező vagy átfedő, azonos tulajdonságú pályaelemeket.
+     * 
+     * Mohó algoritmussal felváltva vízszintesen és függőlegesen egyesíti azokat az
+     * elemeket, amelyek színe, halálossága, visszapattanási értéke és collider aránya
+     * megegyezik, és az uniójuk is téglalap. Csak olyan összevonás történik, amely
+     * után a falak és colliderek által lefedett terület pontosan ugyanaz marad, így
+     * a játékmenet nem változik, de kevesebb fal, collider és renderelő jön létre.
+     * 
+     * @param elements Az összevonandó pályaelemek.
+     * @return Az összevont pályaelemek.
+     */
+    static std::vector<MapElement> mergeElements(const std::vector<MapElement>& elements);
+
+    /**
+     * @brief Egy tengely mentén összevonja a szomszédos pályaelemeket.
+     * 
+     * @param elements Az összevonandó pályaelemek, az eredmény is ide kerül.
+     * @param horizontal true esetén az X, egyébként az Y tengely mentén von össze.
+     * @return Az összevonások száma.
+     */
+    static size_t mergeElementsAlongAxis(std::vector<MapElement>& elements, const bool horizontal);
+
+    /**
+     * @brief Megpróbálja a megadott elemet hozzávonni a cél elemhez egy tengely mentén.
+     * 
+     * @param target A bővítendő pályaelem.
+     * @param element A hozzávonandó pályaelem.
+     * @param horizontal true esetén az X, egyébként az Y tengely mentén von össze.
+     * @return true, ha az összevonás megtörtént, különben false.
+     */
+    static bool tryMergeElement(MapElement& target, const MapElement& element, const bool horizontal);
+
+
+    /**
+     * @brief Megadja, hogy a file neve `.gamemap` kiterjesztésre végződik-e.
+     * 
+     * A kiterjesztés kis- és nagybetűtől függetlenül, ASCII szerint kerül
+     * összehasonlításra.
+     */
+    static bool hasGamemapExtension(const std::string& filename);
+
+    /**
+     * @brief Beolvassa a file teljes tartalmát egy pufferbe.
+     * 
+     * @param filename A file neve.
+     * @param content A file tartalma.
+     * @return true, ha a beolvasás sikerült, különben false.
+     */
+    static bool readFile(const std::string& filename, std::string& content);
+
+    /**
+     * @brief Feldolgozza egy pályafile tartalmát.
+     * 
+     * A file szóközökkel elválasztott számokat tartalmaz: a pálya magasságát,
+     * a háttérszínt, a győzelemhez szükséges pontszámot, a két játékos
+     * kezdőpozícióját, majd a pályaelemeket elemenként 11 számmal.
+     * 
+     * @param text A file tartalma.
+     * @return A pálya adatai, még összevont elemek nélkül.
+     * @throws ParseError Ha a file hibás, a hiba sorával és oszlopával.
+     */
+    static Map parseMap(const std::string& text);
+
+    /**
+     * @brief Beolvassa és feldolgozza a pályafile-okat, majd a sorrendjükben a pályák közé teszi őket.
+     * 
+     * A file-ok beolvasása és feldolgozása néhány szálon párhuzamosan történik,
+     * a pályák sorrendje ettől függetlenül a file-ok sorrendje marad. A hibás
+     * file-ok kimaradnak.
+     * 
+     * @param files A pályafile-ok nevei a kívánt sorrendben.
+     */
+    void loadMapFiles(const std::vector<std::string>& files);
 
     #ifdef CPORTA
     /**
@@ -97,17 +227,82 @@ class MapManager
      * @param map A betöltendő pálya adatai.
      */
     void initializeMap(const Map& map);
+
+    /**
+     * @brief Létrehoz egy falat a pool-ban a pályaelem alapján.
+     * 
+     * @param element A fal adatai.
+     * @return A létrehozott fal.
+     */
+    Wall* createWall(const MapElement& element);
+
+    /**
+     * @brief Törli a falat a pool-ból, a gyermeklistáját megtartja a következő falaknak.
+     * 
+     * A törlések előtt a `childLists.reserve` hívással kell helyet foglalni a listáknak.
+     * 
+     * @param wall A pool-ban létrehozott fal.
+     */
+    void destroyWall(Wall* const wall);
+
+    /**
+     * @brief Beállítja a pálya méretét és háttérszínét a renderelő számára.
+     * 
+     * @param map A pálya adatai.
+     */
+    void applyMapSettings(const Map& map);
     #endif
 
+    /**
+     * @brief Párba állítja a régi és az új pálya azonos falait.
+     * 
+     * Két fal akkor azonos, ha minden tulajdonságuk megegyezik. Minden régi fal
+     * legfeljebb egy új falhoz tartozik.
+     * 
+     * @param oldWalls A régi pálya falai.
+     * @param newWalls Az új pálya falai.
+     * @return Minden új falhoz a neki megfelelő régi fal indexe, vagy `notMatched`.
+     */
+    static std::vector<size_t> matchWalls(const std::vector<MapElement>& oldWalls, const std::vector<MapElement>& newWalls);
+
+    /**
+     * @brief Felosztja a pálya falait chunkokra, a falak létrehozása nélkül.
+     * 
+     * @param map A pálya adatai, a `walls` listának elkészültnek kell lennie.
+     */
+    void buildChunks(const Map& map);
+
+    /**
+     * @brief Létrehozza a chunk falait.
+     */
+    void loadChunk(Chunk& chunk);
+
+    /**
+     * @brief Törli a chunk falait.
+     */
+    void unloadChunk(Chunk& chunk);
+
     /**
      * @brief Az aktuálisan betöltött pálya eltávolítása a játék világából.
      * 
      * A metódus törli az aktuálisan betöltött pálya összes elemét, felszabadítja
      * az ezekhez tartozó erőforrásokat, és kiüríti a pályaelemek listáját.
+     * A pálya collidereit egy lépésben veszi ki a globális listából, így a törlés
+     * ideje lineáris az elemek számában.
      */
     void discardMap();
 
     public:
+    /**
+     * @brief Egy pálya újratöltésekor a falakon végzett változtatások száma.
+     */
+    struct MapPatch
+    {
+        size_t kept; ///< A változatlanul megmaradt falak száma.
+        size_t added; ///< Az új vagy megváltozott, ezért újonnan létrehozott falak száma.
+        size_t removed; ///< A törölt vagy megváltozott, ezért eltávolított falak száma.
+    };
+
     /**
      * @brief Létrehoz egy `MapManager` objektumot.
      * 
@@ -177,18 +372,62 @@ class MapManager
      */
     double getMapHeight() const;
 
-    #ifndef CPORTA
+    /**
+     * @brief Lekérdezi egy játékos kezdőpozícióját a megadott pályán.
+     * 
+     * @param mapId A pálya azonosítója.
+     * @param playerId A játékos azonosítója (0 az első játékos, 1 a második játékos).
+     * @return A játékos kezdőpozíciója.
+     * @throws std::out_of_range Ha a `mapId` vagy a `playerId` érvénytelen.
+     */
+    Vector2 getPlayerPosition(const size_t mapId, const size_t playerId) const;
+
+    /**
+     * @brief Visszaadja a győzelemhez szükséges pontszámot a megadott pályán.
+     * 
+     * @param mapId A pálya azonosítója.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     */
+    int getScoreToWin(const size_t mapId) const;
+
+    /**
+     * @brief Visszaadja a megadott pálya magasságát.
+     * 
+     * @param mapId A pálya azonosítója.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     */
+    double getMapHeight(const size_t mapId) const;
+
+    /**
+     * @brief Létrehozza egy pálya falainak collidereit megjelenítés nélkül.
+     * 
+     * Megjelenítés nélküli mérkőzésekhez készült, a colliderek a hívó szálon
+     * aktuális világba kerülnek. A pálya adatait csak olvassa, így több szálról
+     * is hívható, amíg egyik szál sem tölt be vagy készít elő pályát. Az
+     * előkészített pályák összevont elemeit használja, a többi pálya elemeit
+     * maga vonja össze.
+     * 
+     * @param mapId A pálya azonosítója.
+     * @param colliders A lista, amelynek a végére a colliderek kerülnek.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     */
+    void createColliders(const size_t mapId, std::vector<Collider>& colliders) const;
+
     /**
      * @brief Betölt egy pályát a játék világába.
      * 
      * A metódus eltávolítja az aktuálisan betöltött pályát, majd betölti
      * a megadott azonosítójú pályát, és inicializálja annak elemeit.
      * 
+     * Ha a megadott pálya már be van töltve, az elemei megmaradnak, csak
+     * a pálya beállításai kerülnek újra alkalmazásra. A falak állapota nem
+     * változik játék közben, így a kör újraindítása a pálya méretétől
+     * függetlenül konstans idejű.
+     * 
      * @param mapId A betöltendő pálya azonosítója.
      * @throws std::out_of_range Ha a `mapId` érvénytelen.
      */
     void loadMap(const size_t mapId);
-    #endif
 
     /**
      * @brief Eltávolítja az aktuálisan betöltött pályát a játék világából.
@@ -198,6 +437,128 @@ class MapManager
      */
     void unloadMap();
 
+    /**
+     * @brief Beállítja a streamelt betöltés paramétereit.
+     * 
+     * A legalább `threshold` falból álló pályák streamelve töltődnek be: a falak
+     * `chunkSize` méretű chunkokra oszlanak, és csak a `streamChunks` által kért
+     * terület környékén lévő chunkok falai jönnek létre. A beállítás a következő
+     * pálya betöltésétől érvényes.
+     * 
+     * @param threshold A falak száma, amelytől a pálya streamelve töltődik be.
+     * @param chunkSize A chunkok cellájának oldalhossza.
+     * @param margin A fókusz körüli sáv szélessége, amelyben a chunkok betöltődnek.
+     */
+    void setStreaming(const size_t threshold, const double chunkSize, const double margin);
+
+    /**
+     * @brief Streamelt pálya esetén a fókusz köré tölti a chunkokat.
+     * 
+     * Betölti a fókusztól `margin` távolságon belüli chunkokat, a legközelebbiekkel
+     * kezdve, és törli azokat, amelyek a fókusztól `2 * margin` távolságnál
+     * messzebb kerültek. A két határ közti különbség miatt a határon mozgó fókusz
+     * nem tölti be és törli újra meg újra ugyanazt a chunkot. Egy hívás legfeljebb
+     * `maxChanges` chunkot tölt be vagy töröl, így a munka képkockákra osztható.
+     * Nem streamelt pálya esetén nem csinál semmit.
+     * 
+     * @param focusMin A fókusz terület bal alsó sarka (például a kamera és a játékosok köré).
+     * @param focusMax A fókusz terület jobb felső sarka.
+     * @param maxChanges A hívásonként betölthető vagy törölhető chunkok száma.
+     */
+    void streamChunks(const Vector2& focusMin, const Vector2& focusMax, const size_t maxChanges);
+
+    /**
+     * @brief Megadja, hogy a betöltött pálya streamelve van-e.
+     */
+    bool isStreaming() const;
+
+    /**
+     * @brief Visszaadja a betöltött pálya chunkjainak számát, vagy 0-t ha nincs streamelve.
+     */
+    size_t getChunkCount() const;
+
+    /**
+     * @brief Visszaadja a betöltött chunkok számát.
+     */
+    size_t getLoadedChunkCount() const;
+
+    /**
+     * @brief Elkezdi a pályafile-ok változásainak figyelését.
+     * 
+     * A figyelés csak Linuxon támogatott. A változásokat a `pollHotReload`
+     * dolgozza fel.
+     * 
+     * @return true, ha a figyelés elindult, különben false.
+     */
+    bool enableHotReload();
+
+    /**
+     * @brief Újratölti a legutóbbi hívás óta megváltozott pályafile-okat.
+     * 
+     * Csak a megváltozott file-ok kerülnek újra feldolgozásra. A hibás file
+     * helyett a pálya előző változata marad meg. Új pályafile-ok csak a játék
+     * újraindításakor kerülnek a pályák közé. Ha a figyelés nem fut, a metódus
+     * nem csinál semmit.
+     */
+    void pollHotReload();
+
+    /**
+     * @brief Lecseréli a pálya adatait a megadott szövegből feldolgozottra.
+     * 
+     * Ha a pálya éppen be van töltve, csak a megváltozott falak cserélődnek:
+     * a változatlan falak (és ezzel a collidereik) megmaradnak, a törölt és a
+     * megváltozott falak eltávolításra, az új és a megváltozott falak létrehozásra
+     * kerülnek. A pálya mérete és háttérszíne azonnal, a játékosok kezdőpozíciója
+     * és a győzelemhez szükséges pontszám a következő körtől érvényes. Streamelt
+     * pálya esetén a chunkok újraépülnek, és a következő `streamChunks` hívások
+     * töltik be őket.
+     * 
+     * @param mapId A pálya azonosítója.
+     * @param text A pályafile új tartalma.
+     * @return A falakon végzett változtatások száma.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     * @throws ParseError Ha a szöveg hibás, ilyenkor a pálya nem változik.
+     */
+    MapPatch reloadMap(const size_t mapId, const std::string& text);
+
+    /**
+     * @brief Háttérszálon elkezdi egy pálya előkészítését.
+     * 
+     * Az előkészítés (a pályaelemek összevonása) a pálya betöltéséig a játék
+     * főciklusától függetlenül fut, így a betöltéskor már csak a falak
+     * létrehozása marad a fő szálon. Ha a pálya már elő van készítve, vagy
+     * éppen készül, a metódus nem csinál semmit. Egyszerre egy pálya készülhet:
+     * egy másik pálya még folyamatban lévő előkészítését a metódus megvárja,
+     * és az eredményét eldobja.
+     * 
+     * @param mapId Az előkészítendő pálya azonosítója.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     */
+    void prepareMapAsync(const size_t mapId);
+
+    /**
+     * @brief Előkészíti a pályát a betöltéshez.
+     * 
+     * Ha a pálya háttérszálon készül, megvárja és átveszi az eredményt,
+     * különben a fő szálon készíti el. Az eredmény a pályával együtt
+     * tárolódik, a későbbi betöltésekhez már nem kell újra elkészíteni.
+     * 
+     * @param mapId Az előkészítendő pálya azonosítója.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     */
+    void prepareMap(const size_t mapId);
+
+    /**
+     * @brief Megadja, hogy a pálya elő van-e készítve a betöltéshez.
+     * 
+     * A háttérszálon készülő pálya csak a `prepareMap` vagy a `loadMap`
+     * hívása után számít előkészítettnek.
+     * 
+     * @param mapId A pálya azonosítója.
+     * @throws std::out_of_range Ha a `mapId` érvénytelen.
+     */
+    bool isMapPrepared(const size_t mapId) const;
+
     #ifdef CPORTA
     /**
      * @brief Visszaadja a megadott pálya adatait szöveges formátumban.
@@ -216,5 +577,44 @@ class MapManager
      * collider arányát.
      */
     std::string getSerializedMapElement(const size_t mapId, const size_t elementId);
+
+    /**
+     * @brief Visszaadja a megadott pálya összevont elemeinek számát.
+     * 
+     * A metódus tesztelési célzattal készült.
+     */
+    size_t getMergedElementCount(const size_t mapId) const;
+
+    /**
+     * @brief Visszaadja a megadott összevont pályaelem adatait szöveges formátumban.
+     * 
+     * A metódus tesztelési célzattal készült, a formátum megegyezik a 
+     * `getSerializedMapElement` formátumával.
+     */
+    std::string getSerializedMergedElement(const size_t mapId, const size_t elementId) const;
+
+    /**
+     * @brief Feldolgoz egy pályafile tartalmát, és visszaadja a hibaüzenetet.
+     * 
+     * A metódus tesztelési célzattal készült; sikeres feldolgozás esetén
+     * üres szöveget ad vissza, különben a `sor:oszlop: leírás` formájú hibát.
+     */
+    static std::string getParseError(const std::string& text);
+
+    /**
+     * @brief Visszaadja a betöltött pálya létrehozott falainak számát, a chunkok falai nélkül.
+     * 
+     * A metódus tesztelési célzattal készült.
+     */
+    size_t getLoadedWallCount() const;
+
+    /**
+     * @brief Visszaadja a betöltött pálya egy létrehozott falát.
+     * 
+     * A metódus tesztelési célzattal készült.
+     * 
+     * @throws std::out_of_range Ha a `wallId` érvénytelen.
+     */
+    Wall* getLoadedWall(const size_t wallId) const;
     #endif
 };
\ No newline at end of file
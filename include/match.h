@@ -0,0 +1,146 @@
+#pragma once
+#include "memtrace.h"
+
+#include "fighter.h"
+#include "mapmanager.h"
+#include "world.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Két játékos megjelenítés nélküli mérkőzése egy pályán, lépésenként vezérelve.
+ *
+ * A `Match` saját `World`-ben futtatja a pálya falait és a két karaktert.
+ * Egy lépés a játék ciklusához hasonlóan egy fizikai frissítés, egy
+ * frissítés és egy frissítés utáni lépés, a két játékos irányítását a hívó
+ * adja meg. Halál után a megadott idő elteltével a kör újraindul, a
+ * pontszámok a mérkőzés állapotának részei.
+ *
+ * Az állapot számozott helyekre menthető és onnan visszatölthető, ez a
+ * rollback alapú hálózati játék alapja: ugyanabból az állapotból ugyanazzal
+ * az irányítással ugyanaz az állapot következik.
+ */
+class Match
+{
+    public:
+    /**
+     * @brief A mérkőzés teljes, visszaállítható állapota.
+     */
+    struct State
+    {
+        std::array<Fighter::State, 2> fighters; ///< A két karakter állapota.
+        std::array<int, 2> scores = {0, 0}; ///< A két játékos pontszáma.
+        size_t resetTicks = 0; ///< A kör újraindításáig hátralévő lépések, 0 ha a kör tart.
+        size_t tick = 0; ///< A lefutott lépések száma.
+    };
+
+    private:
+    World world; ///< A mérkőzés világa.
+    std::vector<Collider> walls; ///< A pálya falai.
+    std::array<DirectController, 2> controllers; ///< A karakterek irányítói.
+    std::array<std::unique_ptr<Fighter>, 2> fighters; ///< A két karakter, a mérkőzés világában létrehozva.
+    std::array<Vector2, 2> spawns; ///< A karakterek kezdőpozíciója.
+
+    std::array<int, 2> scores; ///< A két játékos pontszáma.
+    size_t resetTicks; ///< A kör újraindításáig hátralévő lépések, 0 ha a kör tart.
+    size_t resetDelay; ///< A halál és az újraindítás között eltelő lépések száma.
+    size_t tick; ///< A lefutott lépések száma.
+
+    std::vector<State> savedStates; ///< A mentett állapotok helyenként.
+
+    Match(const Match& match);
+
+    Match& operator=(const Match& match);
+
+    /**
+     * @brief Kiosztja a pontot, ha valamelyik karakter meghalt, és kezeli az újraindítást.
+     */
+    void updateRound();
+
+    public:
+    /**
+     * @brief Létrehoz egy mérkőzést a megadott pályán.
+     *
+     * A pályának előkészítettnek kell lennie, a pályakezelőt csak olvassa.
+     *
+     * @param maps A pályák.
+     * @param mapId A pálya azonosítója.
+     * @param aspectRatio A pálya szélességének és magasságának aránya.
+     * @param physicsRate A lépések rátája másodpercenként.
+     * @param resetTime A halál és a kör újraindítása között eltelő idő másodpercben.
+     * @throws std::out_of_range Ha a pálya azonosítója érvénytelen.
+     */
+    Match(const MapManager& maps, const size_t mapId, const double aspectRatio = 16.0 / 9.0, const double physicsRate = 100, const double resetTime = 0.5);
+
+    /**
+     * @brief Lefuttat egy lépést a megadott irányításokkal.
+     *
+     * @param input1 Az első játékos irányítása.
+     * @param input2 A második játékos irányítása.
+     */
+    void step(const PlayerInput& input1, const PlayerInput& input2);
+
+    /**
+     * @brief Elmenti az aktuális állapotot a megadott helyre.
+     *
+     * A helyek tárhelye újrahasznosul, bemelegedés után a mentés nem foglal memóriát.
+     *
+     * @param slot A mentés helye.
+     */
+    void saveState(const size_t slot);
+
+    /**
+     * @brief Visszatölti a megadott helyre mentett állapotot.
+     *
+     * @param slot A mentés helye.
+     * @throws std::out_of_range Ha a helyre még nem történt mentés.
+     */
+    void loadState(const size_t slot);
+
+    /**
+     * @brief Visszaadja az aktuális állapot egy másolatát.
+     */
+    State getState() const;
+
+    /**
+     * @brief Kiszámolja az aktuális állapot hashét.
+     *
+     * A világ állapothashét a pontszámokkal és a kör állapotával egészíti ki.
+     */
+    uint64_t getStateHash() const;
+
+    /**
+     * @brief Visszaadja a megadott játékos karakterét.
+     *
+     * @param side A játékos sorszáma (0 vagy 1).
+     * @throws std::out_of_range Ha a sorszám érvénytelen.
+     */
+    const Fighter& getFighter(const size_t side) const;
+
+    /**
+     * @brief Visszaadja a megadott játékos pontszámát.
+     *
+     * @param side A játékos sorszáma (0 vagy 1).
+     * @throws std::out_of_range Ha a sorszám érvénytelen.
+     */
+    int getScore(const size_t side) const;
+
+    /**
+     * @brief Visszaadja a lefutott lépések számát.
+     */
+    size_t getTick() const;
+};
+
+/**
+ * @brief Összehasonlít két mérkőzésállapotot, a lebegőpontos értékeket pontos egyezéssel.
+ */
+bool operator==(const Match::State& state1, const Match::State& state2);
+
+/**
+ * @brief Összehasonlít két mérkőzésállapotot.
+ */
+bool operator!=(const Match::State& state1, const Match::State& state2);
@@ -26,6 +26,10 @@ inclue-ok:  2017., 2018., 2019., 2021., 2022.
 /*ha definialva van, akkor a megallaskor automatikus riport keszul */
 #define MEMTRACE_AUTO
 
+/*ha definialva van, akkor a foglalasokat hivasi helyenkent osszesiti, a riport a megallaskor*/
+/*es a mem_profile() hivasakor keszul. MEMTRACE_TO_MEMORY kell hozza*/
+/*#define MEMTRACE_PROFILE*/
+
 /*ha definialva van, akkor malloc()/calloc()/realloc()/free() kovetve lesz*/
 #define MEMTRACE_C
 
@@ -97,6 +101,8 @@ inclue-ok:  2017., 2018., 2019., 2021., 2022.
 
 START_NAMESPACE
 	int allocated_blocks();
+	size_t allocation_count();
+	size_t allocated_bytes();
 END_NAMESPACE
 
 #if defined(MEMTRACE_TO_MEMORY)
@@ -106,6 +112,14 @@ START_NAMESPACE
 END_NAMESPACE
 #endif
 
+#if defined(MEMTRACE_PROFILE)
+#include <cstdio>
+START_NAMESPACE
+    /*a legtobb bajtot foglalo top hivasi hely statisztikaja*/
+    void mem_profile(size_t top = 20, FILE* fp = stderr);
+END_NAMESPACE
+#endif
+
 #if defined(MEMTRACE_TO_MEMORY) && defined(USE_ATEXIT_OBJECT)
 #include <cstdio>
 START_NAMESPACE
@@ -165,6 +179,13 @@ END_NAMESPACE
     #if __cplusplus >= 201103L
         #include <iterator>
         #include <regex>
+        #include <utility>
+        #include <future>
+        #include <atomic>
+        #include <thread>
+    #endif
+    #if __cplusplus >= 201703L
+        #include <charconv>
     #endif
 #endif
 #ifdef MEMTRACE_CPP
@@ -0,0 +1,103 @@
+#pragma once
+#include "memtrace.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Több termelő és egy fogyasztó szál közötti, zármentes, rögzített méretű sor.
+ *
+ * A sor egy gyűrűpuffer, amelynek minden helye egy sorszámot tárol. A
+ * termelők a sor végét (`tail`) összehasonlítás és csere művelettel
+ * foglalják le, majd az elem beírása után a hely sorszámával jelzik a
+ * fogyasztónak, hogy az elem kész. Így a termelők nem várnak egymásra, és a
+ * műveletek nem foglalnak memóriát.
+ *
+ * A `push` bármelyik szálról, a `pop` csak a fogyasztó szálról hívható.
+ *
+ * @tparam T Az elemek típusa, másolható és alapértelmezetten létrehozható.
+ */
+template <typename T>
+class MpscQueue
+{
+    private:
+    static constexpr size_t cacheLineSize = 64; ///< A gyorsítótár-sor feltételezett mérete.
+
+    /**
+     * @brief A gyűrűpuffer egy helye.
+     */
+    struct Cell
+    {
+        std::atomic<size_t> sequence; ///< Az elem sorszáma, ha kész, a sorszám eggyel nagyobb.
+        T value; ///< Az elem.
+
+        Cell() : sequence(0), value() {}
+    };
+
+    std::vector<Cell> cells; ///< A gyűrűpuffer, a mérete kettő hatványa.
+    size_t mask; ///< A puffer méreténél eggyel kisebb szám az indexek maradékához.
+
+    alignas(cacheLineSize) std::atomic<size_t> head; ///< A következő kiolvasandó elem sorszáma, a fogyasztó írja.
+    alignas(cacheLineSize) std::atomic<size_t> tail; ///< A következő lefoglalandó hely sorszáma, a termelők írják.
+
+    /**
+     * @brief Visszaadja a kapacitás feletti legkisebb kettő hatványt.
+     *
+     * @throws std::invalid_argument Ha a kapacitás 0.
+     */
+    static size_t roundCapacity(const size_t capacity);
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    MpscQueue(const MpscQueue& queue);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    MpscQueue& operator=(const MpscQueue& queue);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres sort.
+     *
+     * @param capacity A sorban egyszerre tárolható elemek legkisebb száma,
+     * a következő kettő hatványára kerekítve.
+     * @throws std::invalid_argument Ha a kapacitás 0.
+     */
+    explicit MpscQueue(const size_t capacity);
+
+    /**
+     * @brief A sor végére tesz egy elemet. Bármelyik szálról hívható.
+     *
+     * @param value Az elem.
+     * @return false, ha a sor tele van, és az elem nem került bele.
+     */
+    bool push(const T& value);
+
+    /**
+     * @brief Kiveszi a sor első elemét. Csak a fogyasztó szálról hívható.
+     *
+     * Ha az első helyet lefoglaló termelő még nem írta be az elemet, a sor
+     * üresnek látszik, a később kész elemek is csak utána vehetők ki.
+     *
+     * @param value Az első elem, csak siker esetén módosul.
+     * @return false, ha a sor üres.
+     */
+    bool pop(T& value);
+
+    /**
+     * @brief Visszaadja a sorban lévő elemek számát.
+     *
+     * Másik szál egyidejű műveletei mellett csak közelítő érték.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Visszaadja a sorban egyszerre tárolható elemek számát.
+     */
+    size_t capacity() const;
+};
+
+#include "mpscqueue.inl"
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdexcept>
+
+template <typename T>
+size_t MpscQueue<T>::roundCapacity(const size_t capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("queue capacity must be positive");
+
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    return size;
+}
+
+template <typename T>
+MpscQueue<T>::MpscQueue(const size_t capacity)
+: cells(roundCapacity(capacity)), mask(cells.size() - 1), head(0), tail(0)
+{
+    for (size_t i = 0; i < cells.size(); i++)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool MpscQueue<T>::push(const T& value)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+        cell = &cells[position & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (sequence == position)
+        {
+            //the slot is free, the producer that moves the tail owns it
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (sequence < position)
+        {
+            //the consumer has not freed the slot of the previous round yet
+            return false;
+        }
+        else
+        {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value = value;
+
+    //the element is written before the consumer can see the new sequence
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool MpscQueue<T>::pop(T& value)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    Cell& cell = cells[position & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+        return false;
+
+    value = cell.value;
+
+    //the slot is read before a producer of the next round can claim it
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+size_t MpscQueue<T>::size() const
+{
+    //the head never passes the tail, so it is read first
+    size_t first = head.load(std::memory_order_acquire);
+    size_t last = tail.load(std::memory_order_acquire);
+    return last > first ? last - first : 0;
+}
+
+template <typename T>
+size_t MpscQueue<T>::capacity() const
+{
+    return cells.size();
+}
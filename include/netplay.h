@@ -0,0 +1,90 @@
+#pragma once
+#include "memtrace.h"
+
+#include "mapmanager.h"
+#include "nettransport.h"
+#include "rollback.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Hálózati mérkőzéseket futtató osztály, megjelenítés nélkül, botokkal.
+ *
+ * A `runLoopback` egy gépen, egy szálon játszat le egy rollback alapú
+ * hálózati mérkőzést két fél között egy `LoopbackLink` felett, tetszőleges
+ * késleltetéssel, szórással és csomagvesztéssel. A két félnél futó
+ * mérkőzés végén a két állapotnak egyeznie kell, így a rollback helyessége
+ * gépről gépre nem függő módon ellenőrizhető.
+ *
+ * `NETPLAY` fordítás esetén a parancssori belépési pont valódi UDP
+ * kapcsolatot is tud, ekkor a két fél két külön folyamat.
+ *
+ * A hálózati játék csak grafika nélkül, a `Match` és a botok felett
+ * érhető el: a `GameManager` helyi módja nem használja, így a grafikus
+ * játékban a két játékos továbbra is a közös `InputHandler`-ből olvas.
+ */
+class Netplay
+{
+    public:
+    /**
+     * @brief A loopback mérkőzés paraméterei.
+     */
+    struct Settings
+    {
+        size_t ticks = 3000; ///< A lejátszandó lépések száma.
+        size_t mapId = 0; ///< A pálya azonosítója.
+        double physicsRate = 100; ///< A lépések rátája másodpercenként.
+        std::string bots[2] = {"chase", "random"}; ///< A két fél botjának neve.
+        uint64_t seed = 1; ///< A botok véletlenszám-generátorainak kezdőértéke.
+        LoopbackLink::Settings link; ///< A kapcsolat paraméterei.
+        RollbackSession::Settings session; ///< A munkamenetek paraméterei.
+        StateHashLog* hashLog = nullptr; ///< Az első fél véglegessé vált lépéseinek hashnaplója, vagy nullptr.
+    };
+
+    /**
+     * @brief A loopback mérkőzés eredménye.
+     */
+    struct Result
+    {
+        bool inSync = false; ///< Jelzi, hogy a két fél állapota a mérkőzés végén és a lépések hashe alapján közben is egyezik-e.
+        size_t harnessTicks = 0; ///< A kapcsolat lépéseinek száma a végéig, a várakozással együtt.
+        size_t packetsSent = 0; ///< Az elküldött csomagok száma.
+        size_t packetsLost = 0; ///< Az elveszett csomagok száma.
+        int scores[2] = {0, 0}; ///< A játékosok pontszáma az első fél szerint.
+        RollbackSession::Stats stats[2]; ///< A két fél munkamenetének statisztikái.
+    };
+
+    /**
+     * @brief Lejátszik egy hálózati mérkőzést két fél között egy gépen.
+     *
+     * Mindkét fél a saját botjával irányít, és a saját, becsült állapotából
+     * dönt. A két fél a megadott számú lépés után megáll, és megvárja, amíg
+     * minden irányítás megérkezik.
+     *
+     * @param maps A pályák, a mérkőzés pályáját a függvény előkészíti.
+     * @param settings A mérkőzés paraméterei.
+     * @return A mérkőzés eredménye.
+     * @throws std::invalid_argument Ha a paraméterek érvénytelenek.
+     * @throws std::out_of_range Ha a pálya azonosítója érvénytelen.
+     */
+    static Result runLoopback(MapManager& maps, const Settings& settings);
+
+    /**
+     * @brief A parancssori hálózati mérkőzés belépési pontja.
+     *
+     * A paraméterek `kulcs=érték` alakúak: `ticks`, `map`, `rate`, `seed`,
+     * `bots` (két vesszővel elválasztott név), `latency`, `jitter` (lépésekben),
+     * `loss` (0 és 1 között), `rollback`, `delay`, `hashlog` (a véglegessé vált
+     * lépések hashének naplófájlja). `NETPLAY` fordítás esetén a
+     * `port` megadásával UDP felett játszik: ekkor `side` a helyi játékos
+     * sorszáma, `peer` a másik fél `cím:port` alakú címe (a kiszolgáló
+     * félnél elhagyható), `bots` pedig egyetlen, a helyi botot adó név.
+     *
+     * @param argc A paraméterek száma.
+     * @param argv A paraméterek.
+     * @return 0 siker esetén, különben 1.
+     */
+    static int runCommandLine(const int argc, const char* const argv[]);
+};
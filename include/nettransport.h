@@ -0,0 +1,167 @@
+#pragma once
+#include "memtrace.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Datagramokat küldő és fogadó hálózati kapcsolat közös felülete.
+ *
+ * A csomagok elveszhetnek és más sorrendben érkezhetnek, mint ahogy
+ * elküldték őket, ahogy UDP felett is. A fogadás nem blokkol.
+ */
+class NetTransport
+{
+    public:
+    /**
+     * @brief Virtuális destruktor.
+     */
+    virtual ~NetTransport();
+
+    /**
+     * @brief Elküld egy csomagot a másik félnek.
+     *
+     * @param packet A csomag tartalma.
+     */
+    virtual void send(const std::vector<uint8_t>& packet) = 0;
+
+    /**
+     * @brief Átveszi a következő megérkezett csomagot, ha van.
+     *
+     * @param packet Ide kerül a csomag tartalma, a kapacitása újrahasznosul.
+     * @return true, ha volt megérkezett csomag, különben false.
+     */
+    virtual bool receive(std::vector<uint8_t>& packet) = 0;
+};
+
+/**
+ * @brief Két végpont közötti, memóriában futó kapcsolat késleltetéssel, szórással és csomagvesztéssel.
+ *
+ * A hálózati játék egy gépen, determinisztikusan tesztelhető vele. Az idő
+ * lépésekben telik, a `tick` hívásával. Minden csomag a küldéskor
+ * sorsolt késleltetés (`latency` plusz legfeljebb `jitter` lépés) után
+ * érkezik meg, vagy `loss` valószínűséggel elveszik. A szórás miatt a
+ * csomagok sorrendje felcserélődhet.
+ */
+class LoopbackLink
+{
+    public:
+    /**
+     * @brief A kapcsolat paraméterei.
+     */
+    struct Settings
+    {
+        size_t latency = 0; ///< Az egyirányú késleltetés lépésekben.
+        size_t jitter = 0; ///< A késleltetéshez adódó véletlen többlet legnagyobb értéke lépésekben.
+        double loss = 0; ///< A csomagvesztés valószínűsége (0 és 1 között).
+        uint64_t seed = 1; ///< A véletlenszám-generátor kezdőértéke.
+    };
+
+    private:
+    /**
+     * @brief A kapcsolat egyik végpontja.
+     */
+    class Endpoint : public NetTransport
+    {
+        private:
+        LoopbackLink& link; ///< A kapcsolat.
+        size_t side; ///< A végpont sorszáma.
+
+        public:
+        Endpoint(LoopbackLink& link, const size_t side);
+
+        void send(const std::vector<uint8_t>& packet) override;
+
+        bool receive(std::vector<uint8_t>& packet) override;
+    };
+
+    Settings settings; ///< A kapcsolat paraméterei.
+    std::mt19937_64 random; ///< A késleltetést és a vesztést sorsoló generátor.
+    size_t now; ///< Az eltelt lépések száma.
+    Endpoint endpoints[2]; ///< A két végpont.
+    std::multimap<size_t, std::vector<uint8_t>> inFlight[2]; ///< A végpontok felé úton lévő csomagok az érkezés ideje szerint.
+    size_t sentCount; ///< Az elküldött csomagok száma.
+    size_t lostCount; ///< Az elveszett csomagok száma.
+
+    LoopbackLink(const LoopbackLink& link);
+
+    LoopbackLink& operator=(const LoopbackLink& link);
+
+    public:
+    /**
+     * @brief Létrehoz egy kapcsolatot.
+     *
+     * @param settings A kapcsolat paraméterei.
+     * @throws std::invalid_argument Ha a vesztés valószínűsége nem 0 és 1 közé esik.
+     */
+    explicit LoopbackLink(const Settings& settings);
+
+    /**
+     * @brief Visszaadja a kapcsolat egyik végpontját.
+     *
+     * @param side A végpont sorszáma (0 vagy 1).
+     * @throws std::out_of_range Ha a sorszám érvénytelen.
+     */
+    NetTransport& getEndpoint(const size_t side);
+
+    /**
+     * @brief Eltelik egy lépés, a megérkező csomagok átvehetővé válnak.
+     */
+    void tick();
+
+    /**
+     * @brief Visszaadja az elküldött csomagok számát.
+     */
+    size_t getSentCount() const;
+
+    /**
+     * @brief Visszaadja az elveszett csomagok számát.
+     */
+    size_t getLostCount() const;
+};
+
+#ifdef NETPLAY
+/**
+ * @brief UDP feletti kapcsolat egy másik géppel (csak POSIX rendszereken).
+ *
+ * A helyi porton fogad és a megadott címre küld. Ha a cím üres, a
+ * kapcsolat az első beérkező csomag feladójának válaszol, így a
+ * kiszolgáló félnek nem kell ismernie a csatlakozó címét.
+ */
+class UdpTransport : public NetTransport
+{
+    private:
+    int socketHandle; ///< A nem blokkoló UDP socket.
+    std::vector<uint8_t> peerAddress; ///< A másik fél címe (`sockaddr_in`), vagy üres, ha még nem ismert.
+
+    UdpTransport(const UdpTransport& transport);
+
+    UdpTransport& operator=(const UdpTransport& transport);
+
+    public:
+    /**
+     * @brief Megnyitja a kapcsolatot.
+     *
+     * @param localPort A helyi port, amelyen a csomagok érkeznek.
+     * @param peerHost A másik fél IPv4 címe, vagy üres, ha a másik fél csatlakozik.
+     * @param peerPort A másik fél portja.
+     * @throws std::invalid_argument Ha a cím érvénytelen.
+     * @throws std::runtime_error Ha a socket nem nyitható meg.
+     */
+    UdpTransport(const uint16_t localPort, const std::string& peerHost = "", const uint16_t peerPort = 0);
+
+    /**
+     * @brief Lezárja a socketet.
+     */
+    ~UdpTransport();
+
+    void send(const std::vector<uint8_t>& packet) override;
+
+    bool receive(std::vector<uint8_t>& packet) override;
+};
+#endif
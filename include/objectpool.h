@@ -0,0 +1,116 @@
+#pragma once
+#include "memtrace.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Azonos típusú objektumok tárolására szolgáló, bővíthető slab allokátor.
+ * 
+ * Az `ObjectPool` a memóriát `slabSize` objektumnyi blokkokban (slabekben) foglalja,
+ * és ezekben hozza létre az objektumokat. A felszabadított helyek egy láncolt
+ * listába kerülnek, amelyet a következő létrehozások újra felhasználnak, így
+ * bemelegedés után (amikor a kapacitás elérte a csúcsigényt) a létrehozás és
+ * a törlés nem foglal memóriát.
+ * 
+ * Az objektumok címe a törlésükig nem változik, ezért a `this` pointert
+ * regisztráló objektumok (például `Collider`, `Updatable`) is tárolhatók benne.
+ * 
+ * A pool nem tartja nyilván az élő objektumokat: a tulajdonos felelőssége, hogy
+ * a pool megszűnése előtt mindet törölje a `destroy` metódussal.
+ * 
+ * @tparam T A tárolt objektumok típusa.
+ */
+template <typename T>
+class ObjectPool
+{
+    private:
+    /**
+     * @brief Egy objektumnyi hely, amely szabad állapotban a következő szabad helyre mutat.
+     */
+    union Slot
+    {
+        Slot* next; ///< A következő szabad hely.
+        alignas(T) unsigned char storage[sizeof(T)]; ///< Az objektum tárhelye.
+    };
+
+    size_t slabSize; ///< Egy slabben tárolható objektumok száma.
+    std::vector<Slot*> slabs; ///< A lefoglalt slabek.
+    Slot* freeList; ///< Az első szabad hely.
+
+    size_t occupancy; ///< Az élő objektumok száma.
+    size_t highWaterMark; ///< Az élő objektumok legnagyobb száma a pool élete során.
+
+    /**
+     * @brief Lefoglal egy új slabet, és a helyeit a szabad listára fűzi.
+     */
+    void grow();
+
+    /**
+     * @brief Másoló konstruktor tiltása, az objektumok címe nem változhat.
+     */
+    ObjectPool(const ObjectPool& pool);
+
+    /**
+     * @brief Értékadás tiltása, az objektumok címe nem változhat.
+     */
+    ObjectPool& operator=(const ObjectPool& pool);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres poolt.
+     * 
+     * @param slabSize Egy slabben tárolható objektumok száma.
+     */
+    explicit ObjectPool(const size_t slabSize = 64);
+
+    /**
+     * @brief Felszabadítja a slabeket.
+     */
+    ~ObjectPool();
+
+    /**
+     * @brief Addig bővíti a poolt, amíg legalább `capacity` objektum elfér benne.
+     * 
+     * @param capacity Az objektumok várható száma.
+     */
+    void reserve(const size_t capacity);
+
+    /**
+     * @brief Létrehoz egy objektumot egy szabad helyen, szükség esetén új slabet foglal.
+     * 
+     * @param args A konstruktor paraméterei.
+     * @return A létrehozott objektum.
+     */
+    template <typename... Args>
+    T* create(Args&&... args);
+
+    /**
+     * @brief Törli az objektumot, és a helyét visszaadja a poolnak.
+     * 
+     * @param object A poolban létrehozott objektum.
+     */
+    void destroy(T* const object);
+
+    /**
+     * @brief Visszaadja az élő objektumok számát.
+     */
+    size_t getOccupancy() const;
+
+    /**
+     * @brief Visszaadja az élő objektumok legnagyobb számát a pool élete során.
+     */
+    size_t getHighWaterMark() const;
+
+    /**
+     * @brief Visszaadja, hány objektum fér el a lefoglalt slabekben.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Visszaadja a lefoglalt slabek számát.
+     */
+    size_t getSlabCount() const;
+};
+
+#include "objectpool.inl"
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+template <typename T>
+ObjectPool<T>::ObjectPool(const size_t slabSize)
+: slabSize(slabSize > 0 ? slabSize : 1), freeList(nullptr), occupancy(0), highWaterMark(0)
+{
+
+}
+
+template <typename T>
+ObjectPool<T>::~ObjectPool()
+{
+    for (Slot* slab : slabs)
+    {
+        delete[] slab;
+    }
+}
+
+template <typename T>
+void ObjectPool<T>::grow()
+{
+    //make room first, so a failed push can not leak the slab
+    slabs.reserve(slabs.size() + 1);
+    Slot* slab = new Slot[slabSize];
+    slabs.push_back(slab);
+
+    //push in reverse, so the slots are handed out in address order
+    for (size_t i = slabSize; i > 0; i--)
+    {
+        slab[i - 1].next = freeList;
+        freeList = &slab[i - 1];
+    }
+}
+
+template <typename T>
+void ObjectPool<T>::reserve(const size_t capacity)
+{
+    while (getCapacity() < capacity)
+    {
+        grow();
+    }
+}
+
+template <typename T>
+template <typename... Args>
+T* ObjectPool<T>::create(Args&&... args)
+{
+    if (freeList == nullptr)
+        grow();
+
+    Slot* slot = freeList;
+    freeList = slot->next;
+
+    T* object = reinterpret_cast<T*>(slot->storage);
+    try
+    {
+        //allocator_traits keeps placement new away from the memtrace new macro
+        std::allocator<T> allocator;
+        std::allocator_traits<std::allocator<T>>::construct(allocator, object, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->next = freeList;
+        freeList = slot;
+        throw;
+    }
+
+    occupancy++;
+    if (occupancy > highWaterMark)
+        highWaterMark = occupancy;
+
+    return object;
+}
+
+template <typename T>
+void ObjectPool<T>::destroy(T* const object)
+{
+    std::allocator<T> allocator;
+    std::allocator_traits<std::allocator<T>>::destroy(allocator, object);
+
+    Slot* slot = reinterpret_cast<Slot*>(object);
+    slot->next = freeList;
+    freeList = slot;
+    occupancy--;
+}
+
+template <typename T>
+size_t ObjectPool<T>::getOccupancy() const { return occupancy; }
+
+template <typename T>
+size_t ObjectPool<T>::getHighWaterMark() const { return highWaterMark; }
+
+template <typename T>
+size_t ObjectPool<T>::getCapacity() const { return slabs.size() * slabSize; }
+
+template <typename T>
+size_t ObjectPool<T>::getSlabCount() const { return slabs.size(); }
@@ -3,8 +3,6 @@
 #include "core.h"
 #include "collider.h"
 
-#include <unordered_set>
-
 /**
  * @brief Egy fizikai objektumot reprezentáló osztály.
  * 
@@ -16,6 +14,21 @@
  */
 class PhysicsObject : public Transform, PhysicsUpdatable
 {
+    public:
+    /**
+     * @brief Az objektum szimulációs állapota, amelyből a szimuláció visszaállítható.
+     */
+    struct State
+    {
+        Vector2 position; ///< A lokális pozíció.
+        Vector2 velocity; ///< A sebesség.
+        Vector2 acceleration; ///< A gyorsulás.
+        Vector2 gravity; ///< A gravitáció.
+        std::pair<double, double> maxXVelocity; ///< A maximális sebesség az X tengelyen.
+        std::pair<double, double> maxYVelocity; ///< A maximális sebesség az Y tengelyen.
+        unsigned int touchedTags = 0; ///< Az érintett collider címkék bitmaszkja.
+    };
+
     private:
     static const double maxIntersectionResolveDistance; ///< A maximális távolság, amelyen belül a metszéseket feloldhatja.
     static const size_t intersectionResolvePasses; ///< A metszések feloldásához végrehajtott iterációk száma.
@@ -31,13 +44,13 @@ class PhysicsObject : public Transform, PhysicsUpdatable
 
     std::vector<Collider*> colliders; ///< Az objektumhoz tartozó colliderek listája.
 
-    std::unordered_set<ColliderTag> touchedTags; ///< Az objektum által érintett collider címkék halmaza.
+    unsigned int touchedTags; ///< Az objektum által érintett collider címkék bitmaszkja.
 
     /**
      * @brief Hozzáadja a collider címkéit az érintett címkék közé.
      * 
      * A metódus a megadott collider címkéit (`ColliderTag`) hozzáadja az objektum
-     * által érintett címkék halmazához (`touchedTags`).
+     * által érintett címkék maszkjához (`touchedTags`).
      * 
      * @param collider A collider, amelynek címkéit hozzá kell adni.
      */
@@ -80,7 +93,7 @@ class PhysicsObject : public Transform, PhysicsUpdatable
      * @param intersects Egy referencia a colliderek vektorára, amely tartalmazza azokat a collidereket,
      *                   amelyekkel az objektum ütközött.
      */
-    void tryCheck(const Vector2& offset, bool& didIntersect, double& maxBounciness, std::vector<Collider*>& intersects);
+    void tryCheck(const Vector2& offset, bool& didIntersect, double& maxBounciness, ArenaVector<Collider*>& intersects);
 
     public:
     /**
@@ -188,7 +201,28 @@ class PhysicsObject : public Transform, PhysicsUpdatable
      * @brief Törli az összes érintett collider címkét.
      * 
      * A metódus eltávolítja az összes érintett collider címkét az objektum
-     * `touchedTags` halmazából. Ezt minden `update` után meghívja a `postUpdate`.
+     * `touchedTags` maszkjából. Ezt minden `update` után meghívja a `postUpdate`.
      */
     void clearTags();
+
+    /**
+     * @brief Elmenti az objektum szimulációs állapotát.
+     * 
+     * @param state A mentés helye, a címkelista kapacitása újrahasznosul.
+     */
+    void saveState(State& state) const;
+
+    /**
+     * @brief Visszaállítja az objektum szimulációs állapotát.
+     * 
+     * A collidereket és a hierarchiát nem módosítja.
+     * 
+     * @param state A korábban mentett állapot.
+     */
+    void loadState(const State& state);
+
+    /**
+     * @brief Hozzáadja a pozíciót, a sebességet, a gyorsulást és az érintett címkéket a hashhez.
+     */
+    void hashState(StateHasher& hasher) const override;
 };
\ No newline at end of file
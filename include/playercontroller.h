@@ -0,0 +1,191 @@
+#pragma once
+#include "memtrace.h"
+
+#include "vector2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifndef CPORTA
+#include "inputscheme.h"
+#endif
+
+/**
+ * @brief Egy játékos egy frissítéshez tartozó irányítása.
+ */
+struct PlayerInput
+{
+    bool left = false; ///< Mozgás balra.
+    bool right = false; ///< Mozgás jobbra.
+    bool jump = false; ///< Ugrás, nyomva tartva lassabb esés felfelé.
+    bool dash = false; ///< Vetődés lefelé.
+
+    /**
+     * @brief Egy bájtba kódolja az irányítást, a hálózati küldéshez.
+     *
+     * @return A kódolt irányítás, az alsó négy biten.
+     */
+    uint8_t encode() const;
+
+    /**
+     * @brief Visszafejti az `encode` által kódolt irányítást.
+     *
+     * @param bits A kódolt irányítás.
+     * @return Az irányítás.
+     */
+    static PlayerInput decode(const uint8_t bits);
+};
+
+/**
+ * @brief Egy játékos irányításhoz látható állapota.
+ */
+struct PlayerView
+{
+    Vector2 position; ///< A játékos pozíciója.
+    Vector2 velocity; ///< A játékos sebessége.
+    bool grounded = false; ///< Jelzi, hogy a játékos a talajon áll-e.
+    bool dead = false; ///< Jelzi, hogy a játékos halott-e.
+};
+
+/**
+ * @brief A játékosokat irányító objektumok közös felülete.
+ *
+ * A `Fighter` minden fizikai lépés előtt megkérdezi az irányítóját, hogy mit
+ * csináljon. Az irányító a saját és az ellenfél állapotát látja, így a
+ * billentyűzet mellett programozott botok is irányíthatnak, akár
+ * megjelenítés nélküli mérkőzésekben.
+ */
+class PlayerController
+{
+    public:
+    /**
+     * @brief Virtuális destruktor.
+     */
+    virtual ~PlayerController();
+
+    /**
+     * @brief Meghatározza a játékos irányítását az aktuális frissítésre.
+     *
+     * @param self Az irányított játékos állapota.
+     * @param opponent Az ellenfél állapota.
+     * @return A játékos irányítása.
+     */
+    virtual PlayerInput control(const PlayerView& self, const PlayerView& opponent) = 0;
+};
+
+/**
+ * @brief Előre megadott lépéseket ismétlő irányító.
+ *
+ * Minden lépés egy irányítást és a hozzá tartozó frissítések számát tartalmazza,
+ * az utolsó lépés után az első következik. Üres lépéslista esetén a játékos áll.
+ */
+class ScriptedController : public PlayerController
+{
+    public:
+    /**
+     * @brief Az irányító egy lépése.
+     */
+    struct Step
+    {
+        PlayerInput input; ///< Az irányítás a lépés alatt.
+        size_t ticks; ///< A lépés hossza frissítésekben.
+    };
+
+    private:
+    std::vector<Step> steps; ///< A lépések.
+    size_t stepIndex; ///< Az aktuális lépés indexe.
+    size_t stepTicks; ///< Az aktuális lépésben eltelt frissítések száma.
+
+    public:
+    /**
+     * @brief Létrehoz egy irányítót a megadott lépésekkel.
+     *
+     * @param steps A lépések, a nulla hosszú lépések kimaradnak.
+     */
+    explicit ScriptedController(const std::vector<Step>& steps);
+
+    PlayerInput control(const PlayerView& self, const PlayerView& opponent) override;
+};
+
+/**
+ * @brief Véletlenszerűen mozgó irányító.
+ *
+ * Néhány frissítésenként új irányt és ugrást választ. A véletlenszámokat a
+ * seed határozza meg, így ugyanaz a seed ugyanazt a mozgást adja.
+ */
+class RandomController : public PlayerController
+{
+    private:
+    std::mt19937_64 random; ///< A véletlenszám-generátor.
+    PlayerInput current; ///< Az aktuális irányítás.
+    size_t ticksLeft; ///< Az aktuális irányításból hátralévő frissítések száma.
+
+    public:
+    /**
+     * @brief Létrehoz egy véletlenszerű irányítót.
+     *
+     * @param seed A véletlenszám-generátor kezdőértéke.
+     */
+    explicit RandomController(const uint64_t seed);
+
+    PlayerInput control(const PlayerView& self, const PlayerView& opponent) override;
+};
+
+/**
+ * @brief Az ellenfelet üldöző, heurisztikus irányító.
+ *
+ * Az ellenfél felé mozog és ugrál, fölé érve rávetődik, alatta állva pedig
+ * kitér előle, mert a fejére érkező ellenfél megöli.
+ */
+class ChaseController : public PlayerController
+{
+    public:
+    PlayerInput control(const PlayerView& self, const PlayerView& opponent) override;
+};
+
+/**
+ * @brief A kívülről beállított irányítást visszaadó irányító.
+ *
+ * A hálózati játék így adja át a karakternek a helyi és a távoli
+ * játékos adott frissítéshez tartozó irányítását.
+ */
+class DirectController : public PlayerController
+{
+    private:
+    PlayerInput input; ///< A következő frissítések irányítása.
+
+    public:
+    /**
+     * @brief Beállítja a következő frissítések irányítását.
+     *
+     * @param input Az irányítás.
+     */
+    void setInput(const PlayerInput& input);
+
+    PlayerInput control(const PlayerView& self, const PlayerView& opponent) override;
+};
+
+#ifndef CPORTA
+/**
+ * @brief A billentyűzetről irányító objektum.
+ *
+ * A lenyomott billentyűket az `InputHandler` adja az aktuális világból.
+ */
+class KeyboardController : public PlayerController
+{
+    private:
+    const InputScheme inputScheme; ///< A játékoshoz tartozó bemeneti kiosztás.
+
+    public:
+    /**
+     * @brief Létrehoz egy irányítót a megadott billentyűkiosztással.
+     *
+     * @param inputScheme A játékoshoz tartozó bemeneti kiosztás.
+     */
+    explicit KeyboardController(const InputScheme& inputScheme);
+
+    PlayerInput control(const PlayerView& self, const PlayerView& opponent) override;
+};
+#endif
@@ -3,6 +3,11 @@
 #include "core.h"
 #include "transform.h"
 #include "colors.h"
+#include "rendersnapshot.h"
+
+#include <atomic>
+
+struct TTF_Font;
 
 /**
  * @brief A játék grafikai megjelenítéséért felelős osztály.
@@ -10,15 +15,44 @@
  * A `Renderer` osztály felelős a játék grafikai elemeinek megjelenítéséért,
  * beleértve a háttér kirajzolását, a képernyő és a játék világának koordinátái
  * közötti átváltást, valamint a játék világának méretének és arányainak kezelését.
+ * 
+ * A kamera, a háttérszín és a képkocka statisztikái a hívó szálon aktuális
+ * `World` részei.
+ *
+ * A renderelők nem rajzolnak közvetlenül, hanem a szimuláció szálán a
+ * képkocka `RenderSnapshot` állapotába veszik fel a téglalapokat és a
+ * szövegeket. A főszál a `drawSnapshot` metódussal csak a legutóbb
+ * elkészült képkockát rajzolja ki, a világhoz nem nyúl. A képernyő méretét
+ * a főszál adja meg, a szimuláció a tárolt értéket olvassa.
  */
-class Renderer : public Transform, Updatable
+class Renderer : public Transform, public Updatable
 {
     private:
-    static double gameHeight; ///< A játék világának magassága játékegységekben.
-    static Color backgroundColor; //< A játék világának háttérszíne (RGBA formátumban).
+    static std::atomic<int> screenWidth; ///< A képernyő szélessége pixelben, a főszál frissíti.
+    static std::atomic<int> screenHeight; ///< A képernyő magassága pixelben, a főszál frissíti.
+
+    static TTF_Font* font; ///< A szövegek betűtípusa, csak a főszál használja.
+    static int fontSize; ///< A betöltött betűtípus mérete pixelben.
+
+    /**
+     * @brief Kirajzolja a szöveget a képernyő közepére.
+     *
+     * Szükség esetén újratölti a betűtípust a szöveg méretével.
+     *
+     * @param text A szöveg.
+     */
+    static void drawText(const RenderSnapshot::Text& text);
+
+    protected:
+    /**
+     * @brief Hozzáadja a kirajzolt objektumok számát a képkocka statisztikájához.
+     */
+    static void countDrawn(const size_t count);
 
-    static Vector2 cameraOffset;
-    static double cameraScale;
+    /**
+     * @brief Hozzáadja a kihagyott objektumok számát a képkocka statisztikájához.
+     */
+    static void countCulled(const size_t count);
 
     public:
     /**
@@ -32,11 +66,76 @@ class Renderer : public Transform, Updatable
     Renderer(const Transform& transform, UpdatePriority priority);
 
     /**
-     * @brief Kirajzolja a játék hátterét.
+     * @brief Előkészíti a képkocka kirajzolását.
      * 
-     * A metódus a beállított háttérszínt használva kirajzolja a játék hátterét.
+     * A kamera eltolásából, méretéből és a képarányból kiszámolja a képkockában
+     * látható terület határait, amelyeket a renderelők a kirajzolás előtti
+     * ellenőrzéshez használnak, és nullázza a képkocka statisztikáit.
+     * Képkockánként egyszer, a renderelők frissítése előtt kell meghívni.
+     * 
+     * @param snapshot A kiürítendő képkocka, amelybe a renderelők az
+     * `endFrame` hívásig rajzolnak.
+     */
+    static void beginFrame(RenderSnapshot& snapshot);
+
+    /**
+     * @brief Lezárja a képkockát.
+     * 
+     * A képkockába írja a kamera renderelők frissítése utáni állapotát, és
+     * leválasztja a képkockát a világról.
+     */
+    static void endFrame();
+
+    /**
+     * @brief Megadja, hogy a téglalap belelóg-e a képkockában látható területbe.
+     * 
+     * A `beginFrame` által kiszámolt határokat használja, SDL hívás nélkül.
+     * 
+     * @param position A téglalap középpontja.
+     * @param scale A téglalap mérete.
+     * @return true, ha a téglalap legalább részben látható.
+     */
+    static bool isVisible(const Vector2& position, const Vector2& scale);
+
+    /**
+     * @brief Visszaadja a képkockában látható terület bal alsó sarkát.
+     */
+    static Vector2 getViewMin();
+
+    /**
+     * @brief Visszaadja a képkockában látható terület jobb felső sarkát.
+     */
+    static Vector2 getViewMax();
+
+    /**
+     * @brief Visszaadja az aktuális képkockában eddig kirajzolt objektumok számát.
+     */
+    static size_t getDrawnCount();
+
+    /**
+     * @brief Visszaadja az aktuális képkockában eddig kihagyott, nem látható objektumok számát.
+     */
+    static size_t getCulledCount();
+
+    /**
+     * @brief Kirajzolja a képkockát az SDL rendererrel. Csak a főszálról hívható.
+     * 
+     * Kirajzolja a hátteret, a téglalapokat és a szövegeket a képernyő
+     * aktuális méretével.
+     * 
+     * @param snapshot A kirajzolandó képkocka.
+     */
+    static void drawSnapshot(const RenderSnapshot& snapshot);
+
+    /**
+     * @brief Frissíti a tárolt képernyőméretet az SDL renderer kimenetéből. Csak a főszálról hívható.
+     */
+    static void updateScreenSize();
+
+    /**
+     * @brief Felszabadítja a kirajzolás erőforrásait, ezalatt a betűtípust értve.
      */
-    static void drawBackground();
+    static void releaseResources();
 
     /**
      * @brief Visszaadja a játék világának szélességét.
@@ -0,0 +1,159 @@
+#pragma once
+#include "memtrace.h"
+
+#include "colors.h"
+#include "vector2.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Egy képkocka kirajzolásához szükséges, a szimulációtól független állapot.
+ *
+ * A szimuláció a képkocka végén a renderelők által felvett téglalapokból és
+ * szövegekből, valamint a kamera állapotából állítja össze, a megjelenítés
+ * pedig csak ebből rajzol, a világhoz nem nyúl. Így a két folyamat külön
+ * szálon futhat.
+ *
+ * A téglalapok a játék világának koordinátáiban vannak, a képernyőre a
+ * megjelenítés váltja át őket az aktuális képernyőmérettel. A `clear` a
+ * tárolók kapacitását megtartja, így az újrahasznosított képkockák nem
+ * foglalnak memóriát.
+ */
+class RenderSnapshot
+{
+    public:
+    /**
+     * @brief Egy kitöltött téglalap a játék világában.
+     */
+    struct Rect
+    {
+        Vector2 position; ///< A téglalap középpontja.
+        Vector2 scale; ///< A téglalap mérete.
+        Color color; ///< A téglalap színe.
+    };
+
+    /**
+     * @brief Egy képernyő közepére írt szöveg.
+     */
+    struct Text
+    {
+        std::string text; ///< A szöveg tartalma.
+        Color color; ///< A szöveg színe.
+        double scale = 0; ///< A szöveg magassága a képernyő magasságához viszonyítva.
+    };
+
+    /**
+     * @brief Egy téglalap a képernyőn, pixelben.
+     */
+    struct ScreenRect
+    {
+        float x; ///< A bal felső sarok X koordinátája.
+        float y; ///< A bal felső sarok Y koordinátája.
+        float width; ///< A szélesség.
+        float height; ///< A magasság.
+    };
+
+    private:
+    Color backgroundColor; ///< A háttér színe.
+    Vector2 cameraOffset; ///< A kamera eltolása.
+    double gameHeight; ///< A játék világának a kamera méretével szorzott magassága.
+
+    std::vector<Rect> rects; ///< A kirajzolandó téglalapok, a kirajzolás sorrendjében.
+    std::vector<Text> texts; ///< A szövegek, az első `textCount` érvényes, a többi újrahasznosításra vár.
+    size_t textCount; ///< A képkocka szövegeinek száma.
+
+    public:
+    /**
+     * @brief Létrehoz egy üres, fehér hátterű képkockát.
+     */
+    RenderSnapshot();
+
+    /**
+     * @brief Kiüríti a képkockát a tárolók kapacitásának megtartásával.
+     */
+    void clear();
+
+    /**
+     * @brief Beállítja a kamera állapotát.
+     *
+     * @param backgroundColor A háttér színe.
+     * @param cameraOffset A kamera eltolása.
+     * @param gameHeight A játék világának a kamera méretével szorzott magassága.
+     * @throws std::invalid_argument Ha a magasság nem pozitív.
+     */
+    void setCamera(const Color& backgroundColor, const Vector2& cameraOffset, const double gameHeight);
+
+    /**
+     * @brief Hozzáad egy téglalapot a képkockához.
+     *
+     * @param position A téglalap középpontja.
+     * @param scale A téglalap mérete.
+     * @param color A téglalap színe.
+     */
+    void addRect(const Vector2& position, const Vector2& scale, const Color& color);
+
+    /**
+     * @brief Hozzáad egy szöveget a képkockához.
+     *
+     * @param text A szöveg tartalma.
+     * @param color A szöveg színe.
+     * @param scale A szöveg magassága a képernyő magasságához viszonyítva.
+     */
+    void addText(const std::string& text, const Color& color, const double scale);
+
+    /**
+     * @brief A képkocka végéhez fűzi a másik képkocka téglalapjait és szövegeit.
+     *
+     * A kamera állapota nem változik.
+     *
+     * @param snapshot A hozzáfűzendő képkocka.
+     */
+    void append(const RenderSnapshot& snapshot);
+
+    /**
+     * @brief Visszaadja a háttér színét.
+     */
+    const Color& getBackgroundColor() const;
+
+    /**
+     * @brief Visszaadja a kamera eltolását.
+     */
+    const Vector2& getCameraOffset() const;
+
+    /**
+     * @brief Visszaadja a játék világának a kamera méretével szorzott magasságát.
+     */
+    double getGameHeight() const;
+
+    /**
+     * @brief Visszaadja a kirajzolandó téglalapokat.
+     */
+    const std::vector<Rect>& getRects() const;
+
+    /**
+     * @brief Visszaadja a szövegek számát.
+     */
+    size_t getTextCount() const;
+
+    /**
+     * @brief Visszaadja a megadott sorszámú szöveget.
+     *
+     * @throws std::out_of_range Ha nincs ilyen sorszámú szöveg.
+     */
+    const Text& getText(const size_t index) const;
+
+    /**
+     * @brief Átváltja a téglalapot képernyő koordinátákra.
+     *
+     * Ugyanazt az átváltást végzi, mint a `Renderer` koordináta-átváltó
+     * metódusai, de a képkocka kamerájával, így a világ nélkül is használható.
+     *
+     * @param rect A téglalap a játék világában.
+     * @param screenWidth A képernyő szélessége pixelben.
+     * @param screenHeight A képernyő magassága pixelben.
+     * @return A téglalap a képernyőn.
+     */
+    ScreenRect toScreen(const Rect& rect, const int screenWidth, const int screenHeight) const;
+};
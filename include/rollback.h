@@ -0,0 +1,178 @@
+#pragma once
+#include "memtrace.h"
+
+#include "match.h"
+#include "nettransport.h"
+#include "statehash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Rollback alapú hálózati játék egyik fele (GGPO mintájára).
+ *
+ * A munkamenet minden lépésben átveszi a helyi játékos irányítását,
+ * elküldi a másik félnek, és a mérkőzést azonnal lépteti, a távoli
+ * játékos még meg nem érkezett irányítását az utolsó ismert irányításával
+ * becsülve. Minden lépés előtt elmenti a mérkőzés állapotát. Ha egy
+ * később megérkező irányítás eltér a becsléstől, a munkamenet visszatölti
+ * az eltérő lépés előtti állapotot, és onnan az ismert irányításokkal
+ * újraszimulálja a mérkőzést a jelenig.
+ *
+ * A csomagok a másik fél által még nem nyugtázott összes helyi irányítást
+ * tartalmazzák, így az elveszett vagy felcserélődött csomagok nem okoznak
+ * hibát. Ha a helyi fél `maxRollback` lépésnél többel járna a távoli
+ * irányítások előtt, a munkamenet vár, amíg azok meg nem érkeznek.
+ *
+ * A véglegessé vált (mindkét irányítással ismert) lépések állapothashét a
+ * csomagok a másik félhez is eljuttatják. Eltérés esetén a munkamenet
+ * feljegyzi az első eltérő lépést (desync), a hashek naplózhatók is.
+ *
+ * Az irányítások lépésenként egy, a hashek nyolc bájtot foglalnak, és a
+ * mérkőzés végéig megmaradnak.
+ */
+class RollbackSession
+{
+    public:
+    /**
+     * @brief A munkamenet paraméterei.
+     */
+    struct Settings
+    {
+        size_t maxRollback = 8; ///< A legtöbb lépés, amennyivel a helyi fél a távoli irányítások előtt járhat.
+        size_t inputDelay = 0; ///< Ennyi lépéssel később érvényesül a helyi irányítás, ami kevesebb visszatekerést okoz.
+    };
+
+    /**
+     * @brief A munkamenet statisztikái.
+     */
+    struct Stats
+    {
+        size_t rollbacks = 0; ///< A hibás becslések miatti visszatekerések száma.
+        size_t resimulatedTicks = 0; ///< Az újraszimulált lépések száma.
+        size_t maxRollbackDepth = 0; ///< A legmélyebb visszatekerés lépésekben.
+        size_t stalledTicks = 0; ///< A távoli irányításra várva kihagyott lépések száma.
+        size_t packetsReceived = 0; ///< A feldolgozott csomagok száma.
+        size_t desyncTick = SIZE_MAX; ///< Az első lépés, amelynek hashe a két félnél eltér, vagy `SIZE_MAX`.
+    };
+
+    private:
+    Match& match; ///< A szimulált mérkőzés.
+    NetTransport& transport; ///< A kapcsolat a másik féllel.
+    size_t localSide; ///< A helyi játékos sorszáma a mérkőzésben.
+    Settings settings; ///< A munkamenet paraméterei.
+    Stats stats; ///< A munkamenet statisztikái.
+
+    size_t tick; ///< A lefutott lépések száma.
+    std::vector<uint8_t> localInputs; ///< A helyi irányítások lépésenként, a késleltetéssel eltolva.
+    std::vector<uint8_t> remoteInputs; ///< A távoli irányítások lépésenként, a meg nem erősítettek a becslések.
+    size_t remoteConfirmed; ///< A megérkezett távoli irányítások száma.
+    size_t remoteAck; ///< A másik fél által nyugtázott helyi irányítások száma.
+    std::vector<uint8_t> packet; ///< A küldött és fogadott csomagok puffere.
+
+    std::vector<uint64_t> tickHashes; ///< A visszatekerhető lépések utáni állapothashek, lépésenként körbeírva.
+    std::vector<uint64_t> finalHashes; ///< A véglegessé vált lépések utáni állapothashek.
+    size_t remoteHashTick; ///< A másik féltől kapott, még össze nem vetett hash lépése, vagy `SIZE_MAX`.
+    uint64_t remoteHash; ///< A másik féltől utoljára kapott hash.
+    StateHashLog* hashLog; ///< A véglegessé vált lépések hashének naplója, vagy nullptr.
+
+    RollbackSession(const RollbackSession& session);
+
+    RollbackSession& operator=(const RollbackSession& session);
+
+    /**
+     * @brief Visszaadja a távoli irányítás becslését: az utolsó megérkezett irányítást.
+     */
+    uint8_t predictRemoteInput() const;
+
+    /**
+     * @brief Lefuttat egy lépést a tárolt irányításokkal.
+     *
+     * @param stepTick A lépés sorszáma.
+     */
+    void simulate(const size_t stepTick);
+
+    /**
+     * @brief Feldolgoz egy csomagot.
+     *
+     * @param mismatchTick A legkorábbi hibásan becsült lépés, frissül, ha a csomag korábbit tartalmaz.
+     */
+    void readPacket(size_t& mismatchTick);
+
+    /**
+     * @brief Feldolgozza a megérkezett csomagokat, és hibás becslés esetén visszateker.
+     *
+     * A legkorábbi hibásan becsült lépés előtti állapotot tölti vissza, és
+     * onnan a jelenig újraszimulál.
+     */
+    void receiveInputs();
+
+    /**
+     * @brief Véglegesíti a mindkét irányítással ismert lépések hashét, és összeveti a másik félével.
+     */
+    void finalizeTicks();
+
+    /**
+     * @brief Elküldi a nem nyugtázott helyi irányításokat és a nyugtát.
+     */
+    void sendInputs();
+
+    public:
+    /**
+     * @brief Létrehoz egy munkamenetet.
+     *
+     * @param match A szimulált mérkőzés, a munkamenet kezdetén a két félnél azonos állapotban.
+     * @param transport A kapcsolat a másik féllel.
+     * @param localSide A helyi játékos sorszáma a mérkőzésben (0 vagy 1).
+     * @param settings A munkamenet paraméterei.
+     * @throws std::invalid_argument Ha a sorszám vagy a paraméterek érvénytelenek.
+     */
+    RollbackSession(Match& match, NetTransport& transport, const size_t localSide, const Settings& settings);
+
+    /**
+     * @brief Feldolgozza a megérkezett csomagokat és elküldi a helyi irányításokat, lépés nélkül.
+     *
+     * Ha egy távoli irányítás eltér a becsléstől, visszateker és újraszimulál.
+     */
+    void poll();
+
+    /**
+     * @brief Lefuttat egy lépést a helyi irányítással.
+     *
+     * Előtte feldolgozza a megérkezett csomagokat, utána elküldi a helyi irányítást.
+     *
+     * @param localInput A helyi játékos irányítása.
+     * @return false, ha a munkamenet a távoli irányításra vár, és a lépés elmaradt, különben true.
+     */
+    bool advance(const PlayerInput& localInput);
+
+    /**
+     * @brief Visszaadja a lefutott lépések számát.
+     */
+    size_t getTick() const;
+
+    /**
+     * @brief Visszaadja a mindkét játékos irányításával ismert lépések számát.
+     *
+     * Az ennél korábbi lépések már nem tekerhetők vissza.
+     */
+    size_t getConfirmedTick() const;
+
+    /**
+     * @brief Visszaadja a munkamenet statisztikáit.
+     */
+    const Stats& getStats() const;
+
+    /**
+     * @brief Visszaadja a véglegessé vált lépések utáni állapothasheket.
+     */
+    const std::vector<uint64_t>& getFinalHashes() const;
+
+    /**
+     * @brief Beállítja a véglegessé vált lépések hashének naplóját.
+     *
+     * @param log A napló, vagy nullptr. A munkamenet nem veszi át.
+     */
+    void setHashLog(StateHashLog* const log);
+};
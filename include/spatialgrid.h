@@ -0,0 +1,182 @@
+#pragma once
+#include "memtrace.h"
+
+#include "vector2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Tengelyekkel párhuzamos téglalapokat cellákba soroló térbeli index.
+ *
+ * A `SpatialGrid` a játék világát `cellSize` méretű négyzetes cellákra osztja,
+ * és minden elemet azokba a cellákba sorol, amelyeket a befoglaló téglalapja
+ * érint. Egy téglalapba eső elemek lekérdezése így csak az érintett cellákat
+ * járja be, az ideje a találatok számával arányos, nem az összes elemével.
+ *
+ * Csak a nem üres cellák foglalnak memóriát, így a pálya mérete nincs korlátozva.
+ * A kiürült cellák megmaradnak, a következő beszúrások újra felhasználják őket.
+ *
+ * A lekérdezések nem módosítják az indexet, így több szálon egyszerre is
+ * futhatnak, amíg az indexbe senki nem szúr be és nem töröl.
+ *
+ * @tparam T A tárolt elemek típusa, az index csak pointert tárol rájuk.
+ */
+template <typename T>
+class SpatialGrid
+{
+    public:
+    using Handle = uint32_t; ///< Egy elem azonosítója az indexben.
+    static constexpr Handle invalidHandle = UINT32_MAX; ///< Érvénytelen azonosító jelölése.
+
+    private:
+    /**
+     * @brief Egy elem adatai az indexben.
+     */
+    struct Item
+    {
+        T* value; ///< Az elem, vagy `nullptr` ha a hely szabad.
+        Vector2 min; ///< A befoglaló téglalap bal alsó sarka.
+        Vector2 max; ///< A befoglaló téglalap jobb felső sarka.
+        int32_t cellMinX; ///< Az elem első cellájának oszlopa.
+        int32_t cellMinY; ///< Az elem első cellájának sora.
+        int32_t cellMaxX; ///< Az elem utolsó cellájának oszlopa.
+        int32_t cellMaxY; ///< Az elem utolsó cellájának sora.
+    };
+
+    double cellSize; ///< A cellák oldalhossza.
+    std::vector<Item> items; ///< Az elemek, az azonosító az indexük.
+    std::vector<Handle> freeItems; ///< A felszabadult azonosítók.
+    std::unordered_map<uint64_t, std::vector<Handle>> cells; ///< A nem üres cellák elemei.
+    size_t count; ///< Az elemek száma.
+
+    /**
+     * @brief Visszaadja a koordinátát tartalmazó cella sorszámát egy tengely mentén.
+     */
+    int32_t getCellCoordinate(const double coordinate) const;
+
+    /**
+     * @brief Visszaadja a cella kulcsát a cellák táblájában.
+     */
+    static uint64_t getCellKey(const int32_t x, const int32_t y);
+
+    /**
+     * @brief Visszaadja a kulcsú cella oszlopát.
+     */
+    static int32_t getCellX(const uint64_t key);
+
+    /**
+     * @brief Visszaadja a kulcsú cella sorát.
+     */
+    static int32_t getCellY(const uint64_t key);
+
+    /**
+     * @brief Átadja a látogatónak a cella azon elemeit, amelyeknek ez a bejárt terület első cellája.
+     *
+     * Egy elem a bejárt terület (`fromX`, `fromY`) kezdetű részén belül csak
+     * egyetlen cellában, a közös rész bal alsó cellájában kerül a látogatóhoz,
+     * így a lekérdezéseknek nem kell megjelölniük a már látott elemeket.
+     */
+    template <typename Visitor>
+    void visitCell(const std::vector<Handle>& cell, const int64_t x, const int64_t y, const int64_t fromX, const int64_t fromY, Visitor& visitor) const;
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    SpatialGrid(const SpatialGrid& grid);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    SpatialGrid& operator=(const SpatialGrid& grid);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres indexet.
+     *
+     * @param cellSize A cellák oldalhossza játékegységekben.
+     */
+    explicit SpatialGrid(const double cellSize = 4);
+
+    /**
+     * @brief Beszúr egy elemet az indexbe.
+     *
+     * @param value Az elem.
+     * @param min Az elem befoglaló téglalapjának bal alsó sarka.
+     * @param max Az elem befoglaló téglalapjának jobb felső sarka.
+     * @return Az elem azonosítója, amellyel törölhető.
+     */
+    Handle insert(T* const value, const Vector2& min, const Vector2& max);
+
+    /**
+     * @brief Törli az elemet az indexből.
+     *
+     * @param handle Az elem azonosítója.
+     * @throws std::out_of_range Ha az azonosító érvénytelen.
+     */
+    void remove(const Handle handle);
+
+    /**
+     * @brief Összegyűjti a téglalappal érintkező vagy azt átfedő elemeket.
+     *
+     * Minden elem legfeljebb egyszer szerepel az eredményben, akkor is,
+     * ha több cellát érint.
+     *
+     * @param min A téglalap bal alsó sarka.
+     * @param max A téglalap jobb felső sarka.
+     * @param result Az eredmény, a metódus előbb kiüríti.
+     */
+    void query(const Vector2& min, const Vector2& max, std::vector<T*>& result) const;
+
+    /**
+     * @brief Bejárja a téglalappal érintkező vagy azt átfedő elemeket, foglalás nélkül.
+     *
+     * Minden elem legfeljebb egyszer kerül a látogatóhoz.
+     *
+     * @tparam Visitor A látogató, `(T* value, const Vector2& min, const Vector2& max)`
+     * alakban hívható, az elem és a tárolt befoglaló téglalapja a paraméterei.
+     * @param min A téglalap bal alsó sarka.
+     * @param max A téglalap jobb felső sarka.
+     * @param visitor A látogató.
+     */
+    template <typename Visitor>
+    void visit(const Vector2& min, const Vector2& max, Visitor visitor) const;
+
+    /**
+     * @brief Bejárja egy félegyenes, vagy egy mentén mozgatott téglalap útjába eső cellák elemeit.
+     *
+     * A cellákat az origótól távolodva, sorban járja be, így a látogató
+     * csökkentheti a `maxDistance` értékét (például a legközelebbi találat
+     * távolságára), ekkor a bejárás a távolabb kezdődő cellákat már kihagyja.
+     * Ha az út több cellát érintene, mint ahány nem üres cella van, az
+     * összes nem üres cellát járja be, sorrend nélkül. Minden elem legfeljebb
+     * egyszer kerül a látogatóhoz, és a látogatott elemek közül nem mindegyik
+     * esik az útba, azt a látogatónak kell ellenőriznie.
+     *
+     * @tparam Visitor A látogató, `(T* value, const Vector2& min, const Vector2& max)`
+     * alakban hívható.
+     * @param origin A félegyenes kezdőpontja, illetve a téglalap kezdeti középpontja.
+     * @param direction Az egységnyi hosszú irányvektor.
+     * @param maxDistance A bejárt út hossza, a látogató csökkentheti.
+     * @param halfExtent A mozgatott téglalap fél mérete, félegyenes esetén nullvektor.
+     * @param visitor A látogató.
+     */
+    template <typename Visitor>
+    void visitAlongRay(const Vector2& origin, const Vector2& direction, double& maxDistance, const Vector2& halfExtent, Visitor visitor) const;
+
+    /**
+     * @brief Törli az összes elemet.
+     *
+     * A cellák memóriája megmarad a következő beszúrásokhoz.
+     */
+    void clear();
+
+    /**
+     * @brief Visszaadja az elemek számát.
+     */
+    size_t size() const;
+};
+
+#include "spatialgrid.inl"
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+template <typename T>
+SpatialGrid<T>::SpatialGrid(const double cellSize)
+: cellSize(cellSize > 0 ? cellSize : 1), count(0)
+{
+
+}
+
+template <typename T>
+int32_t SpatialGrid<T>::getCellCoordinate(const double coordinate) const
+{
+    double cell = std::floor(coordinate / cellSize);
+
+    //far away coordinates are clamped, so they end up in the border cells
+    if (cell < std::numeric_limits<int32_t>::min())
+        return std::numeric_limits<int32_t>::min();
+    if (cell > std::numeric_limits<int32_t>::max())
+        return std::numeric_limits<int32_t>::max();
+
+    return static_cast<int32_t>(cell);
+}
+
+template <typename T>
+uint64_t SpatialGrid<T>::getCellKey(const int32_t x, const int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+template <typename T>
+int32_t SpatialGrid<T>::getCellX(const uint64_t key)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+}
+
+template <typename T>
+int32_t SpatialGrid<T>::getCellY(const uint64_t key)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(key));
+}
+
+template <typename T>
+typename SpatialGrid<T>::Handle SpatialGrid<T>::insert(T* const value, const Vector2& min, const Vector2& max)
+{
+    Handle handle;
+    if (!freeItems.empty())
+    {
+        handle = freeItems.back();
+        freeItems.pop_back();
+    }
+    else
+    {
+        handle = static_cast<Handle>(items.size());
+        items.push_back({nullptr, Vector2(), Vector2(), 0, 0, 0, 0});
+    }
+
+    int32_t minX = getCellCoordinate(min.x), maxX = getCellCoordinate(max.x);
+    int32_t minY = getCellCoordinate(min.y), maxY = getCellCoordinate(max.y);
+    items[handle] = {value, min, max, minX, minY, maxX, maxY};
+
+    for (int64_t x = minX; x <= maxX; x++)
+    {
+        for (int64_t y = minY; y <= maxY; y++)
+        {
+            cells[getCellKey(static_cast<int32_t>(x), static_cast<int32_t>(y))].push_back(handle);
+        }
+    }
+
+    count++;
+    return handle;
+}
+
+template <typename T>
+void SpatialGrid<T>::remove(const Handle handle)
+{
+    if (handle >= items.size() || items[handle].value == nullptr)
+        throw std::out_of_range("spatial grid handle is not valid");
+
+    const Item& item = items[handle];
+    for (int64_t x = item.cellMinX; x <= item.cellMaxX; x++)
+    {
+        for (int64_t y = item.cellMinY; y <= item.cellMaxY; y++)
+        {
+            std::vector<Handle>& cell = cells[getCellKey(static_cast<int32_t>(x), static_cast<int32_t>(y))];
+            for (size_t i = 0; i < cell.size(); i++)
+            {
+                if (cell[i] == handle)
+                {
+                    //order inside a cell does not matter
+                    cell[i] = cell.back();
+                    cell.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+
+    items[handle].value = nullptr;
+    freeItems.push_back(handle);
+    count--;
+}
+
+template <typename T>
+void SpatialGrid<T>::query(const Vector2& min, const Vector2& max, std::vector<T*>& result) const
+{
+    result.clear();
+    visit(min, max, [&result](T* value, const Vector2&, const Vector2&) { result.push_back(value); });
+}
+
+template <typename T>
+template <typename Visitor>
+void SpatialGrid<T>::visitCell(const std::vector<Handle>& cell, const int64_t x, const int64_t y, const int64_t fromX, const int64_t fromY, Visitor& visitor) const
+{
+    for (Handle handle : cell)
+    {
+        const Item& item = items[handle];
+        if (x == std::max<int64_t>(item.cellMinX, fromX) && y == std::max<int64_t>(item.cellMinY, fromY))
+            visitor(item);
+    }
+}
+
+template <typename T>
+template <typename Visitor>
+void SpatialGrid<T>::visit(const Vector2& min, const Vector2& max, Visitor visitor) const
+{
+    auto collect = [&min, &max, &visitor](const Item& item)
+    {
+        if (item.max.x >= min.x && item.min.x <= max.x && item.max.y >= min.y && item.min.y <= max.y)
+            visitor(item.value, item.min, item.max);
+    };
+
+    int32_t minX = getCellCoordinate(min.x), maxX = getCellCoordinate(max.x);
+    int32_t minY = getCellCoordinate(min.y), maxY = getCellCoordinate(max.y);
+
+    //a query larger than the populated area is cheaper to answer by walking the populated cells
+    double queriedCells = (double(maxX) - minX + 1) * (double(maxY) - minY + 1);
+    if (queriedCells > cells.size())
+    {
+        for (const std::pair<const uint64_t, std::vector<Handle>>& cell : cells)
+            visitCell(cell.second, getCellX(cell.first), getCellY(cell.first), INT64_MIN, INT64_MIN, collect);
+        return;
+    }
+
+    for (int64_t x = minX; x <= maxX; x++)
+    {
+        for (int64_t y = minY; y <= maxY; y++)
+        {
+            auto cell = cells.find(getCellKey(static_cast<int32_t>(x), static_cast<int32_t>(y)));
+            if (cell != cells.end())
+                visitCell(cell->second, x, y, minX, minY, collect);
+        }
+    }
+}
+
+template <typename T>
+template <typename Visitor>
+void SpatialGrid<T>::visitAlongRay(const Vector2& origin, const Vector2& direction, double& maxDistance, const Vector2& halfExtent, Visitor visitor) const
+{
+    //a swept box reaches this many cells around the cell of its center
+    int32_t reachX = halfExtent.x > 0 ? static_cast<int32_t>(std::ceil(halfExtent.x / cellSize)) : 0;
+    int32_t reachY = halfExtent.y > 0 ? static_cast<int32_t>(std::ceil(halfExtent.y / cellSize)) : 0;
+
+    //a long path is cheaper to answer by walking the populated cells
+    double pathCells = (std::abs(direction.x) * maxDistance / cellSize + 1) + (std::abs(direction.y) * maxDistance / cellSize + 1);
+    double walkedCells = pathCells * (2.0 * reachX + 1) * (2.0 * reachY + 1);
+    if (!(walkedCells <= cells.size()))
+    {
+        auto collect = [&visitor](const Item& item) { visitor(item.value, item.min, item.max); };
+        for (const std::pair<const uint64_t, std::vector<Handle>>& cell : cells)
+            visitCell(cell.second, getCellX(cell.first), getCellY(cell.first), INT64_MIN, INT64_MIN, collect);
+        return;
+    }
+
+    //cell walk along the center line (Amanatides-Woo)
+    int64_t x = getCellCoordinate(origin.x), y = getCellCoordinate(origin.y);
+    int64_t stepX = direction.x > 0 ? 1 : -1, stepY = direction.y > 0 ? 1 : -1;
+    const double infinity = std::numeric_limits<double>::infinity();
+    double nextX = direction.x != 0 ? ((x + (stepX > 0)) * cellSize - origin.x) / direction.x : infinity;
+    double nextY = direction.y != 0 ? ((y + (stepY > 0)) * cellSize - origin.y) / direction.y : infinity;
+    double deltaX = direction.x != 0 ? cellSize / std::abs(direction.x) : infinity;
+    double deltaY = direction.y != 0 ? cellSize / std::abs(direction.y) : infinity;
+
+    //the walk is monotone, so the steps that reach an item follow each other
+    //and the item is visited in the first one, the one the previous step missed
+    int64_t previousX = 0, previousY = 0;
+    bool first = true;
+    auto collect = [&](const Item& item)
+    {
+        if (!first && item.cellMaxX >= previousX - reachX && item.cellMinX <= previousX + reachX && item.cellMaxY >= previousY - reachY && item.cellMinY <= previousY + reachY)
+            return;
+
+        visitor(item.value, item.min, item.max);
+    };
+
+    double entry = 0;
+    while (entry <= maxDistance)
+    {
+        for (int64_t cellX = x - reachX; cellX <= x + reachX; cellX++)
+        {
+            for (int64_t cellY = y - reachY; cellY <= y + reachY; cellY++)
+            {
+                auto cell = cells.find(getCellKey(static_cast<int32_t>(cellX), static_cast<int32_t>(cellY)));
+                if (cell != cells.end())
+                    visitCell(cell->second, cellX, cellY, x - reachX, y - reachY, collect);
+            }
+        }
+
+        previousX = x;
+        previousY = y;
+        first = false;
+
+        if (nextX < nextY)
+        {
+            entry = nextX;
+            nextX += deltaX;
+            x += stepX;
+        }
+        else
+        {
+            entry = nextY;
+            nextY += deltaY;
+            y += stepY;
+        }
+    }
+}
+
+template <typename T>
+void SpatialGrid<T>::clear()
+{
+    for (std::pair<const uint64_t, std::vector<Handle>>& cell : cells)
+        cell.second.clear();
+
+    items.clear();
+    freeItems.clear();
+    count = 0;
+}
+
+template <typename T>
+size_t SpatialGrid<T>::size() const
+{
+    return count;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "memtrace.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Egy termelő és egy fogyasztó szál közötti, zármentes, rögzített méretű sor.
+ *
+ * A sor egy gyűrűpuffer: a termelő csak a végét (`tail`), a fogyasztó csak
+ * az elejét (`head`) írja, így a műveletekhez nem kell zár, és nem
+ * foglalnak memóriát. A két index külön gyorsítótár-sorban van, hogy a két
+ * szál ne írja felváltva ugyanazt a sort.
+ *
+ * A `push` csak a termelő, a `front` és a `pop` csak a fogyasztó szálról
+ * hívható. Egyetlen szálon használva a sor egyszerű FIFO.
+ *
+ * @tparam T Az elemek típusa, másolható és alapértelmezetten létrehozható.
+ */
+template <typename T>
+class SpscQueue
+{
+    private:
+    static constexpr size_t cacheLineSize = 64; ///< A gyorsítótár-sor feltételezett mérete.
+
+    std::vector<T> buffer; ///< A gyűrűpuffer, a mérete kettő hatványa.
+    size_t mask; ///< A puffer méreténél eggyel kisebb szám az indexek maradékához.
+
+    alignas(cacheLineSize) std::atomic<size_t> head; ///< A következő kiolvasandó elem sorszáma, a fogyasztó írja.
+    alignas(cacheLineSize) std::atomic<size_t> tail; ///< A következő beírandó elem sorszáma, a termelő írja.
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    SpscQueue(const SpscQueue& queue);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    SpscQueue& operator=(const SpscQueue& queue);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres sort.
+     *
+     * @param capacity A sorban egyszerre tárolható elemek legkisebb száma,
+     * a következő kettő hatványára kerekítve.
+     * @throws std::invalid_argument Ha a kapacitás 0.
+     */
+    explicit SpscQueue(const size_t capacity);
+
+    /**
+     * @brief A sor végére tesz egy elemet. Csak a termelő szálról hívható.
+     *
+     * @param value Az elem.
+     * @return false, ha a sor tele van, és az elem nem került bele.
+     */
+    bool push(const T& value);
+
+    /**
+     * @brief Visszaadja a sor első elemét, kivétel nélkül. Csak a fogyasztó szálról hívható.
+     *
+     * @return Az első elem, vagy nullptr, ha a sor üres. A pointer a következő
+     * `pop` hívásig érvényes.
+     */
+    const T* front() const;
+
+    /**
+     * @brief Kiveszi a sor első elemét. Csak a fogyasztó szálról hívható.
+     *
+     * @param value Az első elem, csak siker esetén módosul.
+     * @return false, ha a sor üres.
+     */
+    bool pop(T& value);
+
+    /**
+     * @brief Visszaadja a sorban lévő elemek számát.
+     *
+     * Másik szál egyidejű műveletei mellett csak közelítő érték.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Visszaadja a sorban egyszerre tárolható elemek számát.
+     */
+    size_t capacity() const;
+};
+
+#include "spscqueue.inl"
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdexcept>
+
+template <typename T>
+SpscQueue<T>::SpscQueue(const size_t capacity)
+: buffer(), mask(0), head(0), tail(0)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("queue capacity must be positive");
+
+    size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    buffer.resize(size);
+    mask = size - 1;
+}
+
+template <typename T>
+bool SpscQueue<T>::push(const T& value)
+{
+    size_t position = tail.load(std::memory_order_relaxed);
+    if (position - head.load(std::memory_order_acquire) > mask)
+        return false;
+
+    buffer[position & mask] = value;
+
+    //the element is written before the consumer can see the new tail
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+const T* SpscQueue<T>::front() const
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    if (position == tail.load(std::memory_order_acquire))
+        return nullptr;
+
+    return &buffer[position & mask];
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    if (position == tail.load(std::memory_order_acquire))
+        return false;
+
+    value = buffer[position & mask];
+
+    //the slot is read before the producer can overwrite it
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+size_t SpscQueue<T>::size() const
+{
+    //the head never passes the tail, so it is read first
+    size_t first = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - first;
+}
+
+template <typename T>
+size_t SpscQueue<T>::capacity() const
+{
+    return buffer.size();
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "memtrace.h"
+
+#include "vector2.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief A szimuláció állapotából 64 bites hasht számoló osztály.
+ *
+ * Az értékek bitre pontosan kerülnek a hashbe, a hozzáadás sorrendje
+ * számít. Két futás ugyanazon lépésének hashe csak akkor egyezik, ha a
+ * szimuláció minden hozzáadott értéke egyezik, így a hash eltérése a
+ * szimulációk szétválását (desync) jelzi.
+ */
+class StateHasher
+{
+    private:
+    uint64_t state; ///< A hash belső állapota.
+
+    public:
+    /**
+     * @brief Létrehoz egy üres hasht.
+     */
+    StateHasher();
+
+    /**
+     * @brief Hozzáad egy 64 bites értéket a hashhez.
+     */
+    void add(const uint64_t value);
+
+    /**
+     * @brief Hozzáad egy lebegőpontos értéket a hashhez a bitjei alapján.
+     */
+    void add(const double value);
+
+    /**
+     * @brief Hozzáad egy lebegőpontos értéket a hashhez a bitjei alapján.
+     */
+    void add(const float value);
+
+    /**
+     * @brief Hozzáadja egy vektor két komponensét a hashhez.
+     */
+    void add(const Vector2& vector);
+
+    /**
+     * @brief Hozzáad egy logikai értéket a hashhez.
+     */
+    void add(const bool value);
+
+    /**
+     * @brief Visszaadja az eddig hozzáadott értékek hashét.
+     */
+    uint64_t getHash() const;
+};
+
+/**
+ * @brief Lépésenkénti állapothashek tömör, bináris naplója.
+ *
+ * A napló egy 8 bájtos fejlécből és lépésenként egy 8 bájtos, kis endián
+ * hashből áll, így több ezer lépés is néhány tíz kilobájt. Két napló
+ * összevetésével megkereshető az első lépés, amelyen két futás eltér,
+ * például egy többszálú vagy SIMD fizika és a soros referencia között.
+ */
+class StateHashLog
+{
+    private:
+    std::ostream& stream; ///< A napló kimenete.
+
+    StateHashLog(const StateHashLog& log);
+
+    StateHashLog& operator=(const StateHashLog& log);
+
+    public:
+    /**
+     * @brief Létrehoz egy naplót, és kiírja a fejlécét.
+     *
+     * @param stream A napló kimenete, bináris módban megnyitva.
+     */
+    explicit StateHashLog(std::ostream& stream);
+
+    /**
+     * @brief Hozzáfűzi a következő lépés hashét a naplóhoz.
+     *
+     * @param hash A lépés hashe.
+     */
+    void append(const uint64_t hash);
+
+    /**
+     * @brief Beolvas egy naplót.
+     *
+     * @param stream A napló bemenete, bináris módban megnyitva.
+     * @return A lépések hashei sorrendben.
+     * @throws std::runtime_error Ha a bemenet nem állapothash napló.
+     */
+    static std::vector<uint64_t> read(std::istream& stream);
+
+    /**
+     * @brief Megkeresi az első lépést, amelyen két napló eltér.
+     *
+     * @return Az első eltérő lépés sorszáma. Ha az egyik napló a másik
+     * eleje, a rövidebb hossza, azonos naplók esetén `SIZE_MAX`.
+     */
+    static size_t findFirstMismatch(const std::vector<uint64_t>& log1, const std::vector<uint64_t>& log2);
+
+    /**
+     * @brief A naplók parancssori összehasonlításának belépési pontja.
+     *
+     * @param argc A paraméterek száma, két fájlnév várható.
+     * @param argv A paraméterek.
+     * @return 0, ha a két napló egyezik, különben 1.
+     */
+    static int runCommandLine(const int argc, const char* const argv[]);
+};
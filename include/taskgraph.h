@@ -0,0 +1,134 @@
+#pragma once
+#include "memtrace.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief Függőségekkel összekötött feladatok irányított, körmentes gráfja.
+ *
+ * A feladatokat az `addTask`, a köztük lévő sorrendet az `addDependency`
+ * metódussal lehet megadni. A `run` minden feladatot egyszer hajt végre úgy,
+ * hogy egy feladat csak a függőségei befejeződése után indul. Szálkészlettel
+ * a független feladatok párhuzamosan futnak, anélkül a hívó szálon, a kész
+ * feladatok közül mindig a legkisebb sorszámúval folytatva.
+ *
+ * A gráf minden futáskor feladatonként méri a végrehajtás idejét.
+ */
+class TaskGraph
+{
+    private:
+    /**
+     * @brief Egy feladat és a hozzá tartozó függőségek.
+     */
+    struct Task
+    {
+        std::string name; ///< A feladat neve a mérésekhez.
+        std::function<void()> function; ///< A végrehajtandó függvény.
+        std::vector<size_t> dependents; ///< Az erre a feladatra váró feladatok sorszámai.
+        size_t dependencyCount = 0; ///< A feladat függőségeinek száma.
+        uint64_t time = 0; ///< A legutóbbi végrehajtás ideje nanoszekundumban.
+    };
+
+    /**
+     * @brief Egy szálkészlettel indított futás közös állapota.
+     */
+    struct PoolRun;
+
+    std::vector<Task> tasks; ///< A feladatok, a sorszámuk szerint.
+
+    /**
+     * @brief Megadja, hogy a feladat függőségein keresztül elérhető-e a másik feladat.
+     */
+    bool reaches(const size_t from, const size_t to) const;
+
+    /**
+     * @brief Végrehajtja a feladatot, és feljegyzi a végrehajtás idejét.
+     */
+    void execute(Task& task);
+
+    /**
+     * @brief Beküldi a feladatot a futás szálkészletébe.
+     */
+    void launch(PoolRun& run, const size_t index);
+
+    /**
+     * @brief Végrehajtja a szálkészletbe beküldött feladatot, és elindítja a rá váró kész feladatokat.
+     */
+    void runLaunched(PoolRun& run, const size_t index);
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    TaskGraph(const TaskGraph& graph);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    TaskGraph& operator=(const TaskGraph& graph);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres gráfot.
+     */
+    TaskGraph();
+
+    /**
+     * @brief Hozzáad egy feladatot a gráfhoz.
+     *
+     * @param name A feladat neve a mérésekhez.
+     * @param function A végrehajtandó függvény.
+     * @return A feladat sorszáma.
+     */
+    size_t addTask(const std::string& name, const std::function<void()>& function);
+
+    /**
+     * @brief Előírja, hogy a feladat csak a függősége befejeződése után induljon.
+     *
+     * @param task A várakozó feladat sorszáma.
+     * @param dependency A függőség sorszáma.
+     * @throws std::out_of_range Ha valamelyik sorszám érvénytelen.
+     * @throws std::invalid_argument Ha a függőség kört zárna be.
+     */
+    void addDependency(const size_t task, const size_t dependency);
+
+    /**
+     * @brief Végrehajtja a gráf összes feladatát a függőségek szerinti sorrendben.
+     *
+     * Ha egy feladat kivételt dob, utána új feladat nem indul, a már futók
+     * befejeződnek, és a metódus továbbdobja az első kivételt.
+     *
+     * @param pool A szálkészlet a független feladatok párhuzamos végrehajtásához,
+     * vagy nullptr a hívó szálon való végrehajtáshoz.
+     */
+    void run(ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Törli az összes feladatot.
+     */
+    void clear();
+
+    /**
+     * @brief Visszaadja a feladatok számát.
+     */
+    size_t getTaskCount() const;
+
+    /**
+     * @brief Visszaadja a feladat nevét.
+     *
+     * @throws std::out_of_range Ha a sorszám érvénytelen.
+     */
+    const std::string& getTaskName(const size_t task) const;
+
+    /**
+     * @brief Visszaadja a feladat legutóbbi végrehajtásának idejét nanoszekundumban.
+     *
+     * @throws std::out_of_range Ha a sorszám érvénytelen.
+     */
+    uint64_t getTaskTime(const size_t task) const;
+};
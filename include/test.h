@@ -10,9 +10,31 @@ class TestRunner
 
     static void runTransformTests();
 
+    static void runTransformHierarchyTests();
+
     static void runColliderTests();
 
+    static void runSpatialGridTests();
+
     static void runPhysicsTests();
 
+    static void runWorldTests();
+
     static void runMapTests();
+
+    static void runBotTests();
+
+    static void runNetplayTests();
+
+    static void runInputTests();
+
+    static void runRenderTests();
+
+    static void runTaskGraphTests();
+
+    static void runArenaTests();
+
+    static void runAllocationTests();
+
+    static void runLogTests();
 };
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+#include "memtrace.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Szövegfeldolgozási hiba, amely a hiba pontos helyét is tárolja.
+ */
+class ParseError : public std::runtime_error
+{
+    private:
+    size_t line; ///< A hiba sora (1-től számozva).
+    size_t column; ///< A hiba oszlopa (1-től számozva).
+
+    public:
+    /**
+     * @brief Létrehoz egy `ParseError` objektumot.
+     *
+     * Az üzenet elé a hiba helye kerül `sor:oszlop: ` formában.
+     *
+     * @param message A hiba leírása.
+     * @param line A hiba sora.
+     * @param column A hiba oszlopa.
+     */
+    ParseError(const std::string& message, const size_t line, const size_t column);
+
+    /**
+     * @brief Visszaadja a hiba sorát.
+     */
+    size_t getLine() const;
+
+    /**
+     * @brief Visszaadja a hiba oszlopát.
+     */
+    size_t getColumn() const;
+};
+
+/**
+ * @brief Szóközökkel elválasztott számokat olvasó osztály.
+ *
+ * A `TextReader` egy memóriában lévő szövegből olvas számokat `std::from_chars`
+ * segítségével, így az `std::istream`-mel ellentétben nem függ a locale-tól, és
+ * nem foglal memóriát. Elválasztóként a szóközt, a tabulátort és a soremelést
+ * (`\n` és `\r\n`) fogadja el, és számon tartja az aktuális sort és oszlopot,
+ * így a hibák pontos helye jelezhető.
+ *
+ * Az olvasó nem másolja a szöveget, annak az olvasó élettartama alatt
+ * érvényesnek kell maradnia.
+ */
+class TextReader
+{
+    private:
+    const char* current; ///< Az olvasás aktuális helye.
+    const char* end; ///< A szöveg vége.
+    size_t line; ///< Az aktuális sor (1-től számozva).
+    size_t column; ///< Az aktuális oszlop (1-től számozva).
+
+    /**
+     * @brief Átlépi az elválasztó karaktereket.
+     */
+    void skipWhitespace();
+
+    /**
+     * @brief Megkeresi a következő szám végét, és hibát dob, ha nincs több szám.
+     *
+     * @param what Az elvárt érték megnevezése a hibaüzenethez.
+     * @return A szám utáni első karakter.
+     */
+    const char* findTokenEnd(const char* what);
+
+    /**
+     * @brief Hibát dob, ha a szám nem értelmezhető, különben a szám után lép.
+     */
+    void finishToken(const char* tokenEnd, const char* parsedEnd, const bool valid, const char* what);
+
+    public:
+    /**
+     * @brief Létrehoz egy `TextReader` objektumot a megadott szöveghez.
+     *
+     * @param text A feldolgozandó szöveg.
+     */
+    explicit TextReader(const std::string& text);
+
+    /**
+     * @brief Megadja, hogy a szövegben van-e még szám.
+     *
+     * Az elválasztó karaktereket átlépi.
+     */
+    bool atEnd();
+
+    /**
+     * @brief Beolvas egy valós számot.
+     *
+     * @param what Az elvárt érték megnevezése a hibaüzenethez.
+     * @return A beolvasott szám.
+     * @throws ParseError Ha a szöveg véget ért, vagy a következő szó nem valós szám.
+     */
+    double readDouble(const char* what);
+
+    /**
+     * @brief Beolvas egy egész számot.
+     *
+     * @param what Az elvárt érték megnevezése a hibaüzenethez.
+     * @return A beolvasott szám.
+     * @throws ParseError Ha a szöveg véget ért, vagy a következő szó nem egész szám.
+     */
+    int readInt(const char* what);
+
+    /**
+     * @brief Visszaadja az aktuális sort.
+     */
+    size_t getLine() const;
+
+    /**
+     * @brief Visszaadja az aktuális oszlopot.
+     */
+    size_t getColumn() const;
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include "memtrace.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Rögzített számú munkaszálból álló szálkészlet.
+ *
+ * A `submit` metódussal beküldött feladatokat a munkaszálak a beküldés
+ * sorrendjében veszik ki a közös sorból. A feladatokra váró szál a
+ * `runPending` metódussal maga is végrehajthat feladatokat, így a készlet
+ * feladataiból indított és bevárt részfeladatok sem akadnak el, akkor sem,
+ * ha minden munkaszál vár.
+ */
+class ThreadPool
+{
+    private:
+    std::vector<std::thread> threads; ///< A munkaszálak.
+    std::vector<std::function<void()>> tasks; ///< A még el nem kezdett feladatok körkörös sora.
+    size_t firstTask; ///< A sor elején álló feladat helye.
+    size_t taskCount; ///< A sorban álló feladatok száma.
+    std::mutex mutex; ///< A feladatok sorát és a leállítást védő zár.
+    std::condition_variable available; ///< Jelez, ha új feladat érkezett, vagy a készlet leáll.
+    bool stopping; ///< Jelzi, hogy a készlet leáll.
+
+    /**
+     * @brief A munkaszálak ciklusa, a leállításig végrehajtja a sor feladatait.
+     */
+    void work();
+
+    /**
+     * @brief A sor végére teszi a feladatot, a zárat a hívó tartja.
+     *
+     * A sor helyei újrahasznosulnak, így a kis feladatok beküldése a sor
+     * bővülése után nem foglal memóriát.
+     */
+    void pushTask(const std::function<void()>& task);
+
+    /**
+     * @brief Kiveszi a sor elején álló feladatot, a zárat a hívó tartja.
+     *
+     * @return false, ha a sor üres.
+     */
+    bool popTask(std::function<void()>& task);
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    ThreadPool(const ThreadPool& pool);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    ThreadPool& operator=(const ThreadPool& pool);
+
+    public:
+    /**
+     * @brief Elindítja a munkaszálakat.
+     *
+     * @param threadCount A munkaszálak száma.
+     * @throws std::invalid_argument Ha a szálak száma 0.
+     */
+    explicit ThreadPool(const size_t threadCount);
+
+    /**
+     * @brief Megvárja a sorban lévő feladatokat, majd leállítja a munkaszálakat.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Beküld egy feladatot a munkaszálaknak.
+     *
+     * A feladat nem dobhat kivételt, a kivételeket a beküldőnek kell
+     * elkapnia és továbbítania.
+     *
+     * @param task A feladat.
+     */
+    void submit(const std::function<void()>& task);
+
+    /**
+     * @brief Végrehajtja a sor első feladatát a hívó szálon, ha van ilyen.
+     *
+     * @return false, ha a sor üres volt.
+     */
+    bool runPending();
+
+    /**
+     * @brief Végrehajtja a törzset a `0 .. count - 1` indexekkel, párhuzamosan.
+     *
+     * Az első indexet a hívó szál hajtja végre, a többit a munkaszálak, és a
+     * hívó a várakozás alatt a sor többi feladatát is végrehajtja. Ha
+     * valamelyik index kivételt dob, a többi végigfut, és az első kivételt
+     * a metódus továbbdobja.
+     *
+     * @param count Az indexek száma.
+     * @param body A törzs, amely az indexet kapja.
+     */
+    void parallelFor(const size_t count, const std::function<void(size_t)>& body);
+
+    /**
+     * @brief Visszaadja a munkaszálak számát.
+     */
+    size_t getThreadCount() const;
+};
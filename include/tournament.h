@@ -0,0 +1,110 @@
+#pragma once
+#include "memtrace.h"
+
+#include "mapmanager.h"
+#include "playercontroller.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Botok közötti, megjelenítés nélküli mérkőzéseket futtató osztály.
+ *
+ * A `Tournament` sok rövid kört játszat le a botok között az összes pályán,
+ * párhuzamosan, szálanként külön `World`-ben. Minden kör egy pályán két
+ * bot között zajlik az első halálig, vagy amíg le nem telik a megadott idő.
+ * Az eredmény a botok győzelmi aránya és a szimuláció átviteli sebessége
+ * (fizikai lépés másodpercenként), így a torna egyszerre balanszeszköz és
+ * tartós terheléses benchmark.
+ *
+ * A körök egymástól függetlenek, a botok seedje a kör sorszámából adódik,
+ * ezért az eredmény a szálak számától függetlenül ugyanaz.
+ */
+class Tournament
+{
+    public:
+    /**
+     * @brief A torna paraméterei.
+     */
+    struct Settings
+    {
+        size_t rounds = 1000; ///< A lejátszandó körök száma.
+        size_t threads = 0; ///< A szálak száma, 0 esetén a processzormagok száma.
+        size_t maxTicks = 6000; ///< Egy kör leghosszabb ideje fizikai lépésekben, utána döntetlen.
+        double physicsRate = 100; ///< A fizikai szimulációk rátája.
+        double aspectRatio = 16.0 / 9.0; ///< A pálya szélességének és magasságának aránya, mint a játék ablakában.
+        uint64_t seed = 1; ///< A botok véletlenszám-generátorainak kezdőértéke.
+        std::vector<std::string> bots = {"chase", "random", "scripted"}; ///< A résztvevő botok neve.
+    };
+
+    /**
+     * @brief Egy bot eredménye.
+     */
+    struct BotResult
+    {
+        std::string name; ///< A bot neve.
+        size_t rounds = 0; ///< A lejátszott körök száma.
+        size_t wins = 0; ///< A megnyert körök száma.
+        size_t losses = 0; ///< Az elvesztett körök száma.
+        size_t ties = 0; ///< A döntetlen körök száma.
+    };
+
+    /**
+     * @brief A torna eredménye.
+     */
+    struct Result
+    {
+        size_t rounds = 0; ///< A lejátszott körök száma.
+        size_t threads = 0; ///< A felhasznált szálak száma.
+        size_t ticks = 0; ///< Az összes lefuttatott fizikai lépés.
+        size_t timeouts = 0; ///< Az időtúllépéssel döntetlenül végződő körök száma.
+        double seconds = 0; ///< A torna futási ideje.
+        std::vector<BotResult> bots; ///< A botok eredménye a beállítások sorrendjében.
+
+        /**
+         * @brief Visszaadja a másodpercenként lefuttatott fizikai lépések számát.
+         */
+        double getTicksPerSecond() const;
+    };
+
+    /**
+     * @brief Létrehoz egy botot a neve alapján.
+     *
+     * Az ismert nevek: `chase`, `random`, `scripted`, `idle`.
+     *
+     * @param name A bot neve.
+     * @param seed A bot véletlenszám-generátorának kezdőértéke.
+     * @return A bot.
+     * @throws std::invalid_argument Ha a név ismeretlen.
+     */
+    static std::unique_ptr<PlayerController> createController(const std::string& name, const uint64_t seed);
+
+    /**
+     * @brief Lejátssza a tornát.
+     *
+     * Futás előtt a hívó szálon előkészíti az összes pályát, a körök alatt
+     * a pályakezelőt csak olvassa.
+     *
+     * @param maps A pályák.
+     * @param settings A torna paraméterei.
+     * @return A torna eredménye.
+     * @throws std::invalid_argument Ha a paraméterek érvénytelenek, vagy nincs pálya.
+     */
+    static Result run(MapManager& maps, const Settings& settings);
+
+    /**
+     * @brief A parancssori torna belépési pontja.
+     *
+     * A paraméterek `kulcs=érték` alakúak: `rounds`, `threads`, `ticks`,
+     * `rate`, `seed`, `bots` (vesszővel elválasztott nevek). A pályák a
+     * játékhoz hasonlóan az aktuális mappából töltődnek be.
+     *
+     * @param argc A paraméterek száma.
+     * @param argv A paraméterek.
+     * @return 0 siker esetén, különben 1.
+     */
+    static int runCommandLine(const int argc, const char* const argv[]);
+};
@@ -1,138 +1,10 @@
 #pragma once
 #include "memtrace.h"
 
-#include <vector>
-
-/**
- * @brief Két dimenziós vektort reprezentáló struktúra.
- * 
- * A `Vector2` struktúra X és Y komponensekkel rendelkező vektorokat reprezentál,
- * amelyeket pozíciók, méretek vagy sebességek tárolására használhatunk.
- * Támogatja az alapvető matematikai műveleteket, például összeadást, kivonást,
- * szorzást és osztást.
- */
-struct Vector2
-{
-    double x; ///< A vektor X komponense.
-    double y; ///< A vektor Y komponense.
-
-    /**
-     * @brief Alapértelmezett konstruktor, amely (0, 0) értékekkel inicializálja a vektort.
-     */
-    Vector2();
+#include "framearena.h"
+#include "vector2.h"
 
-    /**
-     * @brief Konstruktor, amely a megadott X és Y értékekkel inicializálja a vektort.
-     * 
-     * @param x A vektor X komponense.
-     * @param y A vektor Y komponense.
-     */
-    Vector2(const double x, const double y);
-
-    /**
-     * @brief Hozzáad egy másik vektort ehhez a vektorhoz.
-     * 
-     * @param other A hozzáadandó vektor.
-     * @return Az aktuális vektor referenciája.
-     */
-    Vector2& operator+=(const Vector2& other);
-
-    /**
-     * @brief Két vektor összeadása.
-     * 
-     * @param other A hozzáadandó vektor.
-     * @return Az összeadás eredményeként kapott új vektor.
-     */
-    Vector2 operator+(const Vector2& other) const;
-
-    /**
-     * @brief Kivon egy másik vektort ebből a vektorból.
-     * 
-     * @param other A kivonandó vektor.
-     * @return Az aktuális vektor referenciája.
-     */
-    Vector2& operator-=(const Vector2& other);
-
-    /**
-     * @brief Két vektor kivonása.
-     * 
-     * @param other A kivonandó vektor.
-     * @return A kivonás eredményeként kapott új vektor.
-     */
-    Vector2 operator-(const Vector2& other) const;
-
-    /**
-     * @brief Megszorozza a vektort egy skalárral.
-     * 
-     * @param scalar A szorzó értéke.
-     * @return Az aktuális vektor referenciája.
-     */
-    Vector2& operator*=(const double scalar);
-
-    /**
-     * @brief Egy vektor és egy skalár szorzása.
-     * 
-     * @param scalar A szorzó értéke.
-     * @return Az új vektor, amely a szorzás eredménye.
-     */
-    Vector2 operator*(const double scalar) const;
-
-    /**
-     * @brief Elosztja a vektort egy skalárral.
-     * 
-     * @param scalar Az osztó értéke.
-     * @return Az aktuális vektor referenciája.
-     */
-    Vector2& operator/=(const double scalar);
-
-    /**
-     * @brief Egy vektor és egy skalár osztása.
-     * 
-     * @param scalar Az osztó értéke.
-     * @return Az új vektor, amely az osztás eredménye.
-     */
-    Vector2 operator/(const double scalar) const;
-
-    /**
-     * @brief Összehasonlítja ezt a vektort egy másikkal.
-     * 
-     * @param other A másik vektor, amellyel összehasonlítjuk.
-     * @return true, ha a két vektor egyenlő, különben false.
-     */
-    bool operator==(const Vector2& other) const; 
-
-    /**
-     * @brief Összehasonlítja ezt a vektort egy másikkal.
-     * 
-     * @param other A másik vektor, amellyel összehasonlítjuk.
-     * @return true, ha a két vektor nem egyenlő, különben false.
-     */
-    bool operator!=(const Vector2& other) const;
-
-    /**
-     * @brief Egy vektor megfordítása.
-     * 
-     * @return A megfordított vektor.
-     */
-    Vector2 operator-() const; 
-
-    /**
-     * @brief Kiszámolja a vektor hosszát.
-     * 
-     * @return A vektor hossza.
-     */
-    double length() const;
-
-    /**
-     * @brief Normalizálja a vektort.
-     * 
-     * A normalizálás során a vektor hosszát 1-re állítja, miközben megőrzi
-     * az irányát. Ha a vektor hossza 0, akkor a normalizálás nem hajtható végre.
-     * 
-     * @return A normalizált vektor.
-     */
-    Vector2 normalize() const; 
-};
+#include <vector>
 
 /**
  * @brief Hierarchikus transzformációkat kezelő osztály.
@@ -150,6 +22,12 @@ class Transform
     Transform* parent; ///< Az objektum szülője a hierarchiában.
     std::vector<Transform*> children; ///< Az objektum gyermekei a hierarchiában.
 
+    public:
+    class ChildListCache;
+
+    private:
+    static thread_local ChildListCache* activeChildLists; ///< A szálon éppen használt gyermeklista-tár, nullptr esetén nincs újrahasznosítás.
+
     /**
      * @brief Gyermek hozzáadása az objektumhoz.
      * 
@@ -172,6 +50,26 @@ class Transform
      */
     void removeChild(Transform* const child);
 
+    /**
+     * @brief Gyermek lecserélése egy másik objektumra ugyanazon a helyen.
+     * 
+     * Metódus csak belső használatra, mozgatáskor.
+     * 
+     * @param oldChild A lecserélendő gyermek.
+     * @param newChild Az új gyermek.
+     */
+    void replaceChild(Transform* const oldChild, Transform* const newChild);
+
+    /**
+     * @brief Átveszi egy másik objektum helyét a hierarchiában és a gyermekeit.
+     * 
+     * Metódus csak belső használatra, az aktuális objektumnak nem lehet
+     * szülője és gyermeke.
+     * 
+     * @param transform A mozgatandó objektum.
+     */
+    void takeHierarchy(Transform& transform);
+
     public:
     /**
      * @brief Konstruktor.
@@ -213,6 +111,30 @@ class Transform
      */
     Transform& operator=(const Transform& transform);
 
+    /**
+     * @brief Mozgató konstruktor.
+     * 
+     * Az új objektum átveszi a régi pozícióját, méretét, a helyét a szülő
+     * gyermekei között és a gyermekeit is. A gyermekek szülője az új objektum
+     * lesz, a globális transzformációjuk nem változik. A régi objektum szülő
+     * és gyermekek nélkül marad.
+     * 
+     * @param transform A mozgatandó `Transform` objektum.
+     */
+    Transform(Transform&& transform) noexcept;
+
+    /**
+     * @brief Mozgató értékadás operátor.
+     * 
+     * Az aktuális objektum elengedi a saját gyermekeit, mint a destruktor,
+     * majd a mozgató konstruktorhoz hasonlóan átveszi a másik objektum
+     * helyét a hierarchiában és a gyermekeit.
+     * 
+     * @param transform A mozgatandó `Transform` objektum.
+     * @return Az aktuális objektum referenciája.
+     */
+    Transform& operator=(Transform&& transform) noexcept;
+
     /**
      * @brief Destruktor.
      * 
@@ -348,6 +270,118 @@ class Transform
      */
     template <typename T>
     std::vector<T*> findTypeInChildren();
+
+    /**
+     * @brief Keres egy adott típusú objektumot a gyermekek között.
+     * 
+     * A lépésenként ismételt kereséshez készült: a lista kapacitása
+     * megmarad, a bejárás pedig lépésen belül a szál területéből foglal.
+     * 
+     * @tparam T A keresett objektum típusa.
+     * @param found Az adott típusú objektumok listája, a korábbi tartalma törlődik.
+     */
+    template <typename T>
+    void findTypeInChildren(std::vector<T*>& found);
+};
+
+/**
+ * @brief Megszűnt objektumok gyermeklistáinak korlátos tára.
+ *
+ * Amíg egy `Scope` aktív, a szálon megszűnő objektumok a gyermeklistájuk
+ * kapacitását a tárba adják, az először gyermeket kapó objektumok pedig
+ * innen kapnak listát, így a gyakran újraépített hierarchiák (például a
+ * pálya falai) bemelegedés után nem foglalnak memóriát.
+ *
+ * A tár legfeljebb `limit` listát tart meg, és csak a `reserve` által
+ * előre lefoglalt helyre tesz listát, így a destruktorok nem foglalnak
+ * memóriát. A listák a tár megszűnésekor vagy `clear` híváskor szabadulnak fel.
+ */
+class Transform::ChildListCache
+{
+    private:
+    std::vector<std::vector<Transform*>> lists; ///< A megtartott üres listák.
+    size_t limit; ///< A megtartott listák legnagyobb száma.
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    ChildListCache(const ChildListCache& cache);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    ChildListCache& operator=(const ChildListCache& cache);
+
+    public:
+    /**
+     * @brief A tárat a létrehozó szálon aktiváló objektum, a megszűnésekor az előző tár lesz aktív.
+     */
+    class Scope
+    {
+        private:
+        ChildListCache* previous; ///< A korábban aktív tár.
+
+        /**
+         * @brief Másoló konstruktor tiltása.
+         */
+        Scope(const Scope& scope);
+
+        /**
+         * @brief Értékadás tiltása.
+         */
+        Scope& operator=(const Scope& scope);
+
+        public:
+        /**
+         * @brief Aktiválja a tárat a szálon.
+         */
+        explicit Scope(ChildListCache& cache);
+
+        /**
+         * @brief Visszaállítja a korábban aktív tárat.
+         */
+        ~Scope();
+    };
+
+    /**
+     * @brief Létrehoz egy üres tárat.
+     *
+     * @param limit A megtartott listák legnagyobb száma.
+     */
+    explicit ChildListCache(const size_t limit);
+
+    /**
+     * @brief Helyet foglal legalább `count` további listának, a korláton belül.
+     *
+     * A törlések előtt kell hívni, a destruktorok csak a lefoglalt helyre tesznek listát.
+     *
+     * @param count A várhatóan megszűnő objektumok száma.
+     */
+    void reserve(const size_t count);
+
+    /**
+     * @brief Megtartja a lista kapacitását, ha van még lefoglalt hely.
+     *
+     * @param list A megszűnő objektum gyermeklistája.
+     */
+    void give(std::vector<Transform*>& list);
+
+    /**
+     * @brief Átad egy megtartott listát, ha van.
+     *
+     * @param list Az üres, kapacitás nélküli lista.
+     */
+    void take(std::vector<Transform*>& list);
+
+    /**
+     * @brief Felszabadítja a megtartott listákat.
+     */
+    void clear();
+
+    /**
+     * @brief Visszaadja a megtartott listák számát.
+     */
+    size_t size() const;
 };
 
 #include "transform.inl"
\ No newline at end of file
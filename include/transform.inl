@@ -1,27 +1,33 @@
 #pragma once
 
-#include <queue>
-
 template <typename T>
 std::vector<T*> Transform::findTypeInChildren()
 {
-    std::queue<Transform*> toCheck = std::queue<Transform*>();
     std::vector<T*> found = std::vector<T*>();
+    findTypeInChildren(found);
+    return found;
+}
+
+template <typename T>
+void Transform::findTypeInChildren(std::vector<T*>& found)
+{
+    found.clear();
 
-    toCheck.push(this);
-    while (!toCheck.empty())
+    //breadth first, the checked objects stay in the list and only the front index moves,
+    //inside a tick the list is released with the tick's arena
+    ArenaVector<Transform*> toCheck;
+
+    toCheck.push_back(this);
+    for (size_t front = 0; front < toCheck.size(); front++)
     {
-        T* target = dynamic_cast<T*>(toCheck.front());
+        Transform* current = toCheck[front];
+        T* target = dynamic_cast<T*>(current);
         if (target != nullptr)
             found.push_back(target);
 
-        for (size_t i = 0; i < toCheck.front()->countChildren(); i++)
+        for (size_t i = 0; i < current->countChildren(); i++)
         {
-            toCheck.push(toCheck.front()->getChild(i));
+            toCheck.push_back(current->getChild(i));
         }
-
-        toCheck.pop();
     }
-
-    return found;
-}
\ No newline at end of file
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include "memtrace.h"
+
+#include "vector2.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Tömbökben tárolt, indexekkel címzett transzformációs hierarchia.
+ *
+ * A `TransformHierarchy` a `Transform` osztály pointeres hierarchiájának
+ * opcionális alternatívája. A csomópontok lokális és globális pozícióját, méretét
+ * összefüggő tömbökben tárolja, szülő-gyermek előtt sorrendben, így az egész
+ * jelenet globális transzformációi egyetlen lineáris, cache-barát bejárással
+ * (`updateWorld`) számolhatók ki.
+ *
+ * A csomópontokra stabil `Handle` azonosítók hivatkoznak, amelyek a tömbök
+ * átrendezése után is érvényesek maradnak. A hierarchia szerkesztése (létrehozás,
+ * szülőváltás, törlés) konstans időben történik, a sorrend esetleges helyreállítása
+ * a következő `updateWorld` hívásra halasztódik.
+ */
+class TransformHierarchy
+{
+    public:
+    /**
+     * @brief Egy csomópont stabil azonosítója.
+     *
+     * A generációs számláló miatt egy törölt csomópont azonosítója nem válik
+     * véletlenül érvényessé, ha a helyét egy új csomópont foglalja el.
+     */
+    struct Handle
+    {
+        uint32_t slot = invalidIndex; ///< A csomópont helye az azonosító táblában.
+        uint32_t generation = 0; ///< A hely generációja a létrehozáskor.
+
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    static constexpr uint32_t invalidIndex = UINT32_MAX; ///< Érvénytelen index jelölése.
+    static const Handle invalidHandle; ///< Érvénytelen azonosító, szülő nélküli csomópontokhoz.
+
+    private:
+    /**
+     * @brief Egy azonosító tábla bejegyzés, amely a hierarchia kapcsolatait tárolja.
+     *
+     * A kapcsolatok azonosító térben vannak tárolva, így a tömbök átrendezésekor
+     * nem kell őket frissíteni.
+     */
+    struct Slot
+    {
+        uint32_t dense; ///< A csomópont indexe a tömbökben, vagy `invalidIndex` ha szabad.
+        uint32_t generation; ///< A hely aktuális generációja.
+        uint32_t parent; ///< A szülő helye.
+        uint32_t firstChild; ///< Az első gyermek helye.
+        uint32_t nextSibling; ///< A következő testvér helye.
+        uint32_t previousSibling; ///< Az előző testvér helye.
+    };
+
+    std::vector<Vector2> localPositions; ///< A csomópontok lokális pozíciói.
+    std::vector<Vector2> localScales; ///< A csomópontok lokális méretei.
+    std::vector<Vector2> worldPositions; ///< A csomópontok legutóbb kiszámolt globális pozíciói.
+    std::vector<Vector2> worldScales; ///< A csomópontok legutóbb kiszámolt globális méretei.
+    std::vector<uint32_t> parents; ///< A szülők indexe a tömbökben.
+    std::vector<uint32_t> slotOfDense; ///< A tömbök elemeihez tartozó helyek.
+
+    std::vector<Slot> slots; ///< Az azonosító tábla.
+    std::vector<uint32_t> freeSlots; ///< A felszabadult helyek listája.
+
+    std::vector<uint32_t> orderScratch; ///< Segédtömb a sorrend helyreállításához.
+
+    bool orderDirty; ///< Jelzi, hogy a szülő-gyermek előtt sorrend sérült.
+
+    /**
+     * @brief Visszaadja az azonosítóhoz tartozó helyet.
+     *
+     * @throws std::out_of_range Ha az azonosító érvénytelen.
+     */
+    uint32_t getSlot(const Handle handle) const;
+
+    /**
+     * @brief Hozzáfűzi a csomópontot a szülő gyermeklistájához.
+     */
+    void link(const uint32_t slot, const uint32_t parentSlot);
+
+    /**
+     * @brief Kiveszi a csomópontot a szülő gyermeklistájából.
+     */
+    void unlink(const uint32_t slot);
+
+    /**
+     * @brief Kiszámolja egy csomópont aktuális globális pozícióját és méretét az ősein keresztül.
+     *
+     * Szerkesztés közben használatos, amikor a tömbökben tárolt globális értékek
+     * még nem frissültek.
+     */
+    void computeWorld(const uint32_t slot, Vector2& position, Vector2& scale) const;
+
+    /**
+     * @brief Helyreállítja a szülő-gyermek előtt sorrendet a tömbökben.
+     */
+    void restoreOrder();
+
+    public:
+    /**
+     * @brief Létrehoz egy üres hierarchiát.
+     */
+    TransformHierarchy();
+
+    /**
+     * @brief Lefoglal helyet a megadott számú csomópont számára.
+     *
+     * @param capacity A csomópontok várható száma.
+     */
+    void reserve(const size_t capacity);
+
+    /**
+     * @brief Létrehoz egy új csomópontot.
+     *
+     * @param parent A szülő azonosítója, vagy `invalidHandle` ha nincs szülő.
+     * @param localPosition A csomópont lokális pozíciója.
+     * @param localScale A csomópont lokális mérete.
+     * @return Az új csomópont azonosítója.
+     * @throws std::out_of_range Ha a szülő azonosítója érvénytelen.
+     */
+    Handle create(const Handle parent = invalidHandle, const Vector2& localPosition = {0, 0}, const Vector2& localScale = {1, 1});
+
+    /**
+     * @brief Törli a csomópontot.
+     *
+     * A `Transform` destruktorához hasonlóan a gyermekek szülő nélkülivé válnak,
+     * a globális pozíciójuk és méretük megmarad.
+     *
+     * @param handle A törlendő csomópont azonosítója.
+     * @throws std::out_of_range Ha az azonosító érvénytelen.
+     */
+    void destroy(const Handle handle);
+
+    /**
+     * @brief Ellenőrzi, hogy az azonosító érvényes csomópontra mutat-e.
+     */
+    bool isValid(const Handle handle) const;
+
+    /**
+     * @brief Visszaadja a csomópontok számát.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Megváltoztatja a csomópont szülőjét.
+     *
+     * A `Transform::changeParent` metódushoz hasonlóan a globális pozíció és
+     * méret nem változik, a lokális értékek igazodnak az új szülőhöz.
+     *
+     * @param handle A csomópont azonosítója.
+     * @param parent Az új szülő azonosítója, vagy `invalidHandle`.
+     * @throws std::out_of_range Ha valamelyik azonosító érvénytelen.
+     * @throws std::invalid_argument Ha a csomópont a saját leszármazottja alá kerülne.
+     */
+    void changeParent(const Handle handle, const Handle parent);
+
+    /**
+     * @brief Visszaadja a csomópont szülőjét, vagy `invalidHandle`-t ha nincs.
+     */
+    Handle getParent(const Handle handle) const;
+
+    /**
+     * @brief Visszaadja a csomópont lokális pozícióját.
+     */
+    Vector2 getLocalPosition(const Handle handle) const;
+
+    /**
+     * @brief Visszaadja a csomópont lokális méretét.
+     */
+    Vector2 getLocalScale(const Handle handle) const;
+
+    /**
+     * @brief Beállítja a csomópont lokális pozícióját.
+     */
+    void setLocalPosition(const Handle handle, const Vector2& position);
+
+    /**
+     * @brief Beállítja a csomópont lokális méretét.
+     */
+    void setLocalScale(const Handle handle, const Vector2& scale);
+
+    /**
+     * @brief Visszaadja a csomópont globális pozícióját a legutóbbi `updateWorld` hívás szerint.
+     */
+    Vector2 getPosition(const Handle handle) const;
+
+    /**
+     * @brief Visszaadja a csomópont globális méretét a legutóbbi `updateWorld` hívás szerint.
+     */
+    Vector2 getScale(const Handle handle) const;
+
+    /**
+     * @brief Kiszámolja az összes csomópont globális pozícióját és méretét.
+     *
+     * Ha a szerkesztések megsértették a szülő-gyermek előtt sorrendet, először
+     * helyreállítja azt, majd egyetlen lineáris bejárással frissíti a globális
+     * értékeket. Tickenként egyszer érdemes meghívni.
+     */
+    void updateWorld();
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include "memtrace.h"
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Egy író és egy olvasó szál közötti, zármentes hármas puffer.
+ *
+ * Az író mindig a saját pufferét tölti, és a `publish` metódussal
+ * kicseréli a középső pufferrel. Az olvasó az `acquire` metódussal a saját
+ * pufferét cseréli ki a középsővel, ha abba azóta új állapot került. Így az
+ * író sosem vár az olvasóra, az olvasó mindig a legutóbb közzétett, teljes
+ * állapotot látja, a közbülső állapotok pedig elvesznek.
+ *
+ * A pufferek a cserék során újrahasznosulnak, így a bennük lévő tárolók
+ * kapacitása megmarad, és a folyamatos használat nem foglal memóriát.
+ *
+ * A `getWriteBuffer` és a `publish` csak az író, az `acquire` és a
+ * `getReadBuffer` csak az olvasó szálról hívható.
+ *
+ * @tparam T A pufferek típusa, alapértelmezetten létrehozható.
+ */
+template <typename T>
+class TripleBuffer
+{
+    private:
+    static constexpr size_t cacheLineSize = 64; ///< A gyorsítótár-sor feltételezett mérete.
+    static constexpr uint8_t indexMask = 3; ///< A középső puffer indexét tartalmazó bitek.
+    static constexpr uint8_t freshFlag = 4; ///< Jelzi, hogy a középső pufferbe az olvasó utolsó cseréje óta új állapot került.
+
+    T buffers[3]; ///< A három puffer.
+
+    alignas(cacheLineSize) uint8_t writeIndex; ///< Az író pufferének indexe, csak az író használja.
+    alignas(cacheLineSize) std::atomic<uint8_t> middle; ///< A középső puffer indexe és a `freshFlag` jelzés.
+    alignas(cacheLineSize) uint8_t readIndex; ///< Az olvasó pufferének indexe, csak az olvasó használja.
+
+    /**
+     * @brief Másoló konstruktor tiltása.
+     */
+    TripleBuffer(const TripleBuffer& buffer);
+
+    /**
+     * @brief Értékadás tiltása.
+     */
+    TripleBuffer& operator=(const TripleBuffer& buffer);
+
+    public:
+    /**
+     * @brief Létrehoz egy hármas puffert alapértelmezett pufferekkel.
+     */
+    TripleBuffer();
+
+    /**
+     * @brief Visszaadja az író pufferét. Csak az író szálról hívható.
+     *
+     * A puffer a korábbi cserék miatt egy régebbi állapotot tartalmaz, az
+     * írónak teljesen felül kell írnia.
+     */
+    T& getWriteBuffer();
+
+    /**
+     * @brief Közzéteszi az író pufferét. Csak az író szálról hívható.
+     *
+     * Utána a `getWriteBuffer` egy másik puffert ad vissza.
+     */
+    void publish();
+
+    /**
+     * @brief Átveszi a legutóbb közzétett állapotot, ha van újabb. Csak az olvasó szálról hívható.
+     *
+     * @return true, ha az olvasó puffere az utolsó hívás óta újabb állapotra cserélődött.
+     */
+    bool acquire();
+
+    /**
+     * @brief Visszaadja az olvasó pufferét. Csak az olvasó szálról hívható.
+     *
+     * A puffer a következő `acquire` hívásig nem változik.
+     */
+    const T& getReadBuffer() const;
+};
+
+#include "triplebuffer.inl"
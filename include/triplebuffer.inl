@@ -0,0 +1,38 @@
+#pragma once
+
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+: buffers(), writeIndex(0), middle(1), readIndex(2)
+{
+
+}
+
+template <typename T>
+T& TripleBuffer<T>::getWriteBuffer()
+{
+    return buffers[writeIndex];
+}
+
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+    //the written buffer becomes the middle one, the old middle one is written next
+    writeIndex = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+}
+
+template <typename T>
+bool TripleBuffer<T>::acquire()
+{
+    if ((middle.load(std::memory_order_relaxed) & freshFlag) == 0)
+        return false;
+
+    //only the writer sets the flag, so the exchange always takes a fresh buffer
+    readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+    return true;
+}
+
+template <typename T>
+const T& TripleBuffer<T>::getReadBuffer() const
+{
+    return buffers[readIndex];
+}
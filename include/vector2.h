@@ -0,0 +1,188 @@
+#pragma once
+#include "memtrace.h"
+
+#include <type_traits>
+
+/**
+ * @brief Két dimenziós vektort reprezentáló sablon struktúra.
+ *
+ * A `BasicVector2` struktúra X és Y komponensekkel rendelkező vektorokat reprezentál,
+ * amelyeket pozíciók, méretek vagy sebességek tárolására használhatunk.
+ * Támogatja az alapvető matematikai műveleteket, például összeadást, kivonást,
+ * szorzást és osztást.
+ *
+ * A struktúra teljes egészében a fejlécben van definiálva (`vector2.inl`), így
+ * a műveletek minden fordítási egységben inline-olhatók, és a `length`,
+ * `normalize` kivételével `constexpr` kifejezésekben is használhatók.
+ *
+ * @tparam T A komponensek skalár típusa (`float` vagy `double`).
+ */
+template <typename T>
+struct BasicVector2
+{
+    static_assert(std::is_floating_point<T>::value, "BasicVector2 requires a floating point scalar type");
+
+    using Scalar = T; ///< A komponensek skalár típusa.
+
+    T x; ///< A vektor X komponense.
+    T y; ///< A vektor Y komponense.
+
+    /**
+     * @brief Alapértelmezett konstruktor, amely (0, 0) értékekkel inicializálja a vektort.
+     */
+    constexpr BasicVector2() noexcept;
+
+    /**
+     * @brief Konstruktor, amely a megadott X és Y értékekkel inicializálja a vektort.
+     *
+     * Tetszőleges aritmetikai típusú értékeket elfogad, és a vektor skalár
+     * típusára konvertálja őket, így a `{0, -9.81}` alakú inicializálás
+     * `float` és `double` alapú vektor esetén is működik.
+     *
+     * @param x A vektor X komponense.
+     * @param y A vektor Y komponense.
+     */
+    template <typename U, typename V,
+              typename = std::enable_if_t<std::is_arithmetic<U>::value && std::is_arithmetic<V>::value>>
+    constexpr BasicVector2(const U x, const V y) noexcept;
+
+    /**
+     * @brief Konvertáló konstruktor más skalár típusú vektorról.
+     *
+     * @param other Az átkonvertálandó vektor.
+     */
+    template <typename U>
+    constexpr explicit BasicVector2(const BasicVector2<U>& other) noexcept;
+
+    /**
+     * @brief Hozzáad egy másik vektort ehhez a vektorhoz.
+     *
+     * @param other A hozzáadandó vektor.
+     * @return Az aktuális vektor referenciája.
+     */
+    constexpr BasicVector2& operator+=(const BasicVector2& other) noexcept;
+
+    /**
+     * @brief Két vektor összeadása.
+     *
+     * @param other A hozzáadandó vektor.
+     * @return Az összeadás eredményeként kapott új vektor.
+     */
+    constexpr BasicVector2 operator+(const BasicVector2& other) const noexcept;
+
+    /**
+     * @brief Kivon egy másik vektort ebből a vektorból.
+     *
+     * @param other A kivonandó vektor.
+     * @return Az aktuális vektor referenciája.
+     */
+    constexpr BasicVector2& operator-=(const BasicVector2& other) noexcept;
+
+    /**
+     * @brief Két vektor kivonása.
+     *
+     * @param other A kivonandó vektor.
+     * @return A kivonás eredményeként kapott új vektor.
+     */
+    constexpr BasicVector2 operator-(const BasicVector2& other) const noexcept;
+
+    /**
+     * @brief Megszorozza a vektort egy skalárral.
+     *
+     * @param scalar A szorzó értéke.
+     * @return Az aktuális vektor referenciája.
+     */
+    constexpr BasicVector2& operator*=(const T scalar) noexcept;
+
+    /**
+     * @brief Egy vektor és egy skalár szorzása.
+     *
+     * @param scalar A szorzó értéke.
+     * @return Az új vektor, amely a szorzás eredménye.
+     */
+    constexpr BasicVector2 operator*(const T scalar) const noexcept;
+
+    /**
+     * @brief Elosztja a vektort egy skalárral.
+     *
+     * @param scalar Az osztó értéke.
+     * @return Az aktuális vektor referenciája.
+     */
+    constexpr BasicVector2& operator/=(const T scalar) noexcept;
+
+    /**
+     * @brief Egy vektor és egy skalár osztása.
+     *
+     * @param scalar Az osztó értéke.
+     * @return Az új vektor, amely az osztás eredménye.
+     */
+    constexpr BasicVector2 operator/(const T scalar) const noexcept;
+
+    /**
+     * @brief Összehasonlítja ezt a vektort egy másikkal.
+     *
+     * @param other A másik vektor, amellyel összehasonlítjuk.
+     * @return true, ha a két vektor egyenlő, különben false.
+     */
+    constexpr bool operator==(const BasicVector2& other) const noexcept;
+
+    /**
+     * @brief Összehasonlítja ezt a vektort egy másikkal.
+     *
+     * @param other A másik vektor, amellyel összehasonlítjuk.
+     * @return true, ha a két vektor nem egyenlő, különben false.
+     */
+    constexpr bool operator!=(const BasicVector2& other) const noexcept;
+
+    /**
+     * @brief Egy vektor megfordítása.
+     *
+     * @return A megfordított vektor.
+     */
+    constexpr BasicVector2 operator-() const noexcept;
+
+    /**
+     * @brief Kiszámolja a vektor hosszának négyzetét.
+     *
+     * Gyökvonás nélkül számol, így hosszak összehasonlítására olcsóbb,
+     * mint a `length`.
+     *
+     * @return A vektor hosszának négyzete.
+     */
+    constexpr T sqrLength() const noexcept;
+
+    /**
+     * @brief Kiszámolja a vektor hosszát.
+     *
+     * @return A vektor hossza.
+     */
+    T length() const noexcept;
+
+    /**
+     * @brief Normalizálja a vektort.
+     *
+     * A normalizálás során a vektor hosszát 1-re állítja, miközben megőrzi
+     * az irányát. Ha a vektor hossza 0, akkor a normalizálás nem hajtható végre.
+     *
+     * @return A normalizált vektor.
+     */
+    BasicVector2 normalize() const noexcept;
+};
+
+/**
+ * @brief A motor által használt skalár típus.
+ *
+ * Alapértelmezés szerint `double`, a `VECTOR2_FLOAT32` makró definiálásával
+ * `float` alapú (32 bites) build készíthető.
+ */
+#ifdef VECTOR2_FLOAT32
+using VectorScalar = float;
+#else
+using VectorScalar = double;
+#endif
+
+using Vector2 = BasicVector2<VectorScalar>; ///< A motor alapértelmezett vektor típusa.
+using Vector2f = BasicVector2<float>; ///< 32 bites lebegőpontos vektor.
+using Vector2d = BasicVector2<double>; ///< 64 bites lebegőpontos vektor.
+
+#include "vector2.inl"
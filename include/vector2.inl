@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cmath>
+
+template <typename T>
+constexpr BasicVector2<T>::BasicVector2() noexcept : x(0), y(0)
+{
+
+}
+
+template <typename T>
+template <typename U, typename V, typename>
+constexpr BasicVector2<T>::BasicVector2(const U x, const V y) noexcept : x(static_cast<T>(x)), y(static_cast<T>(y))
+{
+
+}
+
+template <typename T>
+template <typename U>
+constexpr BasicVector2<T>::BasicVector2(const BasicVector2<U>& other) noexcept : x(static_cast<T>(other.x)), y(static_cast<T>(other.y))
+{
+
+}
+
+template <typename T>
+constexpr BasicVector2<T>& BasicVector2<T>::operator+=(const BasicVector2& other) noexcept
+{
+    x += other.x;
+    y += other.y;
+
+    return *this;
+}
+template <typename T>
+constexpr BasicVector2<T> BasicVector2<T>::operator+(const BasicVector2& other) const noexcept
+{
+    return BasicVector2(x + other.x, y + other.y);
+}
+
+template <typename T>
+constexpr BasicVector2<T>& BasicVector2<T>::operator-=(const BasicVector2& other) noexcept
+{
+    x -= other.x;
+    y -= other.y;
+
+    return *this;
+}
+template <typename T>
+constexpr BasicVector2<T> BasicVector2<T>::operator-(const BasicVector2& other) const noexcept
+{
+    return BasicVector2(x - other.x, y - other.y);
+}
+
+template <typename T>
+constexpr BasicVector2<T>& BasicVector2<T>::operator*=(const T scalar) noexcept
+{
+    x *= scalar;
+    y *= scalar;
+
+    return *this;
+}
+template <typename T>
+constexpr BasicVector2<T> BasicVector2<T>::operator*(const T scalar) const noexcept
+{
+    return BasicVector2(x * scalar, y * scalar);
+}
+
+template <typename T>
+constexpr BasicVector2<T>& BasicVector2<T>::operator/=(const T scalar) noexcept
+{
+    x /= scalar;
+    y /= scalar;
+
+    return *this;
+}
+template <typename T>
+constexpr BasicVector2<T> BasicVector2<T>::operator/(const T scalar) const noexcept
+{
+    return BasicVector2(x / scalar, y / scalar);
+}
+
+template <typename T>
+constexpr bool BasicVector2<T>::operator==(const BasicVector2& other) const noexcept
+{
+    return (x == other.x && y == other.y);
+}
+
+template <typename T>
+constexpr bool BasicVector2<T>::operator!=(const BasicVector2& other) const noexcept
+{
+    return !(*this == other);
+}
+
+template <typename T>
+constexpr BasicVector2<T> BasicVector2<T>::operator-() const noexcept
+{
+    return BasicVector2(-x, -y);
+}
+
+template <typename T>
+constexpr T BasicVector2<T>::sqrLength() const noexcept
+{
+    return x * x + y * y;
+}
+
+template <typename T>
+T BasicVector2<T>::length() const noexcept
+{
+    return std::sqrt(sqrLength());
+}
+
+template <typename T>
+BasicVector2<T> BasicVector2<T>::normalize() const noexcept
+{
+    T len = length();
+    if (len == 0) return BasicVector2(0, 0);
+    return BasicVector2(x / len, y / len);
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "memtrace.h"
+
+#include "vector2.h"
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VECTOR2_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief SSE2 regiszterbe csomagolt vektorokat reprezentáló sablon struktúra.
+ *
+ * A `PackedVector2` egyszerre `width` darab egymás után tárolt `BasicVector2`
+ * értéket kezel egyetlen 128 bites regiszterben: `double` esetén egy, `float`
+ * esetén két vektort. SSE2 támogatás hiányában egyetlen vektort tartalmazó,
+ * skalár műveletekkel dolgozó változat kerül használatra.
+ *
+ * A struktúra a `Vector2Batch` tömbös műveleteinek építőköve.
+ *
+ * @tparam T A komponensek skalár típusa (`float` vagy `double`).
+ */
+template <typename T>
+struct PackedVector2
+{
+    static constexpr size_t width = 1; ///< Az egy regiszterben tárolt vektorok száma.
+
+    BasicVector2<T> value; ///< A csomagolt vektor.
+
+    /**
+     * @brief Betölt `width` darab vektort a megadott címről.
+     */
+    static PackedVector2 load(const BasicVector2<T>* source) noexcept { return {*source}; }
+
+    /**
+     * @brief Minden sávba ugyanazt a skalárt tölti.
+     */
+    static PackedVector2 broadcast(const T scalar) noexcept { return {BasicVector2<T>(scalar, scalar)}; }
+
+    /**
+     * @brief Kiírja a csomagolt vektorokat a megadott címre.
+     */
+    void store(BasicVector2<T>* destination) const noexcept { *destination = value; }
+
+    PackedVector2 operator+(const PackedVector2& other) const noexcept { return {value + other.value}; }
+    PackedVector2 operator-(const PackedVector2& other) const noexcept { return {value - other.value}; }
+    PackedVector2 operator*(const PackedVector2& other) const noexcept { return {BasicVector2<T>(value.x * other.value.x, value.y * other.value.y)}; }
+};
+
+#ifdef VECTOR2_SSE2
+/**
+ * @brief Egy `double` alapú vektor egy SSE2 regiszterben (x, y sávok).
+ */
+template <>
+struct PackedVector2<double>
+{
+    static constexpr size_t width = 1; ///< Az egy regiszterben tárolt vektorok száma.
+
+    __m128d value; ///< A csomagolt vektor.
+
+    static PackedVector2 load(const BasicVector2<double>* source) noexcept { return {_mm_loadu_pd(&source->x)}; }
+    static PackedVector2 broadcast(const double scalar) noexcept { return {_mm_set1_pd(scalar)}; }
+    void store(BasicVector2<double>* destination) const noexcept { _mm_storeu_pd(&destination->x, value); }
+
+    PackedVector2 operator+(const PackedVector2& other) const noexcept { return {_mm_add_pd(value, other.value)}; }
+    PackedVector2 operator-(const PackedVector2& other) const noexcept { return {_mm_sub_pd(value, other.value)}; }
+    PackedVector2 operator*(const PackedVector2& other) const noexcept { return {_mm_mul_pd(value, other.value)}; }
+};
+
+/**
+ * @brief Két `float` alapú vektor egy SSE2 regiszterben (x0, y0, x1, y1 sávok).
+ */
+template <>
+struct PackedVector2<float>
+{
+    static constexpr size_t width = 2; ///< Az egy regiszterben tárolt vektorok száma.
+
+    __m128 value; ///< A csomagolt vektorok.
+
+    static PackedVector2 load(const BasicVector2<float>* source) noexcept { return {_mm_loadu_ps(&source->x)}; }
+    static PackedVector2 broadcast(const float scalar) noexcept { return {_mm_set1_ps(scalar)}; }
+    void store(BasicVector2<float>* destination) const noexcept { _mm_storeu_ps(&destination->x, value); }
+
+    PackedVector2 operator+(const PackedVector2& other) const noexcept { return {_mm_add_ps(value, other.value)}; }
+    PackedVector2 operator-(const PackedVector2& other) const noexcept { return {_mm_sub_ps(value, other.value)}; }
+    PackedVector2 operator*(const PackedVector2& other) const noexcept { return {_mm_mul_ps(value, other.value)}; }
+};
+#endif // VECTOR2_SSE2
+
+static_assert(sizeof(BasicVector2<float>) == 2 * sizeof(float), "BasicVector2<float> must be tightly packed");
+static_assert(sizeof(BasicVector2<double>) == 2 * sizeof(double), "BasicVector2<double> must be tightly packed");
+
+/**
+ * @brief Vektortömbökön dolgozó (batch) műveletek.
+ *
+ * A `Vector2Batch` osztály statikus metódusai egyszerre sok, egymás után
+ * tárolt vektoron végeznek el egy műveletet. A tömbök belsejét `PackedVector2`
+ * segítségével dolgozzák fel, a maradékot skalár műveletekkel.
+ *
+ * A `Scalar` végződésű változatok referencia implementációk, amelyek
+ * a tesztekben és a benchmarkokban szolgálnak összehasonlításként.
+ */
+class Vector2Batch
+{
+    public:
+    /**
+     * @brief A `destination` minden eleméhez hozzáadja a `source` megfelelő elemét.
+     *
+     * @param destination A módosítandó vektorok.
+     * @param source A hozzáadandó vektorok.
+     * @param count A vektorok száma.
+     */
+    template <typename T>
+    static void add(BasicVector2<T>* destination, const BasicVector2<T>* source, const size_t count) noexcept;
+
+    /**
+     * @brief A `destination` minden elemét megszorozza a skalárral.
+     *
+     * @param destination A módosítandó vektorok.
+     * @param scalar A szorzó.
+     * @param count A vektorok száma.
+     */
+    template <typename T>
+    static void scale(BasicVector2<T>* destination, const T scalar, const size_t count) noexcept;
+
+    /**
+     * @brief A `destination` minden eleméhez hozzáadja a `source` megfelelő elemének skalárszorosát.
+     *
+     * Tipikus felhasználása az explicit Euler integrálás: `position += velocity * deltaTime`.
+     *
+     * @param destination A módosítandó vektorok.
+     * @param source A hozzáadandó vektorok.
+     * @param scalar A szorzó.
+     * @param count A vektorok száma.
+     */
+    template <typename T>
+    static void addScaled(BasicVector2<T>* destination, const BasicVector2<T>* source, const T scalar, const size_t count) noexcept;
+
+    /**
+     * @brief Az `addScaled` skalár referencia implementációja.
+     */
+    template <typename T>
+    static void addScaledScalar(BasicVector2<T>* destination, const BasicVector2<T>* source, const T scalar, const size_t count) noexcept;
+};
+
+#include "vector2batch.inl"
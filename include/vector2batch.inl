@@ -0,0 +1,68 @@
+#pragma once
+
+template <typename T>
+void Vector2Batch::add(BasicVector2<T>* destination, const BasicVector2<T>* source, const size_t count) noexcept
+{
+    using Packed = PackedVector2<T>;
+
+    size_t i = 0;
+    for (; i + Packed::width <= count; i += Packed::width)
+    {
+        (Packed::load(destination + i) + Packed::load(source + i)).store(destination + i);
+    }
+
+    //leftover that does not fill a whole register
+    for (; i < count; i++)
+    {
+        destination[i] += source[i];
+    }
+}
+
+template <typename T>
+void Vector2Batch::scale(BasicVector2<T>* destination, const T scalar, const size_t count) noexcept
+{
+    using Packed = PackedVector2<T>;
+
+    const Packed packedScalar = Packed::broadcast(scalar);
+
+    size_t i = 0;
+    for (; i + Packed::width <= count; i += Packed::width)
+    {
+        (Packed::load(destination + i) * packedScalar).store(destination + i);
+    }
+
+    //leftover that does not fill a whole register
+    for (; i < count; i++)
+    {
+        destination[i] *= scalar;
+    }
+}
+
+template <typename T>
+void Vector2Batch::addScaled(BasicVector2<T>* destination, const BasicVector2<T>* source, const T scalar, const size_t count) noexcept
+{
+    using Packed = PackedVector2<T>;
+
+    const Packed packedScalar = Packed::broadcast(scalar);
+
+    size_t i = 0;
+    for (; i + Packed::width <= count; i += Packed::width)
+    {
+        (Packed::load(destination + i) + Packed::load(source + i) * packedScalar).store(destination + i);
+    }
+
+    //leftover that does not fill a whole register
+    for (; i < count; i++)
+    {
+        destination[i] += source[i] * scalar;
+    }
+}
+
+template <typename T>
+void Vector2Batch::addScaledScalar(BasicVector2<T>* destination, const BasicVector2<T>* source, const T scalar, const size_t count) noexcept
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] += source[i] * scalar;
+    }
+}
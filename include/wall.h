@@ -1,21 +1,27 @@
 #pragma once
 #include "memtrace.h"
 
+#ifndef CPORTA
 #include "boxrenderer.h"
+#endif
 #include "collider.h"
+#include "colors.h"
 
 /**
  * @brief Statikus falat reprezentáló osztály a játék világában.
  * 
  * A `Wall` osztály egy statikus falat valósít meg, amely vizuális
- * megjelenítéssel (`BoxRenderer`) rendelkezik, és egy collider segítségével
+ * megjelenítéssel (`StaticBoxRenderer`) rendelkezik, és egy collider segítségével
  * lehetővé teszi, hogy más objektumok nekiütközzenek. A `Transform` osztályból
- * származik, így kezeli a pozíciót és a méretet.
+ * származik, így kezeli a pozíciót és a méretet. Grafika nélküli (`CPORTA`)
+ * buildben a falnak csak collidere van.
  */
 class Wall : public Transform
 {
     private:
-    BoxRenderer renderer; ///< A fal megjelenítéséért felelős renderelő.
+    #ifndef CPORTA
+    StaticBoxRenderer renderer; ///< A fal megjelenítéséért felelős renderelő.
+    #endif
     Collider collider;  ///< A falhoz tartozó collider, amely lehetővé teszi, hogy más objektumok nekiütközzenek.
 
     public:
@@ -31,5 +37,21 @@ class Wall : public Transform
      * @param colliderRatio Az ütközési arány, amely meghatározza a collider méretét a fal méretéhez képest.
      * @param colliderTags A collider címkék, amelyek extra tulajdonságokat adnak a colliderhez.
      */
-    Wall(const Transform& transform, const Color& color, const double bounciness = 0, const Vector2& colliderRatio = {1, 1}, const std::vector<ColliderTag> colliderTags = {});
+    Wall(const Transform& transform, const Color& color, const double bounciness = 0, const Vector2& colliderRatio = {1, 1}, const std::vector<ColliderTag>& colliderTags = {});
+
+    #ifndef CPORTA
+    /**
+     * @brief Visszaadja a fal renderelőjét.
+     * 
+     * @return A fal renderelője.
+     */
+    StaticBoxRenderer& getRenderer();
+    #endif
+
+    /**
+     * @brief Visszaadja a fal colliderét.
+     * 
+     * @return A fal collidere.
+     */
+    Collider& getCollider();
 };
\ No newline at end of file
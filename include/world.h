@@ -0,0 +1,450 @@
+#pragma once
+#include "memtrace.h"
+
+#include "core.h"
+#include "colliderindex.h"
+#include "colors.h"
+#include "rendersnapshot.h"
+#include "spatialgrid.h"
+#include "taskgraph.h"
+#include "threadpool.h"
+#include "vector2.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+class Collider;
+class StaticBoxRenderer;
+class StateHashLog;
+
+/**
+ * @brief Egy játékvilág teljes, más világoktól független állapota.
+ *
+ * A `World` tartalmazza mindazt, ami korábban a motor statikus, globális
+ * nyilvántartásaiban élt: a frissítendő és a fizikai frissítést igénylő
+ * objektumokat, a collidereket, a statikus téglalapok térbeli indexét, a
+ * lenyomott billentyűket, a kamerát és a frissítési időket. Az objektumok a
+ * létrehozásukkor az aktuális világba regisztrálnak, és a megszűnésükig abban
+ * maradnak.
+ *
+ * Az aktuális világ szálanként külön állítható (`Scope`), alapértelmezetten a
+ * folyamat közös világa (`getDefault`). A régi statikus API-k
+ * (`GameRuntime`, `Collider`, `InputHandler`, `Renderer`) az aktuális
+ * világot használják, így egy folyamatban több mérkőzés is futhat párhuzamosan,
+ * külön szálakon, közös módosítható állapot nélkül.
+ *
+ * A világ megszűnése előtt a benne létrehozott objektumokat meg kell szüntetni.
+ * Az objektumokat a saját világuk hatókörében kell mozgatni, így a világ
+ * változásszámlálója (`countTransformChange`) minden mozgást lát.
+ */
+class World
+{
+    public:
+    /**
+     * @brief A világ kamerája és megjelenítési beállításai.
+     */
+    struct Camera
+    {
+        double gameHeight = 5; ///< A játék világának magassága játékegységekben.
+        Color backgroundColor = makeColor(255, 255, 255); ///< A játék világának háttérszíne.
+        Vector2 offset; ///< A kamera eltolása.
+        double scale = 1; ///< A kamera mérete.
+
+        Vector2 viewMin; ///< A képkockában látható terület bal alsó sarka a játék világában.
+        Vector2 viewMax; ///< A képkockában látható terület jobb felső sarka a játék világában.
+        std::atomic<size_t> drawnCount {0}; ///< A képkockában kirajzolt objektumok száma, a párhuzamos fázisok is növelik.
+        std::atomic<size_t> culledCount {0}; ///< A képkockában kihagyott, nem látható objektumok száma.
+        RenderSnapshot* snapshot = nullptr; ///< A képkocka, amelybe a renderelők rajzolnak, vagy nullptr, ha nincs kirajzolás.
+    };
+
+    /**
+     * @brief Egy szálon, a hatókör végéig a megadott világot teszi aktuálissá.
+     */
+    class Scope
+    {
+        private:
+        World* previous; ///< A hatókör előtt aktuális világ.
+
+        /**
+         * @brief Másoló konstruktor tiltása.
+         */
+        Scope(const Scope& scope);
+
+        /**
+         * @brief Értékadás tiltása.
+         */
+        Scope& operator=(const Scope& scope);
+
+        public:
+        /**
+         * @brief Aktuálissá teszi a világot.
+         *
+         * @param world Az aktuális világ a hatókör végéig.
+         */
+        explicit Scope(World& world);
+
+        /**
+         * @brief Visszaállítja a korábban aktuális világot.
+         */
+        ~Scope();
+    };
+
+    /**
+     * @brief A frissítési fázisok száma, prioritásonként egy.
+     */
+    static constexpr size_t phaseCount = (size_t)UpdatePriority::OTHER + 1;
+
+    private:
+    std::set<Updatable*, Updatable::Compare> updatables; ///< A képkockánként frissítendő objektumok.
+    std::set<PhysicsUpdatable*, PhysicsUpdatable::Compare> physicsUpdatables; ///< A fizikai frissítést igénylő objektumok.
+
+    std::vector<std::set<Updatable*, Updatable::Compare>::node_type> spareUpdatableNodes; ///< Az eltávolított objektumok halmazcsúcsai, újrafelhasználásra.
+    std::vector<std::set<PhysicsUpdatable*, PhysicsUpdatable::Compare>::node_type> sparePhysicsUpdatableNodes; ///< Az eltávolított fizikai objektumok halmazcsúcsai, újrafelhasználásra.
+
+    unsigned long long nextRegistrationOrder; ///< A következő regisztráció sorszáma.
+
+    std::vector<Collider*> colliders; ///< A világ összes collidere az ütközések ellenőrzéséhez.
+    std::atomic<uint64_t> transformChangeCount; ///< A világ objektumainak eddigi pozíció-, méret- és szülőváltozásai.
+    ColliderIndex colliderIndex; ///< A colliderek térbeli indexe a sugár- és téglalaplekérdezésekhez.
+
+    SpatialGrid<StaticBoxRenderer> staticBoxRenderers; ///< A világ statikus téglalapjainak térbeli indexe.
+    std::unique_ptr<Updatable> staticBoxLayer; ///< A statikus téglalapokat kirajzoló réteg, az első téglalap hozza létre.
+
+    std::unordered_set<uint32_t> pressedKeys; ///< Az aktuálisan lenyomott billentyűk kódjai.
+
+    uint32_t phaseDependencies[phaseCount]; ///< Fázisonként a megelőző fázisok bitmaszkja.
+    bool parallelPhases[phaseCount]; ///< Fázisonként jelzi, hogy az objektumai párhuzamosan frissülhetnek-e.
+    std::vector<Updatable*> phaseMembers[phaseCount]; ///< A párhuzamos fázisok objektumai a fázis kezdetekor, újrahasznosításra.
+    std::vector<RenderSnapshot> phaseSnapshots[phaseCount]; ///< A fázisok részeinek saját képkockái, újrahasznosításra.
+    size_t phaseSnapshotCounts[phaseCount]; ///< A fázisok által a legutóbbi képkockában használt saját képkockák száma.
+    TaskGraph updateGraph; ///< A képkocka fázisainak gráfja, üres, ha újra kell építeni.
+    std::unique_ptr<ThreadPool> updatePool; ///< A fázisokat végrehajtó szálkészlet, vagy nullptr a hívó szálon való frissítéshez.
+
+    Camera camera; ///< A világ kamerája.
+
+    double deltaTime; ///< A legutóbbi képkocka kirajzolásához szükséges idő.
+    double targetFrameRate; ///< A maximális frissítési ráta.
+    double targetPhysicsRate; ///< A fizikai szimulációk rátája.
+
+    uint64_t stateHash; ///< A legutóbbi fizikai lépés utáni állapothash.
+    StateHashLog* stateHashLog; ///< A lépésenkénti hashek naplója, vagy nullptr.
+
+    static thread_local World* current; ///< A szálon aktuális világ, vagy nullptr az alapértelmezetthez.
+    static thread_local RenderSnapshot* phaseRenderTarget; ///< A szálon futó fázis saját képkockája, vagy nullptr.
+
+    /**
+     * @brief Visszaadja a fázis sorszámát.
+     *
+     * @throws std::out_of_range Ha a prioritás nem érvényes fázis.
+     */
+    static size_t getPhaseIndex(const UpdatePriority phase);
+
+    /**
+     * @brief Felépíti a fázisok gráfját a beállított függőségek szerint.
+     *
+     * @throws std::invalid_argument Ha a függőségek kört alkotnak.
+     */
+    void buildUpdateGraph();
+
+    /**
+     * @brief Frissíti a fázis objektumait.
+     *
+     * A soros fázis a frissítendők halmazát járja be, így a fázis közben
+     * regisztrált, azonos prioritású objektumok is frissülnek. A párhuzamos
+     * fázis a kezdetekor lévő objektumait a szálkészlet szálai között
+     * osztja szét. A kirajzolás a fázis részeinek saját képkockáiba kerül.
+     */
+    void runPhase(const size_t phase);
+
+    /**
+     * @brief Frissíti a fázis objektumait a megadott képkockába rajzolva.
+     */
+    template <typename Iterator>
+    void updateRange(Iterator begin, Iterator end, const UpdatePriority phase, RenderSnapshot* const target);
+
+    /**
+     * @brief Másoló konstruktor tiltása, az objektumok a világ címét tárolják.
+     */
+    World(const World& world);
+
+    /**
+     * @brief Értékadás tiltása, az objektumok a világ címét tárolják.
+     */
+    World& operator=(const World& world);
+
+    public:
+    /**
+     * @brief Létrehoz egy üres világot 60-as képkocka- és 50-es fizikai rátával.
+     */
+    World();
+
+    /**
+     * @brief Megszünteti a világot és a statikus téglalapok rétegét.
+     */
+    ~World();
+
+    /**
+     * @brief Visszaadja a folyamat közös, alapértelmezett világát.
+     */
+    static World& getDefault();
+
+    /**
+     * @brief Visszaadja a hívó szálon aktuális világot.
+     *
+     * @return A legbelső `Scope` világa, ennek hiányában az alapértelmezett világ.
+     */
+    static World& getCurrent();
+
+    /**
+     * @brief Jelzi az aktuális világnak, hogy egy objektumának pozíciója, mérete vagy szülője megváltozott.
+     *
+     * A `Transform` hívja minden módosításkor. Amíg a számláló nem változik,
+     * a világ objektumainak helyéből számolt gyorsítótárak (például a
+     * colliderek térbeli indexe) érvényesek.
+     */
+    static void countTransformChange();
+
+    /**
+     * @brief Frissíti a képkockánként frissítendő objektumokat.
+     *
+     * A frissítés idejére a világ aktuálissá válik a hívó szálon. A
+     * frissítés a fázisok gráfja szerint fut, fázisonként mérve az időt. A
+     * fázisok kirajzolása a saját képkockájukba kerül, amelyeket a frissítés
+     * végén prioritás szerinti sorrendben fűz a kamera képkockájához, így a
+     * kirajzolás sorrendje független a fázisok ütemezésétől.
+     */
+    void update();
+
+    /**
+     * @brief Beállítja, hogy a fázis mely fázisok befejeződése után induljon.
+     *
+     * Alapértelmezés szerint minden fázis a prioritás szerint előtte lévőre
+     * vár, így a fázisok sorosan futnak. Az egymástól független fázisok
+     * (például a csak olvasó renderelők) a függőség elhagyásával egymás
+     * mellett futhatnak. Az objektumokat regisztráló vagy eltávolító fázis
+     * nem futhat más fázissal egy időben. Frissítés közben nem hívható.
+     *
+     * @param phase A fázis.
+     * @param dependencies A fázisok, amelyekre a fázis vár.
+     * @throws std::out_of_range Ha valamelyik prioritás nem érvényes fázis.
+     * @throws std::invalid_argument Ha a függőségek kört alkotnának, ekkor a beállítás nem változik.
+     */
+    void setPhaseDependencies(const UpdatePriority phase, const std::vector<UpdatePriority>& dependencies);
+
+    /**
+     * @brief Beállítja, hogy a fázis objektumai párhuzamosan frissülhetnek-e.
+     *
+     * A párhuzamos fázis objektumai a szálkészlet szálai között oszlanak
+     * meg, ezért csak a saját állapotukat írhatják, a világot csak
+     * olvashatják, és nem regisztrálhatnak vagy távolíthatnak el
+     * objektumokat. Szálkészlet nélkül a fázis sorosan fut.
+     *
+     * @param phase A fázis.
+     * @param parallel true, ha az objektumok párhuzamosan frissülhetnek.
+     * @throws std::out_of_range Ha a prioritás nem érvényes fázis.
+     */
+    void setPhaseParallel(const UpdatePriority phase, const bool parallel);
+
+    /**
+     * @brief Beállítja a fázisokat végrehajtó szálkészlet méretét.
+     *
+     * Frissítés közben nem hívható.
+     *
+     * @param threadCount A munkaszálak száma, 0 esetén a frissítés a hívó szálon fut.
+     */
+    void setUpdateThreadCount(const size_t threadCount);
+
+    /**
+     * @brief Visszaadja a fázisokat végrehajtó munkaszálak számát.
+     */
+    size_t getUpdateThreadCount() const;
+
+    /**
+     * @brief Visszaadja a fázis legutóbbi frissítésének idejét nanoszekundumban.
+     *
+     * @throws std::out_of_range Ha a prioritás nem érvényes fázis.
+     */
+    uint64_t getPhaseTime(const UpdatePriority phase) const;
+
+    /**
+     * @brief Visszaadja a képkockát, amelybe a hívó szálon futó renderelőknek rajzolniuk kell.
+     *
+     * @return A futó fázis saját képkockája, ennek hiányában a kamera
+     * képkockája, vagy nullptr, ha nincs kirajzolás.
+     */
+    RenderSnapshot* getRenderTarget() const;
+
+    /**
+     * @brief Meghívja a fizikai frissítést végző objektumok `postUpdate` metódusát.
+     */
+    void postUpdate();
+
+    /**
+     * @brief Egy fizikai lépést végez a fizikai frissítést végző objektumokon.
+     *
+     * A frissítés idejére a világ aktuálissá válik a hívó szálon. Előbb
+     * minden objektum `prePhysicsUpdate`, majd `physicsUpdate` metódusát
+     * hívja. A lépés végén kiszámolja az állapothasht, és ha van napló,
+     * hozzáfűzi.
+     */
+    void physicsUpdate();
+
+    /**
+     * @brief Kiszámolja a világ dinamikus állapotának hashét.
+     *
+     * A fizikai frissítést végző objektumok a frissítés sorrendjében adják
+     * hozzá az állapotukat, így a hash független a memóriacímektől.
+     */
+    uint64_t computeStateHash() const;
+
+    /**
+     * @brief Visszaadja a legutóbbi fizikai lépés utáni állapothasht.
+     */
+    uint64_t getStateHash() const;
+
+    /**
+     * @brief Beállítja a lépésenkénti állapothashek naplóját.
+     *
+     * @param log A napló, vagy nullptr a naplózás kikapcsolásához. A világ nem veszi át.
+     */
+    void setStateHashLog(StateHashLog* const log);
+
+    /**
+     * @brief Kiad egy új regisztrációs sorszámot.
+     */
+    unsigned long long takeRegistrationOrder();
+
+    /**
+     * @brief Az updatelhető objektum regisztrálása az updateléshez.
+     */
+    void registerForUpdate(Updatable* const updatable);
+
+    /**
+     * @brief Az updatelhető objektum eltávolítása az updatelésből.
+     */
+    void unregisterForUpdate(Updatable* const updatable);
+
+    /**
+     * @brief A fizikai frissítést végző objektum regisztrálása.
+     */
+    void registerForUpdate(PhysicsUpdatable* const updatable);
+
+    /**
+     * @brief A fizikai frissítést végző objektum eltávolítása.
+     */
+    void unregisterForUpdate(PhysicsUpdatable* const updatable);
+
+    /**
+     * @brief Az updatelhető objektum helyét konstans időben átadja egy azonos kulcsú objektumnak.
+     */
+    void replaceForUpdate(Updatable* const oldUpdatable, Updatable* const newUpdatable);
+
+    /**
+     * @brief A fizikai frissítést végző objektum helyét konstans időben átadja egy azonos kulcsú objektumnak.
+     */
+    void replaceForUpdate(PhysicsUpdatable* const oldUpdatable, PhysicsUpdatable* const newUpdatable);
+
+    /**
+     * @brief Egyetlen bejárással eltávolítja a frissítendők közül a már nem regisztrált objektumokat.
+     */
+    void removeUnregisteredUpdatables();
+
+    /**
+     * @brief Visszaadja a frissítendő objektumok számát.
+     */
+    size_t getUpdatableCount() const;
+
+    /**
+     * @brief Visszaadja a fizikai frissítést igénylő objektumok számát.
+     */
+    size_t getPhysicsUpdatableCount() const;
+
+    /**
+     * @brief Visszaadja a világ collidereinek listáját.
+     *
+     * A listát a `Collider` osztály tartja karban.
+     */
+    std::vector<Collider*>& getColliders();
+
+    /**
+     * @brief Visszaadja a colliderek térbeli indexét.
+     *
+     * Az indexet a lekérdezések tartják karban, a `Collider` osztály csak a
+     * lista változását jelzi neki.
+     */
+    ColliderIndex& getColliderIndex();
+
+    /**
+     * @brief Visszaadja a statikus téglalapok térbeli indexét.
+     */
+    SpatialGrid<StaticBoxRenderer>& getStaticBoxRenderers();
+
+    /**
+     * @brief Megadja, hogy létezik-e már a statikus téglalapok rétege.
+     */
+    bool hasStaticBoxLayer() const;
+
+    /**
+     * @brief Átadja a világnak a statikus téglalapok rétegét.
+     *
+     * @param layer A réteg, a világ szünteti meg.
+     */
+    void setStaticBoxLayer(Updatable* const layer);
+
+    /**
+     * @brief Beállítja egy billentyű állapotát.
+     *
+     * @param key A billentyű kódja.
+     * @param pressed true, ha a billentyű lenyomott.
+     */
+    void setKeyPressed(const uint32_t key, const bool pressed);
+
+    /**
+     * @brief Megadja, hogy a billentyű lenyomott-e.
+     */
+    bool isKeyPressed(const uint32_t key) const;
+
+    /**
+     * @brief Felengedi az összes billentyűt.
+     */
+    void releaseAllKeys();
+
+    /**
+     * @brief Visszaadja a világ kameráját.
+     */
+    Camera& getCamera();
+
+    /**
+     * @brief A legutóbbi képkocka kirajzolásához szükséges idő lekérdezése.
+     */
+    double getDeltaTime() const;
+
+    /**
+     * @brief A legutóbbi képkocka kirajzolásához szükséges idő beállítása.
+     */
+    void setDeltaTime(const double deltaTime);
+
+    /**
+     * @brief A fizikai szimulációk között eltelt idő lekérdezése.
+     */
+    double getPhysicsDeltaTime() const;
+
+    /**
+     * @brief A maximális frissítési ráta lekérdezése.
+     */
+    double getTargetFrameRate() const;
+
+    /**
+     * @brief Maximális frissítési ráta beállítása.
+     */
+    void setTargetFrameRate(const double targetRate);
+
+    /**
+     * @brief Fizikai szimulációk rátájának beállítása.
+     */
+    void setTargetPhysicsRate(const double targetRate);
+};
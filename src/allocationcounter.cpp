@@ -0,0 +1,75 @@
+#include "allocationcounter.h"
+#include "framearena.h"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(FRAME_ARENA_ASSERT) && defined(MEMTRACE)
+#error "FRAME_ARENA_ASSERT and MEMTRACE both replace the global operator new"
+#endif
+
+#include "memtrace.h"
+
+std::atomic<size_t> AllocationCounter::count(0);
+std::atomic<size_t> AllocationCounter::bytes(0);
+
+void AllocationCounter::record(const size_t size)
+{
+    count.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+bool AllocationCounter::isAvailable()
+{
+    #if defined(MEMTRACE) || defined(ALLOCATION_HOOK)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+size_t AllocationCounter::getCount()
+{
+    #ifdef MEMTRACE
+    return memtrace::allocation_count();
+    #else
+    return count.load(std::memory_order_relaxed);
+    #endif
+}
+
+size_t AllocationCounter::getBytes()
+{
+    #ifdef MEMTRACE
+    return memtrace::allocated_bytes();
+    #else
+    return bytes.load(std::memory_order_relaxed);
+    #endif
+}
+
+#ifdef ALLOCATION_HOOK
+void* operator new(size_t size)
+{
+    AllocationCounter::record(size);
+    #ifdef FRAME_ARENA_ASSERT
+    FrameArena::reportStrayAllocation(size);
+    #endif
+
+    void* pointer = malloc(size > 0 ? size : 1);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept { free(pointer); }
+
+void operator delete[](void* pointer) noexcept { free(pointer); }
+
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+#endif // ALLOCATION_HOOK
@@ -0,0 +1,760 @@
+#ifdef BENCHMARK
+#include "benchmark.h"
+#include "memtrace.h"
+
+#include "vector2batch.h"
+#include "transform.h"
+#include "transformhierarchy.h"
+#include "collider.h"
+#include "core.h"
+#include "objectpool.h"
+#include "spatialgrid.h"
+#include "mapgenerator.h"
+#include "mapmanager.h"
+#include "tournament.h"
+#include "match.h"
+#include "world.h"
+#include "spscqueue.h"
+#include "rendersnapshot.h"
+#include "triplebuffer.h"
+#include "framearena.h"
+#include "logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Lefuttatja a mérendő függvényt és kiírja az egy műveletre jutó időt.
+ * 
+ * @param name A mérés neve.
+ * @param operations A függvény egy hívása alatt elvégzett műveletek száma.
+ * @param repeats A függvény hívásainak száma.
+ * @param function A mérendő függvény.
+ */
+template <typename Function>
+static void measure(const char* name, const size_t operations, const size_t repeats, Function function)
+{
+    //warm up caches before measuring
+    function();
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; i++)
+    {
+        function();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-40s %10.3f ns/op\n", name, nanoseconds / (double)(operations * repeats));
+}
+
+/**
+ * @brief Feltölti a vektortömböket determinisztikus értékekkel.
+ */
+template <typename T>
+static void fillVectors(std::vector<BasicVector2<T>>& positions, std::vector<BasicVector2<T>>& velocities)
+{
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        positions[i] = BasicVector2<T>((double)i, -(double)i);
+        velocities[i] = BasicVector2<T>(0.5 + (double)(i % 7), -2.0 + (double)(i % 5));
+    }
+}
+
+/**
+ * @brief Kiírja a vektortömb összegét, hogy a fordító ne hagyhassa el a mérést.
+ */
+template <typename T>
+static void printChecksum(const char* name, const std::vector<BasicVector2<T>>& positions)
+{
+    double sum = 0;
+    for (const BasicVector2<T>& position : positions)
+    {
+        sum += position.x + position.y;
+    }
+    std::printf("%-40s %14.3f\n", name, sum);
+}
+
+template <typename T>
+static void benchmarkIntegration(const char* scalarName, const char* packedName, const char* checksumName)
+{
+    const size_t count = 4096;
+    const size_t repeats = 2000;
+    const T deltaTime = (T)0.01;
+
+    std::vector<BasicVector2<T>> positions(count);
+    std::vector<BasicVector2<T>> velocities(count);
+
+    fillVectors(positions, velocities);
+    measure(scalarName, count, repeats, [&]()
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            positions[i] += velocities[i] * deltaTime;
+        }
+    });
+    printChecksum(checksumName, positions);
+
+    fillVectors(positions, velocities);
+    measure(packedName, count, repeats, [&]()
+    {
+        Vector2Batch::addScaled(positions.data(), velocities.data(), deltaTime, count);
+    });
+    printChecksum(checksumName, positions);
+}
+
+void BenchmarkRunner::start()
+{
+    runVector2Benchmarks();
+
+    runTransformBenchmarks();
+
+    runTeardownBenchmarks();
+
+    runMapScalingBenchmarks();
+
+    runTournamentBenchmarks();
+
+    runRollbackBenchmarks();
+
+    runColliderQueryBenchmarks();
+
+    runQueueBenchmarks();
+
+    runRenderSnapshotBenchmarks();
+
+    runUpdatePhaseBenchmarks();
+
+    runFrameArenaBenchmarks();
+
+    runLoggerBenchmarks();
+}
+
+void BenchmarkRunner::runVector2Benchmarks()
+{
+    #ifdef VECTOR2_SSE2
+    std::printf("==== Vector2 (SSE2) ====\n");
+    #else
+    std::printf("==== Vector2 (no SSE2, packed = scalar) ====\n");
+    #endif
+
+    benchmarkIntegration<double>("Vector2d position += velocity * dt", "Vector2Batch<double>::addScaled", "Vector2d checksum");
+    benchmarkIntegration<float>("Vector2f position += velocity * dt", "Vector2Batch<float>::addScaled", "Vector2f checksum");
+}
+void BenchmarkRunner::runTransformBenchmarks()
+{
+    std::printf("==== Transform ====\n");
+
+    //groups of four nested transforms, like a player with its colliders
+    const size_t groups = 2500;
+    const size_t depth = 4;
+    const size_t repeats = 200;
+
+    std::vector<Transform*> transforms;
+    TransformHierarchy hierarchy;
+    hierarchy.reserve(groups * depth);
+
+    for (size_t group = 0; group < groups; group++)
+    {
+        Transform* parent = nullptr;
+        TransformHierarchy::Handle parentHandle = TransformHierarchy::invalidHandle;
+        for (size_t level = 0; level < depth; level++)
+        {
+            Vector2 position((double)group, (double)level);
+            Vector2 scale(1.0 + 0.1 * (double)level, 1.0);
+
+            parent = new Transform(parent, position, scale);
+            transforms.push_back(parent);
+            parentHandle = hierarchy.create(parentHandle, position, scale);
+        }
+    }
+
+    double sum = 0;
+    measure("Transform::getPosition (pointer chain)", transforms.size(), repeats, [&]()
+    {
+        for (Transform* transform : transforms)
+        {
+            sum += transform->getPosition().x;
+        }
+    });
+
+    measure("TransformHierarchy::updateWorld", hierarchy.size(), repeats, [&]()
+    {
+        hierarchy.updateWorld();
+    });
+    std::printf("%-40s %14.3f\n", "Transform checksum", sum);
+
+    //children have to be deleted before their parents
+    for (size_t i = transforms.size(); i > 0; i--)
+    {
+        delete transforms[i - 1];
+    }
+}
+
+/**
+ * @brief Falat utánzó objektum a renderelő nélküli buildhez: collider és frissítendő objektum.
+ */
+class BenchmarkWall : public Collider, public Updatable
+{
+    public:
+    BenchmarkWall(const Vector2& position)
+    : Collider(Transform(nullptr, position, {1, 1})), Updatable(UpdatePriority::WALL_RENDERER) {}
+
+    void update() override {}
+};
+
+/**
+ * @brief Kiírja egy egyszeri művelet idejét ezredmásodpercben.
+ */
+static void printMilliseconds(const char* name, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+{
+    std::printf("%-40s %10.3f ms\n", name, std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+void BenchmarkRunner::runTeardownBenchmarks()
+{
+    std::printf("==== Map teardown ====\n");
+
+    const size_t count = 10000;
+
+    //unrelated objects stay registered, like the players
+    Collider player(Transform(nullptr, {0, 0}, {1, 1}));
+
+    ObjectPool<BenchmarkWall> pool;
+    std::vector<BenchmarkWall*> walls;
+    std::vector<Collider*> colliders;
+    std::vector<Updatable*> updatables;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        walls.push_back(pool.create(Vector2((double)i, 0.0)));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = walls.size(); i > 0; i--)
+    {
+        pool.destroy(walls[i - 1]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    printMilliseconds("10k walls, one by one", start, end);
+    walls.clear();
+
+    //the pool, the registries and the lists are warm from here
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++)
+    {
+        BenchmarkWall* wall = pool.create(Vector2((double)i, 0.0));
+        walls.push_back(wall);
+        colliders.push_back(wall);
+        updatables.push_back(wall);
+    }
+    end = std::chrono::steady_clock::now();
+    printMilliseconds("10k walls, warm pool build", start, end);
+
+    start = std::chrono::steady_clock::now();
+    Collider::unregisterColliders(colliders);
+    Updatable::unregisterUpdatables(updatables);
+    for (size_t i = walls.size(); i > 0; i--)
+    {
+        pool.destroy(walls[i - 1]);
+    }
+    end = std::chrono::steady_clock::now();
+    printMilliseconds("10k walls, bulk", start, end);
+    std::printf("%-40s %14zu\n", "wall pool high-water mark", pool.getHighWaterMark());
+
+    std::printf("%-40s %14zu\n", "remaining colliders", player.checkIntersection().size());
+}
+
+void BenchmarkRunner::runMapScalingBenchmarks()
+{
+    std::printf("==== Map scaling (generated maps) ====\n");
+
+    const size_t counts[] = {10, 100, 1000, 10000, 100000};
+    char name[64];
+
+    for (size_t count : counts)
+    {
+        MapGenerator::Settings settings;
+        settings.elementCount = count;
+        settings.seed = 42;
+
+        auto start = std::chrono::steady_clock::now();
+        std::string text = MapGenerator::generate(settings);
+        auto end = std::chrono::steady_clock::now();
+        std::snprintf(name, sizeof(name), "%zu elements, generate", count);
+        printMilliseconds(name, start, end);
+
+        start = std::chrono::steady_clock::now();
+        std::string error = MapManager::getParseError(text);
+        end = std::chrono::steady_clock::now();
+        std::snprintf(name, sizeof(name), "%zu elements, parse", count);
+        printMilliseconds(name, start, end);
+        if (!error.empty())
+            std::printf("generated map does not parse: %s\n", error.c_str());
+
+        std::vector<MapGenerator::Element> elements = MapGenerator::generateElements(settings);
+
+        //a player sized probe on the first spawn platform against every wall
+        ObjectPool<Collider> pool;
+        std::vector<Collider*> walls;
+        walls.reserve(elements.size());
+        for (const MapGenerator::Element& element : elements)
+            walls.push_back(pool.create(Transform(nullptr, element.position, element.scale)));
+
+        Collider probe(Transform(nullptr, elements[0].position + Vector2(0, 1), {1, 1}));
+        size_t hits = 0;
+        std::snprintf(name, sizeof(name), "%zu elements, broadphase query", count);
+        measure(name, 1, 100, [&]()
+        {
+            hits += probe.checkIntersection().size();
+        });
+
+        //render culling of a screen sized view around the spawn
+        SpatialGrid<const MapGenerator::Element> grid;
+        for (const MapGenerator::Element& element : elements)
+            grid.insert(&element, element.position - element.scale / 2, element.position + element.scale / 2);
+
+        std::vector<const MapGenerator::Element*> visible;
+        size_t drawn = 0;
+        std::snprintf(name, sizeof(name), "%zu elements, viewport query", count);
+        measure(name, 1, 100, [&]()
+        {
+            grid.query(elements[0].position - Vector2(18, 10), elements[0].position + Vector2(18, 10), visible);
+            drawn += visible.size();
+        });
+        std::printf("%-40s %14zu %zu\n", "hits, drawn checksum", hits, drawn);
+
+        Collider::unregisterColliders(walls);
+        for (size_t i = walls.size(); i > 0; i--)
+            pool.destroy(walls[i - 1]);
+    }
+}
+
+void BenchmarkRunner::runTournamentBenchmarks()
+{
+    std::printf("==== Headless tournament ====\n");
+
+    MapManager maps;
+    if (maps.getMapCount() == 0)
+    {
+        std::printf("no maps found, skipped\n");
+        return;
+    }
+
+    Tournament::Settings settings;
+    settings.rounds = 200;
+    settings.maxTicks = 3000;
+
+    const size_t threads[] = {1, 0};
+    char name[64];
+    for (size_t threadCount : threads)
+    {
+        settings.threads = threadCount;
+        Tournament::Result result = Tournament::run(maps, settings);
+
+        std::snprintf(name, sizeof(name), "%zu rounds, %zu threads", result.rounds, result.threads);
+        std::printf("%-40s %10.0f ticks/s\n", name, result.getTicksPerSecond());
+        std::printf("%-40s %14zu\n", "simulated ticks", result.ticks);
+    }
+}
+
+void BenchmarkRunner::runRollbackBenchmarks()
+{
+    std::printf("==== Rollback ====\n");
+
+    MapManager maps;
+    if (maps.getMapCount() == 0)
+    {
+        std::printf("no maps found, skipped\n");
+        return;
+    }
+    maps.prepareMap(0);
+    Match match(maps, 0);
+
+    PlayerInput right, left;
+    right.right = right.jump = true;
+    left.left = true;
+
+    measure("save state", 1, 100000, [&]()
+    {
+        match.saveState(0);
+    });
+
+    uint64_t hash = 0;
+    measure("state hash", 1, 100000, [&]()
+    {
+        hash ^= match.getStateHash();
+    });
+
+    //one rollback of the default window, as a late input would cause it
+    const size_t depth = 8;
+    match.saveState(0);
+    measure("8 tick rollback (load + resimulate)", 1, 2000, [&]()
+    {
+        match.loadState(0);
+        for (size_t i = 0; i < depth; i++)
+            match.step(right, left);
+    });
+    std::printf("%-40s %14.3f %016llx\n", "checksum", (double)match.getFighter(0).getPosition().x, (unsigned long long)hash);
+}
+
+void BenchmarkRunner::runColliderQueryBenchmarks()
+{
+    std::printf("==== Collider queries (generated maps) ====\n");
+
+    const size_t counts[] = {1000, 10000, 100000};
+    const size_t directionCount = 64;
+    char name[64];
+
+    for (size_t count : counts)
+    {
+        MapGenerator::Settings settings;
+        settings.elementCount = count;
+        settings.seed = 42;
+        std::vector<MapGenerator::Element> elements = MapGenerator::generateElements(settings);
+
+        World world;
+        World::Scope scope(world);
+        std::vector<Collider> walls;
+        walls.reserve(elements.size());
+        for (const MapGenerator::Element& element : elements)
+            walls.emplace_back(Transform(nullptr, element.position, element.scale));
+
+        //a bot looking around in every direction from above the first spawn platform
+        Vector2 eye = elements[0].position + Vector2(0, 1);
+        std::vector<Vector2> directions;
+        for (size_t i = 0; i < directionCount; i++)
+        {
+            double angle = 2 * 3.14159265358979 * (double)i / directionCount;
+            directions.push_back(Vector2(std::cos(angle), std::sin(angle)));
+        }
+
+        ColliderHit hit;
+        double distanceSum = 0;
+        std::snprintf(name, sizeof(name), "%zu elements, raycast 20", count);
+        measure(name, directionCount, 200, [&]()
+        {
+            for (const Vector2& direction : directions)
+            {
+                if (Collider::raycast(eye, direction, 20, hit))
+                    distanceSum += hit.distance;
+            }
+        });
+
+        std::snprintf(name, sizeof(name), "%zu elements, boxcast 20", count);
+        measure(name, directionCount, 200, [&]()
+        {
+            for (const Vector2& direction : directions)
+            {
+                if (Collider::boxcast(eye, {1, 1}, direction, 20, hit))
+                    distanceSum += hit.distance;
+            }
+        });
+
+        std::vector<Collider*> result;
+        size_t overlaps = 0;
+        std::snprintf(name, sizeof(name), "%zu elements, overlapBox 8x8", count);
+        measure(name, 1, 10000, [&]()
+        {
+            Collider::overlapBox(eye - Vector2(4, 4), eye + Vector2(4, 4), result);
+            overlaps += result.size();
+        });
+
+        //one moved collider, as a fighter moves between two ticks of perception
+        Collider& moving = walls[0];
+        Vector2 start = moving.getPosition();
+        size_t tick = 0;
+        std::snprintf(name, sizeof(name), "%zu elements, index update + raycast", count);
+        measure(name, 1, 200, [&]()
+        {
+            moving.setPosition(start + Vector2(0.01 * (double)(++tick % 100), 0));
+            if (Collider::raycast(eye, directions[0], 20, hit))
+                distanceSum += hit.distance;
+        });
+        moving.setPosition(start);
+
+        std::printf("%-40s %14.3f %zu\n", "distance, overlap checksum", distanceSum, overlaps);
+    }
+}
+
+void BenchmarkRunner::runQueueBenchmarks()
+{
+    std::printf("==== SPSC queue ====\n");
+
+    const size_t count = 1 << 20;
+    SpscQueue<uint64_t> queue(1024);
+    uint64_t sum = 0;
+
+    measure("push + pop, one thread", count, 10, [&]()
+    {
+        uint64_t value;
+        for (size_t i = 0; i < count; i++)
+        {
+            queue.push(i);
+            queue.pop(value);
+            sum += value;
+        }
+    });
+
+    //on a single core the two threads take turns, the result is not meaningful there
+    measure("transfer between two threads", count, 3, [&]()
+    {
+        std::thread producer([&queue, count]()
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                while (!queue.push(i))
+                    std::this_thread::yield();
+            }
+        });
+
+        uint64_t value;
+        for (size_t received = 0; received < count;)
+        {
+            if (queue.pop(value))
+            {
+                sum += value;
+                received++;
+            }
+            else
+                std::this_thread::yield();
+        }
+        producer.join();
+    });
+    std::printf("%-40s %14llu (%u hardware threads)\n", "checksum", (unsigned long long)sum, std::thread::hardware_concurrency());
+}
+#
+void BenchmarkRunner::runRenderSnapshotBenchmarks()
+{
+    std::printf("==== Render snapshot ====\n");
+
+    //about the walls and players of a large map on screen
+    const size_t rects = 2000;
+    const size_t frames = 2000;
+    TripleBuffer<RenderSnapshot> snapshots;
+    const std::string text = "Player 1 scored 3/5";
+    size_t drawn = 0;
+
+    auto build = [&](RenderSnapshot& snapshot, size_t frame)
+    {
+        snapshot.clear();
+        for (size_t i = 0; i < rects; i++)
+            snapshot.addRect(Vector2((double)(i % 100), (double)(i / 100 + frame % 2)), Vector2(1, 1), makeColor(0, 0, 0));
+        snapshot.addText(text, makeColor(255, 0, 0), 0.2);
+        snapshot.setCamera(makeColor(255, 255, 255), Vector2((double)frame, 0), 5);
+    };
+
+    measure("snapshot build + publish, one thread", frames, 5, [&]()
+    {
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            build(snapshots.getWriteBuffer(), frame);
+            snapshots.publish();
+            if (snapshots.acquire())
+                drawn += snapshots.getReadBuffer().getRects().size();
+        }
+    });
+
+    //the reader only sees the latest frame, the skipped ones are not waited for
+    measure("snapshot publish to a reader thread", frames, 5, [&]()
+    {
+        std::atomic<bool> done(false);
+        std::thread reader([&]()
+        {
+            while (!done.load(std::memory_order_acquire))
+            {
+                if (snapshots.acquire())
+                    drawn += snapshots.getReadBuffer().getRects().size();
+                else
+                    std::this_thread::yield();
+            }
+        });
+
+        for (size_t frame = 0; frame < frames; frame++)
+        {
+            build(snapshots.getWriteBuffer(), frame);
+            snapshots.publish();
+        }
+        done.store(true, std::memory_order_release);
+        reader.join();
+    });
+    std::printf("%-40s %14llu\n", "rects drawn", (unsigned long long)drawn);
+}
+
+/**
+ * @brief A `BoxRenderer` munkáját utánzó objektum a renderelő nélküli buildhez.
+ */
+class BenchmarkDrawer : public Transform, public Updatable
+{
+    public:
+    BenchmarkDrawer(const Vector2& position)
+    : Transform(nullptr, position, {1, 1}), Updatable(UpdatePriority::PLAYER_RENDERER) {}
+
+    void update() override
+    {
+        Vector2 position = getPosition();
+        if (position.x < -1000 || position.x > 1000)
+            return;
+
+        RenderSnapshot* target = getWorld().getRenderTarget();
+        if (target != nullptr)
+            target->addRect(position, getScale(), makeColor(0, 0, 0));
+    }
+};
+
+void BenchmarkRunner::runUpdatePhaseBenchmarks()
+{
+    std::printf("==== Update phases ====\n");
+
+    const size_t count = 20000;
+    World world;
+    World::Scope scope(world);
+    std::vector<BenchmarkDrawer*> drawers;
+    for (size_t i = 0; i < count; i++)
+        drawers.push_back(new BenchmarkDrawer(Vector2((double)(i % 1000), (double)(i / 1000))));
+
+    RenderSnapshot frame;
+    world.getCamera().snapshot = &frame;
+    size_t drawn = 0;
+
+    measure("World::update, serial", count, 50, [&]()
+    {
+        frame.clear();
+        world.update();
+        drawn += frame.getRects().size();
+    });
+
+    //on a single core the workers take turns, the result is not meaningful there
+    world.setUpdateThreadCount(3);
+    world.setPhaseParallel(UpdatePriority::PLAYER_RENDERER, true);
+    measure("World::update, parallel phase (3+1)", count, 50, [&]()
+    {
+        frame.clear();
+        world.update();
+        drawn += frame.getRects().size();
+    });
+    std::printf("%-40s %10.3f us\n", "last PLAYER_RENDERER phase time", (double)world.getPhaseTime(UpdatePriority::PLAYER_RENDERER) / 1000);
+
+    world.getCamera().snapshot = nullptr;
+    for (BenchmarkDrawer* drawer : drawers)
+        delete drawer;
+    drawers.clear();
+    world.setUpdateThreadCount(0);
+
+    //the cost of the graph itself, with no objects
+    measure("World::update, empty world", 1, 100000, [&]() { world.update(); });
+    std::printf("%-40s %14llu (%u hardware threads)\n", "rects drawn", (unsigned long long)drawn, std::thread::hardware_concurrency());
+}
+
+void BenchmarkRunner::runFrameArenaBenchmarks()
+{
+    std::printf("==== Frame arena (per-tick queries) ====\n");
+
+    World world;
+    World::Scope scope(world);
+
+    //a two collider object standing on a row of walls, like a fighter with its ground check
+    std::vector<Collider> walls;
+    walls.reserve(64);
+    for (int i = 0; i < 64; i++)
+        walls.emplace_back(Transform(nullptr, {(double)i - 32, 0}, {1, 1}));
+    Transform body(nullptr, {0, 1}, {1, 1});
+    Collider upper(Transform(&body, {0, 0.25}, {1, 0.5}));
+    Collider lower(Transform(&body, {0, -0.25}, {1, 1.1}));
+
+    std::vector<Collider*> colliders;
+    body.findTypeInChildren(colliders);
+
+    size_t hits = 0;
+    measure("checkIntersectionForList, std::vector", 1, 100000, [&]()
+    {
+        hits += Collider::checkIntersectionForList(colliders).size();
+    });
+
+    measure("checkIntersectionForList, frame arena", 1, 100000, [&]()
+    {
+        FrameArena::Scope arenaScope;
+        ArenaVector<Collider*> intersects;
+        Collider::checkIntersectionForList(colliders, intersects);
+        hits += intersects.size();
+    });
+
+    measure("findTypeInChildren, new vector", 1, 100000, [&]()
+    {
+        hits += body.findTypeInChildren<Collider>().size();
+    });
+
+    measure("findTypeInChildren, reused vector", 1, 100000, [&]()
+    {
+        body.findTypeInChildren(colliders);
+        hits += colliders.size();
+    });
+
+    //a tick's worth of small transient buffers
+    measure("FrameArena, 16 allocations + rewind", 16, 100000, [&]()
+    {
+        FrameArena::Scope arenaScope;
+        for (int i = 0; i < 16; i++)
+            hits += FrameArena::getThreadArena().allocate(64, 8) != nullptr;
+    });
+
+    std::printf("%-40s %14zu (arena peak %zu bytes)\n", "hits", hits, FrameArena::getThreadArena().getPeak());
+}
+
+void BenchmarkRunner::runLoggerBenchmarks()
+{
+    std::printf("==== Logger ====\n");
+
+    FILE* sink = std::fopen("/dev/null", "w");
+    if (sink == nullptr)
+    {
+        std::printf("failed to open /dev/null\n");
+        return;
+    }
+
+    const size_t batch = 1000;
+    const std::string name = "MapManager";
+    measure("fprintf, synchronous", batch, 200, [&]()
+    {
+        for (size_t i = 0; i < batch; i++)
+            std::fprintf(sink, "%s: Built %zu walls, %.3f ms\n", name.c_str(), i, 0.5);
+    });
+
+    Logger::setOutput(sink);
+    measure("LOG_INFO, formatted by the caller", batch, 200, [&]()
+    {
+        for (size_t i = 0; i < batch; i++)
+            LOG_INFO("%s: Built %zu walls, %.3f ms", name, i, 0.5);
+    });
+
+    measure("LOG_VERBOSE, below the runtime level", batch, 200, [&]()
+    {
+        for (size_t i = 0; i < batch; i++)
+            LOG_VERBOSE("%s: Built %zu walls, %.3f ms", name, i, 0.5);
+    });
+
+    //a batch fits into the queue, only the callers are timed, the writer catches up in between
+    //on a single core the writer also runs inside the timed part
+    Logger::start();
+    const size_t droppedBefore = Logger::getDroppedCount();
+    const size_t repeats = 200;
+    double nanoseconds = 0;
+    for (size_t repeat = 0; repeat < repeats; repeat++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < batch; i++)
+            LOG_INFO("%s: Built %zu walls, %.3f ms", name, i, 0.5);
+        nanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        Logger::flush();
+    }
+    std::printf("%-40s %10.3f ns/op\n", "LOG_INFO, queued for the writer", nanoseconds / (double)(batch * repeats));
+    Logger::stop();
+
+    std::printf("%-40s %14zu\n", "dropped", Logger::getDroppedCount() - droppedBefore);
+    Logger::setOutput(nullptr);
+    std::fclose(sink);
+}
+#endif // BENCHMARK
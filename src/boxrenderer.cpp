@@ -1,7 +1,8 @@
 #ifndef CPORTA
 #include "boxrenderer.h"
+#include "world.h"
 
-#include <SDL3/SDL.h>
+#include <cmath>
 
 BoxRenderer::BoxRenderer(const Transform& transform, const Color& color, const UpdatePriority priority) 
 : Renderer(transform, priority), color(color)
@@ -11,15 +12,62 @@ BoxRenderer::BoxRenderer(const Transform& transform, const Color& color, const U
 
 void BoxRenderer::update()
 {
-    SDL_FRect rect;
-    //width and height length
-    rect.w = getScale().x * getGameToScreenRatio();
-    rect.h = getScale().y * getGameToScreenRatio();
-    //top left corner
-    rect.x = gameToScreenXPos(getPosition().x) - rect.w / 2;
-    rect.y = gameToScreenYPos(getPosition().y) - rect.h / 2;
+    if (!isVisible(getPosition(), getScale()))
+    {
+        countCulled(1);
+        return;
+    }
 
-    SDL_SetRenderDrawColor(GameRuntime::getSDLRenderer(), color.r, color.g, color.b, color.a);
-    SDL_RenderFillRect(GameRuntime::getSDLRenderer(), &rect);
+    drawRect(getPosition(), getScale(), color);
+    countDrawn(1);
 }
-#endif
\ No newline at end of file
+
+void BoxRenderer::drawRect(const Vector2& position, const Vector2& scale, const Color& color)
+{
+    //the main thread converts to screen coordinates when it draws the frame
+    RenderSnapshot* snapshot = World::getCurrent().getRenderTarget();
+    if (snapshot != nullptr)
+        snapshot->addRect(position, scale, color);
+}
+
+StaticBoxRenderer::Layer::Layer()
+: Renderer(Transform(), UpdatePriority::WALL_RENDERER)
+{
+
+}
+
+void StaticBoxRenderer::Layer::update()
+{
+    SpatialGrid<StaticBoxRenderer>& grid = getWorld().getStaticBoxRenderers();
+    grid.query(getViewMin(), getViewMax(), visible);
+
+    for (const StaticBoxRenderer* renderer : visible)
+    {
+        BoxRenderer::drawRect(renderer->getPosition(), renderer->getScale(), renderer->color);
+    }
+
+    countDrawn(visible.size());
+    countCulled(grid.size() - visible.size());
+}
+
+void StaticBoxRenderer::createLayer(World& world)
+{
+    //the layer registers with the current world, which is the world of the new renderer
+    if (!world.hasStaticBoxLayer())
+        world.setStaticBoxLayer(new Layer());
+}
+
+StaticBoxRenderer::StaticBoxRenderer(const Transform& transform, const Color& color)
+: Transform(transform), world(&World::getCurrent()), color(color), handle(SpatialGrid<StaticBoxRenderer>::invalidHandle)
+{
+    createLayer(*world);
+
+    Vector2 halfSize(std::abs(getScale().x) / 2, std::abs(getScale().y) / 2);
+    handle = world->getStaticBoxRenderers().insert(this, getPosition() - halfSize, getPosition() + halfSize);
+}
+
+StaticBoxRenderer::~StaticBoxRenderer()
+{
+    world->getStaticBoxRenderers().remove(handle);
+}
+#endif
@@ -1,31 +1,58 @@
 #include "collider.h"
+#include "world.h"
 
-#include <unordered_set>
 #include <algorithm>
+#include <utility>
 
 #include "memtrace.h"
 
-std::vector<Collider*> Collider::colliders = std::vector<Collider*>();
-
 Collider::Collider(const Transform& transform, const ColliderType type, const double bounciness, const std::vector<ColliderTag>& tags)
-: Transform(transform), type(type), bounciness(bounciness), tags(tags)
+: Transform(transform), world(&World::getCurrent()), type(type), bounciness(bounciness), tagMask(0), registryIndex(notRegistered)
 {
+    for (ColliderTag tag : tags)
+    {
+        tagMask |= getTagBit(tag);
+    }
+
     registerCollider();
 }
 
 Collider::Collider(const Collider& collider)
-: Transform(collider), type(collider.type), bounciness(collider.bounciness), tags(collider.tags)
+: Transform(collider), world(&World::getCurrent()), type(collider.type), bounciness(collider.bounciness), tagMask(collider.tagMask), registryIndex(notRegistered)
 {
     registerCollider();
 }
 
+Collider::Collider(Collider&& collider) noexcept
+: Transform(std::move(collider)), world(collider.world), type(collider.type), bounciness(collider.bounciness), tagMask(collider.tagMask), registryIndex(collider.registryIndex)
+{
+    //take over the slot of the moved collider
+    if (registryIndex != notRegistered)
+    {
+        world->getColliders()[registryIndex] = this;
+        world->getColliderIndex().invalidate();
+    }
+
+    collider.registryIndex = notRegistered;
+}
+
 Collider& Collider::operator=(const Collider& collider)
 {
     setLocalPosition(collider.getLocalPosition());
     setLocalScale(collider.getLocalScale());
     type = collider.type;
     bounciness = collider.bounciness;
-    tags = collider.tags;
+    tagMask = collider.tagMask;
+    return *this;
+}
+
+Collider& Collider::operator=(Collider&& collider) noexcept
+{
+    setLocalPosition(collider.getLocalPosition());
+    setLocalScale(collider.getLocalScale());
+    type = collider.type;
+    bounciness = collider.bounciness;
+    tagMask = collider.tagMask;
     return *this;
 }
 
@@ -36,18 +63,62 @@ Collider::~Collider()
 
 void Collider::registerCollider()
 {
+    std::vector<Collider*>& colliders = world->getColliders();
+    registryIndex = colliders.size();
     colliders.push_back(this);
+    world->getColliderIndex().invalidate();
 }
 
 void Collider::unregisterCollider()
 {
-    auto pos = std::find(colliders.begin(), colliders.end(), this);
-
     //element is not in list
-    if (pos == colliders.end())
+    if (registryIndex == notRegistered)
         return;
 
-    colliders.erase(pos);
+    //move the last collider into the freed place
+    std::vector<Collider*>& colliders = world->getColliders();
+    Collider* last = colliders.back();
+    colliders[registryIndex] = last;
+    last->registryIndex = registryIndex;
+    colliders.pop_back();
+    world->getColliderIndex().invalidate();
+
+    registryIndex = notRegistered;
+}
+
+void Collider::unregisterColliders(const std::vector<Collider*>& collidersToRemove)
+{
+    if (collidersToRemove.empty())
+        return;
+
+    for (Collider* collider : collidersToRemove)
+    {
+        collider->registryIndex = notRegistered;
+    }
+
+    //the colliders almost always share one world, every world is compacted once per run of them
+    World* compacted = nullptr;
+    for (Collider* removed : collidersToRemove)
+    {
+        if (removed->world == compacted)
+            continue;
+        compacted = removed->world;
+
+        //compact the list in place, keeping the order of the remaining colliders
+        std::vector<Collider*>& colliders = compacted->getColliders();
+        size_t kept = 0;
+        for (Collider* collider : colliders)
+        {
+            if (collider->registryIndex == notRegistered)
+                continue;
+
+            collider->registryIndex = kept;
+            colliders[kept] = collider;
+            kept++;
+        }
+        colliders.resize(kept);
+        compacted->getColliderIndex().invalidate();
+    }
 }
 
 bool Collider::checkColliders(const Collider& collider1, const Collider& collider2)
@@ -73,11 +144,10 @@ bool Collider::checkColliders(const Collider& collider1, const Collider& collide
     return true;
 }
 
-std::vector<Collider*> Collider::checkIntersection() const
+template <typename Vector>
+void Collider::collectIntersections(Vector& result) const
 {
-    std::vector<Collider*> result = std::vector<Collider*>();
-    
-    for (Collider* collider : colliders)
+    for (Collider* collider : world->getColliders())
     {
         //skip passive colliders and self
         if (this == collider || collider->type == ColliderType::PASSIVE || !checkColliders(*this, *collider))
@@ -85,44 +155,127 @@ std::vector<Collider*> Collider::checkIntersection() const
         
         result.push_back(collider);
     }
-
-    return result;
 }
 
-std::vector<Collider*> Collider::checkIntersectionForList(const std::vector<Collider*>& collidersToCheck)
+template <typename Vector>
+void Collider::collectIntersectionsForList(const std::vector<Collider*>& collidersToCheck, Vector& result)
 {
     //loop through all colliders to get every unique intersection
-    std::unordered_set<Collider*> resultSet;
     for (Collider* collider : collidersToCheck)
     {
         if (collider->type == ColliderType::PASSIVE) continue;
 
-        std::vector<Collider*> intersections = collider->checkIntersection();
-        for (Collider* intersection : intersections)
+        for (Collider* other : collider->world->getColliders())
         {
-            resultSet.insert(intersection);
+            if (collider == other || other->type == ColliderType::PASSIVE || !checkColliders(*collider, *other))
+                continue;
+
+            //exclude the colliders of this object, the lists are short so a linear search is enough
+            if (find(collidersToCheck.begin(), collidersToCheck.end(), other) != collidersToCheck.end()
+                || find(result.begin(), result.end(), other) != result.end())
+                continue;
+
+            result.push_back(other);
         }
     }
+}
 
-    //filter all intersecting colliders to exclude the ones on this object
+std::vector<Collider*> Collider::checkIntersection() const
+{
     std::vector<Collider*> result = std::vector<Collider*>();
+    collectIntersections(result);
+    return result;
+}
 
-    for (Collider* collider : resultSet)
-    {
-        if (find(collidersToCheck.begin(), collidersToCheck.end(), collider) == collidersToCheck.end())
-        {
-            result.push_back(collider);
-        }
-    }
+void Collider::checkIntersection(ArenaVector<Collider*>& result) const
+{
+    result.clear();
+    collectIntersections(result);
+}
 
+std::vector<Collider*> Collider::checkIntersectionForList(const std::vector<Collider*>& collidersToCheck)
+{
+    std::vector<Collider*> result = std::vector<Collider*>();
+    collectIntersectionsForList(collidersToCheck, result);
     return result;
 }
 
+void Collider::checkIntersectionForList(const std::vector<Collider*>& collidersToCheck, ArenaVector<Collider*>& result)
+{
+    result.clear();
+    collectIntersectionsForList(collidersToCheck, result);
+}
+
+bool Collider::raycast(const Vector2& origin, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter)
+{
+    return World::getCurrent().getColliderIndex().raycast(origin, direction, maxDistance, hit, filter);
+}
+
+bool Collider::boxcast(const Vector2& center, const Vector2& size, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter)
+{
+    return World::getCurrent().getColliderIndex().boxcast(center, size, direction, maxDistance, hit, filter);
+}
+
+void Collider::overlapBox(const Vector2& min, const Vector2& max, std::vector<Collider*>& result, const ColliderFilter& filter)
+{
+    World::getCurrent().getColliderIndex().overlapBox(min, max, result, filter);
+}
+
 double Collider::getBounciness() const { return bounciness; }
 
+unsigned int Collider::getTagBit(const ColliderTag tag)
+{
+    return 1u << static_cast<unsigned int>(tag);
+}
+
 bool Collider::hasTag(ColliderTag tag) const
 {
-    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+    return (tagMask & getTagBit(tag)) != 0;
+}
+
+std::vector<ColliderTag> Collider::getTags() const
+{
+    std::vector<ColliderTag> tags;
+    for (unsigned int i = 0; (tagMask >> i) != 0; i++)
+    {
+        if ((tagMask >> i) & 1u)
+            tags.push_back(static_cast<ColliderTag>(i));
+    }
+
+    return tags;
+}
+
+unsigned int Collider::getTagMask() const { return tagMask; }
+
+ColliderFilter& ColliderFilter::require(const ColliderTag tag)
+{
+    requiredTags |= Collider::getTagBit(tag);
+    return *this;
+}
+
+ColliderFilter& ColliderFilter::exclude(const ColliderTag tag)
+{
+    excludedTags |= Collider::getTagBit(tag);
+    return *this;
 }
 
-std::vector<ColliderTag> Collider::getTags() const { return tags; }
\ No newline at end of file
+bool ColliderFilter::accepts(const Collider& collider) const
+{
+    if (!(collider.type == ColliderType::PASSIVE ? passive : interactive))
+        return false;
+
+    if ((collider.tagMask & requiredTags) != requiredTags || (collider.tagMask & excludedTags) != 0)
+        return false;
+
+    //skip the colliders of the ignored object, like the body of the asking bot
+    if (ignored != nullptr)
+    {
+        for (const Transform* transform = &collider; transform != nullptr; transform = transform->getParent())
+        {
+            if (transform == ignored)
+                return false;
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
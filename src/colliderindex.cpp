@@ -0,0 +1,187 @@
+#include "colliderindex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "memtrace.h"
+
+ColliderIndex::ColliderIndex(const std::vector<Collider*>& colliders, const std::atomic<uint64_t>& changeCount)
+: colliders(colliders), grid(cellSize), entries(), changeCount(changeCount), rebuildNeeded(true), syncedChangeCount(0), syncMutex()
+{
+
+}
+
+void ColliderIndex::getBounds(const Collider& collider, Vector2& min, Vector2& max)
+{
+    Vector2 position = collider.getPosition();
+    Vector2 halfScale = collider.getScale() / 2;
+    min = position - halfScale;
+    max = position + halfScale;
+}
+
+bool ColliderIndex::isSynchronized() const
+{
+    return !rebuildNeeded && syncedChangeCount == changeCount.load();
+}
+
+void ColliderIndex::synchronize()
+{
+    if (isSynchronized())
+        return;
+
+    //concurrent queries wait here for the first one to refresh the grid
+    std::lock_guard<std::mutex> lock(syncMutex);
+    if (isSynchronized())
+        return;
+
+    if (rebuildNeeded || entries.size() != colliders.size())
+    {
+        grid.clear();
+        entries.clear();
+        for (Collider* collider : colliders)
+        {
+            Entry entry;
+            getBounds(*collider, entry.min, entry.max);
+            entry.handle = grid.insert(collider, entry.min, entry.max);
+            entries.push_back(entry);
+        }
+    }
+    else
+    {
+        //only the moved colliders change cells, the walls stay where they are
+        for (size_t i = 0; i < colliders.size(); i++)
+        {
+            Entry& entry = entries[i];
+            Vector2 min, max;
+            getBounds(*colliders[i], min, max);
+            if (min == entry.min && max == entry.max)
+                continue;
+
+            grid.remove(entry.handle);
+            entry.min = min;
+            entry.max = max;
+            entry.handle = grid.insert(colliders[i], min, max);
+        }
+    }
+
+    //published last, so a query that sees them also sees the refreshed grid
+    syncedChangeCount = changeCount.load();
+    rebuildNeeded = false;
+}
+
+void ColliderIndex::invalidate() { rebuildNeeded = true; }
+
+bool ColliderIndex::cast(const Vector2& origin, const Vector2& direction, const double maxDistance, const Vector2& halfExtent, ColliderHit& hit, const ColliderFilter& filter)
+{
+    double length = std::sqrt((double)direction.x * direction.x + (double)direction.y * direction.y);
+    if (!(length > 0) || !(maxDistance >= 0))
+        throw std::invalid_argument("cast direction must not be zero and distance must not be negative");
+
+    synchronize();
+
+    const double directionX = direction.x / length, directionY = direction.y / length;
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    double best = maxDistance;
+    Collider* bestCollider = nullptr;
+    double bestNormalX = 0, bestNormalY = 0;
+
+    auto test = [&](Collider* collider, const Vector2& min, const Vector2& max)
+    {
+        if (!filter.accepts(*collider))
+            return;
+
+        //slab test against the collider grown by the half size of the cast box
+        double enter = -infinity, exit = infinity;
+        bool enterX = false;
+
+        double minX = min.x - halfExtent.x, maxX = max.x + halfExtent.x;
+        if (directionX != 0)
+        {
+            double t1 = (minX - origin.x) / directionX, t2 = (maxX - origin.x) / directionX;
+            enter = std::min(t1, t2);
+            exit = std::max(t1, t2);
+            enterX = true;
+        }
+        else if (origin.x < minX || origin.x > maxX)
+            return;
+
+        double minY = min.y - halfExtent.y, maxY = max.y + halfExtent.y;
+        if (directionY != 0)
+        {
+            double t1 = (minY - origin.y) / directionY, t2 = (maxY - origin.y) / directionY;
+            if (std::min(t1, t2) > enter)
+            {
+                enter = std::min(t1, t2);
+                enterX = false;
+            }
+            exit = std::min(exit, std::max(t1, t2));
+        }
+        else if (origin.y < minY || origin.y > maxY)
+            return;
+
+        if (exit < enter || exit < 0)
+            return;
+
+        //ties go to the earlier collider in the world list, independent of the grid layout
+        double distance = std::max(enter, 0.0);
+        if (distance > best || (distance == best && bestCollider != nullptr && collider->registryIndex > bestCollider->registryIndex))
+            return;
+
+        best = distance;
+        bestCollider = collider;
+        if (enter <= 0)
+        {
+            bestNormalX = -directionX;
+            bestNormalY = -directionY;
+        }
+        else if (enterX)
+        {
+            bestNormalX = directionX > 0 ? -1 : 1;
+            bestNormalY = 0;
+        }
+        else
+        {
+            bestNormalX = 0;
+            bestNormalY = directionY > 0 ? -1 : 1;
+        }
+    };
+
+    grid.visitAlongRay(origin, Vector2(directionX, directionY), best, halfExtent, test);
+
+    if (bestCollider == nullptr)
+        return false;
+
+    hit.collider = bestCollider;
+    hit.distance = best;
+    hit.point = Vector2(origin.x + directionX * best, origin.y + directionY * best);
+    hit.normal = Vector2(bestNormalX, bestNormalY);
+    return true;
+}
+
+bool ColliderIndex::raycast(const Vector2& origin, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter)
+{
+    return cast(origin, direction, maxDistance, Vector2(0, 0), hit, filter);
+}
+
+bool ColliderIndex::boxcast(const Vector2& center, const Vector2& size, const Vector2& direction, const double maxDistance, ColliderHit& hit, const ColliderFilter& filter)
+{
+    return cast(center, direction, maxDistance, size / 2, hit, filter);
+}
+
+void ColliderIndex::overlapBox(const Vector2& min, const Vector2& max, std::vector<Collider*>& result, const ColliderFilter& filter)
+{
+    synchronize();
+
+    result.clear();
+    grid.visit(min, max, [&result, &filter](Collider* collider, const Vector2&, const Vector2&)
+    {
+        if (filter.accepts(*collider))
+            result.push_back(collider);
+    });
+
+    //the grid order depends on its history, the list order is the same on every run
+    std::sort(result.begin(), result.end(), [](const Collider* collider1, const Collider* collider2) { return collider1->registryIndex < collider2->registryIndex; });
+}
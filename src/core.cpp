@@ -1,4 +1,6 @@
 #include "core.h"
+#include "world.h"
+#include "logger.h"
 
 #ifndef CPORTA
 #include "renderer.h"
@@ -9,42 +11,122 @@
 #endif
 
 #include <algorithm>
+#include <thread>
+#include <utility>
 
 #include "memtrace.h"
 
 Updatable::Updatable(const UpdatePriority priority)
-: priority(priority)
+: world(&World::getCurrent()), priority(priority), registrationOrder(0), registered(false)
 {
-    GameRuntime::registerForUpdate(this);
+    registerSelf();
 }
 
 Updatable::Updatable(const Updatable& updatable)
-: priority(updatable.priority)
+: world(&World::getCurrent()), priority(updatable.priority), registrationOrder(0), registered(false)
 {
-    GameRuntime::registerForUpdate(this);
+    registerSelf();
+}
+
+Updatable::Updatable(Updatable&& updatable) noexcept
+: world(updatable.world), priority(updatable.priority), registrationOrder(updatable.registrationOrder), registered(updatable.registered)
+{
+    //take over the slot of the moved object, it has the same key
+    if (registered)
+        world->replaceForUpdate(&updatable, this);
+
+    updatable.registered = false;
 }
 
 Updatable& Updatable::operator=(const Updatable& updatable)
 {
-    GameRuntime::unregisterForUpdate(this);
+    unregisterSelf();
     priority = updatable.priority;
-    GameRuntime::registerForUpdate(this);
+    registerSelf();
+    return *this;
+}
+
+Updatable& Updatable::operator=(Updatable&& updatable) noexcept
+{
+    //the slot only has to change if the order changes
+    if (priority != updatable.priority || !registered)
+    {
+        unregisterSelf();
+        priority = updatable.priority;
+        registerSelf();
+    }
     return *this;
 }
 
 Updatable::~Updatable()
 {
-    GameRuntime::unregisterForUpdate(this);
+    unregisterSelf();
+}
+
+void Updatable::unregisterUpdatables(const std::vector<Updatable*>& updatablesToRemove)
+{
+    if (updatablesToRemove.empty())
+        return;
+
+    for (Updatable* updatable : updatablesToRemove)
+    {
+        updatable->registered = false;
+    }
+
+    //the objects almost always share one world, every world is cleaned once per run of them
+    World* cleaned = nullptr;
+    for (Updatable* updatable : updatablesToRemove)
+    {
+        if (updatable->world == cleaned)
+            continue;
+
+        cleaned = updatable->world;
+        cleaned->removeUnregisteredUpdatables();
+    }
+}
+
+bool Updatable::isRegistered() const { return registered; }
+
+UpdatePriority Updatable::getPriority() const { return priority; }
+
+World& Updatable::getWorld() const { return *world; }
+
+void Updatable::registerSelf()
+{
+    registrationOrder = world->takeRegistrationOrder();
+    world->registerForUpdate(this);
+    registered = true;
+}
+
+void Updatable::unregisterSelf()
+{
+    if (!registered)
+        return;
+
+    world->unregisterForUpdate(this);
+    registered = false;
 }
 
 PhysicsUpdatable::PhysicsUpdatable()
+: world(&World::getCurrent()), registrationOrder(world->takeRegistrationOrder()), registered(true)
 {
-    GameRuntime::registerForUpdate(this);
+    world->registerForUpdate(this);
 }
 
 PhysicsUpdatable::PhysicsUpdatable(const PhysicsUpdatable& updatable)
+: world(&World::getCurrent()), registrationOrder(world->takeRegistrationOrder()), registered(true)
+{
+    world->registerForUpdate(this);
+}
+
+PhysicsUpdatable::PhysicsUpdatable(PhysicsUpdatable&& updatable) noexcept
+: world(updatable.world), registrationOrder(updatable.registrationOrder), registered(updatable.registered)
 {
-    GameRuntime::registerForUpdate(this);
+    //take over the slot of the moved object, it has the same key
+    if (registered)
+        world->replaceForUpdate(&updatable, this);
+
+    updatable.registered = false;
 }
 
 PhysicsUpdatable& PhysicsUpdatable::operator=(const PhysicsUpdatable& updatable)
@@ -52,9 +134,27 @@ PhysicsUpdatable& PhysicsUpdatable::operator=(const PhysicsUpdatable& updatable)
     return *this;
 }
 
+PhysicsUpdatable& PhysicsUpdatable::operator=(PhysicsUpdatable&& updatable) noexcept
+{
+    return *this;
+}
+
+World& PhysicsUpdatable::getWorld() const { return *world; }
+
+void PhysicsUpdatable::prePhysicsUpdate()
+{
+
+}
+
+void PhysicsUpdatable::hashState(StateHasher& hasher) const
+{
+
+}
+
 PhysicsUpdatable::~PhysicsUpdatable()
 {
-    GameRuntime::unregisterForUpdate(this);
+    if (registered)
+        world->unregisterForUpdate(this);
 }
 
 bool Updatable::Compare::operator()(const Updatable* updatable1, const Updatable* updatable2) const
@@ -64,39 +164,30 @@ bool Updatable::Compare::operator()(const Updatable* updatable1, const Updatable
     else if (updatable1->priority > updatable2->priority)
         return false;
     else
-        return updatable1 < updatable2;
+        return updatable1->registrationOrder < updatable2->registrationOrder;
+}
+
+bool PhysicsUpdatable::Compare::operator()(const PhysicsUpdatable* updatable1, const PhysicsUpdatable* updatable2) const
+{
+    return updatable1->registrationOrder < updatable2->registrationOrder;
 }
 
 #ifndef CPORTA
 SDL_Window* GameRuntime::SDLWindow = nullptr;
 SDL_Renderer* GameRuntime::SDLRenderer = nullptr;
 
-bool GameRuntime::running = false;
+std::atomic<bool> GameRuntime::running {false};
+
+TripleBuffer<RenderSnapshot> GameRuntime::renderSnapshots;
 
 unsigned long long GameRuntime::lastFrameCounter {0};
 unsigned long long GameRuntime::currentFrameCounter {0};
 
-#endif
-double GameRuntime::deltaTime = 0;
-#ifndef CPORTA
 double GameRuntime::physicsSimTime = 0;
-#endif
-
-double GameRuntime::targetFrameRate = 60;
-double GameRuntime::targetPhysicsRate = 50;
+uint64_t GameRuntime::physicsClock = 0;
 
-std::set<Updatable*, Updatable::Compare> GameRuntime::updatables = std::set<Updatable*, Updatable::Compare>();
-std::set<PhysicsUpdatable*> GameRuntime::physicsUpdatables = std::set<PhysicsUpdatable*>();
-
-#ifndef CPORTA
 void GameRuntime::loop()
 {
-    lastFrameCounter = currentFrameCounter;
-    currentFrameCounter = SDL_GetPerformanceCounter();
-    deltaTime = (double) ((currentFrameCounter - lastFrameCounter)/ (double)SDL_GetPerformanceFrequency());
-
-    physicsSimTime += deltaTime;
-
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
@@ -110,77 +201,112 @@ void GameRuntime::loop()
                     bool isFullscreen = SDL_GetWindowFlags(SDLWindow) & SDL_WINDOW_FULLSCREEN;
                     SDL_SetWindowFullscreen(SDLWindow, isFullscreen ? 0 : SDL_WINDOW_FULLSCREEN);
                 }
+                #if defined(MEMTRACE) && defined(MEMTRACE_PROFILE)
+                //the allocation sites so far, the exit prints the final report
+                if (event.key.key == SDLK_F10 && !event.key.repeat)
+                    memtrace::mem_profile();
+                #endif
                 break;
 
 
             case SDL_EVENT_QUIT:
-                SDL_Log("Game quit!");
-                running = false;
+                LOG_INFO("Game quit!");
+                running.store(false, std::memory_order_release);
                 return;
         }
     }
-    
-    Renderer::drawBackground();
-    schedulePhysicsUpdates();
-    callUpdates();
-    
+
+    Renderer::updateScreenSize();
+
+    //only new frames are drawn, the simulation sets the pace
+    if (!renderSnapshots.acquire())
+    {
+        SDL_Delay(1);
+        return;
+    }
+
+    Renderer::drawSnapshot(renderSnapshots.getReadBuffer());
     SDL_RenderPresent(SDLRenderer);
-    SDL_Delay(1000 / targetFrameRate - deltaTime);
 }
 
-void GameRuntime::callUpdates()
+void GameRuntime::simulate()
 {
-    for (Updatable* updatable : updatables)
+    while (running.load(std::memory_order_acquire))
     {
-        updatable->update();
+        lastFrameCounter = currentFrameCounter;
+        currentFrameCounter = SDL_GetPerformanceCounter();
+        double deltaTime = (double) ((currentFrameCounter - lastFrameCounter)/ (double)SDL_GetPerformanceFrequency());
+        World& world = World::getCurrent();
+        world.setDeltaTime(deltaTime);
+
+        physicsSimTime += deltaTime;
+
+        Renderer::beginFrame(renderSnapshots.getWriteBuffer());
+        schedulePhysicsUpdates();
+        callUpdates();
+        Renderer::endFrame();
+        renderSnapshots.publish();
+
+        //the time spent on this frame is not waited again
+        double frameTime = (double) ((SDL_GetPerformanceCounter() - currentFrameCounter) / (double)SDL_GetPerformanceFrequency());
+        double remainingTime = 1 / world.getTargetFrameRate() - frameTime;
+        if (remainingTime > 0)
+            SDL_Delay((Uint32)(remainingTime * 1000));
     }
+}
 
-    for (PhysicsUpdatable* updatable : physicsUpdatables)
-    {
-        updatable->postUpdate();
-    }
+void GameRuntime::callUpdates()
+{
+    World& world = World::getCurrent();
+    world.update();
+    world.postUpdate();
 }
 
 void GameRuntime::schedulePhysicsUpdates()
 {
-    while (physicsSimTime > getPhysicsDeltaTime())
+    World& world = World::getCurrent();
+    const uint64_t physicsStep = (uint64_t)(world.getPhysicsDeltaTime() * 1e9);
+    while (physicsSimTime > world.getPhysicsDeltaTime())
     {
-        for (PhysicsUpdatable* updatable : physicsUpdatables)
-        {
-            updatable->physicsUpdate();
-        }
-        physicsSimTime -= getPhysicsDeltaTime();
+        //every step sees the keys as they were at its own simulated time
+        InputHandler::applyEvents(physicsClock);
+        world.physicsUpdate();
+        physicsSimTime -= world.getPhysicsDeltaTime();
+        physicsClock += physicsStep;
     }
 }
 
 bool GameRuntime::init(const int resolutionX, const int resolutionY)
 {
+    //the messages are written on a background thread from here on
+    Logger::start();
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) == false)
     {
-        SDL_Log("SDL failed to initialize: %s", SDL_GetError());
+        LOG_ERROR("SDL failed to initialize: %s", SDL_GetError());
         return false;
     }
 
     if (TTF_Init() == false)
     {
-        SDL_Log("SDL_ttf failed to initialize: %s", SDL_GetError());
+        LOG_ERROR("SDL_ttf failed to initialize: %s", SDL_GetError());
         return false;
     }
     
     SDLWindow = SDL_CreateWindow("Platfomer Game", resolutionX, resolutionY, SDL_WINDOW_RESIZABLE);
     if (SDLWindow == NULL)
     {
-        SDL_Log("SDL failed to create SDLWindow: %s", SDL_GetError());
+        LOG_ERROR("SDL failed to create SDLWindow: %s", SDL_GetError());
         return false;
     }
     
     SDLRenderer = SDL_CreateRenderer(SDLWindow, NULL);
     if (SDLRenderer == NULL)
     {
-        SDL_Log("SDL failed to create SDLRenderer: %s", SDL_GetError());
+        LOG_ERROR("SDL failed to create SDLRenderer: %s", SDL_GetError());
         return false;
     }
-    SDL_Log("SDL3 intialized");
+    LOG_INFO("SDL3 intialized");
 
     return true;
 }
@@ -191,17 +317,25 @@ void GameRuntime::startGameLoop()
     lastFrameCounter = 0;
 
     physicsSimTime = 0;
+    physicsClock = SDL_GetTicksNS();
+
+    Renderer::updateScreenSize();
 
-    running = true;
-    while (running)
+    //the world belongs to the simulation thread until it stops, the main thread only draws the published frames
+    running.store(true, std::memory_order_release);
+    std::thread simulation(simulate);
+    while (running.load(std::memory_order_acquire))
     {
         loop();
     }
+    simulation.join();
 }
 
 void GameRuntime::quit()
 {
-    SDL_Log("SDL3 shut down!");
+    LOG_INFO("SDL3 shut down!");
+    Logger::stop();
+    Renderer::releaseResources();
     SDL_DestroyRenderer(SDLRenderer);
     SDL_DestroyWindow(SDLWindow);
     TTF_Quit();
@@ -210,67 +344,62 @@ void GameRuntime::quit()
 
 SDL_Renderer* GameRuntime::getSDLRenderer() { return SDLRenderer; }
 #endif
-double GameRuntime::getDeltaTime() { return deltaTime; }
+double GameRuntime::getDeltaTime() { return World::getCurrent().getDeltaTime(); }
 
-double GameRuntime::getPhysicsDeltaTime() { return 1 / targetPhysicsRate; }
+double GameRuntime::getPhysicsDeltaTime() { return World::getCurrent().getPhysicsDeltaTime(); }
 
-void GameRuntime::setTargetFrameRate(double targetRate) { targetFrameRate = targetRate; }
+uint64_t GameRuntime::getStateHash() { return World::getCurrent().getStateHash(); }
 
-void GameRuntime::setTargetPhysicsRate(double targetRate) { targetPhysicsRate = targetRate; }
+void GameRuntime::setTargetFrameRate(double targetRate) { World::getCurrent().setTargetFrameRate(targetRate); }
 
-void GameRuntime::registerForUpdate(Updatable* const updatable)
-{
-    updatables.insert(updatable);
-}
+void GameRuntime::setTargetPhysicsRate(double targetRate) { World::getCurrent().setTargetPhysicsRate(targetRate); }
 
-void GameRuntime::unregisterForUpdate(Updatable* const updatable)
-{
-    updatables.erase(updatable);
-}
+void GameRuntime::registerForUpdate(Updatable* const updatable) { World::getCurrent().registerForUpdate(updatable); }
 
-void GameRuntime::registerForUpdate(PhysicsUpdatable* const updatable)
+void GameRuntime::unregisterForUpdate(Updatable* const updatable) { World::getCurrent().unregisterForUpdate(updatable); }
+
+void GameRuntime::registerForUpdate(PhysicsUpdatable* const updatable) { World::getCurrent().registerForUpdate(updatable); }
+
+void GameRuntime::unregisterForUpdate(PhysicsUpdatable* const updatable) { World::getCurrent().unregisterForUpdate(updatable); }
+
+void GameRuntime::replaceForUpdate(Updatable* const oldUpdatable, Updatable* const newUpdatable)
 {
-    physicsUpdatables.insert(updatable);
+    World::getCurrent().replaceForUpdate(oldUpdatable, newUpdatable);
 }
 
-void GameRuntime::unregisterForUpdate(PhysicsUpdatable* const updatable)
+void GameRuntime::replaceForUpdate(PhysicsUpdatable* const oldUpdatable, PhysicsUpdatable* const newUpdatable)
 {
-    physicsUpdatables.erase(updatable);
+    World::getCurrent().replaceForUpdate(oldUpdatable, newUpdatable);
 }
 
+void GameRuntime::removeUnregisteredUpdatables() { World::getCurrent().removeUnregisteredUpdatables(); }
+
 #ifdef CPORTA
 void GameRuntime::configureMock(const double targetFrameRate, const double targetPhysicsRate)
 {
-    GameRuntime::targetFrameRate = targetFrameRate;
-    GameRuntime::targetPhysicsRate = targetPhysicsRate;
-
-    GameRuntime::deltaTime = 1 / targetFrameRate;
+    World& world = World::getCurrent();
+    world.setTargetFrameRate(targetFrameRate);
+    world.setTargetPhysicsRate(targetPhysicsRate);
+    world.setDeltaTime(1 / targetFrameRate);
 }
 
 void GameRuntime::mockUpdate(const size_t calls)
 {
+    World& world = World::getCurrent();
     for (size_t i = 0; i < calls; i++)
     {
-        for (Updatable* updatable : updatables)
-        {
-            updatable->update();
-        }
+        world.update();
     }
 
-    for (PhysicsUpdatable* updatable : physicsUpdatables)
-    {
-        updatable->postUpdate();
-    }
+    world.postUpdate();
 }
 
 void GameRuntime::mockPhysicsUpdate(const size_t calls)
 {
+    World& world = World::getCurrent();
     for (size_t i = 0; i < calls; i++)
     {
-        for (PhysicsUpdatable* updatable : physicsUpdatables)
-        {
-            updatable->physicsUpdate();
-        }
+        world.physicsUpdate();
     }
 }
 #endif
\ No newline at end of file
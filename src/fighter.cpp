@@ -0,0 +1,225 @@
+#include "fighter.h"
+
+#include "statehash.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "memtrace.h"
+
+Fighter::Fighter(PlayerController* const controller)
+: PhysicsObject(Transform(), {}),
+  Updatable(UpdatePriority::GAME_LOGIC),
+  collider(Transform(this), ColliderType::INTERACTIVE, 0, {ColliderTag::PLAYER}),
+  groundCheck(Transform(this, {0, -0.6}, {0.99, 0.04}), ColliderType::PASSIVE),
+  headCheck(Transform(this, {0, 0.6}, {0.99, 0.04}), ColliderType::PASSIVE),
+  controller(controller),
+  opponent(nullptr),
+  arenaWidth(0),
+  arenaHeight(0),
+  hasDied(false)
+{
+    setGravity({0, 2* -9.81});
+}
+
+void Fighter::controlFighter()
+{
+    PlayerInput input;
+    if (controller != nullptr)
+    {
+        //without an opponent the controller sees a dead one
+        PlayerView opponentView;
+        opponentView.dead = true;
+        if (opponent != nullptr)
+            opponentView = opponent->getView();
+
+        input = controller->control(getView(), opponentView);
+    }
+
+    Vector2 newAcceleration = getAcceleration();
+    Vector2 newVelocity = getVelocity();
+
+    setMaxYVelocity({-maxFallSpeed, maxFallSpeed});
+    setMaxXVelocity({-maxSpeed, maxSpeed});
+
+    //dash down
+    if (input.dash)
+    {
+        newVelocity.y = std::min<VectorScalar>(-dashSpeed, newVelocity.y);
+    }
+    //jump
+    else if (input.jump && isGrounded())
+    {
+        newVelocity.y = std::max<VectorScalar>(jumpSpeed, newVelocity.y);
+    }
+
+    //adjust gravity;
+    if (input.jump && newVelocity.y > 0)
+        setGravity({0, -floatGravity});
+    else
+        setGravity({0, -fallGravity});
+
+    //move left
+    if (input.left)
+    {
+        if (newVelocity.x <= 0)
+            newAcceleration.x = -moveAcceleration;
+        else
+            newAcceleration.x = -turnAcceleration;
+    }
+    //move right
+    else if (input.right)
+    {
+        if (newVelocity.x >= 0)
+            newAcceleration.x = moveAcceleration;
+        else
+            newAcceleration.x = turnAcceleration;
+    }
+
+    //apply drag if on ground
+    else if (isGrounded())
+    {
+        if (newVelocity.x > 0)
+        {
+            newAcceleration.x = -groundDrag;
+            setMaxXVelocity({0, maxSpeed});
+        }
+        else
+        {
+            newAcceleration.x = groundDrag;
+            setMaxXVelocity({-maxSpeed, 0});
+        }
+    }
+    //apply drag in air
+    else
+    {
+        if (newVelocity.x > 0)
+        {
+            newAcceleration.x = -airDrag;
+            setMaxXVelocity({0, maxSpeed});
+        }
+        else
+        {
+            newAcceleration.x = airDrag;
+            setMaxXVelocity({-maxSpeed, 0});
+        }
+    }
+
+    setVelocity(newVelocity);
+    setAcceleration(newAcceleration);
+}
+
+void Fighter::boundsCheck()
+{
+    if (getPosition().y < -arenaHeight - getScale().y / 2)
+        tryTeleport({getPosition().x, arenaHeight + getScale().y});
+
+    if (getPosition().x < -arenaWidth - getScale().x / 2)
+        tryTeleport({getPosition().x + 2 * arenaWidth + getScale().x, getPosition().y});
+
+    if (getPosition().x > arenaWidth + getScale().x / 2)
+        tryTeleport({getPosition().x - 2 * arenaWidth - getScale().x, getPosition().y});
+}
+
+bool Fighter::checkDeath() const
+{
+    //check if headcheck collider intersects with any players
+    ArenaVector<Collider*> headCheckResult;
+    headCheck.checkIntersection(headCheckResult);
+
+    for (Collider* collider : headCheckResult)
+    {
+        //kill if collider is a player
+        if (collider->hasTag(ColliderTag::PLAYER))
+            return true;
+    }
+
+    //deadly collider check
+    if (checkTag(ColliderTag::DEADLY))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+bool Fighter::isGrounded() const
+{
+    ArenaVector<Collider*> ground;
+    groundCheck.checkIntersection(ground);
+
+    //check if there is any non deadly collider under the player
+    for (Collider* collider : ground)
+    {
+        //ignore deadly colliders
+        if (!collider->hasTag(ColliderTag::DEADLY))
+            return true;
+    }
+
+    return false;
+}
+
+void Fighter::update()
+{
+    boundsCheck();
+
+    if (checkDeath())
+    {
+        hasDied = true;
+        setVelocity({0, 0});
+        setAcceleration({0, 0});
+    }
+}
+
+void Fighter::prePhysicsUpdate()
+{
+    if (!hasDied)
+        controlFighter();
+}
+
+void Fighter::reset(const Vector2& resetPosition)
+{
+    hasDied = false;
+    setPosition(resetPosition);
+    clearTags();
+}
+
+bool Fighter::isDead() const { return hasDied; }
+
+PlayerView Fighter::getView() const
+{
+    PlayerView view;
+    view.position = getPosition();
+    view.velocity = getVelocity();
+    view.grounded = isGrounded();
+    view.dead = hasDied;
+    return view;
+}
+
+void Fighter::setController(PlayerController* const controller) { this->controller = controller; }
+
+void Fighter::setOpponent(const Fighter* const opponent) { this->opponent = opponent; }
+
+void Fighter::setArena(const double width, const double height)
+{
+    arenaWidth = width;
+    arenaHeight = height;
+}
+
+void Fighter::saveState(State& state) const
+{
+    PhysicsObject::saveState(state.physics);
+    state.dead = hasDied;
+}
+
+void Fighter::loadState(const State& state)
+{
+    PhysicsObject::loadState(state.physics);
+    hasDied = state.dead;
+}
+
+void Fighter::hashState(StateHasher& hasher) const
+{
+    PhysicsObject::hashState(hasher);
+    hasher.add(hasDied);
+}
@@ -0,0 +1,82 @@
+#include "filewatcher.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "memtrace.h"
+
+FileWatcher::FileWatcher()
+: inotifyDescriptor(-1), watchDescriptor(-1)
+{
+
+}
+
+FileWatcher::~FileWatcher()
+{
+    #ifdef __linux__
+    if (inotifyDescriptor >= 0)
+        close(inotifyDescriptor);
+    #endif
+}
+
+bool FileWatcher::watch(const std::string& directory)
+{
+    #ifdef __linux__
+    if (inotifyDescriptor < 0)
+        inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (inotifyDescriptor < 0)
+        return false;
+
+    if (watchDescriptor >= 0)
+        inotify_rm_watch(inotifyDescriptor, watchDescriptor);
+
+    //editors either rewrite the file or move a new one in its place
+    watchDescriptor = inotify_add_watch(inotifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    return watchDescriptor >= 0;
+    #else
+    (void)directory;
+    return false;
+    #endif
+}
+
+bool FileWatcher::isWatching() const
+{
+    return watchDescriptor >= 0;
+}
+
+void FileWatcher::poll(std::vector<std::string>& changedFiles)
+{
+    changedFiles.clear();
+
+    #ifdef __linux__
+    if (watchDescriptor < 0)
+        return;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+    {
+        ssize_t length = read(inotifyDescriptor, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0)
+                continue;
+
+            //a save often arrives as several events for the same file
+            std::string name = event->name;
+            if (std::find(changedFiles.begin(), changedFiles.end(), name) == changedFiles.end())
+                changedFiles.push_back(name);
+        }
+    }
+    #endif
+}
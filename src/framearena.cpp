@@ -0,0 +1,223 @@
+#include "framearena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#include "memtrace.h"
+
+std::atomic<size_t> FrameArena::strayAllocations(0);
+
+//plain thread locals, the allocation hook must not construct the thread's arena
+static thread_local size_t openScopes = 0;
+static thread_local bool strayReported = false;
+static thread_local bool allocationsIgnored = false;
+
+FrameArena::Scope::Scope()
+: arena(FrameArena::getThreadArena()), marker(arena.getMarker()), previousFloor(arena.floor)
+{
+    if (openScopes++ == 0)
+        strayReported = false;
+    arena.scopeDepth++;
+    arena.floor = marker;
+}
+
+FrameArena::Scope::~Scope()
+{
+    arena.rewind(marker);
+    arena.floor = previousFloor;
+    arena.scopeDepth--;
+    openScopes--;
+}
+
+FrameArena::FrameArena(const size_t initialSize)
+: blocks(), blockIndex(0), offset(0), initialSize(initialSize), used(0), peak(0), scopeDepth(0), floor({0, 0, 0})
+{
+    if (initialSize == 0)
+        throw std::invalid_argument("frame arena block size must be positive");
+}
+
+FrameArena::~FrameArena()
+{
+    releaseBlocks();
+}
+
+void FrameArena::releaseBlocks()
+{
+    for (Block& block : blocks)
+        free(block.data);
+
+    blocks.clear();
+    blockIndex = 0;
+    offset = 0;
+}
+
+void FrameArena::grow(const size_t size, const size_t alignment)
+{
+    const size_t needed = size + alignment;
+    if (!blocks.empty())
+    {
+        //the tail of the current block stays unused until the rewind
+        used += blocks[blockIndex].size - offset;
+
+        if (blockIndex + 1 < blocks.size() && blocks[blockIndex + 1].size >= needed)
+        {
+            blockIndex++;
+            offset = 0;
+            return;
+        }
+
+        //the later blocks are free, the too small ones are replaced
+        for (size_t i = blockIndex + 1; i < blocks.size(); i++)
+            free(blocks[i].data);
+        blocks.resize(blockIndex + 1);
+    }
+
+    size_t blockSize = std::max(needed, blocks.empty() ? initialSize : 2 * blocks.back().size);
+    Block block;
+    block.data = static_cast<char*>(malloc(blockSize));
+    if (block.data == nullptr)
+        throw std::bad_alloc();
+    block.size = blockSize;
+
+    //the bookkeeping of the arena is not a stray allocation of the tick
+    allocationsIgnored = true;
+    try
+    {
+        blocks.push_back(block);
+    }
+    catch (...)
+    {
+        allocationsIgnored = false;
+        free(block.data);
+        throw;
+    }
+    allocationsIgnored = false;
+
+    blockIndex = blocks.size() - 1;
+    offset = 0;
+}
+
+void* FrameArena::allocate(const size_t size, const size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument("alignment must be a power of two");
+
+    if (blocks.empty())
+        grow(size, alignment);
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(blocks[blockIndex].data);
+    size_t start = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    if (start + size > blocks[blockIndex].size)
+    {
+        grow(size, alignment);
+        base = reinterpret_cast<uintptr_t>(blocks[blockIndex].data);
+        start = ((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+    }
+
+    used += start + size - offset;
+    offset = start + size;
+    peak = std::max(peak, used);
+    return blocks[blockIndex].data + start;
+}
+
+void FrameArena::deallocate(void* pointer, const size_t size)
+{
+    //a growing container usually frees its last buffer, that one can be reused at once,
+    //but the buffers of the outer scopes stay, their scopes rewind past them
+    char* top = blocks.empty() ? nullptr : blocks[blockIndex].data + offset;
+    if (top != nullptr && static_cast<char*>(pointer) + size == top
+        && (blockIndex > floor.block || offset - size >= floor.offset))
+    {
+        offset -= size;
+        used -= size;
+    }
+}
+
+FrameArena::Marker FrameArena::getMarker() const
+{
+    Marker marker;
+    marker.block = blockIndex;
+    marker.offset = offset;
+    marker.used = used;
+    return marker;
+}
+
+void FrameArena::rewind(const Marker& marker)
+{
+    if (marker.block > blockIndex || (marker.block == blockIndex && marker.offset > offset))
+        throw std::out_of_range("frame arena marker is ahead of the arena");
+
+    blockIndex = marker.block;
+    offset = marker.offset;
+    used = marker.used;
+
+    //an empty arena merges its blocks, so the next frame fits into one
+    if (blockIndex == 0 && offset == 0 && blocks.size() > 1)
+    {
+        size_t capacity = getCapacity();
+        releaseBlocks();
+        grow(capacity, 1);
+        used = 0;
+    }
+}
+
+void FrameArena::reset()
+{
+    Marker marker;
+    marker.block = 0;
+    marker.offset = 0;
+    marker.used = 0;
+    rewind(marker);
+}
+
+size_t FrameArena::getUsed() const { return used; }
+
+size_t FrameArena::getPeak() const { return peak; }
+
+size_t FrameArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (const Block& block : blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+size_t FrameArena::getBlockCount() const { return blocks.size(); }
+
+size_t FrameArena::getScopeDepth() const { return scopeDepth; }
+
+FrameArena& FrameArena::getThreadArena()
+{
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+FrameArena* FrameArena::getActive()
+{
+    if (openScopes == 0)
+        return nullptr;
+
+    return &getThreadArena();
+}
+
+void FrameArena::reportStrayAllocation(const size_t size)
+{
+    if (openScopes == 0 || allocationsIgnored)
+        return;
+
+    strayAllocations++;
+    if (strayReported)
+        return;
+
+    //only the first one of a tick is printed, the output must not flood the console
+    strayReported = true;
+    allocationsIgnored = true;
+    std::fprintf(stderr, "stray allocation of %zu bytes inside a frame arena scope\n", size);
+    allocationsIgnored = false;
+}
+
+size_t FrameArena::getStrayAllocationCount() { return strayAllocations; }
@@ -1,6 +1,10 @@
 #ifndef CPORTA
 #include "gamemanager.h"
 
+#include "framearena.h"
+
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 
 GameManager::GameManager()
@@ -15,6 +19,14 @@ GameManager::GameManager()
   timeUntilReset(0),
   shouldReset(false)
 {
+    //the controllers see the other player
+    player1.setOpponent(&player2);
+    player2.setOpponent(&player1);
+
+    #ifdef MAP_HOT_RELOAD
+    mapManager.enableHotReload();
+    #endif
+
     resetGame();
 
 }
@@ -27,7 +39,6 @@ GameManager& GameManager::getInstance()
 
 void GameManager::shutDown()
 {
-    textHandler.cleanUp();
     mapManager.unloadMap();
 }
 
@@ -44,11 +55,20 @@ void GameManager::checkForWin()
 
         if (player2Score >= scoreToWin)
         {
-            textHandler.displayText(player2Name + " won!", player2Color);
+            ArenaString message(player2Name.c_str());
+            message += " won!";
+            textHandler.displayText(message, player2Color);
+            prepareNextMap();
         }
         else
         {
-            textHandler.displayText(player2Name + " scored " + std::to_string(player2Score) + "/" + std::to_string(scoreToWin), player2Color);
+            //the message is built in the tick's arena, the short numbers fit into the small string buffer
+            ArenaString message(player2Name.c_str());
+            message += " scored ";
+            message += std::to_string(player2Score).c_str();
+            message += "/";
+            message += std::to_string(scoreToWin).c_str();
+            textHandler.displayText(message, player2Color);
         }
     }
 
@@ -63,11 +83,20 @@ void GameManager::checkForWin()
 
         if (player1Score >= mapManager.getScoreToWin())
         {
-            textHandler.displayText(player1Name + " won!", player1Color);
+            ArenaString message(player1Name.c_str());
+            message += " won!";
+            textHandler.displayText(message, player1Color);
+            prepareNextMap();
         }
         else
         {
-            textHandler.displayText(player1Name + " scored " + std::to_string(player1Score) + "/" + std::to_string(scoreToWin), player1Color);
+            //the message is built in the tick's arena, the short numbers fit into the small string buffer
+            ArenaString message(player1Name.c_str());
+            message += " scored ";
+            message += std::to_string(player1Score).c_str();
+            message += "/";
+            message += std::to_string(scoreToWin).c_str();
+            textHandler.displayText(message, player1Color);
         }
     }
 
@@ -100,7 +129,7 @@ void GameManager::resetGame()
         player1Score = 0;
         player2Score = 0;
     }
-    //load the current map again
+    //reset the current map, its instance is kept
     else
     {
         mapManager.loadMap(getMapId());
@@ -109,6 +138,9 @@ void GameManager::resetGame()
     //rest player positions
     player1.reset(mapManager.getPlayerPosition(0));
     player2.reset(mapManager.getPlayerPosition(1));
+
+    //the ground under the players has to exist before the first physics update
+    streamMap(SIZE_MAX);
 }
 
 size_t GameManager::getMapId() const
@@ -122,6 +154,26 @@ void GameManager::nextMap()
     mapManager.loadMap(getMapId());    
 }
 
+void GameManager::prepareNextMap()
+{
+    mapManager.prepareMapAsync((round + 1) % mapManager.getMapCount());
+}
+
+void GameManager::streamMap(const size_t maxChanges)
+{
+    Vector2 focusMin = Renderer::getViewMin();
+    Vector2 focusMax = Renderer::getViewMax();
+
+    for (const Player* player : {&player1, &player2})
+    {
+        Vector2 position = player->getPosition();
+        focusMin = Vector2(std::min(focusMin.x, position.x), std::min(focusMin.y, position.y));
+        focusMax = Vector2(std::max(focusMax.x, position.x), std::max(focusMax.y, position.y));
+    }
+
+    mapManager.streamChunks(focusMin, focusMax, maxChanges);
+}
+
 void GameManager::update()
 {
     if (!shouldReset)
@@ -132,6 +184,12 @@ void GameManager::update()
     {
         countReset();
     }
+
+    #ifdef MAP_HOT_RELOAD
+    mapManager.pollHotReload();
+    #endif
+
+    streamMap(chunksPerFrame);
 }
 
 double GameManager::getMapWidth() const
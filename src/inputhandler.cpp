@@ -1,22 +1,31 @@
 #ifndef CPORTA
 #include "inputhandler.h"
+#include "logger.h"
+#include "world.h"
 
-std::unordered_set<SDL_Keycode> InputHandler::pressedKeys{std::unordered_set<SDL_Keycode>()};
+InputQueue InputHandler::events;
 
 void InputHandler::handleEvent(SDL_Event& event)
 {
-    if (event.type == SDL_EVENT_KEY_DOWN)
+    if ((event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat) || event.type == SDL_EVENT_KEY_UP)
     {
-        pressedKeys.insert(event.key.key);
-    }
-    else if (event.type == SDL_EVENT_KEY_UP)
-    {
-        pressedKeys.erase(event.key.key);
+        KeyEvent keyEvent;
+        keyEvent.time = event.key.timestamp;
+        keyEvent.key = event.key.key;
+        keyEvent.pressed = event.type == SDL_EVENT_KEY_DOWN;
+
+        if (!events.record(keyEvent))
+            LOG_WARNING("Input queue is full, key event dropped");
     }
 }
 
+void InputHandler::applyEvents(const uint64_t time)
+{
+    events.apply(World::getCurrent(), time);
+}
+
 bool InputHandler::isKeyPressed(SDL_Keycode key)
 {
-    return pressedKeys.count(key);
+    return World::getCurrent().isKeyPressed(key);
 }
 #endif // CPORTA
\ No newline at end of file
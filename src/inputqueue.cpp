@@ -0,0 +1,43 @@
+#include "inputqueue.h"
+#include "world.h"
+
+#include "memtrace.h"
+
+InputQueue::InputQueue(const size_t capacity)
+: events(capacity), droppedCount(0), overflowed(false)
+{
+
+}
+
+bool InputQueue::record(const KeyEvent& event)
+{
+    if (events.push(event))
+        return true;
+
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    overflowed.store(true, std::memory_order_release);
+    return false;
+}
+
+size_t InputQueue::apply(World& world, const uint64_t time)
+{
+    size_t applied = 0;
+    for (const KeyEvent* event = events.front(); event != nullptr && event->time <= time; event = events.front())
+    {
+        world.setKeyPressed(event->key, event->pressed);
+
+        KeyEvent consumed;
+        events.pop(consumed);
+        applied++;
+    }
+
+    //a lost key release would leave the key held forever
+    if (events.front() == nullptr && overflowed.exchange(false, std::memory_order_acq_rel))
+        world.releaseAllKeys();
+
+    return applied;
+}
+
+size_t InputQueue::getPendingCount() const { return events.size(); }
+
+size_t InputQueue::getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
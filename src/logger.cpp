@@ -0,0 +1,412 @@
+#include "logger.h"
+
+#ifndef CPORTA
+#include <SDL3/SDL.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "memtrace.h"
+
+std::atomic<int> Logger::level {(int)LogLevel::INFO};
+std::atomic<uint32_t> Logger::burstLimit {10};
+std::atomic<uint64_t> Logger::windowLength {1000000000ull};
+
+std::atomic<bool> Logger::running {false};
+std::atomic<size_t> Logger::queued {0};
+std::atomic<size_t> Logger::written {0};
+std::atomic<size_t> Logger::dropped {0};
+size_t Logger::reportedDrops = 0;
+
+std::thread Logger::writer;
+std::mutex Logger::outputMutex;
+FILE* Logger::output = nullptr;
+std::string Logger::text;
+uint64_t Logger::startTime = Logger::now();
+
+/**
+ * @brief Kiolvas egy értéket a bejegyzés paraméterei közül, és továbblépteti a pozíciót.
+ */
+template <typename T>
+static T readValue(const char* payload, size_t& offset)
+{
+    T value;
+    std::memcpy(&value, payload + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+}
+
+/**
+ * @brief A formátum jelzői után írja a hosszmódosítót és a konverziót.
+ */
+static const char* completeSpec(char* spec, const size_t length, const char* modifier, const char conversion)
+{
+    size_t end = length;
+    for (const char* c = modifier; *c != '\0'; c++)
+        spec[end++] = *c;
+
+    spec[end++] = conversion;
+    spec[end] = '\0';
+    return spec;
+}
+
+MpscQueue<Logger::Entry>& Logger::getQueue()
+{
+    static MpscQueue<Entry> queue(queueCapacity);
+    return queue;
+}
+
+uint64_t Logger::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool Logger::allow(Site& site, const uint64_t time, uint32_t& suppressed)
+{
+    const uint32_t limit = burstLimit.load(std::memory_order_relaxed);
+    if (limit == 0)
+        return true;
+
+    //the thread that moves the window start collects the count of the previous window
+    uint64_t start = site.windowStart.load(std::memory_order_relaxed);
+    if (time - start >= windowLength.load(std::memory_order_relaxed)
+        && site.windowStart.compare_exchange_strong(start, time, std::memory_order_relaxed))
+    {
+        site.windowCount.store(0, std::memory_order_relaxed);
+        suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    }
+
+    if (site.windowCount.fetch_add(1, std::memory_order_relaxed) < limit)
+        return true;
+
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::submit(const Entry& entry)
+{
+    if (running.load(std::memory_order_acquire))
+    {
+        if (getQueue().push(entry))
+            queued.fetch_add(1, std::memory_order_release);
+        else
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    emit(entry);
+}
+
+void Logger::writerLoop()
+{
+    while (running.load(std::memory_order_acquire))
+    {
+        //the producers never wake the writer, an empty queue is polled
+        if (drain() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+size_t Logger::drain()
+{
+    std::lock_guard<std::mutex> lock(outputMutex);
+    MpscQueue<Entry>& queue = getQueue();
+
+    Entry entry;
+    size_t count = 0;
+    while (queue.pop(entry))
+    {
+        emit(entry);
+        count++;
+        written.fetch_add(1, std::memory_order_release);
+    }
+
+    const size_t lost = dropped.load(std::memory_order_relaxed);
+    if (lost != reportedDrops)
+    {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%zu log messages were dropped, the queue was full", lost - reportedDrops);
+        emitLine(LogLevel::WARNING, now(), line);
+        reportedDrops = lost;
+    }
+
+    return count;
+}
+
+void Logger::emit(const Entry& entry)
+{
+    format(entry, text);
+    if (entry.suppressed > 0)
+    {
+        char suffix[64];
+        std::snprintf(suffix, sizeof(suffix), " (%u similar messages suppressed)", (unsigned)entry.suppressed);
+        text += suffix;
+    }
+
+    emitLine(entry.level, entry.time, text.c_str());
+}
+
+void Logger::emitLine(const LogLevel level, const uint64_t time, const char* line)
+{
+    #ifndef CPORTA
+    if (output == nullptr)
+    {
+        static const SDL_LogPriority priorities[] = {SDL_LOG_PRIORITY_VERBOSE, SDL_LOG_PRIORITY_INFO, SDL_LOG_PRIORITY_WARN, SDL_LOG_PRIORITY_ERROR};
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, priorities[(int)level], "%s", line);
+        return;
+    }
+    #endif
+
+    static const char* const names[] = {"VERBOSE", "INFO", "WARNING", "ERROR"};
+    FILE* file = output != nullptr ? output : stderr;
+    const double seconds = time > startTime ? (time - startTime) / 1e9 : 0;
+    std::fprintf(file, "[%10.3f] %s: %s\n", seconds, names[(int)level], line);
+}
+
+void Logger::format(const Entry& entry, std::string& result)
+{
+    result.clear();
+
+    char spec[32];
+    char buffer[256];
+    char string[payloadSize + 1];
+    size_t offset = 0;
+    for (const char* c = entry.format; *c != '\0'; c++)
+    {
+        if (*c != '%')
+        {
+            result += *c;
+            continue;
+        }
+
+        c++;
+        if (*c == '%')
+        {
+            result += '%';
+            continue;
+        }
+
+        //flags, width and precision are kept, the length comes from the stored argument
+        size_t length = 0;
+        spec[length++] = '%';
+        while (*c != '\0' && std::strchr("-+ #0123456789.", *c) != nullptr)
+        {
+            if (length < sizeof(spec) - 4)
+                spec[length++] = *c;
+            c++;
+        }
+
+        while (*c != '\0' && std::strchr("hlLqjzt", *c) != nullptr)
+            c++;
+
+        if (*c == '\0')
+            break;
+
+        const char conversion = *c;
+        if (offset >= entry.size)
+        {
+            result += entry.truncated ? "..." : "<missing>";
+            continue;
+        }
+
+        const bool realConversion = std::strchr("feEgGaA", conversion) != nullptr;
+        const bool unsignedConversion = std::strchr("uoxX", conversion) != nullptr;
+        const char tag = entry.payload[offset++];
+        switch (tag)
+        {
+            case 'i':
+            {
+                const long long value = readValue<long long>(entry.payload, offset);
+                if (realConversion)
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "", conversion), (double)value);
+                else if (unsignedConversion)
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "ll", conversion), (unsigned long long)value);
+                else if (conversion == 'c')
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "", 'c'), (int)value);
+                else
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "ll", 'd'), value);
+                break;
+            }
+
+            case 'u':
+            {
+                const unsigned long long value = readValue<unsigned long long>(entry.payload, offset);
+                if (realConversion)
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "", conversion), (double)value);
+                else if (unsignedConversion)
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "ll", conversion), value);
+                else if (conversion == 'c')
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "", 'c'), (int)value);
+                else
+                    std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "ll", 'u'), value);
+                break;
+            }
+
+            case 'f':
+            {
+                const double value = readValue<double>(entry.payload, offset);
+                std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "", realConversion ? conversion : 'g'), value);
+                break;
+            }
+
+            case 's':
+            {
+                const uint16_t size = readValue<uint16_t>(entry.payload, offset);
+                std::memcpy(string, entry.payload + offset, size);
+                string[size] = '\0';
+                offset += size;
+                std::snprintf(buffer, sizeof(buffer), completeSpec(spec, length, "", 's'), string);
+                break;
+            }
+
+            case 'p':
+            {
+                const void* value = readValue<const void*>(entry.payload, offset);
+                std::snprintf(buffer, sizeof(buffer), "%p", value);
+                break;
+            }
+
+            default:
+                //an unknown tag means a corrupted entry, the rest is not read
+                result += "<invalid>";
+                return;
+        }
+
+        result += buffer;
+    }
+}
+
+char* Logger::reserve(Entry& entry, const char tag, const size_t size)
+{
+    //once an argument is left out, the later ones are not stored either
+    if (entry.truncated || entry.size + 1 + size > payloadSize)
+    {
+        entry.truncated = true;
+        return nullptr;
+    }
+
+    entry.payload[entry.size] = tag;
+    char* target = entry.payload + entry.size + 1;
+    entry.size += (uint16_t)(1 + size);
+    return target;
+}
+
+void Logger::encode(Entry& entry, const long long value)
+{
+    char* target = reserve(entry, 'i', sizeof(value));
+    if (target != nullptr)
+        std::memcpy(target, &value, sizeof(value));
+}
+
+void Logger::encode(Entry& entry, const unsigned long long value)
+{
+    char* target = reserve(entry, 'u', sizeof(value));
+    if (target != nullptr)
+        std::memcpy(target, &value, sizeof(value));
+}
+
+void Logger::encode(Entry& entry, const double value)
+{
+    char* target = reserve(entry, 'f', sizeof(value));
+    if (target != nullptr)
+        std::memcpy(target, &value, sizeof(value));
+}
+
+void Logger::encode(Entry& entry, const char* value)
+{
+    encode(entry, std::string_view(value != nullptr ? value : "(null)"));
+}
+
+void Logger::encode(Entry& entry, const std::string& value)
+{
+    encode(entry, std::string_view(value));
+}
+
+void Logger::encode(Entry& entry, const std::string_view value)
+{
+    if (entry.truncated || entry.size + 1 + sizeof(uint16_t) > payloadSize)
+    {
+        entry.truncated = true;
+        return;
+    }
+
+    //the longest prefix that still fits is kept
+    const uint16_t size = (uint16_t)std::min(value.size(), payloadSize - entry.size - 1 - sizeof(uint16_t));
+    char* target = reserve(entry, 's', sizeof(size) + size);
+    std::memcpy(target, &size, sizeof(size));
+    std::memcpy(target + sizeof(size), value.data(), size);
+
+    if (size < value.size())
+        entry.truncated = true;
+}
+
+void Logger::encode(Entry& entry, const void* value)
+{
+    char* target = reserve(entry, 'p', sizeof(value));
+    if (target != nullptr)
+        std::memcpy(target, &value, sizeof(value));
+}
+
+void Logger::start()
+{
+    if (running.load(std::memory_order_acquire))
+        return;
+
+    //the queue is created before the exit handler, so it outlives the last drain
+    getQueue();
+    static const bool stopAtExit = std::atexit(stop) == 0;
+    (void)stopAtExit;
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread(writerLoop);
+}
+
+void Logger::stop()
+{
+    if (!running.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    writer.join();
+
+    //entries pushed while the writer was stopping
+    drain();
+}
+
+void Logger::flush()
+{
+    if (running.load(std::memory_order_acquire))
+    {
+        const size_t target = queued.load(std::memory_order_acquire);
+        while (written.load(std::memory_order_acquire) < target && running.load(std::memory_order_acquire))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    else
+    {
+        drain();
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::fflush(output != nullptr ? output : stderr);
+}
+
+void Logger::setLevel(const LogLevel level) { Logger::level.store((int)level, std::memory_order_relaxed); }
+
+LogLevel Logger::getLevel() { return (LogLevel)level.load(std::memory_order_relaxed); }
+
+void Logger::setRateLimit(const uint32_t messages, const uint64_t windowMilliseconds)
+{
+    burstLimit.store(messages, std::memory_order_relaxed);
+    windowLength.store(windowMilliseconds * 1000000ull, std::memory_order_relaxed);
+}
+
+void Logger::setOutput(FILE* const file)
+{
+    std::lock_guard<std::mutex> lock(outputMutex);
+    output = file;
+}
+
+size_t Logger::getDroppedCount() { return dropped.load(std::memory_order_relaxed); }
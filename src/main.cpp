@@ -1,15 +1,46 @@
 #ifndef CPORTA
 #include "gamemanager.h"
+#include "world.h"
+
+#include <algorithm>
+#include <thread>
 #endif
 
 #ifdef CPORTA
 #include "test.h"
 #endif
 
+#ifdef BENCHMARK
+#include "benchmark.h"
+#endif
+
+#include "mapgenerator.h"
+#include "netplay.h"
+#include "statehash.h"
+#include "tournament.h"
+
+#include <cstring>
+
 #include "memtrace.h"
 
-int main() 
+int main(int argc, char* argv[]) 
 { 
+    //map generation for benchmarks and soak tests, the game does not start
+    if (argc > 1 && std::strcmp(argv[1], "--generate-map") == 0)
+        return MapGenerator::runCommandLine(argc - 2, argv + 2);
+
+    //headless bot matches for balancing and throughput measurements
+    if (argc > 1 && std::strcmp(argv[1], "--tournament") == 0)
+        return Tournament::runCommandLine(argc - 2, argv + 2);
+
+    //rollback netplay between bots, over a simulated link or over UDP
+    if (argc > 1 && std::strcmp(argv[1], "--netplay") == 0)
+        return Netplay::runCommandLine(argc - 2, argv + 2);
+
+    //first differing tick of two state hash logs
+    if (argc > 1 && std::strcmp(argv[1], "--compare-hashes") == 0)
+        return StateHashLog::runCommandLine(argc - 2, argv + 2);
+
     //game behavior
     #ifndef CPORTA
     bool initSuccess = GameRuntime::init(1280, 720);
@@ -19,6 +50,14 @@ int main()
     if (initSuccess == false)
         return -1;
 
+    //the renderers only read the game state, so after the game logic they run next to each other
+    World& world = World::getCurrent();
+    world.setUpdateThreadCount(std::min(3u, std::max(1u, std::thread::hardware_concurrency()) - 1));
+    world.setPhaseDependencies(UpdatePriority::WALL_RENDERER, {UpdatePriority::GAME_LOGIC});
+    world.setPhaseDependencies(UpdatePriority::UI_RENDERER, {UpdatePriority::GAME_LOGIC});
+    world.setPhaseDependencies(UpdatePriority::OTHER, {UpdatePriority::PLAYER_RENDERER, UpdatePriority::WALL_RENDERER, UpdatePriority::UI_RENDERER});
+    world.setPhaseParallel(UpdatePriority::PLAYER_RENDERER, true);
+
     
     //access singleton to initialize game manager and start game
     GameManager::getInstance();
@@ -32,9 +71,14 @@ int main()
     #endif
 
     //test behavior
-    #ifdef CPORTA
+    #if defined(CPORTA) && !defined(BENCHMARK)
     TestRunner::start();
     #endif
 
+    //benchmark behavior
+    #if defined(CPORTA) && defined(BENCHMARK)
+    BenchmarkRunner::start();
+    #endif
+
     return 0;
 }
\ No newline at end of file
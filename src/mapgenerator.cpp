@@ -0,0 +1,335 @@
+#include "mapgenerator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+
+#include "memtrace.h"
+
+/**
+ * @brief Egyenletes eloszlású egész szám a [0, count) intervallumban.
+ *
+ * Az `std::uniform_int_distribution` implementációfüggő, ez nem.
+ */
+static uint64_t uniform(std::mt19937_64& random, const uint64_t count)
+{
+    return random() % count;
+}
+
+/**
+ * @brief A kettes alapú logaritmus 16 bites törtrésszel, 1 <= value < 2^30 esetén.
+ */
+static uint64_t log2Fixed(const uint64_t value)
+{
+    uint64_t integer = 0;
+    while ((value >> (integer + 1)) != 0)
+        integer++;
+
+    //the mantissa is in [1, 2) with 30 fraction bits, every squaring yields the next bit
+    uint64_t mantissa = value << (30 - integer);
+    uint64_t fraction = 0;
+    for (int bit = 15; bit >= 0; bit--)
+    {
+        mantissa = (mantissa * mantissa) >> 30;
+        if (mantissa >= (uint64_t)2 << 30)
+        {
+            mantissa >>= 1;
+            fraction |= (uint64_t)1 << bit;
+        }
+    }
+
+    return (integer << 16) | fraction;
+}
+
+/**
+ * @brief Kettő hatványa egy 16 bites törtkitevőre, 30 bites törtrésszel.
+ */
+static uint64_t exp2Fraction(const uint64_t exponent)
+{
+    //round(2^(2^-i) * 2^30) for i = 1..16
+    static const uint64_t factors[16] = {
+        1518500250, 1276901417, 1170923762, 1121280436, 1097253708, 1085434106, 1079572136, 1076653033,
+        1075196443, 1074468888, 1074105294, 1073923544, 1073832680, 1073787251, 1073764537, 1073753181
+    };
+
+    uint64_t result = (uint64_t)1 << 30;
+    for (int i = 0; i < 16; i++)
+    {
+        if (exponent & ((uint64_t)1 << (15 - i)))
+            result = (result * factors[i] + ((uint64_t)1 << 29)) >> 30;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Egész négyzetgyök, lefelé kerekítve.
+ */
+static uint64_t squareRoot(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value)
+        bit >>= 2;
+
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+            root >>= 1;
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/**
+ * @brief Egy [0, 1] közötti arány 16 bites fixpontos alakja.
+ */
+static uint64_t toFixedShare(const double share)
+{
+    return (uint64_t)std::llround(share * 65536);
+}
+
+static void appendNumber(std::string& text, const double value)
+{
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(buffer, result.ptr);
+}
+
+static void appendNumber(std::string& text, const int value)
+{
+    char buffer[16];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    text.append(buffer, result.ptr);
+}
+
+//the fixed point size math stays within 64 bits up to this size
+static constexpr double maxElementSize = 256;
+
+static void validate(const MapGenerator::Settings& settings)
+{
+    if (settings.elementCount < 2)
+        throw std::invalid_argument("element count must be at least 2");
+    if (!(settings.density > 0 && settings.density <= 1))
+        throw std::invalid_argument("density must be in (0, 1]");
+    if (!(settings.minSize > 0 && settings.minSize <= settings.maxSize && settings.maxSize <= maxElementSize))
+        throw std::invalid_argument("sizes must satisfy 0 < min size <= max size <= 256");
+    if (!(settings.deadlyShare >= 0 && settings.deadlyShare <= 1) || !(settings.bouncyShare >= 0 && settings.bouncyShare <= 1))
+        throw std::invalid_argument("shares must be in [0, 1]");
+}
+
+std::vector<MapGenerator::Element> MapGenerator::generateElements(const Settings& settings)
+{
+    validate(settings);
+
+    std::mt19937_64 random(settings.seed);
+
+    //lengths are counted in eighths with integer math, floating point results could differ between platforms
+    const uint64_t minSize = std::max<uint64_t>(1, std::llround(settings.minSize * 8));
+    const uint64_t maxSize = std::max<uint64_t>(minSize, std::llround(settings.maxSize * 8));
+    const uint64_t logRange = log2Fixed(maxSize) - log2Fixed(minSize);
+
+    //log-uniform: minSize * 2^(u * log2(maxSize / minSize))
+    auto drawSize = [&random, minSize, maxSize, logRange]()
+    {
+        uint64_t exponent = ((random() >> 32) * logRange) >> 32;
+        uint64_t size = ((minSize << (exponent >> 16)) * exp2Fraction(exponent & 0xFFFF) + ((uint64_t)1 << 29)) >> 30;
+        return std::min(size, maxSize);
+    };
+
+    //sizes first, the map area follows from them and the density
+    std::vector<Element> elements(settings.elementCount);
+    uint64_t area = 0;
+    for (size_t i = 2; i < elements.size(); i++)
+    {
+        uint64_t width = drawSize();
+        uint64_t height = drawSize();
+        elements[i].scale = Vector2(width / 8.0, height / 8.0);
+        area += width * height;
+    }
+
+    //twice as wide as high, like a wide screen
+    const uint64_t density = std::max<uint64_t>(1, toFixedShare(settings.density));
+    const uint64_t mapArea = std::max<uint64_t>(area / density * 65536 + area % density * 65536 / density, 64 * 64);
+    const uint64_t mapHeight = squareRoot(mapArea / 2);
+    const uint64_t mapWidth = 2 * mapHeight;
+
+    //the players start on two platforms
+    for (size_t i = 0; i < 2; i++)
+    {
+        int64_t x = (int64_t)(mapWidth + 2) / 4;
+        elements[i].position = Vector2((i == 0 ? -x : x) / 8.0, 0);
+        elements[i].scale = Vector2(4, 1);
+        elements[i].color = makeColor(100, 100, 100);
+        elements[i].deadly = false;
+        elements[i].bounciness = 0;
+    }
+
+    const uint64_t deadlyLimit = toFixedShare(settings.deadlyShare);
+    const uint64_t bouncyLimit = deadlyLimit + (((65536 - deadlyLimit) * toFixedShare(settings.bouncyShare)) >> 16);
+    for (size_t i = 2; i < elements.size(); i++)
+    {
+        Element& element = elements[i];
+        int64_t x = (int64_t)uniform(random, mapWidth + 1) - (int64_t)mapWidth / 2;
+        int64_t y = (int64_t)uniform(random, mapHeight + 1) - (int64_t)mapHeight / 2;
+        element.position = Vector2(x / 8.0, y / 8.0);
+
+        uint64_t kind = random() >> 48;
+        if (kind < deadlyLimit)
+        {
+            element.color = makeColor(200, 50, 50);
+            element.deadly = true;
+            element.bounciness = 0;
+        }
+        else if (kind < bouncyLimit)
+        {
+            element.color = makeColor(50, 200, 50);
+            element.deadly = false;
+            element.bounciness = settings.bounciness;
+        }
+        else
+        {
+            element.color = makeColor(100, 100, 100);
+            element.deadly = false;
+            element.bounciness = 0;
+        }
+    }
+
+    return elements;
+}
+
+std::string MapGenerator::generate(const Settings& settings)
+{
+    std::vector<Element> elements = generateElements(settings);
+
+    //the view shows the whole map
+    double mapHeight = 0;
+    for (const Element& element : elements)
+        mapHeight = std::max<double>(mapHeight, std::abs(element.position.y) + element.scale.y / 2);
+
+    std::string text;
+    text.reserve(64 + elements.size() * 48);
+
+    appendNumber(text, std::max(5.0, std::ceil(mapHeight) + 1));
+    text += "\n255 255 255\n3\n";
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        appendNumber(text, elements[i].position.x);
+        text += ' ';
+        appendNumber(text, elements[i].position.y + 1.5);
+        text += '\n';
+    }
+
+    for (const Element& element : elements)
+    {
+        appendNumber(text, element.position.x);
+        text += ' ';
+        appendNumber(text, element.position.y);
+        text += ' ';
+        appendNumber(text, element.scale.x);
+        text += ' ';
+        appendNumber(text, element.scale.y);
+        text += ' ';
+        appendNumber(text, (int)element.color.r);
+        text += ' ';
+        appendNumber(text, (int)element.color.g);
+        text += ' ';
+        appendNumber(text, (int)element.color.b);
+        text += element.deadly ? " 1 " : " 0 ";
+        appendNumber(text, element.bounciness);
+        text += " 1 1\n";
+    }
+
+    return text;
+}
+
+/**
+ * @brief Beolvas egy számot a parancssori paraméter értékéből.
+ */
+template <typename T>
+static bool parseValue(const char* value, T& result)
+{
+    const char* end = value + std::strlen(value);
+    std::from_chars_result parsed = std::from_chars(value, end, result);
+    return parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+int MapGenerator::runCommandLine(const int argc, const char* const argv[])
+{
+    if (argc < 1)
+    {
+        std::fprintf(stderr, "usage: --generate-map <file> [count=N] [density=D] [min-size=S] [max-size=S] [deadly=P] [bouncy=P] [bounciness=B] [seed=N]\n");
+        return 1;
+    }
+
+    Settings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const char* separator = std::strchr(argument, '=');
+        if (separator == nullptr)
+        {
+            std::fprintf(stderr, "invalid argument '%s', expected key=value\n", argument);
+            return 1;
+        }
+
+        std::string key(argument, separator);
+        const char* value = separator + 1;
+
+        bool valid;
+        if (key == "count") valid = parseValue(value, settings.elementCount);
+        else if (key == "density") valid = parseValue(value, settings.density);
+        else if (key == "min-size") valid = parseValue(value, settings.minSize);
+        else if (key == "max-size") valid = parseValue(value, settings.maxSize);
+        else if (key == "deadly") valid = parseValue(value, settings.deadlyShare);
+        else if (key == "bouncy") valid = parseValue(value, settings.bouncyShare);
+        else if (key == "bounciness") valid = parseValue(value, settings.bounciness);
+        else if (key == "seed") valid = parseValue(value, settings.seed);
+        else
+        {
+            std::fprintf(stderr, "unknown parameter '%s'\n", key.c_str());
+            return 1;
+        }
+
+        if (!valid)
+        {
+            std::fprintf(stderr, "invalid value for '%s': '%s'\n", key.c_str(), value);
+            return 1;
+        }
+    }
+
+    std::string text;
+    try
+    {
+        text = generate(settings);
+    }
+    catch (const std::invalid_argument& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+
+    std::ofstream file(argv[0], std::ios::binary);
+    file.write(text.data(), text.size());
+    if (!file)
+    {
+        std::fprintf(stderr, "failed to write %s\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("generated %s: %zu elements, seed %llu\n", argv[0], settings.elementCount, (unsigned long long)settings.seed);
+    return 0;
+}
@@ -2,10 +2,23 @@
 
 #ifndef CPORTA
 #include <SDL3/SDL.h>
-#include "wall.h"
 #endif // CPORTA
 
+#include "wall.h"
+#include "collider.h"
+#include "core.h"
+#include "logger.h"
+
+#include "textreader.h"
+
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <utility>
 
 #ifndef CPORTA
 #include <filesystem>
@@ -17,6 +30,8 @@
 #include <fstream>
 #include <string>
 #include <stdexcept>
+#include <system_error>
+#include <unordered_map>
 
 #include "memtrace.h"
 
@@ -28,117 +43,194 @@ MapManager::MapElement::MapElement(const Vector2& position, const Vector2& scale
 
 void MapManager::Map::addElement(const Vector2& position, const Vector2& scale, const Color& color, const bool deadly, const double bounciness, const Vector2& colliderRatio)
 {
-    elements.push_back(MapElement(position, scale, color, deadly, bounciness, colliderRatio));
+    elements.emplace_back(position, scale, color, deadly, bounciness, colliderRatio);
 }
 
 MapManager::MapManager()
-: mapCache(), mapInstance(), loadedMapId(0)
+: mapCache(), wallPool(), childLists(childListLimit), mapInstance(), mapColliders(), loadedMapId(0), mapLoaded(false),
+  streamingThreshold(defaultStreamingThreshold), chunkSize(defaultChunkSize), streamMargin(defaultStreamMargin), streaming(false),
+  chunks(), chunkGrid(defaultChunkSize), loadedChunks(), chunkScratch(), mapWatcher(), changedFiles(), pendingWalls(), pendingMapId(0)
 {
-    #ifndef CPORTA
-    //sort files by alphabetical order, because it's not guaranteed by the directory_iterator
-    std::vector<std::filesystem::directory_entry> files;
+    std::vector<std::string> files;
 
-    for (auto& p : std::filesystem::directory_iterator(std::filesystem::current_path()))
+    #ifndef CPORTA
+    for (const std::filesystem::directory_entry& p : std::filesystem::directory_iterator(std::filesystem::current_path()))
     {
         std::string filename = p.path().filename().string();
-        std::string extension = p.path().extension().string();
+        if (hasGamemapExtension(filename))
+            files.push_back(filename);
+    }
+    #else
+    files = getGamemapFiles();
+    #endif
 
-        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) -> char { return std::tolower(c, std::locale()); });
+    //the gamemap files get sorted based on ASCII alphabetical order, because it's not guaranteed by the directory listing
+    std::sort(files.begin(), files.end());
 
-        if (extension != ".gamemap")
-            continue;
+    loadMapFiles(files);
+}
+
+bool MapManager::hasGamemapExtension(const std::string& filename)
+{
+    static const char extension[] = ".gamemap";
+    const size_t extensionLength = sizeof(extension) - 1;
+
+    if (filename.size() < extensionLength)
+        return false;
+
+    //plain ASCII comparison, the locale does not matter for the extension
+    const char* suffix = filename.c_str() + filename.size() - extensionLength;
+    for (size_t i = 0; i < extensionLength; i++)
+    {
+        char c = suffix[i];
+        if (c >= 'A' && c <= 'Z')
+            c = c - 'A' + 'a';
 
-        files.push_back(p);
+        if (c != extension[i])
+            return false;
     }
 
-    //the gamemap files get sorted based on ASCII alphabetical order
-    std::sort(files.begin(), files.end(),
-            [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
-            {
-                return a.path().string() < b.path().string();
-            });
+    return true;
+}
+
+bool MapManager::readFile(const std::string& filename, std::string& content)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (size < 0)
+        return false;
+
+    content.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    file.read(&content[0], size);
 
-    for(auto& p : files)
+    return file.gcount() == size;
+}
+
+MapManager::Map MapManager::parseMap(const std::string& text)
+{
+    TextReader reader(text);
+    Map map = Map();
+
+    //map height
+    map.mapHeight = reader.readDouble("map height");
+
+    //map background color
+    int backgroundR = reader.readInt("background red");
+    int backgroundG = reader.readInt("background green");
+    int backgroundB = reader.readInt("background blue");
+    map.backgroundColor = makeColor(backgroundR, backgroundG, backgroundB);
+
+    //score to win
+    map.scoreToWin = reader.readInt("score to win");
+
+    //player positions
+    double player1PosX = reader.readDouble("player 1 x");
+    double player1PosY = reader.readDouble("player 1 y");
+    map.player1Position = {player1PosX, player1PosY};
+
+    double player2PosX = reader.readDouble("player 2 x");
+    double player2PosY = reader.readDouble("player 2 y");
+    map.player2Position = {player2PosX, player2PosY};
+
+    //read map elements until the end of the file, a trailing newline does not add an element
+    while (!reader.atEnd())
     {
-        std::string filename = p.path().filename().string();
-        std::string extension = p.path().extension().string();
-        
-        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) -> char { return std::tolower(c, std::locale()); });
+        double x = reader.readDouble("element x");
+        double y = reader.readDouble("element y");
+        double sizeX = reader.readDouble("element width");
+        double sizeY = reader.readDouble("element height");
+        int r = reader.readInt("element red");
+        int g = reader.readInt("element green");
+        int b = reader.readInt("element blue");
+        int deadly = reader.readInt("element deadly flag");
+        double bounciness = reader.readDouble("element bounciness");
+        double colliderRatioX = reader.readDouble("element collider ratio x");
+        double colliderRatioY = reader.readDouble("element collider ratio y");
 
-        if (extension != ".gamemap")
-            continue;
+        map.addElement({x, y}, {sizeX, sizeY}, makeColor(r, g, b), deadly, bounciness, {colliderRatioX, colliderRatioY});
+    }
 
-        std::ifstream file(filename);
-        if (!file.is_open())
+    return map;
+}
+
+void MapManager::loadMapFiles(const std::vector<std::string>& files)
+{
+    //every file gets its own result slot, so the workers never share anything but the counter
+    struct LoadResult
+    {
+        Map map;
+        bool loaded = false;
+        std::string error;
+    };
+
+    std::vector<LoadResult> results(files.size());
+    std::atomic<size_t> nextFile(0);
+
+    auto worker = [&files, &results, &nextFile]()
+    {
+        std::string content;
+        for (size_t i = nextFile++; i < files.size(); i = nextFile++)
         {
-            #ifndef CPORTA
-            SDL_Log("MapManager: Failed to open file: %s", filename.c_str());
-            #endif
-            continue;
+            if (!readFile(files[i], content))
+            {
+                results[i].error = "Failed to open file";
+                continue;
+            }
+
+            try
+            {
+                results[i].map = parseMap(content);
+                results[i].map.filename = files[i];
+                results[i].loaded = true;
+            }
+            catch (const ParseError& error)
+            {
+                results[i].error = error.what();
+            }
         }
-    #else
-    std::vector<std::string> files = getGamemapFiles();
+    };
 
-    std::sort(files.begin(), files.end());
+    //a few threads are enough to keep the disk busy, the calling thread works too
+    const size_t maxLoaderThreads = 4;
+    size_t threadCount = std::min<size_t>({std::max(1u, std::thread::hardware_concurrency()), files.size(), maxLoaderThreads});
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    try
+    {
+        for (size_t i = 1; i < threadCount; i++)
+            threads.emplace_back(worker);
+    }
+    catch (const std::system_error&)
+    {
+        //whatever the started threads do not take is done by this thread
+    }
 
-    for (const std::string& filename : files)
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    mapCache.reserve(mapCache.size() + files.size());
+    for (size_t i = 0; i < files.size(); i++)
     {
-        std::ifstream file(filename);
-        if (!file.is_open()) 
+        if (!results[i].loaded)
         {
             #ifndef CPORTA
-            SDL_Log("MapManager: Failed to open file: %s", filename.c_str());
+            LOG_ERROR("MapManager: %s: %s", files[i].c_str(), results[i].error.c_str());
             #endif
             continue;
         }
-    #endif
-
-        Map map = Map();
-        
-        //map height
-        double mapHeight;
-        file >> mapHeight;
-        map.mapHeight = mapHeight;
-
-        //map background color
-        //Color backgroundColor;
-        int backgroundR, backgroundG, backgroundB;
-        file >> backgroundR >> backgroundG >> backgroundB;
-        map.backgroundColor = makeColor(backgroundR, backgroundG, backgroundB);
-        
-        //score to win
-        int scoreToWin;
-        file >> scoreToWin;
-        map.scoreToWin = scoreToWin;
-
-        //player positions
-        double player1PosX, player1PosY;
-        file >> player1PosX >> player1PosY;
-        map.player1Position = {player1PosX, player1PosY};
-
-        double player2PosX, player2PosY;
-        file >> player2PosX >> player2PosY;
-        map.player2Position = {player2PosX, player2PosY};
-        
-        //read map elements
-        while (!file.eof() && !file.fail())
-        {
-            double x, y, sizeX, sizeY;
-            int r, g, b;
-            int deadly;
-            double bounciness;
-            double colliderRatioX, colliderRatioY;
-
-            file >> x >> y >> sizeX >> sizeY >> r >> g >> b >> deadly >> bounciness >> colliderRatioX >> colliderRatioY;
-
-            map.addElement({x, y}, {sizeX, sizeY}, makeColor(r, g, b), deadly, bounciness, {colliderRatioX, colliderRatioY});
-        }
 
-        mapCache.push_back(map);
+        mapCache.push_back(std::move(results[i].map));
         #ifndef CPORTA
-        SDL_Log("MapManager: Loaded map from file: %s", filename.c_str());
+        LOG_INFO("MapManager: Loaded map from file: %s", files[i].c_str());
         #endif // CPORTA
-        file.close();
     }
 }
 
@@ -158,7 +250,7 @@ std::vector<std::string> MapManager::getGamemapFiles() const
     while ((entry = readdir(dir)) != nullptr)
     {
         std::string name = entry->d_name;
-        if (name.size() >= 8 && name.substr(name.size() - 8) == ".gamemap")
+        if (hasGamemapExtension(name))
         {
             files.push_back(name);
         }
@@ -169,31 +261,312 @@ std::vector<std::string> MapManager::getGamemapFiles() const
 }
 #endif
 
-#ifndef CPORTA
-void MapManager::initializeMap(const Map& map)
+void MapManager::applyMapSettings(const Map& map)
 {
+    #ifndef CPORTA
     Renderer::setGameHeight(map.mapHeight);
     Renderer::setBackgroundColor(map.backgroundColor);
+    #else
+    (void)map;
+    #endif
+}
 
-    for (MapElement element : map.elements)
+Wall* MapManager::createWall(const MapElement& element)
+{
+    //shared by every deadly wall, so building a wall does not allocate a tag list
+    static const std::vector<ColliderTag> deadlyTags = {ColliderTag::DEADLY};
+    Transform::ChildListCache::Scope scope(childLists);
+
+    if (element.deadly)
+        return wallPool.create(Transform(nullptr, element.position, element.scale), element.color, element.bounciness, element.colliderRatio, deadlyTags);
+    else
+        return wallPool.create(Transform(nullptr, element.position, element.scale), element.color, element.bounciness, element.colliderRatio);
+}
+
+void MapManager::destroyWall(Wall* const wall)
+{
+    Transform::ChildListCache::Scope scope(childLists);
+    wallPool.destroy(wall);
+}
+
+void MapManager::initializeMap(const Map& map)
+{
+    applyMapSettings(map);
+
+    //large maps only get their chunks here, the walls are created around the players later
+    if (map.walls.size() >= streamingThreshold)
     {
-        Transform* wall;
-        if (element.deadly)
-            wall = new Wall(Transform(nullptr, element.position, element.scale), element.color, element.bounciness, element.colliderRatio, {ColliderTag::DEADLY});
-        else
-            wall = new Wall(Transform(nullptr, element.position, element.scale), element.color, element.bounciness, element.colliderRatio);
+        buildChunks(map);
+        #ifndef CPORTA
+        LOG_INFO("MapManager: Streaming %zu walls in %zu chunks", map.walls.size(), chunks.size());
+        #endif
+        return;
+    }
+
+    mapInstance.reserve(map.walls.size());
+    mapColliders.reserve(map.walls.size());
+    wallPool.reserve(map.walls.size());
+
+    for (const MapElement& element : map.walls)
+    {
+        Wall* wall = createWall(element);
         mapInstance.push_back(wall);
+        mapColliders.push_back(&wall->getCollider());
     }
+
+    #ifndef CPORTA
+    LOG_INFO("MapManager: Built %zu walls from %zu map elements, wall pool: %zu used, %zu capacity, %zu high-water mark",
+            map.walls.size(), map.elements.size(), wallPool.getOccupancy(), wallPool.getCapacity(), wallPool.getHighWaterMark());
+    #endif
 }
-#endif
+
+std::vector<MapManager::MapElement> MapManager::mergeElements(const std::vector<MapElement>& elements)
+{
+    std::vector<MapElement> merged = elements;
+
+    //alternate between the axes until no more elements can be merged
+    size_t mergeCount;
+    do
+    {
+        mergeCount = mergeElementsAlongAxis(merged, true);
+        mergeCount += mergeElementsAlongAxis(merged, false);
+    } while (mergeCount > 0);
+
+    return merged;
+}
+
+size_t MapManager::mergeElementsAlongAxis(std::vector<MapElement>& elements, const bool horizontal)
+{
+    VectorScalar Vector2::* along = horizontal ? &Vector2::x : &Vector2::y;
+    VectorScalar Vector2::* across = horizontal ? &Vector2::y : &Vector2::x;
+
+    //mergeable elements end up next to each other, ordered by their lower edge
+    auto key = [along, across](const MapElement& element)
+    {
+        return std::make_tuple(element.deadly, element.bounciness, element.colliderRatio.x, element.colliderRatio.y,
+                               element.color.r, element.color.g, element.color.b, element.color.a,
+                               element.position.*across, element.scale.*across,
+                               element.position.*along - element.scale.*along / 2);
+    };
+
+    std::sort(elements.begin(), elements.end(), [&key](const MapElement& a, const MapElement& b)
+    {
+        return key(a) < key(b);
+    });
+
+    std::vector<MapElement> merged;
+    merged.reserve(elements.size());
+
+    for (const MapElement& element : elements)
+    {
+        if (!merged.empty() && tryMergeElement(merged.back(), element, horizontal))
+            continue;
+
+        merged.push_back(element);
+    }
+
+    size_t mergeCount = elements.size() - merged.size();
+    elements = std::move(merged);
+    return mergeCount;
+}
+
+bool MapManager::tryMergeElement(MapElement& target, const MapElement& element, const bool horizontal)
+{
+    VectorScalar Vector2::* along = horizontal ? &Vector2::x : &Vector2::y;
+    VectorScalar Vector2::* across = horizontal ? &Vector2::y : &Vector2::x;
+
+    //every property that affects rendering or collision has to match
+    if (target.deadly != element.deadly || target.bounciness != element.bounciness || target.colliderRatio != element.colliderRatio)
+        return false;
+
+    if (target.color.r != element.color.r || target.color.g != element.color.g || target.color.b != element.color.b || target.color.a != element.color.a)
+        return false;
+
+    //the elements have to share the same extent on the other axis
+    if (target.position.*across != element.position.*across || target.scale.*across != element.scale.*across)
+        return false;
+
+    //a shrunk collider leaves gaps between neighbours, merging would close them
+    if (target.colliderRatio.*along != 1)
+        return false;
+
+    //skip degenerate elements
+    if (target.scale.x <= 0 || target.scale.y <= 0 || element.scale.x <= 0 || element.scale.y <= 0)
+        return false;
+
+    VectorScalar targetLow = target.position.*along - target.scale.*along / 2;
+    VectorScalar targetHigh = target.position.*along + target.scale.*along / 2;
+    VectorScalar elementLow = element.position.*along - element.scale.*along / 2;
+    VectorScalar elementHigh = element.position.*along + element.scale.*along / 2;
+
+    //there is a gap between the elements
+    if (elementLow > targetHigh || targetLow > elementHigh)
+        return false;
+
+    VectorScalar mergedLow = std::min(targetLow, elementLow);
+    VectorScalar mergedHigh = std::max(targetHigh, elementHigh);
+    VectorScalar mergedPosition = (mergedLow + mergedHigh) / 2;
+    VectorScalar mergedScale = mergedHigh - mergedLow;
+
+    //only merge if the new edges are exactly the same after rounding
+    if (mergedPosition - mergedScale / 2 != mergedLow || mergedPosition + mergedScale / 2 != mergedHigh)
+        return false;
+
+    target.position.*along = mergedPosition;
+    target.scale.*along = mergedScale;
+    return true;
+}
+
+void MapManager::buildChunks(const Map& map)
+{
+    //the chunk of a wall is the cell its center falls into
+    std::unordered_map<uint64_t, size_t> chunkOfCell;
+
+    for (size_t i = 0; i < map.walls.size(); i++)
+    {
+        const MapElement& element = map.walls[i];
+
+        int64_t cellX = (int64_t)std::floor(element.position.x / chunkSize);
+        int64_t cellY = (int64_t)std::floor(element.position.y / chunkSize);
+        uint64_t key = ((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellY;
+
+        //the collider may be larger than the wall itself
+        Vector2 halfSize(std::abs(element.scale.x) * std::max<VectorScalar>(1, element.colliderRatio.x) / 2,
+                         std::abs(element.scale.y) * std::max<VectorScalar>(1, element.colliderRatio.y) / 2);
+        Vector2 min = element.position - halfSize;
+        Vector2 max = element.position + halfSize;
+
+        auto found = chunkOfCell.find(key);
+        if (found == chunkOfCell.end())
+        {
+            chunkOfCell.emplace(key, chunks.size());
+            chunks.emplace_back();
+            chunks.back().min = min;
+            chunks.back().max = max;
+            chunks.back().wallIds.push_back(i);
+            chunks.back().loaded = false;
+            continue;
+        }
+
+        Chunk& chunk = chunks[found->second];
+        chunk.min = Vector2(std::min(chunk.min.x, min.x), std::min(chunk.min.y, min.y));
+        chunk.max = Vector2(std::max(chunk.max.x, max.x), std::max(chunk.max.y, max.y));
+        chunk.wallIds.push_back(i);
+    }
+
+    //the chunks do not move anymore, so the index can point into the list
+    for (Chunk& chunk : chunks)
+        chunkGrid.insert(&chunk, chunk.min, chunk.max);
+
+    streaming = true;
+}
+
+void MapManager::loadChunk(Chunk& chunk)
+{
+    const Map& map = mapCache[loadedMapId];
+
+    chunk.walls.reserve(chunk.wallIds.size());
+    wallPool.reserve(wallPool.getOccupancy() + chunk.wallIds.size());
+
+    for (size_t wallId : chunk.wallIds)
+        chunk.walls.push_back(createWall(map.walls[wallId]));
+
+    chunk.loaded = true;
+}
+
+void MapManager::unloadChunk(Chunk& chunk)
+{
+    //a chunk is small, the colliders leave the registry one by one in constant time
+    childLists.reserve(chunk.walls.size());
+    for (size_t i = chunk.walls.size(); i > 0; i--)
+        destroyWall(chunk.walls[i - 1]);
+    chunk.walls.clear();
+
+    chunk.loaded = false;
+}
+
+void MapManager::setStreaming(const size_t threshold, const double chunkSize, const double margin)
+{
+    streamingThreshold = threshold;
+    this->chunkSize = chunkSize > 0 ? chunkSize : defaultChunkSize;
+    streamMargin = margin > 0 ? margin : 0;
+}
+
+void MapManager::streamChunks(const Vector2& focusMin, const Vector2& focusMax, const size_t maxChanges)
+{
+    if (!streaming)
+        return;
+
+    size_t changes = 0;
+
+    //page out first, so the number of walls stays bounded
+    Vector2 keepMargin(2 * streamMargin, 2 * streamMargin);
+    Vector2 keepMin = focusMin - keepMargin;
+    Vector2 keepMax = focusMax + keepMargin;
+
+    for (size_t i = 0; i < loadedChunks.size() && changes < maxChanges;)
+    {
+        Chunk* chunk = loadedChunks[i];
+        if (chunk->max.x >= keepMin.x && chunk->min.x <= keepMax.x && chunk->max.y >= keepMin.y && chunk->min.y <= keepMax.y)
+        {
+            i++;
+            continue;
+        }
+
+        unloadChunk(*chunk);
+        loadedChunks[i] = loadedChunks.back();
+        loadedChunks.pop_back();
+        changes++;
+    }
+
+    Vector2 loadMargin(streamMargin, streamMargin);
+    chunkGrid.query(focusMin - loadMargin, focusMax + loadMargin, chunkScratch);
+
+    chunkScratch.erase(std::remove_if(chunkScratch.begin(), chunkScratch.end(), [](const Chunk* chunk) { return chunk->loaded; }), chunkScratch.end());
+
+    //the chunks nearest to the focus come first when the budget runs out
+    Vector2 center = (focusMin + focusMax) / 2;
+    std::sort(chunkScratch.begin(), chunkScratch.end(), [&center](const Chunk* a, const Chunk* b)
+    {
+        return ((a->min + a->max) / 2 - center).sqrLength() < ((b->min + b->max) / 2 - center).sqrLength();
+    });
+
+    for (size_t i = 0; i < chunkScratch.size() && changes < maxChanges; i++)
+    {
+        loadChunk(*chunkScratch[i]);
+        loadedChunks.push_back(chunkScratch[i]);
+        changes++;
+    }
+}
+
+bool MapManager::isStreaming() const { return streaming; }
+
+size_t MapManager::getChunkCount() const { return chunks.size(); }
+
+size_t MapManager::getLoadedChunkCount() const { return loadedChunks.size(); }
 
 void MapManager::discardMap()
 {
-    for (Transform* transform : mapInstance)
+    for (Chunk* chunk : loadedChunks)
+        unloadChunk(*chunk);
+    loadedChunks.clear();
+    chunkGrid.clear();
+    chunks.clear();
+    streaming = false;
+
+    //drop the whole map from the registries at once, the destructors skip them afterwards
+    Collider::unregisterColliders(mapColliders);
+    mapColliders.clear();
+
+    //reverse order, like the destruction of local variables
+    childLists.reserve(mapInstance.size());
+    for (size_t i = mapInstance.size(); i > 0; i--)
     {
-        delete transform;
+        destroyWall(mapInstance[i - 1]);
     }
     mapInstance.clear();
+
+    mapLoaded = false;
 }
 
 size_t MapManager::getMapCount() const { return mapCache.size(); }
@@ -228,24 +601,341 @@ double MapManager::getMapHeight() const
     return mapCache[loadedMapId].mapHeight;
 }
 
-#ifndef CPORTA
+Vector2 MapManager::getPlayerPosition(const size_t mapId, const size_t playerId) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    if (playerId >= 2)
+        throw std::out_of_range("player id out of range");
+
+    return playerId == 0 ? mapCache[mapId].player1Position : mapCache[mapId].player2Position;
+}
+
+int MapManager::getScoreToWin(const size_t mapId) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    return mapCache[mapId].scoreToWin;
+}
+
+double MapManager::getMapHeight(const size_t mapId) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    return mapCache[mapId].mapHeight;
+}
+
+void MapManager::createColliders(const size_t mapId, std::vector<Collider>& colliders) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    static const std::vector<ColliderTag> deadlyTags = {ColliderTag::DEADLY};
+
+    const Map& map = mapCache[mapId];
+    std::vector<MapElement> merged;
+    if (!map.wallsReady)
+        merged = mergeElements(map.elements);
+    const std::vector<MapElement>& walls = map.wallsReady ? map.walls : merged;
+
+    //moving a collider is cheap, but a single allocation is cheaper
+    colliders.reserve(colliders.size() + walls.size());
+    for (const MapElement& element : walls)
+    {
+        Transform transform(nullptr, element.position, Vector2(element.scale.x * element.colliderRatio.x, element.scale.y * element.colliderRatio.y));
+        if (element.deadly)
+            colliders.emplace_back(transform, ColliderType::INTERACTIVE, element.bounciness, deadlyTags);
+        else
+            colliders.emplace_back(transform, ColliderType::INTERACTIVE, element.bounciness);
+    }
+}
+
 void MapManager::loadMap(const size_t mapId) 
 {
+    //walls have no state that changes during a round, so the instance can stay
+    if (mapLoaded && mapId == loadedMapId)
+    {
+        applyMapSettings(mapCache[mapId]);
+        return;
+    }
+
     discardMap();
 
     if (mapId >= getMapCount())
         throw std::out_of_range("map id out of range");
 
     loadedMapId = mapId;
+    prepareMap(mapId);
     initializeMap(mapCache[mapId]);
+    mapLoaded = true;
 }
-#endif
 
 void MapManager::unloadMap()
 {
     discardMap();
 }
 
+std::vector<size_t> MapManager::matchWalls(const std::vector<MapElement>& oldWalls, const std::vector<MapElement>& newWalls)
+{
+    auto key = [](const MapElement& element)
+    {
+        return std::make_tuple(element.position.x, element.position.y, element.scale.x, element.scale.y,
+                               element.color.r, element.color.g, element.color.b, element.color.a,
+                               element.deadly, element.bounciness, element.colliderRatio.x, element.colliderRatio.y);
+    };
+
+    std::vector<size_t> oldOrder(oldWalls.size());
+    std::vector<size_t> newOrder(newWalls.size());
+    std::iota(oldOrder.begin(), oldOrder.end(), 0);
+    std::iota(newOrder.begin(), newOrder.end(), 0);
+
+    std::sort(oldOrder.begin(), oldOrder.end(), [&oldWalls, &key](const size_t a, const size_t b) { return key(oldWalls[a]) < key(oldWalls[b]); });
+    std::sort(newOrder.begin(), newOrder.end(), [&newWalls, &key](const size_t a, const size_t b) { return key(newWalls[a]) < key(newWalls[b]); });
+
+    //walk both sorted lists together, equal walls meet each other
+    std::vector<size_t> oldOfNew(newWalls.size(), notMatched);
+    size_t i = 0, j = 0;
+    while (i < oldOrder.size() && j < newOrder.size())
+    {
+        auto oldKey = key(oldWalls[oldOrder[i]]);
+        auto newKey = key(newWalls[newOrder[j]]);
+
+        if (oldKey < newKey)
+        {
+            i++;
+        }
+        else if (newKey < oldKey)
+        {
+            j++;
+        }
+        else
+        {
+            oldOfNew[newOrder[j]] = oldOrder[i];
+            i++;
+            j++;
+        }
+    }
+
+    return oldOfNew;
+}
+
+MapManager::MapPatch MapManager::reloadMap(const size_t mapId, const std::string& text)
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    //a broken file throws here, before anything changes
+    Map map = parseMap(text);
+    map.filename = mapCache[mapId].filename;
+    map.walls = mergeElements(map.elements);
+    map.wallsReady = true;
+
+    //the background merge still reads the old elements
+    if (pendingWalls.valid() && pendingMapId == mapId)
+        pendingWalls.get();
+
+    Map& oldMap = mapCache[mapId];
+    if (!oldMap.wallsReady)
+    {
+        oldMap.walls = mergeElements(oldMap.elements);
+        oldMap.wallsReady = true;
+    }
+
+    std::vector<size_t> oldOfNew = matchWalls(oldMap.walls, map.walls);
+
+    MapPatch patch = {0, 0, 0};
+    std::vector<bool> oldKept(oldMap.walls.size(), false);
+    for (size_t oldId : oldOfNew)
+    {
+        if (oldId != notMatched)
+        {
+            oldKept[oldId] = true;
+            patch.kept++;
+        }
+    }
+    patch.added = map.walls.size() - patch.kept;
+    patch.removed = oldMap.walls.size() - patch.kept;
+
+    bool live = mapLoaded && loadedMapId == mapId;
+
+    //a streamed map is cut into chunks again, the loaded ones come back with the next streamChunks calls
+    if (live && streaming)
+    {
+        for (Chunk* chunk : loadedChunks)
+            unloadChunk(*chunk);
+        loadedChunks.clear();
+        chunkGrid.clear();
+        chunks.clear();
+
+        mapCache[mapId] = std::move(map);
+        buildChunks(mapCache[mapId]);
+    }
+    else if (live)
+    {
+        //only the walls that differ are rebuilt, the rest keep their place and collider
+        childLists.reserve(oldKept.size());
+        for (size_t i = oldKept.size(); i > 0; i--)
+        {
+            if (!oldKept[i - 1])
+                destroyWall(mapInstance[i - 1]);
+        }
+
+        std::vector<Wall*> patchedInstance;
+        patchedInstance.reserve(map.walls.size());
+        for (size_t i = 0; i < map.walls.size(); i++)
+        {
+            if (oldOfNew[i] != notMatched)
+                patchedInstance.push_back(mapInstance[oldOfNew[i]]);
+            else
+                patchedInstance.push_back(createWall(map.walls[i]));
+        }
+        mapInstance.swap(patchedInstance);
+
+        mapColliders.clear();
+        for (Wall* wall : mapInstance)
+            mapColliders.push_back(&wall->getCollider());
+
+        mapCache[mapId] = std::move(map);
+    }
+    else
+    {
+        mapCache[mapId] = std::move(map);
+    }
+
+    if (live)
+        applyMapSettings(mapCache[mapId]);
+
+    return patch;
+}
+
+bool MapManager::enableHotReload()
+{
+    bool watching = mapWatcher.watch(".");
+
+    #ifndef CPORTA
+    if (watching)
+        LOG_INFO("MapManager: Watching the map files for changes");
+    else
+        LOG_WARNING("MapManager: Failed to watch the map files for changes");
+    #endif
+
+    return watching;
+}
+
+void MapManager::pollHotReload()
+{
+    if (!mapWatcher.isWatching())
+        return;
+
+    mapWatcher.poll(changedFiles);
+
+    for (const std::string& filename : changedFiles)
+    {
+        if (!hasGamemapExtension(filename))
+            continue;
+
+        size_t mapId = 0;
+        while (mapId < getMapCount() && mapCache[mapId].filename != filename)
+            mapId++;
+
+        if (mapId == getMapCount())
+        {
+            #ifndef CPORTA
+            LOG_INFO("MapManager: %s: new map files are loaded on the next start", filename.c_str());
+            #endif
+            continue;
+        }
+
+        std::string content;
+        if (!readFile(filename, content))
+        {
+            #ifndef CPORTA
+            LOG_ERROR("MapManager: %s: Failed to open file", filename.c_str());
+            #endif
+            continue;
+        }
+
+        try
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            MapPatch patch = reloadMap(mapId, content);
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            #ifndef CPORTA
+            LOG_INFO("MapManager: Reloaded %s in %.3f ms: %zu walls kept, %zu added, %zu removed",
+                    filename.c_str(), milliseconds, patch.kept, patch.added, patch.removed);
+            #else
+            (void)patch;
+            (void)milliseconds;
+            #endif
+        }
+        catch (const ParseError& error)
+        {
+            //the previous version of the map stays
+            #ifndef CPORTA
+            LOG_ERROR("MapManager: %s: %s", filename.c_str(), error.what());
+            #else
+            (void)error;
+            #endif
+        }
+    }
+}
+
+void MapManager::prepareMapAsync(const size_t mapId)
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    if (mapCache[mapId].wallsReady || (pendingWalls.valid() && pendingMapId == mapId))
+        return;
+
+    //the cache is not resized after loading, so the elements stay in place for the worker
+    const std::vector<MapElement>* elements = &mapCache[mapId].elements;
+    try
+    {
+        pendingWalls = std::async(std::launch::async, [elements]()
+        {
+            return mergeElements(*elements);
+        });
+        pendingMapId = mapId;
+    }
+    catch (const std::system_error& error)
+    {
+        //no thread available, the map is prepared on the main thread when loaded
+        #ifndef CPORTA
+        LOG_ERROR("MapManager: Failed to prepare map %zu in the background: %s", mapId, error.what());
+        #endif
+    }
+}
+
+void MapManager::prepareMap(const size_t mapId)
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    Map& map = mapCache[mapId];
+    if (map.wallsReady)
+        return;
+
+    if (pendingWalls.valid() && pendingMapId == mapId)
+        map.walls = pendingWalls.get();
+    else
+        map.walls = mergeElements(map.elements);
+
+    map.wallsReady = true;
+}
+
+bool MapManager::isMapPrepared(const size_t mapId) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    return mapCache[mapId].wallsReady;
+}
+
 #ifdef CPORTA
 std::string MapManager::getSerializedMapInfo(const size_t mapId)
 {
@@ -254,7 +944,7 @@ std::string MapManager::getSerializedMapInfo(const size_t mapId)
 
     std::stringstream stream;
 
-    Map map = mapCache[mapId];
+    const Map& map = mapCache[mapId];
     stream << map.mapHeight << " "
            << static_cast<int>(map.backgroundColor.r) << " "
            << static_cast<int>(map.backgroundColor.g) << " "
@@ -278,7 +968,7 @@ std::string MapManager::getSerializedMapElement(const size_t mapId, const size_t
 
     std::stringstream stream;
 
-    MapElement element = mapCache[mapId].elements[elementId];
+    const MapElement& element = mapCache[mapId].elements[elementId];
     stream << element.position.x << " " << element.position.y << " "
            << element.scale.x << " " << element.scale.y << " "
            << static_cast<int>(element.color.r) << " "
@@ -291,4 +981,62 @@ std::string MapManager::getSerializedMapElement(const size_t mapId, const size_t
 
     return stream.str();
 }
+
+size_t MapManager::getMergedElementCount(const size_t mapId) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    return mergeElements(mapCache[mapId].elements).size();
+}
+
+std::string MapManager::getSerializedMergedElement(const size_t mapId, const size_t elementId) const
+{
+    if (mapId >= getMapCount())
+        throw std::out_of_range("map id out of range");
+
+    std::vector<MapElement> merged = mergeElements(mapCache[mapId].elements);
+
+    if (elementId >= merged.size())
+        throw std::out_of_range("element id out of range");
+
+    std::stringstream stream;
+
+    const MapElement& element = merged[elementId];
+    stream << element.position.x << " " << element.position.y << " "
+           << element.scale.x << " " << element.scale.y << " "
+           << static_cast<int>(element.color.r) << " "
+           << static_cast<int>(element.color.g) << " "
+           << static_cast<int>(element.color.b) << " "
+           << element.deadly << " "
+           << element.bounciness << " "
+           << element.colliderRatio.x << " "
+           << element.colliderRatio.y;
+
+    return stream.str();
+}
+
+size_t MapManager::getLoadedWallCount() const { return mapInstance.size(); }
+
+Wall* MapManager::getLoadedWall(const size_t wallId) const
+{
+    if (wallId >= mapInstance.size())
+        throw std::out_of_range("wall id out of range");
+
+    return mapInstance[wallId];
+}
+
+std::string MapManager::getParseError(const std::string& text)
+{
+    try
+    {
+        parseMap(text);
+    }
+    catch (const ParseError& error)
+    {
+        return error.what();
+    }
+
+    return "";
+}
 #endif
\ No newline at end of file
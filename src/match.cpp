@@ -0,0 +1,171 @@
+#include "match.h"
+
+#include "statehash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "memtrace.h"
+
+Match::Match(const MapManager& maps, const size_t mapId, const double aspectRatio, const double physicsRate, const double resetTime)
+: scores({0, 0}),
+  resetTicks(0),
+  resetDelay((size_t)std::lround(resetTime * physicsRate)),
+  tick(0)
+{
+    world.setTargetFrameRate(physicsRate);
+    world.setTargetPhysicsRate(physicsRate);
+    world.setDeltaTime(1 / physicsRate);
+
+    //the walls and the fighters register in the world of the match
+    World::Scope scope(world);
+    maps.createColliders(mapId, walls);
+
+    double height = maps.getMapHeight(mapId);
+    for (size_t side = 0; side < fighters.size(); side++)
+    {
+        fighters[side].reset(new Fighter(&controllers[side]));
+        fighters[side]->setArena(height * aspectRatio, height);
+        spawns[side] = maps.getPlayerPosition(mapId, side);
+        fighters[side]->reset(spawns[side]);
+    }
+    fighters[0]->setOpponent(fighters[1].get());
+    fighters[1]->setOpponent(fighters[0].get());
+}
+
+void Match::updateRound()
+{
+    if (resetTicks > 0)
+    {
+        if (--resetTicks == 0)
+        {
+            for (size_t side = 0; side < fighters.size(); side++)
+                fighters[side]->reset(spawns[side]);
+        }
+        return;
+    }
+
+    bool dead1 = fighters[0]->isDead();
+    bool dead2 = fighters[1]->isDead();
+    if (!dead1 && !dead2)
+        return;
+
+    //a tie scores for nobody, like in the game
+    if (!dead1)
+        scores[0]++;
+    else if (!dead2)
+        scores[1]++;
+    resetTicks = std::max<size_t>(resetDelay, 1);
+}
+
+void Match::step(const PlayerInput& input1, const PlayerInput& input2)
+{
+    controllers[0].setInput(input1);
+    controllers[1].setInput(input2);
+
+    //one frame per physics step, in the order of the game loop
+    world.physicsUpdate();
+    world.update();
+    world.postUpdate();
+
+    updateRound();
+    tick++;
+}
+
+void Match::saveState(const size_t slot)
+{
+    if (slot >= savedStates.size())
+        savedStates.resize(slot + 1);
+
+    State& state = savedStates[slot];
+    fighters[0]->saveState(state.fighters[0]);
+    fighters[1]->saveState(state.fighters[1]);
+    state.scores = scores;
+    state.resetTicks = resetTicks;
+    state.tick = tick;
+}
+
+void Match::loadState(const size_t slot)
+{
+    if (slot >= savedStates.size())
+        throw std::out_of_range("no state saved in slot " + std::to_string(slot));
+
+    const State& state = savedStates[slot];
+    fighters[0]->loadState(state.fighters[0]);
+    fighters[1]->loadState(state.fighters[1]);
+    scores = state.scores;
+    resetTicks = state.resetTicks;
+    tick = state.tick;
+}
+
+Match::State Match::getState() const
+{
+    State state;
+    fighters[0]->saveState(state.fighters[0]);
+    fighters[1]->saveState(state.fighters[1]);
+    state.scores = scores;
+    state.resetTicks = resetTicks;
+    state.tick = tick;
+    return state;
+}
+
+uint64_t Match::getStateHash() const
+{
+    StateHasher hasher;
+    hasher.add(world.computeStateHash());
+    hasher.add((uint64_t)(int64_t)scores[0]);
+    hasher.add((uint64_t)(int64_t)scores[1]);
+    hasher.add((uint64_t)resetTicks);
+    hasher.add((uint64_t)tick);
+    return hasher.getHash();
+}
+
+const Fighter& Match::getFighter(const size_t side) const
+{
+    if (side >= fighters.size())
+        throw std::out_of_range("invalid player index " + std::to_string(side));
+
+    return *fighters[side];
+}
+
+int Match::getScore(const size_t side) const
+{
+    if (side >= scores.size())
+        throw std::out_of_range("invalid player index " + std::to_string(side));
+
+    return scores[side];
+}
+
+size_t Match::getTick() const { return tick; }
+
+/**
+ * @brief Összehasonlít két fizikai állapotot.
+ */
+static bool equalPhysics(const PhysicsObject::State& state1, const PhysicsObject::State& state2)
+{
+    return state1.position == state2.position
+        && state1.velocity == state2.velocity
+        && state1.acceleration == state2.acceleration
+        && state1.gravity == state2.gravity
+        && state1.maxXVelocity == state2.maxXVelocity
+        && state1.maxYVelocity == state2.maxYVelocity
+        && state1.touchedTags == state2.touchedTags;
+}
+
+bool operator==(const Match::State& state1, const Match::State& state2)
+{
+    for (size_t side = 0; side < state1.fighters.size(); side++)
+    {
+        if (!equalPhysics(state1.fighters[side].physics, state2.fighters[side].physics)
+            || state1.fighters[side].dead != state2.fighters[side].dead)
+            return false;
+    }
+
+    return state1.scores == state2.scores
+        && state1.resetTicks == state2.resetTicks
+        && state1.tick == state2.tick;
+}
+
+bool operator!=(const Match::State& state1, const Match::State& state2) { return !(state1 == state2); }
@@ -8,6 +8,8 @@ mem_dump:   2016.
 memset felszabaditaskor: 2018.
 typo:       2019.
 poi_check:  2021.
+szalak:     2026.
+profil:     2026.
 *********************************/
 
 /*definialni kell, ha nem paracssorbol allitjuk be (-DMEMTRACE) */
@@ -27,6 +29,33 @@ poi_check:  2021.
 #define FROM_MEMTRACE_CPP
 #include "memtrace.h"
 
+#if defined(MEMTRACE_PROFILE) && !defined(MEMTRACE_TO_MEMORY)
+	#error "MEMTRACE_PROFILE csak MEMTRACE_TO_MEMORY mellett hasznalhato"
+#endif
+
+/*tobb szalrol is lehet foglalni, a nyilvantartast zar vedi*/
+#if defined(__cplusplus) && __cplusplus >= 201103L
+	#include <mutex>
+	#define LOCK_REGISTRY std::lock_guard<std::recursive_mutex> registry_lock(registry_mutex)
+	#define THREAD_LOCAL thread_local
+#else
+	#define LOCK_REGISTRY
+	#define THREAD_LOCAL
+#endif
+
+#ifdef MEMTRACE_PROFILE
+	#include <chrono>
+	#ifndef MEMTRACE_PROFILE_SITES
+		#define MEMTRACE_PROFILE_SITES 4096 /*ennel tobb hely egybe kerul*/
+	#endif
+	#define MEMTRACE_PROFILE_DEPTH 12 /*a hely nelkuli foglalasok ennyi hivasi kerete*/
+	#if defined(__GLIBC__)
+		#include <execinfo.h>
+		#include <cxxabi.h>
+		#define MEMTRACE_BACKTRACE
+	#endif
+#endif
+
 #define FMALLOC 0
 #define FCALLOC 1
 #define FREALLOC 2
@@ -180,8 +209,229 @@ START_NAMESPACE
 		exit(120);
 	}
 	static void initialize();
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+	/*a rekurzio a die() utani felszabaditasok miatt kell*/
+	static std::recursive_mutex registry_mutex;
+#endif
 END_NAMESPACE
 
+/*******************************************************************/
+/* MEMTRACE_PROFILE */
+/*******************************************************************/
+
+#ifdef MEMTRACE_PROFILE
+START_NAMESPACE
+
+	typedef struct {
+		BOOL used;
+		int f;                /* allocator func */
+		int line;
+		char * file;
+		void * frames[MEMTRACE_PROFILE_DEPTH]; /* ha nincs file, a hivasi lanc */
+		int depth;
+		size_t count;         /* osszes foglalas */
+		size_t bytes;         /* osszes bajt */
+		size_t live;          /* meg el */
+		size_t live_bytes;
+		size_t peak_bytes;    /* egyszerre elo bajtok maximuma */
+		size_t freed;
+		double lifetime;      /* a felszabaditottak elettartamanak osszege (s) */
+	} site_t;
+
+	static site_t sites[MEMTRACE_PROFILE_SITES];
+	static site_t overflow_site; /*ha betelt a tabla*/
+	static int site_count;
+
+	static double now_seconds() {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static size_t hash_site(const call_t * call, void * const * frames, int depth) {
+		size_t h = 2166136261u;
+		const char * c;
+		int i;
+		h = (h ^ (size_t)call->f) * 16777619u;
+		h = (h ^ (size_t)call->line) * 16777619u;
+		if (call->file)
+			for (c = call->file; *c; c++)
+				h = (h ^ (unsigned char)*c) * 16777619u;
+		for (i = 0; i < depth; i++)
+			h = (h ^ (size_t)frames[i]) * 16777619u;
+		return h;
+	}
+
+	static BOOL same_site(const site_t * s, const call_t * call, void * const * frames, int depth) {
+		if (s->f != call->f || s->line != call->line || s->depth != depth)
+			return FALSE;
+		if ((s->file == NULL) != (call->file == NULL))
+			return FALSE;
+		if (s->file && strcmp(s->file, call->file) != 0)
+			return FALSE;
+		return memcmp(s->frames, frames, depth * sizeof(void*)) == 0 ? TRUE : FALSE;
+	}
+
+	/* nyitott cimzes, a zarat a hivo tartja */
+	static site_t * find_site(const call_t * call, void * const * frames, int depth) {
+		size_t i = hash_site(call, frames, depth) % MEMTRACE_PROFILE_SITES;
+		int probes;
+		for (probes = 0; probes < MEMTRACE_PROFILE_SITES; probes++) {
+			site_t * s = &sites[i];
+			if (!s->used) {
+				if (site_count >= MEMTRACE_PROFILE_SITES / 4 * 3)
+					break;
+				s->used = TRUE;
+				s->f = call->f;
+				s->line = call->line;
+				StrCpy(&s->file, call->file);
+				memcpy(s->frames, frames, depth * sizeof(void*));
+				s->depth = depth;
+				site_count++;
+				return s;
+			}
+			if (same_site(s, call, frames, depth))
+				return s;
+			i = (i + 1) % MEMTRACE_PROFILE_SITES;
+		}
+		overflow_site.used = TRUE;
+		return &overflow_site;
+	}
+
+	static void site_alloc(site_t * s, size_t size) {
+		s->count++;
+		s->bytes += size;
+		s->live++;
+		s->live_bytes += size;
+		if (s->live_bytes > s->peak_bytes)
+			s->peak_bytes = s->live_bytes;
+	}
+
+	static void site_free(site_t * s, size_t size, double lifetime) {
+		s->live--;
+		s->live_bytes -= size;
+		s->freed++;
+		s->lifetime += lifetime;
+	}
+
+	static int compare_sites(const void * a, const void * b) {
+		const site_t * sa = *(const site_t * const *)a;
+		const site_t * sb = *(const site_t * const *)b;
+		if (sa->bytes != sb->bytes)
+			return sa->bytes < sb->bytes ? 1 : -1;
+		return sa->count < sb->count ? 1 : (sa->count > sb->count ? -1 : 0);
+	}
+
+#ifdef MEMTRACE_BACKTRACE
+	/* a backtrace_symbols formaja: modul(nev+eltolas) [cim], a nevekhez -rdynamic kell */
+	static const char * frame_name(const char * symbol, size_t * length) {
+		const char * begin = strchr(symbol, '(');
+		const char * end;
+		if (begin == NULL)
+			return NULL;
+		begin++;
+		end = begin;
+		while (*end && *end != '+' && *end != ')')
+			end++;
+		*length = end - begin;
+		return *length ? begin : NULL;
+	}
+
+	static BOOL is_memtrace_frame(const char * symbol) {
+		size_t length;
+		const char * name = frame_name(symbol, &length);
+		if (name && (strstr(name, "memtrace") || strncmp(name, "_Znw", 4) == 0 || strncmp(name, "_Zna", 4) == 0))
+			return TRUE;
+		return FALSE;
+	}
+
+	static BOOL is_std_frame(const char * symbol) {
+		size_t length;
+		const char * name = frame_name(symbol, &length);
+		if (name && (strncmp(name, "_ZNSt", 5) == 0 || strncmp(name, "_ZSt", 4) == 0 || strncmp(name, "_ZNKSt", 6) == 0))
+			return TRUE;
+		return FALSE;
+	}
+
+	static void print_frame(const char * symbol, FILE * fp) {
+		size_t length;
+		const char * name = frame_name(symbol, &length);
+		char mangled[512];
+		char * demangled = NULL;
+		int status = -1;
+		if (name && length < sizeof(mangled)) {
+			memcpy(mangled, name, length);
+			mangled[length] = 0;
+			demangled = abi::__cxa_demangle(mangled, NULL, NULL, &status);
+		}
+		/* a hosszu sablonneveknek az eleje is eleg */
+		fprintf(fp, "%71s%.160s\n", "", status == 0 && demangled ? demangled : symbol);
+		free(demangled);
+	}
+#endif
+
+	static void print_site(const site_t * s, FILE * fp) {
+		if (s == &overflow_site) {
+			fprintf(fp, "(a tobbi hely, betelt a tabla)\n");
+			return;
+		}
+		if (s->file)
+			fprintf(fp, "%s @ %s:%d\n", pretty[s->f], basename(s->file), s->line);
+		else
+			fprintf(fp, "%s @ ?\n", pretty[s->f]);
+		#ifdef MEMTRACE_BACKTRACE
+		if (s->depth > 0) {
+			char ** symbols = backtrace_symbols(s->frames, s->depth);
+			int i, first = 0, printed = 0;
+			if (symbols == NULL)
+				return;
+			/*a memtrace sajat keretei (a new operatorig) nem erdekesek, a statikusaknak nincs neve*/
+			for (i = 0; i < s->depth && i < 4; i++)
+				if (is_memtrace_frame(symbols[i]))
+					first = i + 1;
+			/*a standard konyvtar egymas utani keretei kozul csak a legkulso latszik*/
+			for (i = first; i < s->depth && printed < 4; i++) {
+				if (i + 1 < s->depth && is_std_frame(symbols[i]) && is_std_frame(symbols[i + 1]))
+					continue;
+				print_frame(symbols[i], fp);
+				printed++;
+			}
+			free(symbols);
+		}
+		#endif
+	}
+
+	void mem_profile(size_t top, FILE * fp) {
+		static site_t * order[MEMTRACE_PROFILE_SITES + 1];
+		size_t n = 0, i, total = 0;
+		LOCK_REGISTRY;
+		initialize();
+
+		for (i = 0; i < MEMTRACE_PROFILE_SITES; i++)
+			if (sites[i].used)
+				order[n++] = &sites[i];
+		if (overflow_site.used)
+			order[n++] = &overflow_site;
+		for (i = 0; i < n; i++)
+			total += order[i]->count;
+		qsort(order, n, sizeof(site_t*), compare_sites);
+
+		fprintf(fp, "Foglalasi profil: %d hely, %lu foglalas, a legtobb bajtot foglalo %d hely:\n",
+			(int)n, (unsigned long)total, (int)(top < n ? top : n));
+		fprintf(fp, "%10s %12s %8s %12s %12s %10s  %s\n",
+			"foglalas", "bajt", "el", "el bajt", "csucs bajt", "elet ms", "hely");
+		for (i = 0; i < n && i < top; i++) {
+			const site_t * s = order[i];
+			fprintf(fp, "%10lu %12lu %8lu %12lu %12lu %10.3f  ",
+				(unsigned long)s->count, (unsigned long)s->bytes, (unsigned long)s->live,
+				(unsigned long)s->live_bytes, (unsigned long)s->peak_bytes,
+				s->freed ? s->lifetime / s->freed * 1000 : 0.0);
+			print_site(s, fp);
+		}
+		fflush(fp);
+	}
+END_NAMESPACE
+#endif/*MEMTRACE_PROFILE*/
+
 /*******************************************************************/
 /* MEMTRACE_TO_MEMORY */
 /*******************************************************************/
@@ -193,6 +443,10 @@ START_NAMESPACE
 		void * p;    /* mem pointer*/
 		size_t size; /* size*/
 		call_t call;
+		#ifdef MEMTRACE_PROFILE
+			site_t * site;
+			double birth;
+		#endif
 		struct _registry_item * next;
 	} registry_item;
 
@@ -219,6 +473,10 @@ START_NAMESPACE
 	int mem_check(void) {
 		initialize();
 		if(dying) return  2;    /* címzési hiba */
+		#ifdef MEMTRACE_PROFILE
+			mem_profile(20, fperror);
+		#endif
+		LOCK_REGISTRY;
 
 		if(registry.next) {
 			/*szivarog*/
@@ -237,6 +495,7 @@ START_NAMESPACE
 	int poi_check(void *pu) {
 	    if (pu == NULL) return 1;
 		initialize();
+		LOCK_REGISTRY;
         return find_registry_item(P(pu))->next != NULL;
 	}
 END_NAMESPACE
@@ -258,12 +517,28 @@ END_NAMESPACE
 
 START_NAMESPACE
 	static int allocated_blks;
+	static size_t allocation_cnt;
+	static size_t allocated_byts;
 
-    int allocated_blocks() { return allocated_blks; }
+    int allocated_blocks() { LOCK_REGISTRY; return allocated_blks; }
+    size_t allocation_count() { LOCK_REGISTRY; return allocation_cnt; }
+    size_t allocated_bytes() { LOCK_REGISTRY; return allocated_byts; }
 
 	static BOOL register_memory(void * p, size_t size, call_t call) {
+		#ifdef MEMTRACE_PROFILE
+			/*a hely nelkuli foglalasokat a hivasi lancuk kulonbozteti meg*/
+			void * frames[MEMTRACE_PROFILE_DEPTH];
+			int depth = 0;
+			#ifdef MEMTRACE_BACKTRACE
+				if (call.file == NULL)
+					depth = backtrace(frames, MEMTRACE_PROFILE_DEPTH);
+			#endif
+		#endif
 		initialize();
+		LOCK_REGISTRY;
 		allocated_blks++;
+		allocation_cnt++;
+		allocated_byts += size;
 		#ifdef MEMTRACE_TO_FILE
 			fprintf(trace_file, "%p\t%d\t%s%s", PU(p), (int)size, pretty[call.f], call.par_txt ? call.par_txt : "?");
 			if (call.f <= 3) fprintf(trace_file, ")");
@@ -277,6 +552,11 @@ START_NAMESPACE
 			n->p = p;
 			n->size = size;
 			n->call = call;
+			#ifdef MEMTRACE_PROFILE
+				n->site = find_site(&call, frames, depth);
+				n->birth = now_seconds();
+				site_alloc(n->site, size);
+			#endif
 			n->next = registry.next;
 			registry.next = n;
 		}/*C-blokk*/
@@ -287,6 +567,7 @@ START_NAMESPACE
 
 	static void unregister_memory(void * p, call_t call) {
 		initialize();
+		LOCK_REGISTRY;
 		#ifdef MEMTRACE_TO_FILE
                         fprintf(trace_file, "%p\t%d\t%s%s", PU(p), -1, pretty[call.f], call.par_txt ? call.par_txt : "?");
                         if (call.f <= 3) fprintf(trace_file, ")");
@@ -307,6 +588,9 @@ START_NAMESPACE
                     if (chk > 0)
                         die("Blokk utan serult a memoria", r->p,r->size,&r->call,&call);
 					/*rendben van minden*/
+					#ifdef MEMTRACE_PROFILE
+						site_free(r->site, r->size, now_seconds() - r->birth);
+					#endif
 					if(call.par_txt) free(call.par_txt);
 					if(r->call.par_txt) free(r->call.par_txt);
 					if(call.file) free(call.file);
@@ -390,8 +674,11 @@ START_NAMESPACE
 		initialize();
 
 		#ifdef MEMTRACE_TO_MEMORY
-        		n = find_registry_item(P(old));
-        		if (n) oldsize = n->next->size;
+        		{
+        			LOCK_REGISTRY;
+        			n = find_registry_item(P(old));
+        			if (n) oldsize = n->next->size;
+        		}
 			p = canary_malloc(size, random_byte);
         	#else
         		p = realloc(old, size);
@@ -433,8 +720,9 @@ START_NAMESPACE
 		_new_handler = h;
 	}
 
-	static call_t delete_call;
-	static BOOL delete_called;
+	/*a delete elotti hivas es a delete ugyanazon a szalon tortenik*/
+	static THREAD_LOCAL call_t delete_call;
+	static THREAD_LOCAL BOOL delete_called;
 
 	void set_delete_call(int line, const char * file) {
 		initialize();
@@ -0,0 +1,300 @@
+#include "netplay.h"
+
+#include "match.h"
+#include "tournament.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef NETPLAY
+#include <chrono>
+#include <thread>
+#endif
+
+#include "memtrace.h"
+
+Netplay::Result Netplay::runLoopback(MapManager& maps, const Settings& settings)
+{
+    if (settings.ticks == 0 || !(settings.physicsRate > 0))
+        throw std::invalid_argument("tick count and rate must be positive");
+
+    std::unique_ptr<PlayerController> bots[2] = {
+        Tournament::createController(settings.bots[0], settings.seed),
+        Tournament::createController(settings.bots[1], settings.seed + 1)
+    };
+
+    maps.prepareMap(settings.mapId);
+    Match match1(maps, settings.mapId, 16.0 / 9.0, settings.physicsRate);
+    Match match2(maps, settings.mapId, 16.0 / 9.0, settings.physicsRate);
+    Match* matches[2] = {&match1, &match2};
+
+    LoopbackLink link(settings.link);
+    RollbackSession session1(match1, link.getEndpoint(0), 0, settings.session);
+    RollbackSession session2(match2, link.getEndpoint(1), 1, settings.session);
+    RollbackSession* sessions[2] = {&session1, &session2};
+    session1.setHashLog(settings.hashLog);
+
+    //with any loss below 100% every input arrives well before this
+    const size_t maxHarnessTicks = 10 * settings.ticks + 10000;
+
+    Result result;
+    bool confirmed = false;
+    while (!confirmed && result.harnessTicks < maxHarnessTicks)
+    {
+        confirmed = true;
+        for (size_t side = 0; side < 2; side++)
+        {
+            RollbackSession& session = *sessions[side];
+            const Match& match = *matches[side];
+
+            //each bot decides from the predicted state of its own peer
+            if (session.getTick() < settings.ticks)
+                session.advance(bots[side]->control(match.getFighter(side).getView(), match.getFighter(1 - side).getView()));
+            else
+                session.poll();
+
+            if (session.getConfirmedTick() < settings.ticks)
+                confirmed = false;
+        }
+
+        link.tick();
+        result.harnessTicks++;
+    }
+
+    result.inSync = confirmed && match1.getState() == match2.getState()
+        && session1.getStats().desyncTick == SIZE_MAX && session2.getStats().desyncTick == SIZE_MAX;
+    result.packetsSent = link.getSentCount();
+    result.packetsLost = link.getLostCount();
+    result.scores[0] = match1.getScore(0);
+    result.scores[1] = match1.getScore(1);
+    result.stats[0] = session1.getStats();
+    result.stats[1] = session2.getStats();
+    return result;
+}
+
+/**
+ * @brief Beolvas egy számot a parancssori paraméter értékéből.
+ */
+template <typename T>
+static bool parseValue(const char* value, T& result)
+{
+    const char* end = value + std::strlen(value);
+    std::from_chars_result parsed = std::from_chars(value, end, result);
+    return parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+/**
+ * @brief Beolvas egy vagy két vesszővel elválasztott nevet.
+ */
+static bool parseBots(const char* value, std::string bots[2], size_t& count)
+{
+    const char* comma = std::strchr(value, ',');
+    if (comma == nullptr)
+    {
+        bots[0] = bots[1] = value;
+        count = 1;
+        return !bots[0].empty();
+    }
+
+    bots[0] = std::string(value, comma);
+    bots[1] = std::string(comma + 1);
+    count = 2;
+    return !bots[0].empty() && !bots[1].empty() && std::strchr(comma + 1, ',') == nullptr;
+}
+
+#ifdef NETPLAY
+/**
+ * @brief Beolvas egy `cím:port` alakú címet.
+ */
+static bool parseAddress(const char* value, std::string& host, uint16_t& port)
+{
+    const char* colon = std::strrchr(value, ':');
+    if (colon == nullptr || colon == value)
+        return false;
+
+    host = std::string(value, colon);
+    return parseValue(colon + 1, port);
+}
+
+/**
+ * @brief Lejátszik egy hálózati mérkőzést UDP felett, valós időben.
+ */
+static int runUdp(MapManager& maps, const Netplay::Settings& settings, const size_t side, const uint16_t port, const std::string& peerHost, const uint16_t peerPort)
+{
+    std::unique_ptr<PlayerController> bot = Tournament::createController(settings.bots[0], settings.seed + side);
+
+    maps.prepareMap(settings.mapId);
+    Match match(maps, settings.mapId, 16.0 / 9.0, settings.physicsRate);
+    UdpTransport transport(port, peerHost, peerPort);
+    RollbackSession session(match, transport, side, settings.session);
+    session.setHashLog(settings.hashLog);
+
+    std::printf("netplay: player %zu on port %u, waiting for the other player\n", side, (unsigned)port);
+
+    const std::chrono::duration<double> period(1 / settings.physicsRate);
+    const std::chrono::seconds timeout(10);
+
+    auto next = std::chrono::steady_clock::now();
+    auto lastProgress = next;
+    size_t lastConfirmed = 0;
+    while (session.getConfirmedTick() < settings.ticks)
+    {
+        if (session.getTick() < settings.ticks)
+            session.advance(bot->control(match.getFighter(side).getView(), match.getFighter(1 - side).getView()));
+        else
+            session.poll();
+
+        auto now = std::chrono::steady_clock::now();
+        if (session.getConfirmedTick() != lastConfirmed)
+        {
+            lastConfirmed = session.getConfirmedTick();
+            lastProgress = now;
+        }
+        else if (now - lastProgress > timeout)
+        {
+            std::fprintf(stderr, "the other player did not respond for %d s\n", (int)timeout.count());
+            return 1;
+        }
+
+        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+        std::this_thread::sleep_until(next);
+    }
+
+    //let the last hashes reach the other player
+    for (int i = 0; i < 10; i++)
+    {
+        session.poll();
+        std::this_thread::sleep_for(period);
+    }
+
+    const RollbackSession::Stats& stats = session.getStats();
+    std::printf("%zu ticks, %zu rollbacks, %zu resimulated ticks, max depth %zu, %zu stalled ticks\n", session.getTick(), stats.rollbacks, stats.resimulatedTicks, stats.maxRollbackDepth, stats.stalledTicks);
+    std::printf("score %d : %d, state hash %016llx\n", match.getScore(0), match.getScore(1), (unsigned long long)match.getStateHash());
+    if (stats.desyncTick != SIZE_MAX)
+    {
+        std::printf("DESYNC at tick %zu\n", stats.desyncTick);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+int Netplay::runCommandLine(const int argc, const char* const argv[])
+{
+    Settings settings;
+    size_t botCount = 2;
+    std::string hashLogPath;
+    #ifdef NETPLAY
+    size_t side = 0;
+    uint16_t port = 0;
+    std::string peerHost;
+    uint16_t peerPort = 0;
+    #endif
+
+    for (int i = 0; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const char* separator = std::strchr(argument, '=');
+        if (separator == nullptr)
+        {
+            std::fprintf(stderr, "invalid argument '%s', expected key=value\n", argument);
+            return 1;
+        }
+
+        std::string key(argument, separator);
+        const char* value = separator + 1;
+
+        bool valid;
+        if (key == "ticks") valid = parseValue(value, settings.ticks);
+        else if (key == "map") valid = parseValue(value, settings.mapId);
+        else if (key == "rate") valid = parseValue(value, settings.physicsRate);
+        else if (key == "seed") valid = parseValue(value, settings.seed);
+        else if (key == "bots") valid = parseBots(value, settings.bots, botCount);
+        else if (key == "latency") valid = parseValue(value, settings.link.latency);
+        else if (key == "jitter") valid = parseValue(value, settings.link.jitter);
+        else if (key == "loss") valid = parseValue(value, settings.link.loss);
+        else if (key == "rollback") valid = parseValue(value, settings.session.maxRollback);
+        else if (key == "delay") valid = parseValue(value, settings.session.inputDelay);
+        else if (key == "hashlog") valid = (hashLogPath = value, *value != '\0');
+        #ifdef NETPLAY
+        else if (key == "side") valid = parseValue(value, side) && side <= 1;
+        else if (key == "port") valid = parseValue(value, port) && port != 0;
+        else if (key == "peer") valid = parseAddress(value, peerHost, peerPort);
+        #endif
+        else
+        {
+            std::fprintf(stderr, "unknown parameter '%s'\n", key.c_str());
+            return 1;
+        }
+
+        if (!valid)
+        {
+            std::fprintf(stderr, "invalid value for '%s': '%s'\n", key.c_str(), value);
+            return 1;
+        }
+    }
+
+    std::ofstream hashLogFile;
+    std::unique_ptr<StateHashLog> hashLog;
+    if (!hashLogPath.empty())
+    {
+        hashLogFile.open(hashLogPath, std::ios::binary);
+        if (!hashLogFile)
+        {
+            std::fprintf(stderr, "failed to open '%s'\n", hashLogPath.c_str());
+            return 1;
+        }
+        hashLog.reset(new StateHashLog(hashLogFile));
+        settings.hashLog = hashLog.get();
+    }
+
+    MapManager maps;
+
+    try
+    {
+        #ifdef NETPLAY
+        if (port != 0)
+        {
+            if (botCount != 1)
+            {
+                std::fprintf(stderr, "a network player takes a single bot\n");
+                return 1;
+            }
+            return runUdp(maps, settings, side, port, peerHost, peerPort);
+        }
+        #endif
+
+        Result result = runLoopback(maps, settings);
+
+        std::printf("netplay loopback: %zu ticks on map %zu, latency %zu+%zu ticks, %.1f%% loss\n", settings.ticks, settings.mapId, settings.link.latency, settings.link.jitter, 100 * settings.link.loss);
+        std::printf("%-6s %10s %12s %10s %10s\n", "peer", "rollbacks", "resimulated", "max depth", "stalled");
+        for (size_t peer = 0; peer < 2; peer++)
+        {
+            const RollbackSession::Stats& stats = result.stats[peer];
+            std::printf("%-6zu %10zu %12zu %10zu %10zu\n", peer, stats.rollbacks, stats.resimulatedTicks, stats.maxRollbackDepth, stats.stalledTicks);
+        }
+        std::printf("%zu packets sent, %zu lost, score %d : %d\n", result.packetsSent, result.packetsLost, result.scores[0], result.scores[1]);
+        for (size_t peer = 0; peer < 2; peer++)
+        {
+            if (result.stats[peer].desyncTick != SIZE_MAX)
+                std::printf("peer %zu detected a desync at tick %zu\n", peer, result.stats[peer].desyncTick);
+        }
+        std::printf("%s\n", result.inSync ? "peers in sync" : "peers DESYNCED");
+        return result.inSync ? 0 : 1;
+    }
+    catch (const std::logic_error& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+}
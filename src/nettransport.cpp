@@ -0,0 +1,160 @@
+#include "nettransport.h"
+
+#include <stdexcept>
+
+#ifdef NETPLAY
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "memtrace.h"
+
+NetTransport::~NetTransport()
+{
+
+}
+
+LoopbackLink::Endpoint::Endpoint(LoopbackLink& link, const size_t side)
+: link(link), side(side)
+{
+
+}
+
+void LoopbackLink::Endpoint::send(const std::vector<uint8_t>& packet)
+{
+    link.sentCount++;
+
+    //one draw per packet decides both the loss and the delay
+    uint64_t bits = link.random();
+    if ((double)(bits >> 11) * 0x1.0p-53 < link.settings.loss)
+    {
+        link.lostCount++;
+        return;
+    }
+
+    size_t delay = link.settings.latency;
+    if (link.settings.jitter > 0)
+        delay += (size_t)(bits % (link.settings.jitter + 1));
+
+    //equal arrival times keep the sending order
+    link.inFlight[1 - side].emplace(link.now + delay, packet);
+}
+
+bool LoopbackLink::Endpoint::receive(std::vector<uint8_t>& packet)
+{
+    std::multimap<size_t, std::vector<uint8_t>>& queue = link.inFlight[side];
+    if (queue.empty() || queue.begin()->first > link.now)
+        return false;
+
+    packet.swap(queue.begin()->second);
+    queue.erase(queue.begin());
+    return true;
+}
+
+LoopbackLink::LoopbackLink(const Settings& settings)
+: settings(settings),
+  random(settings.seed),
+  now(0),
+  endpoints{Endpoint(*this, 0), Endpoint(*this, 1)},
+  sentCount(0),
+  lostCount(0)
+{
+    if (!(settings.loss >= 0 && settings.loss <= 1))
+        throw std::invalid_argument("packet loss must be between 0 and 1");
+}
+
+NetTransport& LoopbackLink::getEndpoint(const size_t side)
+{
+    if (side > 1)
+        throw std::out_of_range("invalid endpoint index " + std::to_string(side));
+
+    return endpoints[side];
+}
+
+void LoopbackLink::tick() { now++; }
+
+size_t LoopbackLink::getSentCount() const { return sentCount; }
+
+size_t LoopbackLink::getLostCount() const { return lostCount; }
+
+#ifdef NETPLAY
+UdpTransport::UdpTransport(const uint16_t localPort, const std::string& peerHost, const uint16_t peerPort)
+: socketHandle(-1)
+{
+    if (!peerHost.empty())
+    {
+        sockaddr_in peer = {};
+        peer.sin_family = AF_INET;
+        peer.sin_port = htons(peerPort);
+        if (inet_pton(AF_INET, peerHost.c_str(), &peer.sin_addr) != 1)
+            throw std::invalid_argument("invalid IPv4 address '" + peerHost + "'");
+
+        const uint8_t* bytes = (const uint8_t*)&peer;
+        peerAddress.assign(bytes, bytes + sizeof(peer));
+    }
+
+    socketHandle = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socketHandle < 0)
+        throw std::runtime_error(std::string("failed to open UDP socket: ") + std::strerror(errno));
+
+    sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(localPort);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(socketHandle, (const sockaddr*)&local, sizeof(local)) != 0
+        || fcntl(socketHandle, F_SETFL, fcntl(socketHandle, F_GETFL, 0) | O_NONBLOCK) != 0)
+    {
+        std::string error = std::strerror(errno);
+        close(socketHandle);
+        throw std::runtime_error("failed to bind UDP port " + std::to_string(localPort) + ": " + error);
+    }
+}
+
+UdpTransport::~UdpTransport()
+{
+    close(socketHandle);
+}
+
+void UdpTransport::send(const std::vector<uint8_t>& packet)
+{
+    //the peer is not known until it sends something
+    if (peerAddress.empty())
+        return;
+
+    //a failed send is a lost packet, the protocol resends the inputs anyway
+    sendto(socketHandle, packet.data(), packet.size(), 0, (const sockaddr*)peerAddress.data(), (socklen_t)peerAddress.size());
+}
+
+bool UdpTransport::receive(std::vector<uint8_t>& packet)
+{
+    while (true)
+    {
+        sockaddr_in sender = {};
+        socklen_t senderSize = sizeof(sender);
+
+        packet.resize(1500);
+        ssize_t size = recvfrom(socketHandle, packet.data(), packet.size(), 0, (sockaddr*)&sender, &senderSize);
+        if (size < 0)
+        {
+            packet.clear();
+            return false;
+        }
+        packet.resize((size_t)size);
+
+        const uint8_t* bytes = (const uint8_t*)&sender;
+        if (peerAddress.empty())
+            peerAddress.assign(bytes, bytes + sizeof(sender));
+
+        //packets of anyone else are dropped
+        const sockaddr_in* peer = (const sockaddr_in*)peerAddress.data();
+        if (peer->sin_addr.s_addr == sender.sin_addr.s_addr && peer->sin_port == sender.sin_port)
+            return true;
+    }
+}
+#endif
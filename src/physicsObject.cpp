@@ -1,5 +1,7 @@
 #include "physicsObject.h"
 
+#include "statehash.h"
+
 #include <algorithm>
 
 #ifndef CPORTA
@@ -20,23 +22,23 @@ acceleration({0, 0}),
 gravity({0, -9.81}), 
 maxXVelocity({-100, 100}), 
 maxYVelocity({-100, 100}),
-colliders(colliders)
+colliders(colliders),
+touchedTags(0)
 {
     if (searchChildrenForColliders)
-        this->colliders = findTypeInChildren<Collider>();
+        findTypeInChildren(this->colliders);
 }
 
 void PhysicsObject::addTagsFromCollider(const Collider* collider)
 {
-    for (ColliderTag tag : collider->getTags())
-    {
-        touchedTags.insert(tag);
-    }
+    touchedTags |= collider->getTagMask();
 }
 
 void PhysicsObject::tryResolveIntersections()
 {
-    if (Collider::checkIntersectionForList(colliders).empty())
+    ArenaVector<Collider*> intersects;
+    Collider::checkIntersectionForList(colliders, intersects);
+    if (intersects.empty())
         return;
 
     Vector2 upOffset = tryResolveIntersectionsInDirection({0, maxIntersectionResolveDistance});
@@ -64,7 +66,8 @@ void PhysicsObject::tryResolveIntersections()
 
 Vector2 PhysicsObject::tryResolveIntersectionsInDirection(const Vector2& offset)
 {
-    std::vector<Collider*> intersects = Collider::checkIntersectionForList(colliders);
+    ArenaVector<Collider*> intersects;
+    Collider::checkIntersectionForList(colliders, intersects);
     if (intersects.empty())
         return {0, 0};
 
@@ -82,7 +85,7 @@ Vector2 PhysicsObject::tryResolveIntersectionsInDirection(const Vector2& offset)
         prevOffset = testOffset;
         testOffset = (testOffset - offset / moveFraction);
         move(testOffset);
-        std::vector<Collider*> intersects = Collider::checkIntersectionForList(colliders);
+        Collider::checkIntersectionForList(colliders, intersects);
         
         if (intersects.empty())
             success = true;     
@@ -101,10 +104,10 @@ Vector2 PhysicsObject::tryResolveIntersectionsInDirection(const Vector2& offset)
     return {0, 0};
 }
 
-void PhysicsObject::tryCheck(const Vector2& offset, bool& didIntersect, double& maxBounciness, std::vector<Collider*>& intersects)
+void PhysicsObject::tryCheck(const Vector2& offset, bool& didIntersect, double& maxBounciness, ArenaVector<Collider*>& intersects)
 {
     move(offset);
-    intersects = Collider::checkIntersectionForList(colliders);
+    Collider::checkIntersectionForList(colliders, intersects);
     if (!intersects.empty())
     {
         move(-offset);
@@ -122,17 +125,19 @@ void PhysicsObject::physicsUpdate()
 {
     //search for changes in children
     if (searchChildrenForColliders)
-        colliders = findTypeInChildren<Collider>();
+        findTypeInChildren(colliders);
 
     //check for intersections and try to resolve them
-    if (!Collider::checkIntersectionForList(colliders).empty())
+    ArenaVector<Collider*> intersects;
+    Collider::checkIntersectionForList(colliders, intersects);
+    if (!intersects.empty())
         tryResolveIntersections();
 
     velocity += acceleration * GameRuntime::getPhysicsDeltaTime();
     velocity += gravity * GameRuntime::getPhysicsDeltaTime();
 
-    velocity.x = std::clamp(velocity.x, maxXVelocity.first, maxXVelocity.second);
-    velocity.y = std::clamp(velocity.y, maxYVelocity.first, maxYVelocity.second);
+    velocity.x = std::clamp<VectorScalar>(velocity.x, maxXVelocity.first, maxXVelocity.second);
+    velocity.y = std::clamp<VectorScalar>(velocity.y, maxYVelocity.first, maxYVelocity.second);
 
     double moveFraction;
     bool didIntersectX;
@@ -146,7 +151,6 @@ void PhysicsObject::physicsUpdate()
     bouncinessX = 0;
     bouncinessY = 0;
 
-    std::vector<Collider*> intersects;
     for (size_t pass = 0; pass < physicsPasses; pass++)
     {
         tryCheck({velocity.x / moveFraction * GameRuntime::getPhysicsDeltaTime(), 0}, didIntersectX, bouncinessX, intersects);
@@ -170,7 +174,7 @@ void PhysicsObject::physicsUpdate()
 
 void PhysicsObject::postUpdate()
 {
-    touchedTags.clear();
+    touchedTags = 0;
 }
 
 bool PhysicsObject::tryTeleport(const Vector2& position)
@@ -178,7 +182,8 @@ bool PhysicsObject::tryTeleport(const Vector2& position)
     Vector2 oldPosition = getPosition();
     setPosition(position);
 
-    std::vector<Collider*> intersects = Collider::checkIntersectionForList(colliders);
+    ArenaVector<Collider*> intersects;
+    Collider::checkIntersectionForList(colliders, intersects);
 
     if (!intersects.empty())
         setPosition(oldPosition);
@@ -202,10 +207,41 @@ void PhysicsObject::setMaxYVelocity(const std::pair<double, double>& maxYVelocit
 
 bool PhysicsObject::checkTag(const ColliderTag tag) const
 {
-    return touchedTags.count(tag);
+    return (touchedTags & Collider::getTagBit(tag)) != 0;
 }
 
 void PhysicsObject::clearTags()
 {
-    touchedTags.clear();
-}
\ No newline at end of file
+    touchedTags = 0;
+}
+
+void PhysicsObject::saveState(State& state) const
+{
+    state.position = getLocalPosition();
+    state.velocity = velocity;
+    state.acceleration = acceleration;
+    state.gravity = gravity;
+    state.maxXVelocity = maxXVelocity;
+    state.maxYVelocity = maxYVelocity;
+    state.touchedTags = touchedTags;
+}
+
+void PhysicsObject::loadState(const State& state)
+{
+    setLocalPosition(state.position);
+    velocity = state.velocity;
+    acceleration = state.acceleration;
+    gravity = state.gravity;
+    maxXVelocity = state.maxXVelocity;
+    maxYVelocity = state.maxYVelocity;
+    touchedTags = state.touchedTags;
+}
+
+void PhysicsObject::hashState(StateHasher& hasher) const
+{
+    hasher.add(getPosition());
+    hasher.add(velocity);
+    hasher.add(acceleration);
+
+    hasher.add(static_cast<uint64_t>(touchedTags));
+}
@@ -0,0 +1,135 @@
+#include "playercontroller.h"
+
+#include <cmath>
+
+#ifndef CPORTA
+#include "inputhandler.h"
+#endif
+
+#include "memtrace.h"
+
+uint8_t PlayerInput::encode() const
+{
+    return (uint8_t)(left | right << 1 | jump << 2 | dash << 3);
+}
+
+PlayerInput PlayerInput::decode(const uint8_t bits)
+{
+    PlayerInput input;
+    input.left = bits & 1;
+    input.right = bits & 2;
+    input.jump = bits & 4;
+    input.dash = bits & 8;
+    return input;
+}
+
+PlayerController::~PlayerController()
+{
+
+}
+
+ScriptedController::ScriptedController(const std::vector<Step>& steps)
+: stepIndex(0), stepTicks(0)
+{
+    for (const Step& step : steps)
+    {
+        if (step.ticks > 0)
+            this->steps.push_back(step);
+    }
+}
+
+PlayerInput ScriptedController::control(const PlayerView& self, const PlayerView& opponent)
+{
+    if (steps.empty())
+        return PlayerInput();
+
+    PlayerInput input = steps[stepIndex].input;
+    if (++stepTicks >= steps[stepIndex].ticks)
+    {
+        stepTicks = 0;
+        stepIndex = (stepIndex + 1) % steps.size();
+    }
+
+    return input;
+}
+
+RandomController::RandomController(const uint64_t seed)
+: random(seed), ticksLeft(0)
+{
+
+}
+
+PlayerInput RandomController::control(const PlayerView& self, const PlayerView& opponent)
+{
+    if (ticksLeft == 0)
+    {
+        //a fresh choice every 10 to 40 ticks, drawn from one number so it does not depend on the library
+        uint64_t bits = random();
+        int direction = (int)(bits % 3);
+        current.left = direction == 0;
+        current.right = direction == 1;
+        current.jump = (bits >> 8) % 4 == 0;
+        current.dash = (bits >> 16) % 16 == 0;
+        ticksLeft = 10 + (size_t)((bits >> 24) % 31);
+    }
+
+    ticksLeft--;
+    return current;
+}
+
+PlayerInput ChaseController::control(const PlayerView& self, const PlayerView& opponent)
+{
+    PlayerInput input;
+    if (opponent.dead)
+        return input;
+
+    double dx = opponent.position.x - self.position.x;
+    double dy = opponent.position.y - self.position.y;
+
+    //the opponent above is dangerous, step away from under it
+    if (dy > 0.5 && std::abs(dx) < 1.5)
+    {
+        input.left = dx >= 0;
+        input.right = dx < 0;
+        return input;
+    }
+
+    input.right = dx > 0.25;
+    input.left = dx < -0.25;
+
+    //right above the opponent, drop on it
+    if (dy < -0.5 && std::abs(dx) < 0.75)
+    {
+        input.dash = true;
+        return input;
+    }
+
+    //keep jumping to get above the opponent, holding the key while rising
+    input.jump = self.grounded || self.velocity.y > 0;
+    return input;
+}
+
+void DirectController::setInput(const PlayerInput& input) { this->input = input; }
+
+PlayerInput DirectController::control(const PlayerView& self, const PlayerView& opponent)
+{
+    return input;
+}
+
+#ifndef CPORTA
+KeyboardController::KeyboardController(const InputScheme& inputScheme)
+: inputScheme(inputScheme)
+{
+
+}
+
+PlayerInput KeyboardController::control(const PlayerView& self, const PlayerView& opponent)
+{
+    PlayerInput input;
+    input.left = InputHandler::isKeyPressed(inputScheme.getLeftKey());
+    input.right = InputHandler::isKeyPressed(inputScheme.getRightKey());
+    input.jump = InputHandler::isKeyPressed(inputScheme.getJumpKey());
+    input.dash = InputHandler::isKeyPressed(inputScheme.getDashKey());
+    return input;
+}
+#endif
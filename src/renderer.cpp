@@ -1,12 +1,18 @@
 #ifndef CPORTA
 #include "renderer.h"
+#include "logger.h"
+#include "world.h"
 
 #include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
 
-double Renderer::gameHeight = 5;
-Color Renderer::backgroundColor = makeColor(255, 255, 255);
-Vector2 Renderer::cameraOffset = Vector2(0, 0);
-double Renderer::cameraScale = 1;
+#include <cmath>
+
+std::atomic<int> Renderer::screenWidth {1};
+std::atomic<int> Renderer::screenHeight {1};
+
+TTF_Font* Renderer::font = nullptr;
+int Renderer::fontSize = 0;
 
 Renderer::Renderer(const Transform& transform, const UpdatePriority priority)
 : Transform(transform), Updatable(priority)
@@ -14,36 +20,163 @@ Renderer::Renderer(const Transform& transform, const UpdatePriority priority)
 
 }
 
-void Renderer::drawBackground()
+void Renderer::beginFrame(RenderSnapshot& snapshot)
 {
-    SDL_SetRenderDrawColor(GameRuntime::getSDLRenderer(), backgroundColor.r, backgroundColor.g, backgroundColor.b, 0xff);
-    SDL_RenderClear(GameRuntime::getSDLRenderer());
+    World::Camera& camera = World::getCurrent().getCamera();
+
+    snapshot.clear();
+    camera.snapshot = &snapshot;
+
+    //the screen shows the camera center plus the game width and height in every direction
+    Vector2 center(camera.offset.x, -camera.offset.y);
+    Vector2 halfSize(getGameWidth(), getGameHeight());
+
+    camera.viewMin = center - halfSize;
+    camera.viewMax = center + halfSize;
+
+    camera.drawnCount = 0;
+    camera.culledCount = 0;
 }
 
-double Renderer::getGameWidth()
+void Renderer::endFrame()
 {
-    return getGameHeight() * getAspectRatio();
+    World::Camera& camera = World::getCurrent().getCamera();
+    if (camera.snapshot == nullptr)
+        return;
+
+    //the updates may have loaded a map with another camera
+    camera.snapshot->setCamera(camera.backgroundColor, camera.offset, getGameHeight());
+    camera.snapshot = nullptr;
 }
 
-double Renderer::getGameHeight()
+bool Renderer::isVisible(const Vector2& position, const Vector2& scale)
 {
-    return gameHeight * cameraScale;
+    double halfWidth = std::abs(scale.x) / 2;
+    double halfHeight = std::abs(scale.y) / 2;
+
+    const Vector2& viewMin = World::getCurrent().getCamera().viewMin;
+    const Vector2& viewMax = World::getCurrent().getCamera().viewMax;
+    return position.x + halfWidth >= viewMin.x && position.x - halfWidth <= viewMax.x
+        && position.y + halfHeight >= viewMin.y && position.y - halfHeight <= viewMax.y;
 }
 
-int Renderer::getScreenWidth()
+Vector2 Renderer::getViewMin() { return World::getCurrent().getCamera().viewMin; }
+
+Vector2 Renderer::getViewMax() { return World::getCurrent().getCamera().viewMax; }
+
+size_t Renderer::getDrawnCount() { return World::getCurrent().getCamera().drawnCount; }
+
+size_t Renderer::getCulledCount() { return World::getCurrent().getCamera().culledCount; }
+
+void Renderer::countDrawn(const size_t count) { World::getCurrent().getCamera().drawnCount += count; }
+
+void Renderer::countCulled(const size_t count) { World::getCurrent().getCamera().culledCount += count; }
+
+void Renderer::drawSnapshot(const RenderSnapshot& snapshot)
 {
-    int width, height;
-    SDL_GetCurrentRenderOutputSize(GameRuntime::getSDLRenderer(), &width, &height);
-    return width;
+    SDL_Renderer* renderer = GameRuntime::getSDLRenderer();
+    int width = screenWidth.load(std::memory_order_relaxed);
+    int height = screenHeight.load(std::memory_order_relaxed);
+
+    const Color& backgroundColor = snapshot.getBackgroundColor();
+    SDL_SetRenderDrawColor(renderer, backgroundColor.r, backgroundColor.g, backgroundColor.b, 0xff);
+    SDL_RenderClear(renderer);
+
+    for (const RenderSnapshot::Rect& rect : snapshot.getRects())
+    {
+        RenderSnapshot::ScreenRect screenRect = snapshot.toScreen(rect, width, height);
+        SDL_FRect sdlRect = {screenRect.x, screenRect.y, screenRect.width, screenRect.height};
+
+        SDL_SetRenderDrawColor(renderer, rect.color.r, rect.color.g, rect.color.b, rect.color.a);
+        SDL_RenderFillRect(renderer, &sdlRect);
+    }
+
+    for (size_t i = 0; i < snapshot.getTextCount(); i++)
+    {
+        drawText(snapshot.getText(i));
+    }
+}
+
+void Renderer::drawText(const RenderSnapshot::Text& text)
+{
+    int height = screenHeight.load(std::memory_order_relaxed);
+    int size = (int)(text.scale * height);
+    if (font == nullptr || size != fontSize)
+    {
+        releaseResources();
+
+        font = TTF_OpenFont("gamefont.ttf", size);
+        if (font == nullptr)
+        {
+            LOG_ERROR("Failed to load font: %s", SDL_GetError());
+            return;
+        }
+        fontSize = size;
+    }
+
+    SDL_Surface* textSurface = TTF_RenderText_Blended(font, text.text.c_str(), text.text.length(), text.color);
+    if (textSurface == nullptr)
+    {
+        LOG_ERROR("Error creating text surface: %s", SDL_GetError());
+        return;
+    }
+
+    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(GameRuntime::getSDLRenderer(), textSurface);
+    if (textTexture == nullptr)
+    {
+        LOG_ERROR("Error creating text texture: %s", SDL_GetError());
+        SDL_DestroySurface(textSurface);
+        return;
+    }
+
+    float xCenter = (float)screenWidth.load(std::memory_order_relaxed) / 2;
+    float yCenter = (float)height / 2;
+    float xScale = (float)textSurface->w;
+    float yScale = (float)textSurface->h;
+    SDL_FRect renderQuad = {xCenter - xScale / 2, yCenter - yScale / 2, xScale, yScale};
+
+    SDL_DestroySurface(textSurface);
+    
+    SDL_RenderTexture(GameRuntime::getSDLRenderer(), textTexture, nullptr, &renderQuad);
+
+    SDL_DestroyTexture(textTexture);
 }
 
-int Renderer::getScreenHeight() 
+void Renderer::updateScreenSize()
 {
     int width, height;
-    SDL_GetCurrentRenderOutputSize(GameRuntime::getSDLRenderer(), &width, &height);
-    return height;
+    if (!SDL_GetCurrentRenderOutputSize(GameRuntime::getSDLRenderer(), &width, &height) || width <= 0 || height <= 0)
+        return;
+
+    screenWidth.store(width, std::memory_order_relaxed);
+    screenHeight.store(height, std::memory_order_relaxed);
+}
+
+void Renderer::releaseResources()
+{
+    if (font != nullptr)
+    {
+        TTF_CloseFont(font);
+        font = nullptr;
+        fontSize = 0;
+    }
 }
 
+double Renderer::getGameWidth()
+{
+    return getGameHeight() * getAspectRatio();
+}
+
+double Renderer::getGameHeight()
+{
+    const World::Camera& camera = World::getCurrent().getCamera();
+    return camera.gameHeight * camera.scale;
+}
+
+int Renderer::getScreenWidth() { return screenWidth.load(std::memory_order_relaxed); }
+
+int Renderer::getScreenHeight() { return screenHeight.load(std::memory_order_relaxed); }
+
 double Renderer::getAspectRatio()
 {
     return (double) getScreenWidth() / (double) getScreenHeight();
@@ -61,41 +194,41 @@ double Renderer::getScreenToGameRatio()
 
 int Renderer::gameToScreenXPos(const double gameXPos)
 {
-    return getScreenWidth() / 2 + int((gameXPos - cameraOffset.x) * getGameToScreenRatio());
+    return getScreenWidth() / 2 + int((gameXPos - World::getCurrent().getCamera().offset.x) * getGameToScreenRatio());
 }
 
 int Renderer::gameToScreenYPos(const double gameYPos)
 {
-    return getScreenHeight() / 2 - int((gameYPos + cameraOffset.y) * getGameToScreenRatio());
+    return getScreenHeight() / 2 - int((gameYPos + World::getCurrent().getCamera().offset.y) * getGameToScreenRatio());
 }
 
 double Renderer::screenToGameXPos(const int screenXPos)
 {
-    return ((double)screenXPos - (double)getScreenWidth() / 2) * getScreenToGameRatio() + cameraOffset.x;
+    return ((double)screenXPos - (double)getScreenWidth() / 2) * getScreenToGameRatio() + World::getCurrent().getCamera().offset.x;
 }
 
 double Renderer::screenToGameYPos(const int screenYPos)
 {
-    return - ((double)screenYPos - (double)getScreenHeight() / 2) * getScreenToGameRatio() - cameraOffset.y;
+    return - ((double)screenYPos - (double)getScreenHeight() / 2) * getScreenToGameRatio() - World::getCurrent().getCamera().offset.y;
 }
 
 void Renderer::setGameHeight(const double gameHeight)
 {
-    Renderer::gameHeight = gameHeight;
+    World::getCurrent().getCamera().gameHeight = gameHeight;
 }
 
 void Renderer::setBackgroundColor(const Color backgroundColor)
 {
-    Renderer::backgroundColor = backgroundColor;
+    World::getCurrent().getCamera().backgroundColor = backgroundColor;
 }
 
 void Renderer::setCameraOffset(const Vector2& cameraOffset)
 {
-    Renderer::cameraOffset = cameraOffset;
+    World::getCurrent().getCamera().offset = cameraOffset;
 }
 
 void Renderer::setCameraScale(const double cameraScale)
 {
-    Renderer::cameraScale = cameraScale;
+    World::getCurrent().getCamera().scale = cameraScale;
 }
 #endif // CPORTA
\ No newline at end of file
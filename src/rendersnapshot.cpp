@@ -0,0 +1,90 @@
+#include "rendersnapshot.h"
+
+#include <stdexcept>
+
+#include "memtrace.h"
+
+RenderSnapshot::RenderSnapshot()
+: backgroundColor(makeColor(255, 255, 255)), cameraOffset(), gameHeight(1), rects(), texts(), textCount(0)
+{
+
+}
+
+void RenderSnapshot::clear()
+{
+    rects.clear();
+    textCount = 0;
+}
+
+void RenderSnapshot::setCamera(const Color& backgroundColor, const Vector2& cameraOffset, const double gameHeight)
+{
+    if (!(gameHeight > 0))
+        throw std::invalid_argument("game height must be positive");
+
+    this->backgroundColor = backgroundColor;
+    this->cameraOffset = cameraOffset;
+    this->gameHeight = gameHeight;
+}
+
+void RenderSnapshot::addRect(const Vector2& position, const Vector2& scale, const Color& color)
+{
+    Rect rect;
+    rect.position = position;
+    rect.scale = scale;
+    rect.color = color;
+    rects.push_back(rect);
+}
+
+void RenderSnapshot::addText(const std::string& text, const Color& color, const double scale)
+{
+    //the old strings are overwritten, so their buffers are reused
+    if (textCount == texts.size())
+        texts.emplace_back();
+
+    Text& entry = texts[textCount++];
+    entry.text = text;
+    entry.color = color;
+    entry.scale = scale;
+}
+
+void RenderSnapshot::append(const RenderSnapshot& snapshot)
+{
+    rects.insert(rects.end(), snapshot.rects.begin(), snapshot.rects.end());
+    for (size_t i = 0; i < snapshot.textCount; i++)
+    {
+        const Text& text = snapshot.texts[i];
+        addText(text.text, text.color, text.scale);
+    }
+}
+
+const Color& RenderSnapshot::getBackgroundColor() const { return backgroundColor; }
+
+const Vector2& RenderSnapshot::getCameraOffset() const { return cameraOffset; }
+
+double RenderSnapshot::getGameHeight() const { return gameHeight; }
+
+const std::vector<RenderSnapshot::Rect>& RenderSnapshot::getRects() const { return rects; }
+
+size_t RenderSnapshot::getTextCount() const { return textCount; }
+
+const RenderSnapshot::Text& RenderSnapshot::getText(const size_t index) const
+{
+    if (index >= textCount)
+        throw std::out_of_range("text index out of range");
+
+    return texts[index];
+}
+
+RenderSnapshot::ScreenRect RenderSnapshot::toScreen(const Rect& rect, const int screenWidth, const int screenHeight) const
+{
+    double ratio = (double)screenHeight / (2 * gameHeight);
+
+    ScreenRect screenRect;
+    //width and height length
+    screenRect.width = rect.scale.x * ratio;
+    screenRect.height = rect.scale.y * ratio;
+    //top left corner, rounded like the renderer positions
+    screenRect.x = screenWidth / 2 + int((rect.position.x - cameraOffset.x) * ratio) - screenRect.width / 2;
+    screenRect.y = screenHeight / 2 - int((rect.position.y + cameraOffset.y) * ratio) - screenRect.height / 2;
+    return screenRect;
+}
@@ -0,0 +1,214 @@
+#include "rollback.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "memtrace.h"
+
+static const uint8_t packetMagic = 0x53; ///< Az első bájt minden csomagban.
+static const size_t packetHeaderSize = 22; ///< A csomag fejlécének mérete: azonosító, nyugta, kezdő lépés, hash lépése és értéke, darabszám.
+static const size_t maxInputsPerPacket = 255; ///< Egy csomagban küldött irányítások legnagyobb száma.
+
+/**
+ * @brief Beír egy 32 bites számot a csomagba, kis endián sorrendben.
+ */
+static void writeUint32(std::vector<uint8_t>& packet, const size_t offset, const uint32_t value)
+{
+    for (size_t i = 0; i < 4; i++)
+        packet[offset + i] = (uint8_t)(value >> (8 * i));
+}
+
+/**
+ * @brief Kiolvas egy 32 bites számot a csomagból, kis endián sorrendben.
+ */
+static uint32_t readUint32(const std::vector<uint8_t>& packet, const size_t offset)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++)
+        value |= (uint32_t)packet[offset + i] << (8 * i);
+    return value;
+}
+
+RollbackSession::RollbackSession(Match& match, NetTransport& transport, const size_t localSide, const Settings& settings)
+: match(match),
+  transport(transport),
+  localSide(localSide),
+  settings(settings),
+  tick(0),
+  localInputs(settings.inputDelay, 0),
+  remoteConfirmed(0),
+  remoteAck(0),
+  tickHashes(settings.maxRollback + 1, 0),
+  remoteHashTick(SIZE_MAX),
+  remoteHash(0),
+  hashLog(nullptr)
+{
+    if (localSide > 1)
+        throw std::invalid_argument("local side must be 0 or 1");
+    if (settings.maxRollback == 0)
+        throw std::invalid_argument("rollback window must be at least 1 tick");
+}
+
+uint8_t RollbackSession::predictRemoteInput() const
+{
+    return remoteConfirmed > 0 ? remoteInputs[remoteConfirmed - 1] : 0;
+}
+
+void RollbackSession::simulate(const size_t stepTick)
+{
+    //the state before every tick is kept for the rollback window
+    match.saveState(stepTick % (settings.maxRollback + 1));
+
+    PlayerInput local = PlayerInput::decode(localInputs[stepTick]);
+    PlayerInput remote = PlayerInput::decode(remoteInputs[stepTick]);
+    if (localSide == 0)
+        match.step(local, remote);
+    else
+        match.step(remote, local);
+
+    tickHashes[stepTick % tickHashes.size()] = match.getStateHash();
+}
+
+void RollbackSession::readPacket(size_t& mismatchTick)
+{
+    if (packet.size() < packetHeaderSize || packet[0] != packetMagic || packet.size() != packetHeaderSize + packet[21])
+        return;
+    stats.packetsReceived++;
+
+    size_t ack = readUint32(packet, 1);
+    remoteAck = std::max(remoteAck, std::min(ack, localInputs.size()));
+
+    //the newest final hash of the peer, kept until our own hash of that tick is final
+    size_t hashCount = readUint32(packet, 9);
+    if (hashCount > 0 && remoteHashTick == SIZE_MAX)
+    {
+        remoteHashTick = hashCount - 1;
+        remoteHash = (uint64_t)readUint32(packet, 13) | (uint64_t)readUint32(packet, 17) << 32;
+    }
+
+    //older inputs are duplicates, a gap can not happen since the peer sends everything we have not acknowledged
+    size_t start = readUint32(packet, 5);
+    for (size_t i = 0; i < packet[21]; i++)
+    {
+        size_t inputTick = start + i;
+        if (inputTick != remoteConfirmed)
+            continue;
+
+        uint8_t input = packet[packetHeaderSize + i];
+        if (inputTick < remoteInputs.size())
+        {
+            if (remoteInputs[inputTick] != input)
+                mismatchTick = std::min(mismatchTick, inputTick);
+            remoteInputs[inputTick] = input;
+        }
+        else
+        {
+            remoteInputs.push_back(input);
+        }
+        remoteConfirmed++;
+    }
+}
+
+void RollbackSession::sendInputs()
+{
+    size_t count = std::min(localInputs.size() - remoteAck, maxInputsPerPacket);
+
+    packet.resize(packetHeaderSize + count);
+    packet[0] = packetMagic;
+    writeUint32(packet, 1, (uint32_t)remoteConfirmed);
+    writeUint32(packet, 5, (uint32_t)remoteAck);
+    writeUint32(packet, 9, (uint32_t)finalHashes.size());
+    uint64_t hash = finalHashes.empty() ? 0 : finalHashes.back();
+    writeUint32(packet, 13, (uint32_t)hash);
+    writeUint32(packet, 17, (uint32_t)(hash >> 32));
+    packet[21] = (uint8_t)count;
+    std::copy(localInputs.begin() + remoteAck, localInputs.begin() + remoteAck + count, packet.begin() + packetHeaderSize);
+
+    transport.send(packet);
+}
+
+void RollbackSession::receiveInputs()
+{
+    size_t mismatchTick = SIZE_MAX;
+    while (transport.receive(packet))
+        readPacket(mismatchTick);
+
+    if (mismatchTick >= tick)
+        return;
+
+    size_t depth = tick - mismatchTick;
+    stats.rollbacks++;
+    stats.resimulatedTicks += depth;
+    stats.maxRollbackDepth = std::max(stats.maxRollbackDepth, depth);
+
+    //the inputs that are still unknown are predicted again from the newest confirmed one
+    uint8_t prediction = predictRemoteInput();
+    for (size_t i = remoteConfirmed; i < tick; i++)
+        remoteInputs[i] = prediction;
+
+    match.loadState(mismatchTick % (settings.maxRollback + 1));
+    for (size_t i = mismatchTick; i < tick; i++)
+        simulate(i);
+}
+
+void RollbackSession::finalizeTicks()
+{
+    //a tick is final once the remote input of it is confirmed, its hash can not change anymore
+    for (size_t i = finalHashes.size(); i < getConfirmedTick(); i++)
+    {
+        uint64_t hash = tickHashes[i % tickHashes.size()];
+        finalHashes.push_back(hash);
+        if (hashLog != nullptr)
+            hashLog->append(hash);
+    }
+
+    if (remoteHashTick < finalHashes.size())
+    {
+        if (finalHashes[remoteHashTick] != remoteHash)
+            stats.desyncTick = std::min(stats.desyncTick, remoteHashTick);
+        remoteHashTick = SIZE_MAX;
+    }
+}
+
+void RollbackSession::poll()
+{
+    receiveInputs();
+    finalizeTicks();
+    sendInputs();
+}
+
+bool RollbackSession::advance(const PlayerInput& localInput)
+{
+    receiveInputs();
+
+    finalizeTicks();
+
+    //too far ahead, the oldest state that may be needed would be overwritten
+    if (tick >= remoteConfirmed + settings.maxRollback)
+    {
+        stats.stalledTicks++;
+        sendInputs();
+        return false;
+    }
+
+    localInputs.push_back(localInput.encode());
+    if (tick == remoteInputs.size())
+        remoteInputs.push_back(predictRemoteInput());
+
+    simulate(tick);
+    tick++;
+
+    finalizeTicks();
+    sendInputs();
+    return true;
+}
+
+size_t RollbackSession::getTick() const { return tick; }
+
+size_t RollbackSession::getConfirmedTick() const { return std::min(tick, remoteConfirmed); }
+
+const RollbackSession::Stats& RollbackSession::getStats() const { return stats; }
+
+const std::vector<uint64_t>& RollbackSession::getFinalHashes() const { return finalHashes; }
+
+void RollbackSession::setHashLog(StateHashLog* const log) { hashLog = log; }
@@ -0,0 +1,150 @@
+#include "statehash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "memtrace.h"
+
+static const char logMagic[4] = {'S', 'F', 'S', 'H'}; ///< A napló fejlécének azonosítója.
+static const uint8_t logVersion = 1; ///< A napló formátumának verziója.
+
+StateHasher::StateHasher()
+: state(0x6a09e667f3bcc908ULL)
+{
+
+}
+
+void StateHasher::add(const uint64_t value)
+{
+    //multiply-rotate mixing, every bit of the value reaches the whole state
+    state ^= value * 0x9e3779b97f4a7c15ULL;
+    state = ((state << 31) | (state >> 33)) * 0xbf58476d1ce4e5b9ULL;
+}
+
+void StateHasher::add(const double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+}
+
+void StateHasher::add(const float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add((uint64_t)bits);
+}
+
+void StateHasher::add(const Vector2& vector)
+{
+    add(vector.x);
+    add(vector.y);
+}
+
+void StateHasher::add(const bool value) { add((uint64_t)value); }
+
+uint64_t StateHasher::getHash() const
+{
+    uint64_t hash = state;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+StateHashLog::StateHashLog(std::ostream& stream)
+: stream(stream)
+{
+    char header[8] = {logMagic[0], logMagic[1], logMagic[2], logMagic[3], (char)logVersion, 0, 0, 0};
+    stream.write(header, sizeof(header));
+}
+
+void StateHashLog::append(const uint64_t hash)
+{
+    char bytes[8];
+    for (size_t i = 0; i < 8; i++)
+        bytes[i] = (char)(uint8_t)(hash >> (8 * i));
+    stream.write(bytes, sizeof(bytes));
+}
+
+std::vector<uint64_t> StateHashLog::read(std::istream& stream)
+{
+    char header[8];
+    if (!stream.read(header, sizeof(header)) || std::memcmp(header, logMagic, sizeof(logMagic)) != 0)
+        throw std::runtime_error("not a state hash log");
+    if ((uint8_t)header[4] != logVersion)
+        throw std::runtime_error("unsupported state hash log version " + std::to_string((uint8_t)header[4]));
+
+    std::vector<uint64_t> hashes;
+    char bytes[8];
+    while (stream.read(bytes, sizeof(bytes)))
+    {
+        uint64_t hash = 0;
+        for (size_t i = 0; i < 8; i++)
+            hash |= (uint64_t)(uint8_t)bytes[i] << (8 * i);
+        hashes.push_back(hash);
+    }
+
+    if (stream.gcount() != 0)
+        throw std::runtime_error("state hash log ends with a partial entry");
+
+    return hashes;
+}
+
+size_t StateHashLog::findFirstMismatch(const std::vector<uint64_t>& log1, const std::vector<uint64_t>& log2)
+{
+    size_t common = std::min(log1.size(), log2.size());
+    for (size_t i = 0; i < common; i++)
+    {
+        if (log1[i] != log2[i])
+            return i;
+    }
+
+    return log1.size() == log2.size() ? SIZE_MAX : common;
+}
+
+int StateHashLog::runCommandLine(const int argc, const char* const argv[])
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: --compare-hashes <log> <reference log>\n");
+        return 1;
+    }
+
+    std::vector<uint64_t> logs[2];
+    for (int i = 0; i < 2; i++)
+    {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file)
+        {
+            std::fprintf(stderr, "failed to open '%s'\n", argv[i]);
+            return 1;
+        }
+
+        try
+        {
+            logs[i] = read(file);
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::fprintf(stderr, "%s: %s\n", argv[i], error.what());
+            return 1;
+        }
+    }
+
+    size_t mismatch = findFirstMismatch(logs[0], logs[1]);
+    if (mismatch == SIZE_MAX)
+    {
+        std::printf("%zu ticks, identical\n", logs[0].size());
+        return 0;
+    }
+
+    if (mismatch == logs[0].size() || mismatch == logs[1].size())
+        std::printf("identical for %zu ticks, then one log ends (%zu and %zu ticks)\n", mismatch, logs[0].size(), logs[1].size());
+    else
+        std::printf("first mismatch at tick %zu: %016llx != %016llx\n", mismatch, (unsigned long long)logs[0][mismatch], (unsigned long long)logs[1][mismatch]);
+    return 1;
+}
@@ -0,0 +1,222 @@
+#include "taskgraph.h"
+#include "framearena.h"
+#include "threadpool.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+
+#include "memtrace.h"
+
+TaskGraph::TaskGraph()
+: tasks()
+{
+
+}
+
+bool TaskGraph::reaches(const size_t from, const size_t to) const
+{
+    //walks the dependents, the graphs of a frame have only a few tasks
+    std::vector<size_t> open(1, from);
+    std::vector<bool> visited(tasks.size(), false);
+    while (!open.empty())
+    {
+        size_t task = open.back();
+        open.pop_back();
+        if (task == to)
+            return true;
+        if (visited[task])
+            continue;
+
+        visited[task] = true;
+        for (size_t dependent : tasks[task].dependents)
+            open.push_back(dependent);
+    }
+    return false;
+}
+
+void TaskGraph::execute(Task& task)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    task.function();
+    task.time = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+size_t TaskGraph::addTask(const std::string& name, const std::function<void()>& function)
+{
+    Task task;
+    task.name = name;
+    task.function = function;
+    tasks.push_back(task);
+    return tasks.size() - 1;
+}
+
+void TaskGraph::addDependency(const size_t task, const size_t dependency)
+{
+    if (task >= tasks.size() || dependency >= tasks.size())
+        throw std::out_of_range("task index out of range");
+
+    //the dependency must not already wait for the task
+    if (reaches(task, dependency))
+        throw std::invalid_argument("task dependency would create a cycle");
+
+    tasks[dependency].dependents.push_back(task);
+    tasks[task].dependencyCount++;
+}
+
+struct TaskGraph::PoolRun
+{
+    TaskGraph& graph; ///< A futó gráf.
+    ThreadPool* pool; ///< A feladatokat végrehajtó szálkészlet.
+    ArenaVector<size_t>& remaining; ///< A feladatok még be nem fejeződött függőségeinek száma.
+    std::mutex stateMutex; ///< A futás állapotát védő zár.
+    std::condition_variable finishedCondition; ///< Jelez, ha minden feladat befejeződött.
+    size_t finished; ///< A befejeződött feladatok száma.
+    std::exception_ptr error; ///< Az első kivétel, amelyet egy feladat dobott.
+
+    PoolRun(TaskGraph& graph, ThreadPool* pool, ArenaVector<size_t>& remaining)
+    : graph(graph), pool(pool), remaining(remaining), stateMutex(), finishedCondition(), finished(0), error()
+    {
+
+    }
+};
+
+void TaskGraph::launch(PoolRun& run, const size_t index)
+{
+    //a reference and an index fit into the small buffer of the function, submitting does not allocate
+    run.pool->submit([&run, index]() { run.graph.runLaunched(run, index); });
+}
+
+void TaskGraph::runLaunched(PoolRun& run, const size_t index)
+{
+    bool failed;
+    {
+        std::lock_guard<std::mutex> lock(run.stateMutex);
+        failed = (bool)run.error;
+    }
+
+    //after a failure the remaining tasks are only released, not run
+    std::exception_ptr caught;
+    if (!failed)
+    {
+        try
+        {
+            execute(tasks[index]);
+        }
+        catch (...)
+        {
+            caught = std::current_exception();
+        }
+    }
+
+    FrameArena::Scope arenaScope;
+    ArenaVector<size_t> ready;
+    {
+        std::lock_guard<std::mutex> lock(run.stateMutex);
+        if (caught && !run.error)
+            run.error = caught;
+
+        for (size_t dependent : tasks[index].dependents)
+        {
+            if (--run.remaining[dependent] == 0)
+                ready.push_back(dependent);
+        }
+    }
+
+    for (size_t dependent : ready)
+        launch(run, dependent);
+
+    //counted last, so the run cannot return while this task still launches others
+    std::lock_guard<std::mutex> lock(run.stateMutex);
+    if (++run.finished == tasks.size())
+        run.finishedCondition.notify_all();
+}
+
+void TaskGraph::run(ThreadPool* pool)
+{
+    //the bookkeeping of a run lives in the arena, the frame's graph runs without allocations
+    FrameArena::Scope arenaScope;
+    ArenaVector<size_t> remaining(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++)
+        remaining[i] = tasks[i].dependencyCount;
+
+    if (pool == nullptr)
+    {
+        //the smallest ready index first, so the order only depends on the graph
+        std::priority_queue<size_t, ArenaVector<size_t>, std::greater<size_t>> ready;
+        for (size_t i = 0; i < tasks.size(); i++)
+        {
+            if (remaining[i] == 0)
+                ready.push(i);
+        }
+
+        while (!ready.empty())
+        {
+            size_t index = ready.top();
+            ready.pop();
+            execute(tasks[index]);
+
+            for (size_t dependent : tasks[index].dependents)
+            {
+                if (--remaining[dependent] == 0)
+                    ready.push(dependent);
+            }
+        }
+        return;
+    }
+
+    PoolRun run(*this, pool, remaining);
+
+    //collected first, the launched tasks already release their dependents
+    ArenaVector<size_t> roots;
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        if (remaining[i] == 0)
+            roots.push_back(i);
+    }
+    for (size_t root : roots)
+        launch(run, root);
+
+    //the waiting thread helps, so a graph run from a pool task cannot block every worker
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(run.stateMutex);
+            if (run.finished == tasks.size())
+                break;
+        }
+
+        if (!pool->runPending())
+        {
+            std::unique_lock<std::mutex> lock(run.stateMutex);
+            run.finishedCondition.wait(lock, [this, &run]() { return run.finished == tasks.size(); });
+        }
+    }
+
+    if (run.error)
+        std::rethrow_exception(run.error);
+}
+
+void TaskGraph::clear() { tasks.clear(); }
+
+size_t TaskGraph::getTaskCount() const { return tasks.size(); }
+
+const std::string& TaskGraph::getTaskName(const size_t task) const
+{
+    if (task >= tasks.size())
+        throw std::out_of_range("task index out of range");
+
+    return tasks[task].name;
+}
+
+uint64_t TaskGraph::getTaskTime(const size_t task) const
+{
+    if (task >= tasks.size())
+        throw std::out_of_range("task index out of range");
+
+    return tasks[task].time;
+}
@@ -5,15 +5,47 @@
 #include "memtrace.h"
 
 #include "transform.h"
+#include "vector2batch.h"
+#include "transformhierarchy.h"
 #include "collider.h"
+#include "objectpool.h"
+#include "spatialgrid.h"
 
 #include "core.h"
+#include "world.h"
 #include "physicsObject.h"
+#include "fighter.h"
+#include "tournament.h"
+#include "match.h"
+#include "netplay.h"
+#include "statehash.h"
+#include "spscqueue.h"
+#include "inputqueue.h"
+#include "playercontroller.h"
+#include "rendersnapshot.h"
+#include "triplebuffer.h"
+#include "taskgraph.h"
+#include "threadpool.h"
+#include "framearena.h"
+#include "mpscqueue.h"
+#include "logger.h"
 
 #include "mapmanager.h"
-
+#include "mapgenerator.h"
+#include "wall.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <utility>
 
 void TestRunner::start() 
 {
@@ -23,12 +55,33 @@ void TestRunner::start()
 
     runTransformTests();
 
+    runTransformHierarchyTests();
+
     runColliderTests();
 
+    runSpatialGridTests();
+
     runPhysicsTests();
 
+    runWorldTests();
+
     runMapTests();
 
+    runBotTests();
+
+    runNetplayTests();
+
+    runInputTests();
+
+    runRenderTests();
+
+    runTaskGraphTests();
+
+    runArenaTests();
+    runAllocationTests();
+
+    runLogTests();
+
     GTEND(std::cerr);
 }
 
@@ -117,6 +170,53 @@ void TestRunner::runVector2Tests()
         EXPECT_DOUBLE_EQ(v4.x, 8.0);
         EXPECT_DOUBLE_EQ(v4.y, 16.0);
     } END
+
+    //vector2 fordítási idejű kiértékelés teszt
+    TEST (Vector2, constexpr_muveletek)
+    {
+        constexpr Vector2 v1 = (Vector2(1.0, 2.0) + Vector2(3.0, 4.0)) * 2.0 - Vector2(1.0, 1.0);
+        static_assert(v1.x == 7.0 && v1.y == 11.0, "Vector2 operators must be usable in constant expressions");
+
+        constexpr Vector2f v2 = Vector2f(Vector2d(0.5, -0.25));
+        static_assert(v2.x == 0.5f && v2.y == -0.25f, "Vector2 conversion must be usable in constant expressions");
+
+        EXPECT_DOUBLE_EQ(v1.x, 7.0);
+        EXPECT_DOUBLE_EQ(Vector2(3.0, 4.0).length(), 5.0);
+        EXPECT_DOUBLE_EQ(Vector2(3.0, 4.0).normalize().y, 0.8);
+    } END
+
+    //vector2 tömbös műveletek teszt (a csomagolt változat egyezik a skalárral)
+    TEST (Vector2, batch_muveletek)
+    {
+        const size_t count = 7; //nem többszöröse a regiszter szélességének
+        std::vector<Vector2f> packedFloats(count), scalarFloats(count), floatVelocities(count);
+        std::vector<Vector2d> packedDoubles(count), scalarDoubles(count), doubleVelocities(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            packedFloats[i] = scalarFloats[i] = Vector2f(i, -(double)i);
+            floatVelocities[i] = Vector2f(1.5 * i, 0.25);
+            packedDoubles[i] = scalarDoubles[i] = Vector2d(i, -(double)i);
+            doubleVelocities[i] = Vector2d(1.5 * i, 0.25);
+        }
+
+        Vector2Batch::addScaled(packedFloats.data(), floatVelocities.data(), 0.5f, count);
+        Vector2Batch::addScaledScalar(scalarFloats.data(), floatVelocities.data(), 0.5f, count);
+        Vector2Batch::addScaled(packedDoubles.data(), doubleVelocities.data(), 0.5, count);
+        Vector2Batch::addScaledScalar(scalarDoubles.data(), doubleVelocities.data(), 0.5, count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            EXPECT_TRUE(packedFloats[i] == scalarFloats[i]);
+            EXPECT_TRUE(packedDoubles[i] == scalarDoubles[i]);
+        }
+        EXPECT_DOUBLE_EQ(packedDoubles[6].x, 6.0 + 0.5 * 9.0);
+        EXPECT_DOUBLE_EQ(packedDoubles[6].y, -6.0 + 0.125);
+
+        Vector2Batch::add(packedDoubles.data(), doubleVelocities.data(), count);
+        Vector2Batch::scale(packedDoubles.data(), 2.0, count);
+        EXPECT_DOUBLE_EQ(packedDoubles[6].x, 2 * (6.0 + 0.5 * 9.0 + 9.0));
+    } END
 }
 
 void TestRunner::runTransformTests()
@@ -979,6 +1079,180 @@ void TestRunner::runTransformTests()
         EXPECT_EQ(children3.size(), 1);
         EXPECT_EQ(children3[0], &t3);
     } END
+
+    //transform teszt (mozgató konstruktor, a hely a hierarchiában átkerül)
+    TEST(Transform, mozgato_konstruktor)
+    {
+        Transform parent(nullptr, {1.0, 1.0}, {2.0, 2.0});
+        Transform sibling(&parent);
+        Transform t1(&parent, {1.0, 0.0}, {1.0, 1.0});
+        Transform child(&t1, {0.0, 1.0}, {1.0, 1.0});
+        Vector2 childPosition = child.getPosition();
+
+        Transform t2(std::move(t1));
+
+        EXPECT_EQ(t2.getParent(), &parent);
+        EXPECT_EQ(parent.countChildren(), 2);
+        EXPECT_EQ(parent.getChild(0), &sibling);
+        EXPECT_EQ(parent.getChild(1), &t2);
+
+        EXPECT_EQ(child.getParent(), &t2);
+        EXPECT_EQ(t2.countChildren(), 1);
+        EXPECT_DOUBLE_EQ(child.getPosition().x, childPosition.x);
+        EXPECT_DOUBLE_EQ(child.getPosition().y, childPosition.y);
+
+        EXPECT_EQ(t1.getParent(), nullptr);
+        EXPECT_EQ(t1.countChildren(), 0);
+    } END
+
+    //transform teszt (mozgató értékadás, a régi gyerekek elengedése)
+    TEST(Transform, mozgato_ertekadas)
+    {
+        Transform parent;
+        Transform t1(&parent, {3.0, 0.0});
+        Transform child1(&t1);
+
+        Transform t2(nullptr, {2.0, 2.0}, {2.0, 2.0});
+        Transform child2(&t2, {1.0, 1.0});
+
+        t2 = std::move(t1);
+
+        EXPECT_EQ(child2.getParent(), nullptr);
+        EXPECT_DOUBLE_EQ(child2.getPosition().x, 4.0);
+        EXPECT_DOUBLE_EQ(child2.getPosition().y, 4.0);
+
+        EXPECT_EQ(t2.getParent(), &parent);
+        EXPECT_EQ(parent.countChildren(), 1);
+        EXPECT_EQ(parent.getChild(0), &t2);
+        EXPECT_DOUBLE_EQ(t2.getPosition().x, 3.0);
+        EXPECT_EQ(child1.getParent(), &t2);
+        EXPECT_EQ(t1.countChildren(), 0);
+    } END
+    //transform teszt (a gyermeklisták csak aktív tárba és csak a lefoglalt helyre kerülnek)
+    TEST(Transform, gyermeklista_tar)
+    {
+        Transform::ChildListCache cache(2);
+        std::vector<std::unique_ptr<Transform>> parents;
+        std::vector<std::unique_ptr<Transform>> children;
+        for (int i = 0; i < 5; i++)
+        {
+            parents.emplace_back(new Transform());
+            children.emplace_back(new Transform(parents.back().get()));
+        }
+
+        //aktív tár nélkül a lista felszabadul
+        children[4].reset();
+        parents[4].reset();
+        EXPECT_EQ(cache.size(), (size_t)0);
+
+        //lefoglalt hely nélkül sem kerül a tárba
+        {
+            Transform::ChildListCache::Scope scope(cache);
+            children[3].reset();
+            parents[3].reset();
+        }
+        EXPECT_EQ(cache.size(), (size_t)0);
+
+        //a korlát felett a lista felszabadul
+        cache.reserve(5);
+        {
+            Transform::ChildListCache::Scope scope(cache);
+            for (int i = 0; i < 3; i++)
+            {
+                children[i].reset();
+                parents[i].reset();
+            }
+        }
+        EXPECT_EQ(cache.size(), (size_t)2);
+
+        //az új gyermek foglalás nélkül a tárolt listába kerül
+        Transform parent;
+        {
+            Transform::ChildListCache::Scope scope(cache);
+            EXPECT_NO_ALLOCATIONS(Transform child(&parent));
+        }
+        EXPECT_EQ(cache.size(), (size_t)1);
+
+        cache.clear();
+        EXPECT_EQ(cache.size(), (size_t)0);
+    } END
+}
+
+void TestRunner::runTransformHierarchyTests()
+{
+    //transformHierarchy teszt (globális értékek egyeznek a Transform hierarchiával)
+    TEST (TransformHierarchy, vilag_frissites)
+    {
+        Transform root(nullptr, {1.0, 2.0}, {2.0, 2.0});
+        Transform child(&root, {1.0, 1.0}, {0.5, 0.5});
+        Transform grandChild(&child, {2.0, 0.0}, {1.0, 3.0});
+
+        TransformHierarchy hierarchy;
+        TransformHierarchy::Handle rootHandle = hierarchy.create(TransformHierarchy::invalidHandle, {1.0, 2.0}, {2.0, 2.0});
+        TransformHierarchy::Handle childHandle = hierarchy.create(rootHandle, {1.0, 1.0}, {0.5, 0.5});
+        TransformHierarchy::Handle grandChildHandle = hierarchy.create(childHandle, {2.0, 0.0}, {1.0, 3.0});
+        hierarchy.updateWorld();
+
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(grandChildHandle).x, grandChild.getPosition().x);
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(grandChildHandle).y, grandChild.getPosition().y);
+        EXPECT_DOUBLE_EQ(hierarchy.getScale(grandChildHandle).x, grandChild.getScale().x);
+        EXPECT_DOUBLE_EQ(hierarchy.getScale(grandChildHandle).y, grandChild.getScale().y);
+
+        root.move({3.0, 0.0});
+        hierarchy.setLocalPosition(rootHandle, hierarchy.getLocalPosition(rootHandle) + Vector2(3.0, 0.0));
+        hierarchy.updateWorld();
+
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(childHandle).x, child.getPosition().x);
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(grandChildHandle).x, grandChild.getPosition().x);
+        EXPECT_EQ(hierarchy.size(), (size_t)3);
+    } END
+
+    //transformHierarchy teszt (szülő csere későbbi csomópontra, a globális pozíció megmarad)
+    TEST (TransformHierarchy, szulo_csere)
+    {
+        TransformHierarchy hierarchy;
+        TransformHierarchy::Handle a = hierarchy.create(TransformHierarchy::invalidHandle, {1.0, 1.0});
+        TransformHierarchy::Handle b = hierarchy.create(TransformHierarchy::invalidHandle, {4.0, 0.0}, {2.0, 2.0});
+
+        hierarchy.changeParent(a, b);
+        EXPECT_TRUE(hierarchy.getParent(a) == b);
+        EXPECT_DOUBLE_EQ(hierarchy.getLocalPosition(a).x, -1.5);
+        EXPECT_DOUBLE_EQ(hierarchy.getLocalScale(a).x, 0.5);
+
+        hierarchy.updateWorld();
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(a).x, 1.0);
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(a).y, 1.0);
+
+        hierarchy.setLocalPosition(b, {5.0, 0.0});
+        hierarchy.updateWorld();
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(a).x, 2.0);
+
+        EXPECT_THROW(hierarchy.changeParent(b, a), std::invalid_argument);
+    } END
+
+    //transformHierarchy teszt (törlés, a gyerekek megtartják a globális pozíciójukat)
+    TEST (TransformHierarchy, torles)
+    {
+        TransformHierarchy hierarchy;
+        TransformHierarchy::Handle parent = hierarchy.create(TransformHierarchy::invalidHandle, {2.0, 0.0}, {2.0, 2.0});
+        TransformHierarchy::Handle child = hierarchy.create(parent, {1.0, 1.0});
+        TransformHierarchy::Handle other = hierarchy.create(TransformHierarchy::invalidHandle, {-1.0, 0.0});
+
+        hierarchy.destroy(parent);
+        hierarchy.updateWorld();
+
+        EXPECT_FALSE(hierarchy.isValid(parent));
+        EXPECT_TRUE(hierarchy.getParent(child) == TransformHierarchy::invalidHandle);
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(child).x, 4.0);
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(child).y, 2.0);
+        EXPECT_DOUBLE_EQ(hierarchy.getPosition(other).x, -1.0);
+
+        //a felszabadult hely újrafelhasználása nem teszi érvényessé a régi azonosítót
+        TransformHierarchy::Handle reused = hierarchy.create();
+        EXPECT_TRUE(hierarchy.isValid(reused));
+        EXPECT_FALSE(hierarchy.isValid(parent));
+        EXPECT_THROW(hierarchy.getPosition(parent), std::out_of_range);
+    } END
 }
 
 void TestRunner::runColliderTests()
@@ -1121,6 +1395,404 @@ void TestRunner::runColliderTests()
         EXPECT_EQ(intersections[0], &c2);
     }
     END
+
+    // Ütközés teszt (mozgatás, a hely a statikus listában átkerül)
+    TEST(Collider, mozgatas)
+    {
+        Collider c1(Transform(nullptr, {0.0, 0.0}, {2.0, 2.0}));
+        Collider c2(Transform(nullptr, {1.0, 1.0}, {2.0, 2.0}), ColliderType::INTERACTIVE, 0.5, {ColliderTag::DEADLY});
+        Collider c3(std::move(c2));
+
+        EXPECT_TRUE(c3.hasTag(ColliderTag::DEADLY));
+        EXPECT_DOUBLE_EQ(c3.getBounciness(), 0.5);
+
+        std::vector<Collider*> intersections = c1.checkIntersection();
+        EXPECT_EQ(intersections.size(), 1);
+        EXPECT_EQ(intersections[0], &c3);
+
+        //a vektor növekedésekor az elemek mozgatással kerülnek át
+        std::vector<Collider> walls;
+        for (int i = 0; i < 5; i++)
+        {
+            walls.push_back(Collider(Transform(nullptr, {0.25 * i, 0.0}, {1.0, 1.0})));
+        }
+
+        intersections = c1.checkIntersection();
+        EXPECT_EQ(intersections.size(), 6);
+        for (Collider& wall : walls)
+        {
+            EXPECT_TRUE(std::find(intersections.begin(), intersections.end(), &wall) != intersections.end());
+        }
+    } END
+
+    //object pool teszt (helyek újrafelhasználása, statisztikák)
+    TEST(ObjectPool, letrehozas_torles)
+    {
+        Collider c1(Transform(nullptr, {0.0, 0.0}, {2.0, 2.0}));
+
+        ObjectPool<Collider> pool(2);
+        Collider* first = pool.create(Transform(nullptr, {0.0, 0.0}, {1.0, 1.0}));
+        Collider* second = pool.create(Transform(nullptr, {0.5, 0.0}, {1.0, 1.0}));
+        Collider* third = pool.create(Transform(nullptr, {1.0, 0.0}, {1.0, 1.0}));
+
+        EXPECT_EQ(second - first, 1);
+        EXPECT_EQ(pool.getOccupancy(), 3);
+        EXPECT_EQ(pool.getSlabCount(), 2);
+        EXPECT_EQ(pool.getCapacity(), 4);
+        EXPECT_EQ(c1.checkIntersection().size(), 3);
+
+        pool.destroy(second);
+        pool.destroy(first);
+        pool.destroy(third);
+        EXPECT_EQ(pool.getOccupancy(), 0);
+        EXPECT_EQ(pool.getHighWaterMark(), 3);
+        EXPECT_EQ(c1.checkIntersection().size(), 0);
+
+        //a felszabadult helyek újrafelhasználódnak, nem kell új slab
+        std::vector<Collider*> created;
+        for (int i = 0; i < 4; i++)
+        {
+            created.push_back(pool.create(Transform()));
+        }
+        EXPECT_EQ(created[0], third);
+        EXPECT_EQ(pool.getSlabCount(), 2);
+        EXPECT_EQ(pool.getHighWaterMark(), 4);
+
+        created.push_back(pool.create(Transform()));
+        EXPECT_EQ(pool.getSlabCount(), 3);
+        EXPECT_EQ(pool.getHighWaterMark(), 5);
+
+        for (Collider* collider : created)
+        {
+            pool.destroy(collider);
+        }
+    } END
+
+    // Ütközés teszt (tömeges törlés a statikus listából)
+    TEST(Collider, tomeges_torles)
+    {
+        Collider c1(Transform(nullptr, {0.0, 0.0}, {2.0, 2.0}));
+
+        ObjectPool<Collider> pool;
+        std::vector<Collider*> pooledColliders;
+        for (int i = 0; i < 4; i++)
+        {
+            pooledColliders.push_back(pool.create(Transform(nullptr, {0.25 * i, 0.0}, {1.0, 1.0})));
+        }
+
+        Collider c2(Transform(nullptr, {1.0, 1.0}, {2.0, 2.0}));
+        EXPECT_EQ(c1.checkIntersection().size(), 5);
+
+        Collider::unregisterColliders(pooledColliders);
+        std::vector<Collider*> intersections = c1.checkIntersection();
+        EXPECT_EQ(intersections.size(), 1);
+        EXPECT_EQ(intersections[0], &c2);
+
+        //a destruktorok már nem módosíthatják a listát
+        for (Collider* collider : pooledColliders)
+        {
+            pool.destroy(collider);
+        }
+        Collider c3(Transform(nullptr, {-1.0, 0.0}, {1.0, 1.0}));
+        intersections = c1.checkIntersection();
+        EXPECT_EQ(intersections.size(), 2);
+        EXPECT_EQ(intersections[0], &c2);
+        EXPECT_EQ(intersections[1], &c3);
+    } END
+
+    //collider teszt (sugár lekérdezés: távolság, normálvektor, szűrők, elmozdult collider)
+    TEST(Collider, sugar)
+    {
+        World world;
+        World::Scope scope(world);
+
+        Collider near(Transform(nullptr, {5.0, 0.0}, {2.0, 2.0}));
+        Collider far(Transform(nullptr, {9.0, 0.0}, {2.0, 2.0}), ColliderType::INTERACTIVE, 0, {ColliderTag::DEADLY});
+        Collider sensor(Transform(nullptr, {2.0, 0.0}, {1.0, 1.0}), ColliderType::PASSIVE);
+
+        ColliderHit hit;
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {2.0, 0.0}, 20, hit));
+        EXPECT_EQ(hit.collider, &near);
+        EXPECT_DOUBLE_EQ(hit.distance, 4.0);
+        EXPECT_DOUBLE_EQ(hit.point.x, 4.0);
+        EXPECT_DOUBLE_EQ(hit.normal.x, -1.0);
+        EXPECT_DOUBLE_EQ(hit.normal.y, 0.0);
+
+        //túl rövid sugár, a találat nem módosul
+        hit.collider = nullptr;
+        EXPECT_FALSE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 3.5, hit));
+        EXPECT_TRUE(hit.collider == nullptr);
+
+        //címke és típus szűrő
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 20, hit, ColliderFilter().require(ColliderTag::DEADLY)));
+        EXPECT_EQ(hit.collider, &far);
+        EXPECT_DOUBLE_EQ(hit.distance, 8.0);
+        ColliderFilter withPassive;
+        withPassive.passive = true;
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 20, hit, withPassive));
+        EXPECT_EQ(hit.collider, &sensor);
+        withPassive.ignored = &sensor;
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 20, hit, withPassive));
+        EXPECT_EQ(hit.collider, &near);
+
+        //az elmozdult collidert az index követi
+        near.setPosition({5.0, 10.0});
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 20, hit));
+        EXPECT_EQ(hit.collider, &far);
+        EXPECT_TRUE(Collider::raycast({0.0, 10.0}, {1.0, 0.0}, 20, hit));
+        EXPECT_EQ(hit.collider, &near);
+
+        //átlós sugár felülről, és kezdőpont a collider belsejében
+        EXPECT_TRUE(Collider::raycast({7.0, 3.0}, {1.0, -1.0}, 20, hit));
+        EXPECT_EQ(hit.collider, &far);
+        EXPECT_DOUBLE_EQ(hit.point.x, 9.0);
+        EXPECT_DOUBLE_EQ(hit.point.y, 1.0);
+        EXPECT_DOUBLE_EQ(hit.normal.y, 1.0);
+        EXPECT_TRUE(Collider::raycast({9.0, 0.0}, {0.0, 1.0}, 20, hit));
+        EXPECT_EQ(hit.collider, &far);
+        EXPECT_DOUBLE_EQ(hit.distance, 0.0);
+        EXPECT_DOUBLE_EQ(hit.normal.y, -1.0);
+
+        EXPECT_THROW(Collider::raycast({0.0, 0.0}, {0.0, 0.0}, 20, hit), std::invalid_argument);
+    } END
+
+    //collider teszt (mozgatott téglalap és téglalap lekérdezés)
+    TEST(Collider, teglalap_lekerdezes)
+    {
+        World world;
+        World::Scope scope(world);
+
+        Collider floor(Transform(nullptr, {0.0, -1.5}, {20.0, 1.0}));
+        Collider wall(Transform(nullptr, {5.0, 1.6}, {2.0, 2.0}));
+        Collider player(Transform(nullptr, {-5.0, 0.0}, {1.0, 1.0}), ColliderType::INTERACTIVE, 0, {ColliderTag::PLAYER});
+
+        //a fal alja 0.6-on van, az 1 magas téglalap alatta elfér
+        ColliderHit hit;
+        EXPECT_FALSE(Collider::boxcast({0.0, 0.0}, {1.0, 1.0}, {1.0, 0.0}, 10, hit));
+        EXPECT_TRUE(Collider::boxcast({0.0, 0.0}, {1.0, 1.4}, {1.0, 0.0}, 10, hit));
+        EXPECT_EQ(hit.collider, &wall);
+        EXPECT_DOUBLE_EQ(hit.distance, 3.5);
+        EXPECT_DOUBLE_EQ(hit.point.x, 3.5);
+        EXPECT_DOUBLE_EQ(hit.normal.x, -1.0);
+
+        //lefelé a padlón áll meg
+        EXPECT_TRUE(Collider::boxcast({0.0, 3.0}, {1.0, 1.0}, {0.0, -1.0}, 10, hit));
+        EXPECT_EQ(hit.collider, &floor);
+        EXPECT_DOUBLE_EQ(hit.distance, 3.5);
+        EXPECT_DOUBLE_EQ(hit.normal.y, 1.0);
+
+        //a listabeli sorrendben, szűrve
+        std::vector<Collider*> result;
+        Collider::overlapBox({-6.0, -1.5}, {6.0, 1.0}, result);
+        EXPECT_EQ(result.size(), (size_t)3);
+        EXPECT_EQ(result[0], &floor);
+        EXPECT_EQ(result[1], &wall);
+        EXPECT_EQ(result[2], &player);
+        Collider::overlapBox({-6.0, -1.5}, {6.0, 1.0}, result, ColliderFilter().require(ColliderTag::PLAYER));
+        EXPECT_EQ(result.size(), (size_t)1);
+        EXPECT_EQ(result[0], &player);
+
+        //törlés után az index újraépül
+        {
+            Collider extra(Transform(nullptr, {0.0, 0.0}, {1.0, 1.0}));
+            Collider::overlapBox({-0.1, -0.1}, {0.1, 0.1}, result);
+            EXPECT_EQ(result.size(), (size_t)1);
+        }
+        Collider::overlapBox({-0.1, -0.1}, {0.1, 0.1}, result);
+        EXPECT_EQ(result.size(), (size_t)0);
+    } END
+
+    //collider teszt (a rács bejárása ugyanazt adja, mint az összes collider vizsgálata)
+    TEST(Collider, sugar_teljes_kereses)
+    {
+        World world;
+        World::Scope scope(world);
+
+        std::mt19937 random(7);
+        std::uniform_real_distribution<double> coordinate(-40, 40);
+        std::uniform_real_distribution<double> size(0.1, 5);
+
+        std::vector<std::unique_ptr<Collider>> colliders;
+        for (int i = 0; i < 300; i++)
+            colliders.emplace_back(new Collider(Transform(nullptr, {coordinate(random), coordinate(random)}, {size(random), size(random)})));
+
+        //a colliderek helye VectorScalar pontosságú, a két számolás ennyiben térhet el
+        const double tolerance = 1000 * std::numeric_limits<VectorScalar>::epsilon();
+        size_t mismatches = 0, hits = 0;
+        for (int i = 0; i < 500; i++)
+        {
+            Vector2 origin(coordinate(random), coordinate(random));
+            Vector2 direction(coordinate(random), coordinate(random));
+            Vector2 half = i % 2 == 0 ? Vector2(0, 0) : Vector2(size(random), size(random)) / 2;
+            double length = direction.length();
+            direction /= length;
+            double maxDistance = i % 3 == 0 ? 1000.0 : 30.0;
+
+            //összehasonlítás a legközelebbi találat távolságával, az összes collidert megvizsgálva
+            double expected = std::numeric_limits<double>::infinity();
+            for (const std::unique_ptr<Collider>& collider : colliders)
+            {
+                Vector2 min = collider->getPosition() - collider->getScale() / 2 - half;
+                Vector2 max = collider->getPosition() + collider->getScale() / 2 + half;
+                double enter = 0, exit = maxDistance;
+                bool missed = false;
+                for (int axis = 0; axis < 2; axis++)
+                {
+                    double o = axis == 0 ? origin.x : origin.y, d = axis == 0 ? direction.x : direction.y;
+                    double lo = axis == 0 ? min.x : min.y, hi = axis == 0 ? max.x : max.y;
+                    if (d == 0)
+                    {
+                        missed = missed || o < lo || o > hi;
+                        continue;
+                    }
+                    double t1 = (lo - o) / d, t2 = (hi - o) / d;
+                    enter = std::max(enter, std::min(t1, t2));
+                    exit = std::min(exit, std::max(t1, t2));
+                }
+                if (!missed && enter <= exit)
+                    expected = std::min(expected, enter);
+            }
+
+            ColliderHit hit;
+            bool found = Collider::boxcast(origin, half * 2, direction, maxDistance, hit);
+            if (found != (expected <= maxDistance) || (found && std::abs(hit.distance - expected) > tolerance))
+                mismatches++;
+            if (found)
+                hits++;
+        }
+
+        EXPECT_EQ(mismatches, (size_t)0);
+        EXPECT_GT(hits, (size_t)0);
+    } END
+
+    //collider teszt (a világ hatókörében, másik szálon elmozdított collider)
+    TEST(Collider, sugar_masik_szal)
+    {
+        World world;
+        World::Scope scope(world);
+
+        Collider wall(Transform(nullptr, {5.0, 0.0}, {1.0, 1.0}));
+        ColliderHit hit;
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 100, hit));
+        EXPECT_DOUBLE_EQ(hit.distance, 4.5);
+
+        std::thread mover([&world, &wall]()
+        {
+            World::Scope moverScope(world);
+            wall.setPosition({50.0, 0.0});
+        });
+        mover.join();
+
+        EXPECT_TRUE(Collider::raycast({0.0, 0.0}, {1.0, 0.0}, 100, hit));
+        EXPECT_DOUBLE_EQ(hit.distance, 49.5);
+    } END
+
+    //collider teszt (egyidejű lekérdezések több szálon, mozgatás után az első frissíti az indexet)
+    TEST(Collider, parhuzamos_lekerdezes)
+    {
+        World world;
+        World::Scope scope(world);
+
+        std::vector<std::unique_ptr<Collider>> colliders;
+        for (int i = 0; i < 100; i++)
+            colliders.emplace_back(new Collider(Transform(nullptr, {i * 3.0, (i % 10) * 3.0}, {2.0, 2.0})));
+        for (std::unique_ptr<Collider>& collider : colliders)
+            collider->move({0.0, 1.0});
+
+        std::vector<size_t> failures(4, 0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < failures.size(); t++)
+        {
+            threads.emplace_back([&world, &colliders, &failures, t]()
+            {
+                World::Scope threadScope(world);
+                std::vector<Collider*> result;
+                for (size_t i = 0; i < 200; i++)
+                {
+                    //felülről lefelé minden oszlopban csak egy collider van
+                    const Collider& target = *colliders[(i * 7 + t) % colliders.size()];
+                    ColliderHit hit;
+                    if (!Collider::raycast({target.getPosition().x, 100.0}, {0.0, -1.0}, 200, hit) || hit.collider != &target || hit.distance != 100 - target.getPosition().y - 1)
+                        failures[t]++;
+
+                    //a teljes terület minden collidert egyszer, a lista sorrendjében ad vissza
+                    Collider::overlapBox({-10.0, -10.0}, {310.0, 40.0}, result);
+                    bool ordered = result.size() == colliders.size();
+                    for (size_t j = 0; ordered && j < result.size(); j++)
+                        ordered = result[j] == colliders[j].get();
+                    if (!ordered)
+                        failures[t]++;
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (size_t failureCount : failures)
+        {
+            EXPECT_EQ(failureCount, (size_t)0);
+        }
+    } END
+}
+
+void TestRunner::runSpatialGridTests()
+{
+    //spatialGrid teszt (lekérdezés, több cellát érintő elem egyszer szerepel)
+    TEST(SpatialGrid, lekerdezes)
+    {
+        SpatialGrid<int> grid(1);
+        int wide = 0, small = 1, far = 2;
+
+        grid.insert(&wide, {-5, -0.5}, {5, 0.5});
+        grid.insert(&small, {2, 2}, {2.5, 2.5});
+        grid.insert(&far, {100, 100}, {101, 101});
+        EXPECT_EQ(grid.size(), (size_t)3);
+
+        std::vector<int*> result;
+        grid.query({-1, -1}, {3, 3}, result);
+        EXPECT_EQ(result.size(), (size_t)2);
+        EXPECT_TRUE(std::find(result.begin(), result.end(), &wide) != result.end());
+        EXPECT_TRUE(std::find(result.begin(), result.end(), &small) != result.end());
+
+        //egy cellán belül is csak az átfedő elemek
+        grid.query({2.6, 2.6}, {2.9, 2.9}, result);
+        EXPECT_EQ(result.size(), (size_t)0);
+
+        //érintkezés is találat
+        grid.query({5, 0.5}, {6, 1}, result);
+        EXPECT_EQ(result.size(), (size_t)1);
+
+        //a lakott területnél nagyobb lekérdezés
+        grid.query({-1000, -1000}, {1000, 1000}, result);
+        EXPECT_EQ(result.size(), (size_t)3);
+    } END
+
+    //spatialGrid teszt (törlés, azonosító újrafelhasználása)
+    TEST(SpatialGrid, torles)
+    {
+        SpatialGrid<int> grid(2);
+        int a = 0, b = 1;
+
+        SpatialGrid<int>::Handle handleA = grid.insert(&a, {-3, -3}, {3, 3});
+        grid.insert(&b, {0, 0}, {1, 1});
+
+        grid.remove(handleA);
+        EXPECT_EQ(grid.size(), (size_t)1);
+        EXPECT_THROW(grid.remove(handleA), std::out_of_range);
+
+        std::vector<int*> result;
+        grid.query({-3, -3}, {3, 3}, result);
+        EXPECT_EQ(result.size(), (size_t)1);
+        EXPECT_EQ(result[0], &b);
+
+        //a felszabadult azonosító újra kiosztásra kerül
+        EXPECT_EQ(grid.insert(&a, {-10, -10}, {-9, -9}), handleA);
+        grid.query({-10, -10}, {-9.5, -9.5}, result);
+        EXPECT_EQ(result.size(), (size_t)1);
+        EXPECT_EQ(result[0], &a);
+    } END
 }
 
 void TestRunner::runPhysicsTests()
@@ -1181,10 +1853,72 @@ void TestRunner::runPhysicsTests()
             po.physicsUpdate();
         }
 
-        EXPECT_DOUBLE_EQ(po.getPosition().x, 5.0 * 200 * GameRuntime::getPhysicsDeltaTime());
+        //a 200 összeadás kerekítési hibája a vektor skalártípusának pontosságával arányos
+        double expected = 5.0 * 200 * GameRuntime::getPhysicsDeltaTime();
+        double tolerance = 200 * expected * std::numeric_limits<VectorScalar>::epsilon();
+        EXPECT_TRUE(std::abs(po.getPosition().x - expected) <= tolerance);
         EXPECT_DOUBLE_EQ(po.getPosition().y, 0.0);
     } END
 
+    //physics object teszt (mozgatás után csak az új objektum frissül)
+    TEST(PhysicsObject, mozgatas)
+    {
+        Transform t1(nullptr, {0.0, 0.0}, {1.0, 1.0});
+        Collider c1(t1);
+        std::vector<Collider*> colliders = {&c1};
+
+        PhysicsObject po(t1, colliders);
+        po.setVelocity({5.0, 0.0});
+        po.setGravity({0.0, 0.0});
+
+        PhysicsObject po2(std::move(po));
+        GameRuntime::mockPhysicsUpdate(10);
+
+        EXPECT_DOUBLE_EQ(po2.getPosition().x, 5.0 * 10 * GameRuntime::getPhysicsDeltaTime());
+        EXPECT_DOUBLE_EQ(po.getPosition().x, 0.0);
+    } END
+
+    //updatable teszt (tömeges eltávolítás a frissítendők közül)
+    TEST(Updatable, tomeges_torles)
+    {
+        class Counter : public Updatable
+        {
+            public:
+            int calls = 0;
+            Counter() : Updatable(UpdatePriority::OTHER) {}
+            void update() override { calls++; }
+        };
+
+        Counter kept;
+        ObjectPool<Counter> pool;
+        std::vector<Counter*> counters;
+        std::vector<Updatable*> removed;
+        for (int i = 0; i < 3; i++)
+        {
+            counters.push_back(pool.create());
+            removed.push_back(counters.back());
+        }
+
+        GameRuntime::mockUpdate(1);
+        EXPECT_EQ(kept.calls, 1);
+        EXPECT_EQ(counters[0]->calls, 1);
+
+        Updatable::unregisterUpdatables(removed);
+        EXPECT_FALSE(removed[0]->isRegistered());
+        EXPECT_TRUE(kept.isRegistered());
+
+        GameRuntime::mockUpdate(1);
+        EXPECT_EQ(kept.calls, 2);
+        EXPECT_EQ(counters[0]->calls, 1);
+
+        for (Counter* counter : counters)
+        {
+            pool.destroy(counter);
+        }
+        GameRuntime::mockUpdate(1);
+        EXPECT_EQ(kept.calls, 3);
+    } END
+
     //physics object teszt (gyorsulás)
     TEST(PhysicsObject, gyorsulas)
     {
@@ -1486,6 +2220,156 @@ void TestRunner::runPhysicsTests()
     } END
 }
 
+void TestRunner::runWorldTests()
+{
+    //world teszt (a világok nem látják egymás objektumait)
+    TEST(World, fuggetlen)
+    {
+        class Counter : public Updatable
+        {
+            public:
+            int calls = 0;
+            Counter() : Updatable(UpdatePriority::OTHER) {}
+            void update() override { calls++; }
+        };
+
+        World first;
+        World second;
+        {
+            World::Scope firstScope(first);
+            Counter firstCounter;
+            Collider firstCollider(Transform(nullptr, {0.0, 0.0}, {1.0, 1.0}));
+            first.setKeyPressed(32, true);
+
+            {
+                World::Scope secondScope(second);
+                Counter secondCounter;
+                Collider secondCollider(Transform(nullptr, {0.0, 0.0}, {1.0, 1.0}));
+                EXPECT_EQ(&World::getCurrent(), &second);
+                EXPECT_EQ(&secondCounter.getWorld(), &second);
+
+                first.update();
+                first.update();
+                second.update();
+                EXPECT_EQ(firstCounter.calls, 2);
+                EXPECT_EQ(secondCounter.calls, 1);
+
+                //azonos helyen vannak, mégsem ütköznek
+                EXPECT_TRUE(firstCollider.checkIntersection().empty());
+                EXPECT_EQ(second.getColliders().size(), (size_t)1);
+                EXPECT_FALSE(second.isKeyPressed(32));
+            }
+
+            EXPECT_EQ(&World::getCurrent(), &first);
+            EXPECT_EQ(second.getUpdatableCount(), (size_t)0);
+            EXPECT_EQ(second.getColliders().size(), (size_t)0);
+            EXPECT_EQ(first.getUpdatableCount(), (size_t)1);
+            EXPECT_TRUE(first.isKeyPressed(32));
+        }
+        EXPECT_EQ(&World::getCurrent(), &World::getDefault());
+    } END
+
+    //world teszt (párhuzamos szimulációk külön szálakon)
+    TEST(World, parhuzamos)
+    {
+        auto simulate = [](const bool withFloor)
+        {
+            World world;
+            World::Scope scope(world);
+            world.setTargetPhysicsRate(100);
+
+            PhysicsObject po(Transform(nullptr, {0.0, 3.0}, {1.0, 1.0}), {});
+            Collider body(Transform(&po, {0, 0}, {1.0, 1.0}));
+            std::vector<Collider> floor;
+            if (withFloor)
+                floor.emplace_back(Transform(nullptr, {0.0, 0.0}, {10.0, 1.0}));
+
+            for (int i = 0; i < 200; i++)
+            {
+                world.physicsUpdate();
+            }
+            return po.getPosition().y;
+        };
+
+        std::vector<double> results(4);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            threads.emplace_back([&results, &simulate, i]() { results[i] = simulate(i % 2 == 0); });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        double withFloor = simulate(true);
+        double withoutFloor = simulate(false);
+        EXPECT_GT(withFloor, 0.0); //A talajon áll
+        EXPECT_LT(withoutFloor, 0.0); //Tovább esik
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            EXPECT_DOUBLE_EQ(results[i], i % 2 == 0 ? withFloor : withoutFloor);
+        }
+    } END
+
+    //world teszt (állapothash)
+    TEST(World, allapothash)
+    {
+        StateHasher hasher1, hasher2, hasher3;
+        hasher1.add(1.0);
+        hasher1.add(true);
+        hasher2.add(1.0);
+        hasher2.add(true);
+        hasher3.add(true);
+        hasher3.add(1.0);
+        EXPECT_EQ(hasher1.getHash(), hasher2.getHash());
+        EXPECT_NE(hasher1.getHash(), hasher3.getHash()); //A sorrend számít
+        hasher1.add(0.0);
+        hasher2.add(-0.0);
+        EXPECT_NE(hasher1.getHash(), hasher2.getHash()); //Bitre pontos
+
+        uint64_t hashes[2];
+        for (uint64_t& hash : hashes)
+        {
+            World world;
+            World::Scope scope(world);
+            world.setTargetPhysicsRate(100);
+
+            Collider floor(Transform(nullptr, {0.0, -1.0}, {10.0, 1.0}));
+            PhysicsObject box(Transform(nullptr, {0.0, 2.0}, {1.0, 1.0}), {});
+            Collider boxCollider(Transform(&box, {0, 0}, {1.0, 1.0}));
+
+            uint64_t empty = world.getStateHash();
+            world.physicsUpdate();
+            EXPECT_NE(world.getStateHash(), empty);
+            EXPECT_EQ(world.getStateHash(), world.computeStateHash());
+
+            uint64_t falling = world.getStateHash();
+            world.physicsUpdate();
+            EXPECT_NE(world.getStateHash(), falling); //Esik, változik az állapot
+            hash = world.getStateHash();
+        }
+        EXPECT_EQ(hashes[0], hashes[1]);
+
+        //napló
+        std::stringstream stream;
+        StateHashLog log(stream);
+        log.append(1);
+        log.append(0xfedcba9876543210ULL);
+        std::vector<uint64_t> read = StateHashLog::read(stream);
+        EXPECT_EQ(read.size(), (size_t)2);
+        EXPECT_EQ(read[1], 0xfedcba9876543210ULL);
+
+        EXPECT_EQ(StateHashLog::findFirstMismatch(read, read), SIZE_MAX);
+        EXPECT_EQ(StateHashLog::findFirstMismatch(read, {1}), (size_t)1);
+        EXPECT_EQ(StateHashLog::findFirstMismatch(read, {1, 2}), (size_t)1);
+        EXPECT_EQ(StateHashLog::findFirstMismatch(read, {0, 0xfedcba9876543210ULL}), (size_t)0);
+
+        std::stringstream invalid("not a log");
+        EXPECT_THROW(StateHashLog::read(invalid), std::runtime_error);
+    } END
+}
+
 void TestRunner::runMapTests()
 {
     //mapManager teszt (beolvasás)
@@ -1502,5 +2386,1422 @@ void TestRunner::runMapTests()
         EXPECT_STREQ(mapManager.getSerializedMapElement(1, 1).c_str(), "0 -10 40 1 50 150 250 0 0 1 1");
         EXPECT_STREQ(mapManager.getSerializedMapElement(1, 2).c_str(), "0 -7 4 1 100 200 100 0 1 1 1");
     } END
+
+    //mapManager teszt (pályaelemek összevonása)
+    TEST(MapManager, elemek_osszevonasa)
+    {
+        MapManager mapManager;
+
+        //a sor és az alatta lévő elem egy falba olvad, a halálos és a kisebb colliderű elemek nem
+        EXPECT_EQ(mapManager.getMergedElementCount(2), (size_t)4);
+        EXPECT_STREQ(mapManager.getSerializedMergedElement(2, 2).c_str(), "0 -3.5 4 2 100 100 100 0 0 1 1");
+
+        //a fájlban tárolt elemek nem változnak
+        EXPECT_STREQ(mapManager.getSerializedMapElement(2, 0).c_str(), "-1.5 -3 1 1 100 100 100 0 0 1 1");
+
+        //nem összevonható elemek
+        EXPECT_EQ(mapManager.getMergedElementCount(1), (size_t)3);
+    } END
+
+    //mapManager teszt (pálya előkészítése háttérszálon)
+    TEST(MapManager, aszinkron_elokeszites)
+    {
+        MapManager mapManager;
+
+        EXPECT_FALSE(mapManager.isMapPrepared(2));
+        mapManager.prepareMapAsync(2);
+        mapManager.prepareMapAsync(2);
+        EXPECT_FALSE(mapManager.isMapPrepared(2));
+
+        //az eredményt a hívó szál veszi át
+        mapManager.prepareMap(2);
+        EXPECT_TRUE(mapManager.isMapPrepared(2));
+        EXPECT_FALSE(mapManager.isMapPrepared(1));
+
+        //előkészített pálya nem indul újra
+        mapManager.prepareMapAsync(2);
+        mapManager.prepareMap(1);
+        EXPECT_TRUE(mapManager.isMapPrepared(1));
+
+        EXPECT_THROW(mapManager.prepareMapAsync(mapManager.getMapCount()), std::out_of_range);
+        EXPECT_THROW(mapManager.isMapPrepared(mapManager.getMapCount()), std::out_of_range);
+    } END
+
+    //mapManager teszt (streamelt pálya, chunkok betöltése a fókusz körül)
+    TEST(MapManager, streameles)
+    {
+        World world;
+        World::Scope scope(world);
+        MapManager mapManager;
+
+        //kis pálya nem streamelődik
+        mapManager.loadMap(2);
+        EXPECT_FALSE(mapManager.isStreaming());
+
+        //4 egységes chunkok: a középső fal, az 5-ös és 7-es falak, a 8-as fal
+        mapManager.setStreaming(0, 4, 0.5);
+        mapManager.unloadMap();
+        mapManager.loadMap(2);
+        EXPECT_TRUE(mapManager.isStreaming());
+        EXPECT_EQ(mapManager.getChunkCount(), (size_t)3);
+        EXPECT_EQ(mapManager.getLoadedChunkCount(), (size_t)0);
+
+        mapManager.streamChunks({-1, -3}, {1, -3}, SIZE_MAX);
+        EXPECT_EQ(mapManager.getLoadedChunkCount(), (size_t)1);
+
+        //a fókusz elmozdul, a régi chunk kikerül
+        mapManager.streamChunks({6, -3}, {6, -3}, SIZE_MAX);
+        EXPECT_EQ(mapManager.getLoadedChunkCount(), (size_t)1);
+
+        //hívásonként legfeljebb maxChanges változás
+        mapManager.streamChunks({-100, -100}, {100, 100}, 1);
+        EXPECT_EQ(mapManager.getLoadedChunkCount(), (size_t)2);
+        mapManager.streamChunks({-100, -100}, {100, 100}, 1);
+        EXPECT_EQ(mapManager.getLoadedChunkCount(), (size_t)3);
+
+        mapManager.unloadMap();
+        EXPECT_FALSE(mapManager.isStreaming());
+        EXPECT_EQ(mapManager.getLoadedChunkCount(), (size_t)0);
+    } END
+
+    //mapManager teszt (az aktuális pálya újra betöltésekor a falak és a colliderek megmaradnak)
+    TEST(MapManager, azonos_palya_betoltese)
+    {
+        World world;
+        World::Scope scope(world);
+        MapManager mapManager;
+
+        mapManager.loadMap(1);
+        EXPECT_EQ(mapManager.getLoadedWallCount(), (size_t)3);
+        EXPECT_EQ(world.getColliders().size(), (size_t)3);
+
+        std::vector<Wall*> walls;
+        std::vector<Collider*> colliders;
+        for (size_t i = 0; i < mapManager.getLoadedWallCount(); i++)
+        {
+            walls.push_back(mapManager.getLoadedWall(i));
+            colliders.push_back(&walls.back()->getCollider());
+        }
+
+        mapManager.loadMap(1);
+        EXPECT_EQ(mapManager.getLoadedWallCount(), walls.size());
+        EXPECT_EQ(world.getColliders().size(), colliders.size());
+        for (size_t i = 0; i < walls.size(); i++)
+        {
+            EXPECT_EQ(mapManager.getLoadedWall(i), walls[i]);
+            EXPECT_EQ(&mapManager.getLoadedWall(i)->getCollider(), colliders[i]);
+            EXPECT_EQ(world.getColliders()[i], colliders[i]);
+        }
+
+        //másik pálya betöltésekor a falak lecserélődnek
+        mapManager.loadMap(2);
+        EXPECT_EQ(mapManager.getLoadedWallCount(), (size_t)4);
+        EXPECT_EQ(world.getColliders().size(), (size_t)4);
+
+        mapManager.unloadMap();
+        EXPECT_EQ(mapManager.getLoadedWallCount(), (size_t)0);
+        EXPECT_EQ(world.getColliders().size(), (size_t)0);
+    } END
+
+    //mapManager teszt (újratöltés, csak a megváltozott falak cserélődnek)
+    TEST(MapManager, ujratoltes)
+    {
+        World world;
+        World::Scope scope(world);
+        MapManager mapManager;
+        mapManager.loadMap(2);
+
+        //a halálos fal átszíneződik, a 8-as fal eltűnik, egy új fal kerül a pályára
+        const std::string text =
+            "6\n255 255 255\n2\n-2 0\n2 0\n"
+            "-1.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "-0.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "0.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "1.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "0 -4 4 1 100 100 100 0 0 1 1\n"
+            "5 -3 1 1 200 0 0 1 0 1 1\n"
+            "7 -3 1 1 100 100 100 0 0 0.9 1\n"
+            "10 -3 1 1 100 100 100 0 0 1 1\n";
+
+        MapManager::MapPatch patch = mapManager.reloadMap(2, text);
+        EXPECT_EQ(patch.kept, (size_t)2);
+        EXPECT_EQ(patch.added, (size_t)2);
+        EXPECT_EQ(patch.removed, (size_t)2);
+        EXPECT_EQ(mapManager.getMapHeight(), 6.0);
+        EXPECT_EQ(mapManager.getScoreToWin(), 2);
+
+        //hibás szöveg esetén a pálya nem változik
+        EXPECT_THROW(mapManager.reloadMap(2, "6 255 255"), ParseError);
+        EXPECT_EQ(mapManager.getMergedElementCount(2), (size_t)4);
+        EXPECT_THROW(mapManager.reloadMap(mapManager.getMapCount(), text), std::out_of_range);
+    } END
+
+    //mapManager teszt (a betöltött pálya fájljának átírása után csak a megváltozott falak cserélődnek)
+    TEST(MapManager, eles_ujratoltes)
+    {
+        //a név a többi pálya után következik, így azok sorszáma nem változik
+        const char* const filename = "zz_hotreload.gamemap";
+        const std::string header = "5\n255 255 255\n1\n-2 0\n2 0\n";
+        const std::string row =
+            "-1.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "-0.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "0.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "1.5 -3 1 1 100 100 100 0 0 1 1\n"
+            "7 -3 1 1 100 100 100 0 0 0.9 1\n";
+        {
+            std::ofstream file(filename, std::ios::binary);
+            file << header << row << "5 -3 1 1 100 100 100 1 0 1 1\n" << "8 -3 1 1 100 100 100 0 0 0.9 1\n";
+        }
+
+        {
+            World world;
+            World::Scope scope(world);
+            MapManager mapManager;
+            size_t mapId = mapManager.getMapCount() - 1;
+            bool watching = mapManager.enableHotReload();
+            mapManager.loadMap(mapId);
+
+            auto findWall = [&mapManager](const double x, const double y) -> Wall*
+            {
+                for (size_t i = 0; i < mapManager.getLoadedWallCount(); i++)
+                {
+                    Wall* wall = mapManager.getLoadedWall(i);
+                    if (wall->getPosition().x == x && wall->getPosition().y == y)
+                        return wall;
+                }
+                return nullptr;
+            };
+
+            Wall* merged = findWall(0, -3);
+            Wall* seven = findWall(7, -3);
+            Wall* five = findWall(5, -3);
+            EXPECT_TRUE(merged != nullptr && seven != nullptr && findWall(8, -3) != nullptr);
+            EXPECT_TRUE(five != nullptr && five->getCollider().hasTag(ColliderTag::DEADLY));
+            Collider* mergedCollider = merged != nullptr ? &merged->getCollider() : nullptr;
+            Collider* sevenCollider = seven != nullptr ? &seven->getCollider() : nullptr;
+            EXPECT_EQ(world.getColliders().size(), (size_t)4);
+
+            //az 5-ös fal már nem halálos, a 8-as helyett a 10-es fal kerül a pályára
+            const std::string text = header + row + "5 -3 1 1 100 100 100 0 0 1 1\n" + "10 -3 1 1 100 100 100 0 0 0.9 1\n";
+            {
+                std::ofstream file(filename, std::ios::binary);
+                file << text;
+            }
+            if (watching)
+                mapManager.pollHotReload();
+            else
+                mapManager.reloadMap(mapId, text);
+
+            EXPECT_EQ(mapManager.getLoadedWallCount(), (size_t)4);
+            EXPECT_EQ(findWall(0, -3), merged);
+            EXPECT_TRUE(merged != nullptr && &merged->getCollider() == mergedCollider);
+            EXPECT_EQ(findWall(7, -3), seven);
+            EXPECT_TRUE(seven != nullptr && &seven->getCollider() == sevenCollider);
+            five = findWall(5, -3);
+            EXPECT_TRUE(five != nullptr && !five->getCollider().hasTag(ColliderTag::DEADLY));
+            EXPECT_TRUE(findWall(8, -3) == nullptr);
+            EXPECT_TRUE(findWall(10, -3) != nullptr);
+
+            //a megmaradt colliderek a világban maradnak, a törölt fal collidere kikerül
+            EXPECT_EQ(world.getColliders().size(), (size_t)4);
+            EXPECT_TRUE(std::find(world.getColliders().begin(), world.getColliders().end(), mergedCollider) != world.getColliders().end());
+            EXPECT_TRUE(std::find(world.getColliders().begin(), world.getColliders().end(), sevenCollider) != world.getColliders().end());
+        }
+
+        std::remove(filename);
+    } END
+
+    //mapGenerator teszt (ugyanaz a seed ugyanazt a pályát adja, a pálya beolvasható)
+    TEST(MapGenerator, reprodukalhato)
+    {
+        MapGenerator::Settings settings;
+        settings.elementCount = 500;
+        settings.deadlyShare = 0.25;
+        settings.seed = 7;
+
+        std::string text = MapGenerator::generate(settings);
+        EXPECT_STREQ(MapGenerator::generate(settings).c_str(), text.c_str());
+        EXPECT_STREQ(MapManager::getParseError(text).c_str(), "");
+
+        //a pálya minden platformon bitre azonos, az FNV-1a ellenőrzőösszege rögzített
+        uint64_t checksum = 14695981039346656037ull;
+        for (char c : text)
+            checksum = (checksum ^ (unsigned char)c) * 1099511628211ull;
+        EXPECT_EQ(checksum, (uint64_t)10344799793444816488ull);
+
+        //fejléc 5 sor, elemenként egy sor
+        EXPECT_EQ((size_t)std::count(text.begin(), text.end(), '\n'), (size_t)505);
+
+        std::vector<MapGenerator::Element> elements = MapGenerator::generateElements(settings);
+        size_t deadly = std::count_if(elements.begin(), elements.end(), [](const MapGenerator::Element& element) { return element.deadly; });
+        EXPECT_TRUE(deadly > 75 && deadly < 175);
+        EXPECT_FALSE(elements[0].deadly);
+        EXPECT_FALSE(elements[1].deadly);
+
+        settings.seed = 8;
+        EXPECT_TRUE(MapGenerator::generate(settings) != text);
+
+        settings.elementCount = 1;
+        EXPECT_THROW(MapGenerator::generate(settings), std::invalid_argument);
+    } END
+
+    //mapManager teszt (hibás pályafájl, a hiba sora és oszlopa)
+    TEST(MapManager, hibas_fajl)
+    {
+        const std::string header = "5 255 255 255 3\r\n-5 -2 5 -2\r\n";
+
+        //CRLF sorvégek és záró újsor mellett hibátlan
+        EXPECT_STREQ(MapManager::getParseError(header + "0 -5 20 1 100 100 100 0 0 1 1\r\n").c_str(), "");
+
+        EXPECT_STREQ(MapManager::getParseError(header + "0 -5 2x0 1 100 100 100 0 0 1 1").c_str(), "3:6: invalid element width '2x0'");
+        EXPECT_STREQ(MapManager::getParseError(header + "0 -5 20 1 100 100 100 0 0\n").c_str(), "4:1: unexpected end of file, expected element collider ratio x");
+        EXPECT_STREQ(MapManager::getParseError("5 255 255\t1.5").c_str(), "1:11: invalid background blue '1.5'");
+    } END
+}
+void TestRunner::runBotTests()
+{
+    //bot teszt (az ellenfelet üldöző bot legyőzi az álló ellenfelet)
+    TEST(Bot, uldozes)
+    {
+        World world;
+        World::Scope scope(world);
+        world.setTargetPhysicsRate(100);
+
+        Collider floor(Transform(nullptr, {0.0, -1.0}, {40.0, 1.0}));
+        ChaseController chase;
+        PlayerInput right;
+        right.right = true;
+        ScriptedController walker({{right, 20}});
+
+        Fighter hunter(&chase);
+        Fighter target(&walker);
+        hunter.setOpponent(&target);
+        target.setOpponent(&hunter);
+        hunter.setArena(20, 10);
+        target.setArena(20, 10);
+        hunter.reset({-4.0, 0.0});
+        target.reset({4.0, 0.0});
+
+        for (int i = 0; i < 20; i++)
+        {
+            world.physicsUpdate();
+            world.update();
+        }
+        EXPECT_GT(target.getPosition().x, 4.0); //A script jobbra viszi
+        EXPECT_TRUE(target.getView().grounded);
+
+        walker = ScriptedController({});
+        for (int i = 0; i < 1000 && !target.isDead(); i++)
+        {
+            world.physicsUpdate();
+            world.update();
+        }
+        EXPECT_TRUE(target.isDead());
+        EXPECT_FALSE(hunter.isDead());
+    } END
+
+    //torna teszt (az eredmény nem függ a szálak számától)
+    TEST(Tournament, determinisztikus)
+    {
+        MapManager maps;
+        Tournament::Settings settings;
+        settings.rounds = 12;
+        settings.maxTicks = 600;
+        settings.threads = 1;
+
+        Tournament::Result single = Tournament::run(maps, settings);
+        settings.threads = 3;
+        Tournament::Result parallel = Tournament::run(maps, settings);
+
+        EXPECT_EQ(single.rounds, (size_t)12);
+        EXPECT_EQ(parallel.threads, (size_t)3);
+        EXPECT_EQ(single.ticks, parallel.ticks);
+        EXPECT_EQ(single.timeouts, parallel.timeouts);
+
+        size_t rounds = 0;
+        for (size_t i = 0; i < single.bots.size(); i++)
+        {
+            const Tournament::BotResult& bot = single.bots[i];
+            EXPECT_EQ(bot.wins + bot.losses + bot.ties, bot.rounds);
+            EXPECT_EQ(bot.wins, parallel.bots[i].wins);
+            EXPECT_EQ(bot.losses, parallel.bots[i].losses);
+            rounds += bot.rounds;
+        }
+        EXPECT_EQ(rounds, (size_t)24);
+
+        settings.bots = {"chase", "nobody"};
+        EXPECT_THROW(Tournament::run(maps, settings), std::invalid_argument);
+    } END
+}
+void TestRunner::runNetplayTests()
+{
+    //mérkőzés teszt (a visszatöltött állapotból ugyanaz következik)
+    TEST(Match, visszatoltes)
+    {
+        MapManager maps;
+        maps.prepareMap(0);
+        Match match(maps, 0);
+
+        PlayerInput right, jump;
+        right.right = true;
+        jump.jump = jump.left = true;
+
+        for (int i = 0; i < 30; i++)
+            match.step(right, jump);
+        match.saveState(3);
+        for (int i = 0; i < 40; i++)
+            match.step(jump, right);
+        Match::State expected = match.getState();
+
+        match.loadState(3);
+        EXPECT_EQ(match.getTick(), (size_t)30);
+        for (int i = 0; i < 40; i++)
+            match.step(jump, right);
+        EXPECT_TRUE(match.getState() == expected);
+
+        EXPECT_THROW(match.loadState(4), std::out_of_range);
+        EXPECT_THROW(match.getFighter(2), std::out_of_range);
+    } END
+
+    //loopback teszt (késleltetés és csomagvesztés)
+    TEST(LoopbackLink, kesleltetes)
+    {
+        LoopbackLink::Settings settings;
+        settings.latency = 2;
+        LoopbackLink link(settings);
+
+        std::vector<uint8_t> packet = {1, 2, 3};
+        link.getEndpoint(0).send(packet);
+        link.tick();
+        EXPECT_FALSE(link.getEndpoint(1).receive(packet));
+        link.tick();
+        EXPECT_FALSE(link.getEndpoint(0).receive(packet)); //A küldő nem kapja vissza
+        EXPECT_TRUE(link.getEndpoint(1).receive(packet));
+        EXPECT_EQ(packet.size(), (size_t)3);
+
+        settings.loss = 1;
+        LoopbackLink lossy(settings);
+        lossy.getEndpoint(1).send(packet);
+        lossy.tick();
+        lossy.tick();
+        EXPECT_FALSE(lossy.getEndpoint(0).receive(packet));
+        EXPECT_EQ(lossy.getLostCount(), (size_t)1);
+
+        settings.loss = 1.5;
+        EXPECT_THROW(LoopbackLink invalid(settings), std::invalid_argument);
+        EXPECT_THROW(link.getEndpoint(2), std::out_of_range);
+    } END
+
+    //rollback teszt (késés, szórás és vesztés mellett is egyezik a két fél)
+    TEST(Rollback, szinkron)
+    {
+        MapManager maps;
+        Netplay::Settings settings;
+        settings.ticks = 600;
+        settings.link.latency = 4;
+        settings.link.jitter = 3;
+        settings.link.loss = 0.2;
+
+        Netplay::Result result = Netplay::runLoopback(maps, settings);
+        EXPECT_TRUE(result.inSync);
+        EXPECT_GT(result.stats[0].rollbacks, (size_t)0);
+        EXPECT_GT(result.packetsLost, (size_t)0);
+        for (const RollbackSession::Stats& stats : result.stats)
+            EXPECT_LE(stats.maxRollbackDepth, settings.session.maxRollback);
+
+        //a nagyobb késleltetés várakozást okoz, de nem szakad szét
+        settings.link.latency = 12;
+        settings.session.inputDelay = 2;
+        result = Netplay::runLoopback(maps, settings);
+        EXPECT_TRUE(result.inSync);
+        EXPECT_GT(result.stats[1].stalledTicks, (size_t)0);
+
+        Match match(maps, 0);
+        LoopbackLink link(LoopbackLink::Settings{});
+        EXPECT_THROW(RollbackSession(match, link.getEndpoint(0), 2, RollbackSession::Settings()), std::invalid_argument);
+    } END
+
+    //rollback teszt (a két fél eltérő állapotát a hashek jelzik)
+    TEST(Rollback, desync)
+    {
+        MapManager maps;
+        maps.prepareMap(0);
+        maps.prepareMap(1);
+
+        //a két fél más pályán játszik
+        Match match1(maps, 0);
+        Match match2(maps, 1);
+        LoopbackLink link(LoopbackLink::Settings{});
+        RollbackSession session1(match1, link.getEndpoint(0), 0, RollbackSession::Settings());
+        RollbackSession session2(match2, link.getEndpoint(1), 1, RollbackSession::Settings());
+
+        std::stringstream stream;
+        StateHashLog log(stream);
+        session2.setHashLog(&log);
+
+        for (int i = 0; i < 50; i++)
+        {
+            session1.advance(PlayerInput());
+            session2.advance(PlayerInput());
+            link.tick();
+        }
+
+        EXPECT_EQ(session1.getStats().desyncTick, (size_t)0);
+        EXPECT_EQ(session2.getStats().desyncTick, (size_t)0);
+        EXPECT_TRUE(StateHashLog::read(stream) == session2.getFinalHashes());
+        EXPECT_NE(StateHashLog::findFirstMismatch(session1.getFinalHashes(), session2.getFinalHashes()), SIZE_MAX);
+    } END
+}
+
+void TestRunner::runInputTests()
+{
+    //spscQueue teszt (sorrend, betelés, körbeérés)
+    TEST(SpscQueue, sorrend)
+    {
+        SpscQueue<int> queue(3);
+        EXPECT_EQ(queue.capacity(), (size_t)4);
+        EXPECT_TRUE(queue.front() == nullptr);
+
+        int value = -1;
+        EXPECT_FALSE(queue.pop(value));
+        EXPECT_EQ(value, -1);
+
+        //többször körbeér a pufferen
+        int next = 0, expected = 0;
+        for (int round = 0; round < 10; round++)
+        {
+            while (queue.push(next))
+                next++;
+            EXPECT_EQ(queue.size(), (size_t)4);
+
+            EXPECT_EQ(*queue.front(), expected);
+            for (int i = 0; i < 3; i++)
+            {
+                EXPECT_TRUE(queue.pop(value));
+                EXPECT_EQ(value, expected++);
+            }
+        }
+        EXPECT_EQ(queue.size(), (size_t)1);
+
+        EXPECT_THROW(SpscQueue<int> empty(0), std::invalid_argument);
+    } END
+
+    //spscQueue teszt (két szál között minden elem sorrendben átér)
+    TEST(SpscQueue, ket_szal)
+    {
+        SpscQueue<uint32_t> queue(64);
+        const uint32_t count = 200000;
+
+        std::thread producer([&queue, count]()
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                while (!queue.push(i))
+                    std::this_thread::yield();
+            }
+        });
+
+        uint32_t expected = 0;
+        bool ordered = true;
+        while (expected < count)
+        {
+            uint32_t value;
+            if (!queue.pop(value))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            ordered = ordered && value == expected;
+            expected++;
+        }
+        producer.join();
+
+        EXPECT_TRUE(ordered);
+        EXPECT_EQ(queue.size(), (size_t)0);
+    } END
+
+    //inputQueue teszt (az események a lépés időpontja szerint érvényesülnek)
+    TEST(InputQueue, idopont)
+    {
+        World world;
+        InputQueue queue;
+
+        KeyEvent event;
+        event.key = 'a';
+        event.pressed = true;
+        event.time = 10;
+        EXPECT_TRUE(queue.record(event));
+        event.pressed = false;
+        event.time = 25;
+        EXPECT_TRUE(queue.record(event));
+        event.key = 'b';
+        event.pressed = true;
+        event.time = 30;
+        EXPECT_TRUE(queue.record(event));
+
+        EXPECT_EQ(queue.apply(world, 5), (size_t)0);
+        EXPECT_FALSE(world.isKeyPressed('a'));
+
+        EXPECT_EQ(queue.apply(world, 10), (size_t)1);
+        EXPECT_TRUE(world.isKeyPressed('a'));
+        EXPECT_EQ(queue.apply(world, 20), (size_t)0);
+        EXPECT_TRUE(world.isKeyPressed('a'));
+        EXPECT_EQ(queue.getPendingCount(), (size_t)2);
+
+        EXPECT_EQ(queue.apply(world, 30), (size_t)2);
+        EXPECT_FALSE(world.isKeyPressed('a'));
+        EXPECT_TRUE(world.isKeyPressed('b'));
+        EXPECT_EQ(queue.getDroppedCount(), (size_t)0);
+    } END
+
+    //inputQueue teszt (betelt sor után nem ragad be billentyű)
+    TEST(InputQueue, tele)
+    {
+        World world;
+        InputQueue queue(2);
+
+        KeyEvent event;
+        event.pressed = true;
+        for (uint32_t key = 1; key <= 3; key++)
+        {
+            event.key = key;
+            event.time = key;
+            queue.record(event);
+        }
+        EXPECT_EQ(queue.getDroppedCount(), (size_t)1);
+
+        //a sor kiürülésekor minden billentyű felengedődik
+        EXPECT_EQ(queue.apply(world, 1), (size_t)1);
+        EXPECT_TRUE(world.isKeyPressed(1));
+        EXPECT_EQ(queue.apply(world, 10), (size_t)1);
+        EXPECT_FALSE(world.isKeyPressed(1));
+        EXPECT_FALSE(world.isKeyPressed(2));
+    } END
+
+    //fighter teszt (az irányítás minden fizikai lépés előtt érvényesül, képkocka nélkül is)
+    TEST(Fighter, iranyitas_lepesenkent)
+    {
+        World world;
+        World::Scope scope(world);
+        world.setTargetPhysicsRate(100);
+
+        DirectController controller;
+        Fighter fighter(&controller);
+
+        PlayerInput left;
+        left.left = true;
+        controller.setInput(left);
+        world.physicsUpdate();
+        EXPECT_LT(fighter.getVelocity().x, 0.0);
+
+        PlayerInput right;
+        right.right = true;
+        controller.setInput(right);
+        for (int i = 0; i < 20; i++)
+            world.physicsUpdate();
+        EXPECT_GT(fighter.getVelocity().x, 0.0);
+    } END
+}
+
+void TestRunner::runRenderTests()
+{
+    //tripleBuffer teszt (az olvasó mindig a legutóbb közzétett állapotot kapja)
+    TEST(TripleBuffer, legutobbi)
+    {
+        TripleBuffer<int> buffer;
+        EXPECT_FALSE(buffer.acquire());
+
+        buffer.getWriteBuffer() = 1;
+        buffer.publish();
+        buffer.getWriteBuffer() = 2;
+        buffer.publish();
+
+        //a közbülső állapot elveszik
+        EXPECT_TRUE(buffer.acquire());
+        EXPECT_EQ(buffer.getReadBuffer(), 2);
+        EXPECT_FALSE(buffer.acquire());
+        EXPECT_EQ(buffer.getReadBuffer(), 2);
+
+        //az író nem írhat az olvasó pufferébe
+        for (int i = 3; i < 10; i++)
+        {
+            EXPECT_FALSE(&buffer.getWriteBuffer() == &buffer.getReadBuffer());
+            buffer.getWriteBuffer() = i;
+            buffer.publish();
+        }
+        EXPECT_TRUE(buffer.acquire());
+        EXPECT_EQ(buffer.getReadBuffer(), 9);
+    } END
+
+    //tripleBuffer teszt (két szál között az olvasó sosem lát régebbi vagy félkész állapotot)
+    TEST(TripleBuffer, ket_szal)
+    {
+        TripleBuffer<std::vector<uint32_t>> buffer;
+        const uint32_t count = 20000;
+
+        std::thread writer([&buffer, count]()
+        {
+            for (uint32_t i = 1; i <= count; i++)
+            {
+                std::vector<uint32_t>& values = buffer.getWriteBuffer();
+                values.assign(16, i);
+                buffer.publish();
+            }
+        });
+
+        uint32_t last = 0;
+        bool consistent = true;
+        while (last < count)
+        {
+            if (!buffer.acquire())
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const std::vector<uint32_t>& values = buffer.getReadBuffer();
+            consistent = consistent && values.size() == 16 && values.front() > last
+                && std::all_of(values.begin(), values.end(), [&values](uint32_t value) { return value == values.front(); });
+            last = values.front();
+        }
+        writer.join();
+
+        EXPECT_TRUE(consistent);
+        EXPECT_EQ(last, count);
+    } END
+
+    //renderSnapshot teszt (képernyő koordináták, újrahasznosítás)
+    TEST(RenderSnapshot, kepernyo)
+    {
+        RenderSnapshot snapshot;
+        snapshot.setCamera(makeColor(10, 20, 30), Vector2(1, -2), 5);
+        EXPECT_EQ(snapshot.getBackgroundColor().g, 20);
+        EXPECT_EQ(snapshot.getGameHeight(), 5.0);
+        EXPECT_THROW(snapshot.setCamera(makeColor(0, 0, 0), Vector2(0, 0), 0), std::invalid_argument);
+
+        //a kamera középpontja a képernyő közepe, egy egység 1000 / 10 = 100 pixel
+        snapshot.addRect(Vector2(1, 2), Vector2(2, 1), makeColor(255, 0, 0));
+        snapshot.addRect(Vector2(3, 2.5), Vector2(1, 1), makeColor(0, 255, 0));
+        EXPECT_EQ(snapshot.getRects().size(), (size_t)2);
+
+        RenderSnapshot::ScreenRect rect = snapshot.toScreen(snapshot.getRects()[0], 2000, 1000);
+        EXPECT_EQ(rect.width, 200.0f);
+        EXPECT_EQ(rect.height, 100.0f);
+        EXPECT_EQ(rect.x, 900.0f);
+        EXPECT_EQ(rect.y, 450.0f);
+
+        rect = snapshot.toScreen(snapshot.getRects()[1], 2000, 1000);
+        EXPECT_EQ(rect.x, 1150.0f);
+        EXPECT_EQ(rect.y, 400.0f);
+
+        //a szövegek helye újrahasznosul
+        snapshot.addText("elso", makeColor(0, 0, 0), 0.2);
+        EXPECT_EQ(snapshot.getTextCount(), (size_t)1);
+        snapshot.clear();
+        EXPECT_EQ(snapshot.getRects().size(), (size_t)0);
+        EXPECT_EQ(snapshot.getTextCount(), (size_t)0);
+        EXPECT_THROW(snapshot.getText(0), std::out_of_range);
+
+        snapshot.addText("masodik", makeColor(1, 2, 3), 0.5);
+        EXPECT_EQ(snapshot.getTextCount(), (size_t)1);
+        EXPECT_EQ(snapshot.getText(0).text, std::string("masodik"));
+        EXPECT_EQ(snapshot.getText(0).scale, 0.5);
+        EXPECT_EQ(snapshot.getBackgroundColor().b, 30);
+    } END
+}
+
+void TestRunner::runTaskGraphTests()
+{
+    //taskGraph teszt (függőségi sorrend, körök, hibák a hívó szálon)
+    TEST(TaskGraph, sorrend)
+    {
+        TaskGraph graph;
+        std::vector<int> order;
+        size_t a = graph.addTask("a", [&order]() { order.push_back(0); });
+        size_t b = graph.addTask("b", [&order]() { order.push_back(1); });
+        size_t c = graph.addTask("c", [&order]() { order.push_back(2); });
+        size_t d = graph.addTask("d", [&order]() { order.push_back(3); });
+
+        //az a a c után, a b a d után fut
+        graph.addDependency(a, c);
+        graph.addDependency(b, d);
+        graph.run();
+        EXPECT_TRUE(order == std::vector<int>({2, 0, 3, 1}));
+        EXPECT_EQ(graph.getTaskName(d), std::string("d"));
+
+        EXPECT_THROW(graph.addDependency(c, a), std::invalid_argument);
+        EXPECT_THROW(graph.addDependency(a, a), std::invalid_argument);
+        EXPECT_THROW(graph.addDependency(a, 4), std::out_of_range);
+        EXPECT_THROW(graph.getTaskTime(4), std::out_of_range);
+
+        //a hibás feladat után nem indul új
+        size_t failing = graph.addTask("hiba", []() { throw std::runtime_error("hiba"); });
+        graph.addDependency(a, failing);
+        graph.addDependency(c, failing);
+        order.clear();
+        EXPECT_THROW(graph.run(), std::runtime_error);
+        EXPECT_TRUE(order == std::vector<int>({3, 1}));
+    } END
+
+    //taskGraph teszt (szálkészleten a függőségek előbb befejeződnek, a független feladatok párhuzamosan futhatnak)
+    TEST(TaskGraph, szalkeszlet)
+    {
+        ThreadPool pool(3);
+        EXPECT_EQ(pool.getThreadCount(), (size_t)3);
+        EXPECT_THROW(ThreadPool empty(0), std::invalid_argument);
+
+        //gyémánt: a forrás után négy ág, majd a nyelő
+        TaskGraph graph;
+        std::atomic<int> source(0), branches(0), sink(0), branchRuns(0);
+        std::atomic<bool> ordered(true);
+        size_t first = graph.addTask("forras", [&]() { source++; });
+        size_t last = graph.addTask("nyelo", [&]()
+        {
+            if (branches.load() != 4) ordered = false;
+            sink++;
+        });
+        for (int i = 0; i < 4; i++)
+        {
+            size_t branch = graph.addTask("ag", [&]()
+            {
+                if (source.load() != 1) ordered = false;
+                branches++;
+                branchRuns++;
+            });
+            graph.addDependency(branch, first);
+            graph.addDependency(last, branch);
+        }
+
+        //minden feladat futásonként pontosan egyszer fut
+        for (int run = 0; run < 2000; run++)
+        {
+            source = 0;
+            branches = 0;
+            graph.run(&pool);
+        }
+        EXPECT_TRUE(ordered.load());
+        EXPECT_EQ(sink.load(), 2000);
+        EXPECT_EQ(branchRuns.load(), 8000);
+
+        //a készlet feladatából indított ciklus sem akad el, ha minden szál vár
+        std::atomic<int> inner(0);
+        pool.parallelFor(8, [&](size_t)
+        {
+            pool.parallelFor(8, [&](size_t) { inner++; });
+        });
+        EXPECT_EQ(inner.load(), 64);
+
+        EXPECT_THROW(pool.parallelFor(4, [](size_t index) { if (index == 2) throw std::runtime_error("hiba"); }), std::runtime_error);
+
+        size_t failing = graph.addTask("hiba", []() { throw std::runtime_error("hiba"); });
+        graph.addDependency(first, failing);
+        sink = 0;
+        EXPECT_THROW(graph.run(&pool), std::runtime_error);
+        EXPECT_EQ(sink.load(), 0);
+    } END
+
+    //world teszt (a fázisok alapértelmezett sorrendje, saját függőségek, párhuzamos fázis)
+    TEST(World, fazisok)
+    {
+        class Drawer : public Updatable
+        {
+            public:
+            int id;
+            std::vector<int>* log;
+            Drawer(UpdatePriority priority, int id, std::vector<int>* log) : Updatable(priority), id(id), log(log) {}
+            void update() override
+            {
+                if (log != nullptr)
+                    log->push_back(id);
+
+                //a rajzolás a fázis saját képkockájába kerül
+                RenderSnapshot* target = getWorld().getRenderTarget();
+                if (target != nullptr)
+                    target->addRect(Vector2(id, 0), Vector2(1, 1), makeColor(0, 0, 0));
+            }
+        };
+
+        World world;
+        World::Scope scope(world);
+        std::vector<int> log;
+        std::vector<std::unique_ptr<Drawer>> drawers;
+        drawers.emplace_back(new Drawer(UpdatePriority::OTHER, 4, &log));
+        drawers.emplace_back(new Drawer(UpdatePriority::UI_RENDERER, 3, &log));
+        drawers.emplace_back(new Drawer(UpdatePriority::GAME_LOGIC, 0, &log));
+        drawers.emplace_back(new Drawer(UpdatePriority::WALL_RENDERER, 2, &log));
+
+        world.update();
+        EXPECT_TRUE(log == std::vector<int>({0, 2, 3, 4}));
+
+        //az OTHER fázis már csak a játéklogikára vár, a hívó szálon a kisebb sorszámú kész fázis fut előbb
+        world.setPhaseDependencies(UpdatePriority::OTHER, {UpdatePriority::GAME_LOGIC});
+        world.setPhaseDependencies(UpdatePriority::GAME_LOGIC, {});
+        world.setPhaseDependencies(UpdatePriority::UI_RENDERER, {UpdatePriority::OTHER});
+        log.clear();
+        world.update();
+        EXPECT_TRUE(log == std::vector<int>({0, 2, 4, 3}));
+
+        EXPECT_THROW(world.setPhaseDependencies(UpdatePriority::OTHER, {UpdatePriority::UI_RENDERER}), std::invalid_argument);
+        EXPECT_THROW(world.setPhaseDependencies(UpdatePriority::OTHER, {UpdatePriority::OTHER}), std::invalid_argument);
+        EXPECT_THROW(world.setPhaseParallel((UpdatePriority)7, true), std::out_of_range);
+        log.clear();
+        world.update();
+        EXPECT_TRUE(log == std::vector<int>({0, 2, 4, 3}));
+
+        //sok objektum párhuzamosan, a rajzolás mégis a regisztráció sorrendjében, a fázisok egymás mellett futnak
+        for (std::unique_ptr<Drawer>& drawer : drawers)
+            drawer->log = nullptr;
+        const int count = 1000;
+        for (int i = 0; i < count; i++)
+            drawers.emplace_back(new Drawer(UpdatePriority::WALL_RENDERER, 100 + i, nullptr));
+
+        world.setUpdateThreadCount(3);
+        world.setPhaseParallel(UpdatePriority::WALL_RENDERER, true);
+        for (size_t phase = 0; phase < World::phaseCount; phase++)
+            world.setPhaseDependencies((UpdatePriority)phase, {});
+        EXPECT_EQ(world.getUpdateThreadCount(), (size_t)3);
+
+        RenderSnapshot frame;
+        world.getCamera().snapshot = &frame;
+        for (int run = 0; run < 20; run++)
+        {
+            frame.clear();
+            world.update();
+
+            std::vector<int> drawn;
+            for (const RenderSnapshot::Rect& rect : frame.getRects())
+                drawn.push_back((int)rect.position.x);
+
+            std::vector<int> expected({0, 2});
+            for (int i = 0; i < count; i++)
+                expected.push_back(100 + i);
+            expected.push_back(3);
+            expected.push_back(4);
+            EXPECT_TRUE(drawn == expected);
+        }
+        world.getCamera().snapshot = nullptr;
+        EXPECT_EQ(world.getRenderTarget(), nullptr);
+        EXPECT_GT(world.getPhaseTime(UpdatePriority::WALL_RENDERER), (uint64_t)0);
+
+        drawers.clear();
+        world.setUpdateThreadCount(0);
+    } END
+}
+
+void TestRunner::runArenaTests()
+{
+    //frameArena teszt (igazítás, visszaállítás, a blokkok összevonása)
+    TEST(FrameArena, visszaallitas)
+    {
+        FrameArena arena(64);
+        EXPECT_EQ(arena.getBlockCount(), (size_t)0);
+        EXPECT_THROW(FrameArena(0), std::invalid_argument);
+        EXPECT_THROW(arena.allocate(8, 3), std::invalid_argument);
+
+        char* first = static_cast<char*>(arena.allocate(1, 1));
+        double* second = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(double), (uintptr_t)0);
+        EXPECT_EQ(arena.getBlockCount(), (size_t)1);
+
+        //a legutóbbi foglalás azonnal újra felhasználható
+        arena.deallocate(second, sizeof(double));
+        EXPECT_EQ(arena.allocate(sizeof(double), alignof(double)), (void*)second);
+
+        FrameArena::Marker marker = arena.getMarker();
+        size_t used = arena.getUsed();
+        void* third = arena.allocate(16, 16);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(third) % 16, (uintptr_t)0);
+        arena.rewind(marker);
+        EXPECT_EQ(arena.getUsed(), used);
+        EXPECT_EQ(arena.allocate(16, 16), third);
+        EXPECT_THROW(arena.rewind(FrameArena::Marker{3, 0, 0}), std::out_of_range);
+
+        //a túlcsorduló foglalások új blokkba kerülnek, a visszaállítás után egy blokk marad
+        for (int i = 0; i < 20; i++)
+            arena.allocate(40, 8);
+        EXPECT_GT(arena.getBlockCount(), (size_t)1);
+        size_t capacity = arena.getCapacity();
+        arena.reset();
+        EXPECT_EQ(arena.getBlockCount(), (size_t)1);
+        EXPECT_TRUE(arena.getCapacity() >= capacity);
+        EXPECT_EQ(arena.getUsed(), (size_t)0);
+        EXPECT_TRUE(arena.getPeak() >= 800);
+        EXPECT_TRUE(first != nullptr);
+    } END
+
+    //arenaAllocator teszt (a pontokon kívül az általános foglaló, belül a szál területe)
+    TEST(ArenaAllocator, tarolok)
+    {
+        ArenaVector<int> outside;
+        EXPECT_EQ(outside.get_allocator().getArena(), nullptr);
+        outside.push_back(1);
+
+        FrameArena& arena = FrameArena::getThreadArena();
+        size_t depth = arena.getScopeDepth();
+        size_t used = arena.getUsed();
+        {
+            FrameArena::Scope scope;
+            EXPECT_EQ(FrameArena::getActive(), &arena);
+            EXPECT_EQ(arena.getScopeDepth(), depth + 1);
+
+            ArenaVector<int> numbers;
+            EXPECT_EQ(numbers.get_allocator().getArena(), &arena);
+            for (int i = 0; i < 1000; i++)
+                numbers.push_back(i);
+            EXPECT_EQ(numbers[999], 999);
+            EXPECT_TRUE(arena.getUsed() >= used + 1000 * sizeof(int));
+
+            ArenaString text("egy hosszabb szöveg, amely nem fér a belső pufferbe");
+            text += "!";
+            EXPECT_EQ(text.get_allocator().getArena(), &arena);
+            EXPECT_EQ(std::string(text.c_str()), std::string("egy hosszabb szöveg, amely nem fér a belső pufferbe!"));
+
+            //a belső pontban a külső pont foglalása nem szabadul fel, a belső pont visszaállítása ezt megtartja
+            void* outer = arena.allocate(32, 8);
+            {
+                FrameArena::Scope inner;
+                arena.deallocate(outer, 32);
+                EXPECT_NE(arena.allocate(32, 8), outer);
+            }
+            arena.deallocate(outer, 32);
+            EXPECT_EQ(arena.allocate(32, 8), outer);
+        }
+        EXPECT_EQ(arena.getUsed(), used);
+        EXPECT_EQ(arena.getScopeDepth(), depth);
+        EXPECT_EQ(FrameArena::getActive() == nullptr, depth == 0);
+        EXPECT_EQ(outside[0], 1);
+    } END
+
+    //ütközés teszt (a területből foglaló változatok ugyanazt adják)
+    TEST(Collider, terulet_eredmeny)
+    {
+        World world;
+        World::Scope scope(world);
+        Transform parent(nullptr, {0.0, 0.0}, {1.0, 1.0});
+        Collider c1(Transform(&parent, {0.0, 0.0}, {2.0, 2.0}));
+        Collider c2(Transform(&parent, {0.5, 0.0}, {2.0, 2.0}));
+        Collider c3(Transform(nullptr, {1.0, 1.0}, {2.0, 2.0}));
+        Collider c4(Transform(nullptr, {-1.0, -1.0}, {2.0, 2.0}));
+        Collider c5(Transform(nullptr, {5.0, 5.0}, {1.0, 1.0}));
+
+        std::vector<Collider*> colliders;
+        parent.findTypeInChildren(colliders);
+        EXPECT_TRUE(colliders == parent.findTypeInChildren<Collider>());
+        EXPECT_EQ(colliders.size(), (size_t)2);
+
+        FrameArena::Scope arenaScope;
+        ArenaVector<Collider*> intersections;
+        c1.checkIntersection(intersections);
+        std::vector<Collider*> expected = c1.checkIntersection();
+        EXPECT_TRUE(std::vector<Collider*>(intersections.begin(), intersections.end()) == expected);
+        EXPECT_EQ(intersections.size(), (size_t)3);
+
+        //mindkét saját collider metszi a c3-at, az eredményben mégis egyszer szerepel
+        Collider::checkIntersectionForList(colliders, intersections);
+        EXPECT_EQ(intersections.size(), (size_t)2);
+        EXPECT_TRUE(std::find(intersections.begin(), intersections.end(), &c3) != intersections.end());
+        EXPECT_TRUE(std::find(intersections.begin(), intersections.end(), &c4) != intersections.end());
+        EXPECT_EQ(Collider::checkIntersectionForList(colliders).size(), (size_t)2);
+    } END
+
+    #ifdef FRAME_ARENA_ASSERT
+    //frameArena teszt (a pontokon belüli new hibának számít)
+    TEST(FrameArena, kobor_foglalas)
+    {
+        size_t stray = FrameArena::getStrayAllocationCount();
+        std::unique_ptr<int> outside(new int(1));
+        EXPECT_EQ(FrameArena::getStrayAllocationCount(), stray);
+        {
+            FrameArena::Scope scope;
+            ArenaVector<int> numbers(100, 1);
+            EXPECT_EQ(FrameArena::getStrayAllocationCount(), stray);
+            std::unique_ptr<int> inside(new int(2));
+            EXPECT_EQ(FrameArena::getStrayAllocationCount(), stray + 1);
+        }
+    } END
+    #endif
+}
+
+void TestRunner::runAllocationTests()
+{
+    //allocationBudget teszt (a mérés a new hívásokat számolja)
+    TEST(AllocationBudget, meres)
+    {
+        if (AllocationCounter::isAvailable())
+        {
+            gtest_lite::AllocationBudget budget;
+            std::unique_ptr<int> number(new int(1));
+            std::unique_ptr<char[]> buffer(new char[100]);
+            EXPECT_EQ(budget.count(), (size_t)2);
+            EXPECT_TRUE(budget.bytes() >= sizeof(int) + 100);
+        }
+
+        std::vector<int> numbers;
+        EXPECT_ALLOCATIONS_LE(1, 100 * sizeof(int), numbers.reserve(100));
+        EXPECT_NO_ALLOCATIONS(numbers.assign(100, 7));
+        EXPECT_EQ(numbers[99], 7);
+    } END
+
+    //physicsObject teszt (a bemelegedés után a fizikai lépés és az állapot mentése nem foglal)
+    TEST(PhysicsObject, foglalasmentes_lepes)
+    {
+        World world;
+        World::Scope scope(world);
+        PhysicsObject po(Transform(nullptr, {0.0, 5.0}, {1.0, 1.0}), {});
+        Collider body(Transform(&po, {0, 0}, {1.0, 1.0}));
+        Collider ground(Transform(nullptr, {0.0, 0.0}, {10.0, 1.0}), ColliderType::INTERACTIVE, 0.0, {ColliderTag::DEADLY});
+        Collider wall(Transform(nullptr, {3.0, 3.0}, {1.0, 6.0}), ColliderType::INTERACTIVE, 0.5, {ColliderTag::PLAYER});
+        po.setVelocity({5.0, -10.0});
+
+        //az első lépések töltik fel a terület blokkjait és a tárolókat
+        for (int i = 0; i < 5; i++)
+        {
+            world.physicsUpdate();
+            world.postUpdate();
+        }
+
+        bool touched = false;
+        {
+            ALLOCATION_BUDGET(0, 0);
+            for (int i = 0; i < 200; i++)
+            {
+                world.physicsUpdate();
+                touched = touched || po.checkTag(ColliderTag::DEADLY);
+                PhysicsObject::State state; //Minden lépés új állapotba ment, mint a rollback
+                po.saveState(state);
+                world.postUpdate();
+            }
+        }
+        EXPECT_TRUE(touched);
+        EXPECT_FALSE(po.checkTag(ColliderTag::DEADLY));
+    } END
+
+    //collider teszt (a lekérdezések újrahasznosított tárolóval nem foglalnak)
+    TEST(Collider, foglalasmentes_lekerdezes)
+    {
+        World world;
+        World::Scope scope(world);
+        Transform parent(nullptr, {0.0, 0.0}, {1.0, 1.0});
+        Collider c1(Transform(&parent, {0.0, 0.0}, {2.0, 2.0}));
+        Collider c2(Transform(&parent, {0.5, 0.0}, {2.0, 2.0}));
+        Collider c3(Transform(nullptr, {1.0, 1.0}, {2.0, 2.0}), ColliderType::INTERACTIVE, 0, {ColliderTag::DEADLY});
+        Collider c4(Transform(nullptr, {6.0, 0.0}, {2.0, 2.0}));
+
+        std::vector<Collider*> colliders;
+        parent.findTypeInChildren(colliders);
+        std::vector<Collider*> result;
+        result.reserve(8);
+        ColliderHit hit;
+        FrameArena::Scope arenaScope;
+        ArenaVector<Collider*> intersections;
+        Collider::checkIntersectionForList(colliders, intersections);
+        Collider::overlapBox({-5.0, -5.0}, {10.0, 5.0}, result);
+
+        size_t found = 0;
+        {
+            ALLOCATION_BUDGET(0, 0);
+            for (int i = 0; i < 50; i++)
+            {
+                c1.checkIntersection(intersections);
+                found += intersections.size();
+                Collider::checkIntersectionForList(colliders, intersections);
+                found += intersections.size();
+                Collider::overlapBox({-5.0, -5.0}, {10.0, 5.0}, result);
+                found += result.size();
+                found += Collider::raycast({-5.0, 1.0}, {1.0, 0.0}, 20, hit, ColliderFilter().require(ColliderTag::DEADLY));
+                found += Collider::boxcast({-5.0, 0.0}, {0.5, 0.5}, {1.0, 0.0}, 20, hit);
+                parent.findTypeInChildren(colliders);
+            }
+        }
+        EXPECT_EQ(found, (size_t)50 * (2 + 1 + 4 + 1 + 1));
+    } END
+
+    //renderSnapshot teszt (a bemelegedés után a kirajzolás nem foglal)
+    TEST(RenderSnapshot, foglalasmentes_rajzolas)
+    {
+        class Drawer : public Updatable
+        {
+            public:
+            int id;
+            std::string label;
+            Drawer(UpdatePriority priority, int id) : Updatable(priority), id(id), label("egy felirat, amely nem fér a belső pufferbe") {}
+            void update() override
+            {
+                RenderSnapshot* target = getWorld().getRenderTarget();
+                if (target == nullptr)
+                    return;
+
+                target->addRect(Vector2(id, 0), Vector2(1, 1), makeColor(0, 0, 0));
+                if (id % 10 == 0)
+                    target->addText(label, makeColor(255, 255, 255), 0.5);
+            }
+        };
+
+        World world;
+        World::Scope scope(world);
+        std::vector<std::unique_ptr<Drawer>> drawers;
+        for (int i = 0; i < 100; i++)
+            drawers.emplace_back(new Drawer(i % 2 == 0 ? UpdatePriority::WALL_RENDERER : UpdatePriority::PLAYER_RENDERER, i));
+
+        RenderSnapshot frame;
+        world.getCamera().snapshot = &frame;
+        for (int i = 0; i < 3; i++)
+        {
+            frame.clear();
+            world.update();
+        }
+
+        {
+            ALLOCATION_BUDGET(0, 0);
+            for (int i = 0; i < 20; i++)
+            {
+                frame.clear();
+                world.update();
+            }
+        }
+        EXPECT_EQ(frame.getRects().size(), (size_t)100);
+        EXPECT_EQ(frame.getTextCount(), (size_t)10);
+        world.getCamera().snapshot = nullptr;
+    } END
+
+    #if defined(MEMTRACE) && defined(MEMTRACE_PROFILE)
+    //memtrace teszt (a profil hívási helyenként összesít)
+    TEST(Memtrace, profil)
+    {
+        const int line = __LINE__; std::unique_ptr<char[]> buffer(new char[12345]);
+        FILE* report = std::tmpfile();
+        memtrace::mem_profile(1000, report);
+
+        std::string text;
+        char chunk[256];
+        std::rewind(report);
+        while (std::fgets(chunk, sizeof(chunk), report) != nullptr)
+            text += chunk;
+        std::fclose(report);
+
+        //az élő foglalás a helyével együtt szerepel
+        std::string site = "new[] @ test.cpp:" + std::to_string(line);
+        EXPECT_NE(text.find(site), std::string::npos);
+        EXPECT_NE(text.find("12345"), std::string::npos);
+    } END
+    #endif
+}
+
+void TestRunner::runLogTests()
+{
+    //a naplófájl sorai
+    auto readLines = [](FILE* file)
+    {
+        std::vector<std::string> lines;
+        char chunk[512];
+        std::rewind(file);
+        while (std::fgets(chunk, sizeof(chunk), file) != nullptr)
+        {
+            std::string line = chunk;
+            if (!line.empty() && line.back() == '\n')
+                line.pop_back();
+            lines.push_back(line);
+        }
+        return lines;
+    };
+
+    //mpscQueue teszt (sorrend, betelés, körbeérés)
+    TEST(MpscQueue, sorrend)
+    {
+        MpscQueue<int> queue(3);
+        EXPECT_EQ(queue.capacity(), (size_t)4);
+
+        int value = -1;
+        EXPECT_FALSE(queue.pop(value));
+        EXPECT_EQ(value, -1);
+
+        //többször körbeér a pufferen
+        int next = 0, expected = 0;
+        for (int round = 0; round < 10; round++)
+        {
+            while (queue.push(next))
+                next++;
+            EXPECT_EQ(queue.size(), (size_t)4);
+
+            for (int i = 0; i < 3; i++)
+            {
+                EXPECT_TRUE(queue.pop(value));
+                EXPECT_EQ(value, expected++);
+            }
+        }
+        EXPECT_EQ(queue.size(), (size_t)1);
+
+        EXPECT_THROW(MpscQueue<int> empty(0), std::invalid_argument);
+    } END
+
+    //mpscQueue teszt (több termelő elemei elvesztés nélkül, termelőnként sorrendben érnek át)
+    TEST(MpscQueue, tobb_termelo)
+    {
+        MpscQueue<uint32_t> queue(64);
+        const uint32_t producerCount = 4;
+        const uint32_t count = 50000;
+
+        std::vector<std::thread> producers;
+        for (uint32_t producer = 0; producer < producerCount; producer++)
+        {
+            producers.emplace_back([&queue, producer, count]()
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    while (!queue.push(producer << 24 | i))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        std::vector<uint32_t> expected(producerCount, 0);
+        bool ordered = true;
+        uint32_t received = 0;
+        while (received < producerCount * count)
+        {
+            uint32_t value;
+            if (!queue.pop(value))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            uint32_t producer = value >> 24;
+            ordered = ordered && producer < producerCount && (value & 0xFFFFFF) == expected[producer];
+            if (producer < producerCount)
+                expected[producer]++;
+            received++;
+        }
+        for (std::thread& producer : producers)
+            producer.join();
+
+        EXPECT_TRUE(ordered);
+        EXPECT_EQ(queue.size(), (size_t)0);
+    } END
+
+    //logger teszt (a tárolt paraméterekből a printf formátum szerint áll össze a sor)
+    TEST(Logger, formazas)
+    {
+        FILE* file = std::tmpfile();
+        Logger::setOutput(file);
+
+        LOG_INFO("a %d b %s c %.2f d %zu e %x |%5s|%-4d| 100%%", -3, std::string("str"), 1.5, (size_t)7, 255u, "ab", 12);
+        LOG_ERROR("%c%c %u %p", 'o', 'k', true, (const void*)nullptr);
+
+        //a túl hosszú szöveg levágódik, az utána következő paraméter kimarad
+        std::string longText(300, 'x');
+        LOG_INFO("%s %d", longText, 5);
+        Logger::flush();
+
+        std::vector<std::string> lines = readLines(file);
+        EXPECT_EQ(lines.size(), (size_t)3);
+        if (lines.size() == 3)
+        {
+            EXPECT_NE(lines[0].find("INFO: a -3 b str c 1.50 d 7 e ff |   ab|12  | 100%"), std::string::npos);
+            EXPECT_NE(lines[1].find("ERROR: ok 1 "), std::string::npos);
+            EXPECT_NE(lines[2].find(std::string(100, 'x')), std::string::npos);
+            EXPECT_EQ(lines[2].find(longText), std::string::npos);
+            EXPECT_EQ(lines[2].substr(lines[2].size() - 4), std::string(" ..."));
+        }
+
+        Logger::setOutput(nullptr);
+        std::fclose(file);
+    } END
+
+    //logger teszt (a futási idejű szint alatti bejegyzések nem íródnak ki)
+    TEST(Logger, szint)
+    {
+        FILE* file = std::tmpfile();
+        Logger::setOutput(file);
+
+        EXPECT_TRUE(Logger::getLevel() == LogLevel::INFO);
+        LOG_VERBOSE("rejtett");
+        Logger::setLevel(LogLevel::WARNING);
+        EXPECT_FALSE(Logger::isEnabled(LogLevel::INFO));
+        LOG_INFO("rejtett");
+        LOG_WARNING("latszik");
+        Logger::setLevel(LogLevel::INFO);
+        Logger::flush();
+
+        std::vector<std::string> lines = readLines(file);
+        EXPECT_EQ(lines.size(), (size_t)1);
+        if (lines.size() == 1)
+            EXPECT_NE(lines[0].find("WARNING: latszik"), std::string::npos);
+
+        Logger::setOutput(nullptr);
+        std::fclose(file);
+    } END
+
+    //logger teszt (az ismétlődő hibák közül ablakonként csak néhány íródik ki, a többit a következő összegzi)
+    TEST(Logger, utemkorlat)
+    {
+        FILE* file = std::tmpfile();
+        Logger::setOutput(file);
+        Logger::setRateLimit(3, 50);
+
+        for (int i = 0; i < 11; i++)
+        {
+            //az utolsó bejegyzés már új ablakba esik
+            if (i == 10)
+                std::this_thread::sleep_for(std::chrono::milliseconds(60));
+            LOG_ERROR("hiba %d", i);
+        }
+
+        //az informális bejegyzésekre nem vonatkozik
+        for (int i = 0; i < 5; i++)
+            LOG_INFO("info %d", i);
+        Logger::flush();
+
+        std::vector<std::string> lines = readLines(file);
+        EXPECT_EQ(lines.size(), (size_t)9);
+        if (lines.size() == 9)
+        {
+            EXPECT_NE(lines[2].find("hiba 2"), std::string::npos);
+            EXPECT_NE(lines[3].find("hiba 10 (7 similar messages suppressed)"), std::string::npos);
+        }
+
+        Logger::setRateLimit(10, 1000);
+        Logger::setOutput(nullptr);
+        std::fclose(file);
+    } END
+
+    //logger teszt (több szálról az író szálon keresztül minden bejegyzés kiíródik vagy elveszettként számolódik)
+    TEST(Logger, tobb_szal)
+    {
+        FILE* file = std::tmpfile();
+        Logger::setOutput(file);
+        Logger::start();
+
+        const int threadCount = 4;
+        const int count = 2000;
+        const size_t droppedBefore = Logger::getDroppedCount();
+
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < threadCount; thread++)
+        {
+            threads.emplace_back([thread, count]()
+            {
+                for (int i = 0; i < count; i++)
+                    LOG_INFO("szal %d uzenet %d", thread, i);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        //a sorba tétel a bemelegedés után nem foglal memóriát
+        EXPECT_NO_ALLOCATIONS(LOG_INFO("szal %d uzenet %d", threadCount, 0));
+        Logger::flush();
+        Logger::stop();
+
+        size_t messages = 0;
+        for (const std::string& line : readLines(file))
+        {
+            if (line.find("uzenet") != std::string::npos)
+                messages++;
+        }
+        EXPECT_EQ(messages + Logger::getDroppedCount() - droppedBefore, (size_t)(threadCount * count + 1));
+
+        Logger::setOutput(nullptr);
+        std::fclose(file);
+    } END
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,113 @@
+#include "textreader.h"
+
+#include <charconv>
+#include <system_error>
+
+#include "memtrace.h"
+
+ParseError::ParseError(const std::string& message, const size_t line, const size_t column)
+: std::runtime_error(std::to_string(line) + ":" + std::to_string(column) + ": " + message), line(line), column(column)
+{
+
+}
+
+size_t ParseError::getLine() const
+{
+    return line;
+}
+
+size_t ParseError::getColumn() const
+{
+    return column;
+}
+
+TextReader::TextReader(const std::string& text)
+: current(text.data()), end(text.data() + text.size()), line(1), column(1)
+{
+
+}
+
+static bool isWhitespace(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+void TextReader::skipWhitespace()
+{
+    while (current != end && isWhitespace(*current))
+    {
+        if (*current == '\n')
+        {
+            line++;
+            column = 1;
+        }
+        //the \r of a \r\n line ending does not count as a column
+        else if (*current != '\r')
+        {
+            column++;
+        }
+
+        current++;
+    }
+}
+
+const char* TextReader::findTokenEnd(const char* what)
+{
+    skipWhitespace();
+
+    if (current == end)
+        throw ParseError(std::string("unexpected end of file, expected ") + what, line, column);
+
+    const char* tokenEnd = current;
+    while (tokenEnd != end && !isWhitespace(*tokenEnd))
+        tokenEnd++;
+
+    return tokenEnd;
+}
+
+void TextReader::finishToken(const char* tokenEnd, const char* parsedEnd, const bool valid, const char* what)
+{
+    if (!valid || parsedEnd != tokenEnd)
+        throw ParseError(std::string("invalid ") + what + " '" + std::string(current, tokenEnd) + "'", line, column);
+
+    column += tokenEnd - current;
+    current = tokenEnd;
+}
+
+bool TextReader::atEnd()
+{
+    skipWhitespace();
+    return current == end;
+}
+
+double TextReader::readDouble(const char* what)
+{
+    const char* tokenEnd = findTokenEnd(what);
+
+    double value = 0;
+    std::from_chars_result result = std::from_chars(current, tokenEnd, value);
+    finishToken(tokenEnd, result.ptr, result.ec == std::errc(), what);
+
+    return value;
+}
+
+int TextReader::readInt(const char* what)
+{
+    const char* tokenEnd = findTokenEnd(what);
+
+    int value = 0;
+    std::from_chars_result result = std::from_chars(current, tokenEnd, value);
+    finishToken(tokenEnd, result.ptr, result.ec == std::errc(), what);
+
+    return value;
+}
+
+size_t TextReader::getLine() const
+{
+    return line;
+}
+
+size_t TextReader::getColumn() const
+{
+    return column;
+}
@@ -0,0 +1,152 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "memtrace.h"
+
+ThreadPool::ThreadPool(const size_t threadCount)
+: threads(), tasks(), firstTask(0), taskCount(0), mutex(), available(), stopping(false)
+{
+    if (threadCount == 0)
+        throw std::invalid_argument("thread pool needs at least one thread");
+
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+        threads.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || taskCount > 0; });
+
+            //the queued tasks still run after the stop request
+            if (!popTask(task))
+                return;
+        }
+        task();
+    }
+}
+
+void ThreadPool::pushTask(const std::function<void()>& task)
+{
+    if (taskCount == tasks.size())
+    {
+        //the queue is unrolled into a larger buffer, in order
+        std::vector<std::function<void()>> grown(std::max<size_t>(16, 2 * tasks.size()));
+        for (size_t i = 0; i < taskCount; i++)
+            grown[i] = std::move(tasks[(firstTask + i) % tasks.size()]);
+        tasks.swap(grown);
+        firstTask = 0;
+    }
+
+    tasks[(firstTask + taskCount) % tasks.size()] = task;
+    taskCount++;
+}
+
+bool ThreadPool::popTask(std::function<void()>& task)
+{
+    if (taskCount == 0)
+        return false;
+
+    //the slot is emptied, so the finished task releases its captures at once
+    task = std::move(tasks[firstTask]);
+    tasks[firstTask] = nullptr;
+    firstTask = (firstTask + 1) % tasks.size();
+    taskCount--;
+    return true;
+}
+
+void ThreadPool::submit(const std::function<void()>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pushTask(task);
+    }
+    available.notify_one();
+}
+
+bool ThreadPool::runPending()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!popTask(task))
+            return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::parallelFor(const size_t count, const std::function<void(size_t)>& body)
+{
+    if (count == 0)
+        return;
+
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    size_t remaining = count;
+    std::exception_ptr error;
+
+    auto run = [&](size_t index)
+    {
+        std::exception_ptr caught;
+        try
+        {
+            body(index);
+        }
+        catch (...)
+        {
+            caught = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(doneMutex);
+        if (caught && !error)
+            error = caught;
+        if (--remaining == 0)
+            doneCondition.notify_all();
+    };
+
+    for (size_t i = 1; i < count; i++)
+        submit([&run, i]() { run(i); });
+    run(0);
+
+    //the waiting thread helps, so nested loops cannot block every worker
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (remaining == 0)
+                break;
+        }
+
+        if (!runPending())
+        {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            doneCondition.wait(lock, [&remaining]() { return remaining == 0; });
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+size_t ThreadPool::getThreadCount() const { return threads.size(); }
@@ -0,0 +1,323 @@
+#include "tournament.h"
+
+#include "fighter.h"
+#include "world.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include "memtrace.h"
+
+/**
+ * @brief Egy kör kimenetele.
+ */
+struct RoundResult
+{
+    int winner; ///< A győztes oldal (0 vagy 1), döntetlen esetén -1.
+    size_t ticks; ///< A kör fizikai lépéseinek száma.
+    bool timeout; ///< Jelzi, hogy a kör időtúllépéssel ért véget.
+};
+
+/**
+ * @brief A kör sorszámából és az oldalból előállít egy seedet (splitmix64).
+ */
+static uint64_t mixSeed(const uint64_t seed, const size_t round, const size_t side)
+{
+    uint64_t value = seed + 0x9e3779b97f4a7c15ULL * (2 * (uint64_t)round + side + 1);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Lejátszik egy kört egy saját világban.
+ */
+static RoundResult playRound(const MapManager& maps, const Tournament::Settings& settings, const size_t round, const size_t mapId, const size_t first, const size_t second)
+{
+    World world;
+    World::Scope scope(world);
+    world.setTargetFrameRate(settings.physicsRate);
+    world.setTargetPhysicsRate(settings.physicsRate);
+    world.setDeltaTime(1 / settings.physicsRate);
+
+    std::vector<Collider> walls;
+    maps.createColliders(mapId, walls);
+
+    std::unique_ptr<PlayerController> controller1 = Tournament::createController(settings.bots[first], mixSeed(settings.seed, round, 0));
+    std::unique_ptr<PlayerController> controller2 = Tournament::createController(settings.bots[second], mixSeed(settings.seed, round, 1));
+
+    Fighter fighter1(controller1.get());
+    Fighter fighter2(controller2.get());
+    fighter1.setOpponent(&fighter2);
+    fighter2.setOpponent(&fighter1);
+
+    double height = maps.getMapHeight(mapId);
+    fighter1.setArena(height * settings.aspectRatio, height);
+    fighter2.setArena(height * settings.aspectRatio, height);
+    fighter1.reset(maps.getPlayerPosition(mapId, 0));
+    fighter2.reset(maps.getPlayerPosition(mapId, 1));
+
+    //one frame per physics step, in the order of the game loop
+    RoundResult result = {-1, 0, false};
+    while (result.ticks < settings.maxTicks)
+    {
+        world.physicsUpdate();
+        world.update();
+        world.postUpdate();
+        result.ticks++;
+
+        if (fighter1.isDead() || fighter2.isDead())
+        {
+            if (!fighter1.isDead())
+                result.winner = 0;
+            else if (!fighter2.isDead())
+                result.winner = 1;
+            return result;
+        }
+    }
+
+    result.timeout = true;
+    return result;
+}
+
+double Tournament::Result::getTicksPerSecond() const
+{
+    return seconds > 0 ? (double)ticks / seconds : 0;
+}
+
+std::unique_ptr<PlayerController> Tournament::createController(const std::string& name, const uint64_t seed)
+{
+    if (name == "chase")
+        return std::unique_ptr<PlayerController>(new ChaseController());
+
+    if (name == "random")
+        return std::unique_ptr<PlayerController>(new RandomController(seed));
+
+    if (name == "scripted")
+    {
+        PlayerInput right, rightJump, left, leftJump, dash;
+        right.right = true;
+        rightJump.right = rightJump.jump = true;
+        left.left = true;
+        leftJump.left = leftJump.jump = true;
+        dash.dash = true;
+        return std::unique_ptr<PlayerController>(new ScriptedController({{right, 80}, {rightJump, 30}, {dash, 5}, {left, 80}, {leftJump, 30}, {dash, 5}}));
+    }
+
+    if (name == "idle")
+        return std::unique_ptr<PlayerController>(new ScriptedController({}));
+
+    throw std::invalid_argument("unknown bot '" + name + "'");
+}
+
+Tournament::Result Tournament::run(MapManager& maps, const Settings& settings)
+{
+    if (settings.rounds == 0)
+        throw std::invalid_argument("round count must be at least 1");
+    if (settings.maxTicks == 0 || !(settings.physicsRate > 0) || !(settings.aspectRatio > 0))
+        throw std::invalid_argument("tick limit, rate and aspect ratio must be positive");
+    if (settings.bots.empty())
+        throw std::invalid_argument("at least one bot is required");
+    if (maps.getMapCount() == 0)
+        throw std::invalid_argument("no maps are loaded");
+
+    //unknown names fail here, not on a worker
+    for (const std::string& bot : settings.bots)
+        createController(bot, 0);
+
+    //the workers only read the maps
+    for (size_t mapId = 0; mapId < maps.getMapCount(); mapId++)
+        maps.prepareMap(mapId);
+
+    //every ordered pair plays on every map, a single bot plays against itself
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t first = 0; first < settings.bots.size(); first++)
+    {
+        for (size_t second = 0; second < settings.bots.size(); second++)
+        {
+            if (first != second || settings.bots.size() == 1)
+                pairs.emplace_back(first, second);
+        }
+    }
+
+    size_t threadCount = settings.threads;
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, settings.rounds);
+
+    std::vector<Result> partials(threadCount);
+    for (Result& partial : partials)
+        partial.bots.resize(settings.bots.size());
+
+    std::atomic<size_t> nextRound(0);
+    auto work = [&](Result& partial)
+    {
+        for (size_t round = nextRound++; round < settings.rounds; round = nextRound++)
+        {
+            size_t mapId = round % maps.getMapCount();
+            const std::pair<size_t, size_t>& pair = pairs[(round / maps.getMapCount()) % pairs.size()];
+
+            RoundResult outcome = playRound(maps, settings, round, mapId, pair.first, pair.second);
+
+            partial.rounds++;
+            partial.ticks += outcome.ticks;
+            if (outcome.timeout)
+                partial.timeouts++;
+
+            BotResult& first = partial.bots[pair.first];
+            BotResult& second = partial.bots[pair.second];
+            first.rounds++;
+            second.rounds++;
+            if (outcome.winner == 0)
+            {
+                first.wins++;
+                second.losses++;
+            }
+            else if (outcome.winner == 1)
+            {
+                second.wins++;
+                first.losses++;
+            }
+            else
+            {
+                first.ties++;
+                second.ties++;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    //the calling thread is one of the workers
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; i++)
+        workers.emplace_back(work, std::ref(partials[i]));
+    work(partials[0]);
+    for (std::thread& worker : workers)
+        worker.join();
+
+    auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.threads = threadCount;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.bots.resize(settings.bots.size());
+    for (size_t i = 0; i < result.bots.size(); i++)
+        result.bots[i].name = settings.bots[i];
+
+    for (const Result& partial : partials)
+    {
+        result.rounds += partial.rounds;
+        result.ticks += partial.ticks;
+        result.timeouts += partial.timeouts;
+        for (size_t i = 0; i < result.bots.size(); i++)
+        {
+            result.bots[i].rounds += partial.bots[i].rounds;
+            result.bots[i].wins += partial.bots[i].wins;
+            result.bots[i].losses += partial.bots[i].losses;
+            result.bots[i].ties += partial.bots[i].ties;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Beolvas egy számot a parancssori paraméter értékéből.
+ */
+template <typename T>
+static bool parseValue(const char* value, T& result)
+{
+    const char* end = value + std::strlen(value);
+    std::from_chars_result parsed = std::from_chars(value, end, result);
+    return parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+/**
+ * @brief Szétbontja a vesszővel elválasztott neveket.
+ */
+static bool parseNames(const char* value, std::vector<std::string>& names)
+{
+    names.clear();
+    const char* begin = value;
+    while (true)
+    {
+        const char* comma = std::strchr(begin, ',');
+        const char* end = comma != nullptr ? comma : begin + std::strlen(begin);
+        if (end == begin)
+            return false;
+
+        names.emplace_back(begin, end);
+        if (comma == nullptr)
+            return true;
+        begin = comma + 1;
+    }
+}
+
+int Tournament::runCommandLine(const int argc, const char* const argv[])
+{
+    Settings settings;
+    for (int i = 0; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const char* separator = std::strchr(argument, '=');
+        if (separator == nullptr)
+        {
+            std::fprintf(stderr, "invalid argument '%s', expected key=value\n", argument);
+            return 1;
+        }
+
+        std::string key(argument, separator);
+        const char* value = separator + 1;
+
+        bool valid;
+        if (key == "rounds") valid = parseValue(value, settings.rounds);
+        else if (key == "threads") valid = parseValue(value, settings.threads);
+        else if (key == "ticks") valid = parseValue(value, settings.maxTicks);
+        else if (key == "rate") valid = parseValue(value, settings.physicsRate);
+        else if (key == "seed") valid = parseValue(value, settings.seed);
+        else if (key == "bots") valid = parseNames(value, settings.bots);
+        else
+        {
+            std::fprintf(stderr, "unknown parameter '%s'\n", key.c_str());
+            return 1;
+        }
+
+        if (!valid)
+        {
+            std::fprintf(stderr, "invalid value for '%s': '%s'\n", key.c_str(), value);
+            return 1;
+        }
+    }
+
+    MapManager maps;
+
+    Result result;
+    try
+    {
+        result = run(maps, settings);
+    }
+    catch (const std::invalid_argument& error)
+    {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+
+    std::printf("tournament: %zu rounds on %zu maps, %zu threads\n", result.rounds, maps.getMapCount(), result.threads);
+    std::printf("%-12s %8s %8s %8s %8s %9s\n", "bot", "rounds", "wins", "losses", "ties", "win rate");
+    for (const BotResult& bot : result.bots)
+    {
+        double winRate = bot.rounds > 0 ? 100.0 * (double)bot.wins / (double)bot.rounds : 0;
+        std::printf("%-12s %8zu %8zu %8zu %8zu %8.1f%%\n", bot.name.c_str(), bot.rounds, bot.wins, bot.losses, bot.ties, winRate);
+    }
+    std::printf("%zu ticks, %zu timeouts, %.3f s, %.0f ticks/s\n", result.ticks, result.timeouts, result.seconds, result.getTicksPerSecond());
+    return 0;
+}
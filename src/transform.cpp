@@ -1,114 +1,61 @@
 #include "transform.h"
+#include "world.h"
 
 #include <algorithm>
-#include <cmath>
+#include <utility>
 
 #include "memtrace.h"
 
-Vector2::Vector2() : x(0), y(0)
-{
-
-}
-
-Vector2::Vector2(const double x, const double y) : x(x), y(y)
-{
-
-}
-
-Vector2& Vector2::operator+=(const Vector2& other)
-{
-    x += other.x;
-    y += other.y;
-
-    return *this;
-}
-Vector2 Vector2::operator+(const Vector2& other) const
-{
-    return Vector2(x + other.x, y + other.y);
-}
+thread_local Transform::ChildListCache* Transform::activeChildLists = nullptr;
 
-Vector2& Vector2::operator-=(const Vector2& other)
-{
-    x -= other.x;
-    y -= other.y;
-
-    return *this;
-}
-Vector2 Vector2::operator-(const Vector2& other) const
+Transform::Transform(Transform* const parent, const Vector2& position, const Vector2& scale) 
+: position(position), scale(scale), parent(parent), children(std::vector<Transform*>())
 {
-    return Vector2(x - other.x, y - other.y);
+    if (parent != nullptr)
+        parent->addChild(this);
 }
 
-Vector2& Vector2::operator*=(const double scalar)
-{
-    x *= scalar;
-    y *= scalar;
-
-    return *this;
-}
-Vector2 Vector2::operator*(const double scalar) const
+Transform::Transform(const Transform& transform)
+: position(transform.position), scale(transform.scale), parent(transform.parent)
 {
-    return Vector2(x * scalar, y * scalar);
+    if (parent != nullptr)
+        parent->addChild(this);
 }
 
-Vector2& Vector2::operator/=(const double scalar)
+Transform& Transform::operator=(const Transform& transform)
 {
-    x /= scalar;
-    y /= scalar;
-
+    changeParent(transform.parent);
+    position = transform.position;
+    scale = transform.scale;
+    World::countTransformChange();
     return *this;
 }
-Vector2 Vector2::operator/(const double scalar) const
-{
-    return Vector2(x / scalar, y / scalar);
-}
 
-bool Vector2::operator==(const Vector2& other) const
+Transform::Transform(Transform&& transform) noexcept
+: position(transform.position), scale(transform.scale), parent(nullptr)
 {
-    return (x == other.x && y == other.y);
+    takeHierarchy(transform);
 }
 
-bool Vector2::operator!=(const Vector2& other) const
+Transform& Transform::operator=(Transform&& transform) noexcept
 {
-    return !(*this == other);
-}
+    if (this == &transform)
+        return *this;
 
-Vector2 Vector2::operator-() const
-{
-    return Vector2(-x, -y);
-}
-
-double Vector2::length() const
-{
-    return std::sqrt(x * x + y * y);
-}
-
-Vector2 Vector2::normalize() const
-{
-    double len = length();
-    if (len == 0) return Vector2(0, 0);
-    return Vector2(x / len, y / len);
-}
-
-Transform::Transform(Transform* const parent, const Vector2& position, const Vector2& scale) 
-: position(position), scale(scale), parent(parent), children(std::vector<Transform*>())
-{
-    if (parent != nullptr)
-        parent->addChild(this);
-}
+    //release the current hierarchy like the destructor does
+    while (!children.empty())
+    {
+        children.back()->changeParent(nullptr);
+    }
 
-Transform::Transform(const Transform& transform)
-: position(transform.position), scale(transform.scale), parent(transform.parent)
-{
     if (parent != nullptr)
-        parent->addChild(this);
-}
+        parent->removeChild(this);
+    parent = nullptr;
 
-Transform& Transform::operator=(const Transform& transform)
-{
-    changeParent(transform.parent);
     position = transform.position;
     scale = transform.scale;
+    takeHierarchy(transform);
+    World::countTransformChange();
     return *this;
 }
 
@@ -121,6 +68,28 @@ Transform::~Transform()
 
     if (parent != nullptr)
         parent->removeChild(this);
+
+    //keep the allocated list for the next transform that gets children
+    if (activeChildLists != nullptr && children.capacity() > 0)
+        activeChildLists->give(children);
+}
+
+void Transform::takeHierarchy(Transform& transform)
+{
+    parent = transform.parent;
+    children = std::move(transform.children);
+    transform.children.clear();
+    transform.parent = nullptr;
+
+    //keep the place in the parent so the child order does not change
+    if (parent != nullptr)
+        parent->replaceChild(&transform, this);
+
+    //local values are relative to the parent, so they stay valid
+    for (Transform* child : children)
+    {
+        child->parent = this;
+    }
 }
 
 void Transform::addChild(Transform* const child)
@@ -130,6 +99,9 @@ void Transform::addChild(Transform* const child)
     if (childPos != children.end())
         return;
 
+    if (activeChildLists != nullptr && children.capacity() == 0)
+        activeChildLists->take(children);
+
     children.push_back(child);
 }
 
@@ -143,9 +115,19 @@ void Transform::removeChild(Transform* const child)
     children.erase(childPos);
 }
 
+void Transform::replaceChild(Transform* const oldChild, Transform* const newChild)
+{
+    auto childPos = find(children.begin(), children.end(), oldChild);
+    if (childPos == children.end())
+        return;
+
+    *childPos = newChild;
+}
+
 void Transform::move(const Vector2& offset)
 {
     position += offset;
+    World::countTransformChange();
 }
 
 Transform* Transform::getParent() const
@@ -163,6 +145,7 @@ void Transform::changeParent(Transform* const parent)
     Transform* oldParent = this->parent;
 
     this->parent = parent;
+    World::countTransformChange();
     setPosition(oldPosition);
     setScale(oldScale);
 
@@ -200,6 +183,8 @@ Vector2 Transform::getScale() const
 
 void Transform::setPosition(const Vector2& position)
 {
+    World::countTransformChange();
+
     if (parent == nullptr)
         this->position = position;
 
@@ -212,6 +197,8 @@ void Transform::setPosition(const Vector2& position)
 
 void Transform::setScale(const Vector2& scale) 
 {
+    World::countTransformChange();
+
     if (parent == nullptr)
         this->scale = scale;
     else
@@ -224,5 +211,54 @@ void Transform::setScale(const Vector2& scale)
 Vector2 Transform::getLocalPosition() const { return position; }
 Vector2 Transform::getLocalScale() const { return scale; }
 
-void Transform::setLocalPosition(const Vector2& position) { this->position = position; }
-void Transform::setLocalScale(const Vector2& scale) { this->scale = scale; }
\ No newline at end of file
+void Transform::setLocalPosition(const Vector2& position) { this->position = position; World::countTransformChange(); }
+void Transform::setLocalScale(const Vector2& scale) { this->scale = scale; World::countTransformChange(); }
+
+Transform::ChildListCache::Scope::Scope(ChildListCache& cache)
+: previous(activeChildLists)
+{
+    activeChildLists = &cache;
+}
+
+Transform::ChildListCache::Scope::~Scope()
+{
+    activeChildLists = previous;
+}
+
+Transform::ChildListCache::ChildListCache(const size_t limit)
+: limit(limit)
+{
+
+}
+
+void Transform::ChildListCache::reserve(const size_t count)
+{
+    lists.reserve(std::min(lists.size() + count, limit));
+}
+
+void Transform::ChildListCache::give(std::vector<Transform*>& list)
+{
+    //only the reserved slots are used, so a destructor never allocates here
+    if (lists.size() >= lists.capacity() || lists.size() >= limit)
+        return;
+
+    list.clear();
+    lists.push_back(std::move(list));
+}
+
+void Transform::ChildListCache::take(std::vector<Transform*>& list)
+{
+    if (lists.empty())
+        return;
+
+    list = std::move(lists.back());
+    lists.pop_back();
+}
+
+void Transform::ChildListCache::clear()
+{
+    //swapping with an empty vector releases the capacity as well
+    std::vector<std::vector<Transform*>>().swap(lists);
+}
+
+size_t Transform::ChildListCache::size() const { return lists.size(); }
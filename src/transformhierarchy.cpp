@@ -0,0 +1,334 @@
+#include "transformhierarchy.h"
+
+#include <stdexcept>
+
+#include "memtrace.h"
+
+const TransformHierarchy::Handle TransformHierarchy::invalidHandle = TransformHierarchy::Handle();
+
+/**
+ * @brief Két vektor komponensenkénti szorzata.
+ */
+static Vector2 multiply(const Vector2& a, const Vector2& b)
+{
+    return Vector2(a.x * b.x, a.y * b.y);
+}
+
+TransformHierarchy::TransformHierarchy()
+: orderDirty(false)
+{
+
+}
+
+void TransformHierarchy::reserve(const size_t capacity)
+{
+    localPositions.reserve(capacity);
+    localScales.reserve(capacity);
+    worldPositions.reserve(capacity);
+    worldScales.reserve(capacity);
+    parents.reserve(capacity);
+    slotOfDense.reserve(capacity);
+    slots.reserve(capacity);
+}
+
+uint32_t TransformHierarchy::getSlot(const Handle handle) const
+{
+    if (!isValid(handle))
+        throw std::out_of_range("transform handle is not valid");
+
+    return handle.slot;
+}
+
+bool TransformHierarchy::isValid(const Handle handle) const
+{
+    return handle.slot < slots.size() && slots[handle.slot].dense != invalidIndex && slots[handle.slot].generation == handle.generation;
+}
+
+size_t TransformHierarchy::size() const
+{
+    return localPositions.size();
+}
+
+void TransformHierarchy::link(const uint32_t slot, const uint32_t parentSlot)
+{
+    slots[slot].parent = parentSlot;
+    slots[slot].previousSibling = invalidIndex;
+    slots[slot].nextSibling = invalidIndex;
+
+    if (parentSlot == invalidIndex)
+        return;
+
+    //insert at the front of the child list
+    uint32_t firstChild = slots[parentSlot].firstChild;
+    slots[slot].nextSibling = firstChild;
+    if (firstChild != invalidIndex)
+        slots[firstChild].previousSibling = slot;
+    slots[parentSlot].firstChild = slot;
+}
+
+void TransformHierarchy::unlink(const uint32_t slot)
+{
+    uint32_t parentSlot = slots[slot].parent;
+    uint32_t previous = slots[slot].previousSibling;
+    uint32_t next = slots[slot].nextSibling;
+
+    if (previous != invalidIndex)
+        slots[previous].nextSibling = next;
+    else if (parentSlot != invalidIndex)
+        slots[parentSlot].firstChild = next;
+
+    if (next != invalidIndex)
+        slots[next].previousSibling = previous;
+
+    slots[slot].parent = invalidIndex;
+    slots[slot].previousSibling = invalidIndex;
+    slots[slot].nextSibling = invalidIndex;
+}
+
+void TransformHierarchy::computeWorld(const uint32_t slot, Vector2& position, Vector2& scale) const
+{
+    uint32_t dense = slots[slot].dense;
+    position = localPositions[dense];
+    scale = localScales[dense];
+
+    for (uint32_t ancestor = slots[slot].parent; ancestor != invalidIndex; ancestor = slots[ancestor].parent)
+    {
+        uint32_t ancestorDense = slots[ancestor].dense;
+        position = localPositions[ancestorDense] + multiply(localScales[ancestorDense], position);
+        scale = multiply(localScales[ancestorDense], scale);
+    }
+}
+
+TransformHierarchy::Handle TransformHierarchy::create(const Handle parent, const Vector2& localPosition, const Vector2& localScale)
+{
+    uint32_t parentSlot = parent == invalidHandle ? invalidIndex : getSlot(parent);
+
+    uint32_t slot;
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = (uint32_t)slots.size();
+        slots.push_back({invalidIndex, 0, invalidIndex, invalidIndex, invalidIndex, invalidIndex});
+    }
+
+    //new nodes go to the end, so their parent is always before them
+    uint32_t dense = (uint32_t)localPositions.size();
+    localPositions.push_back(localPosition);
+    localScales.push_back(localScale);
+    worldPositions.push_back(localPosition);
+    worldScales.push_back(localScale);
+    parents.push_back(parentSlot == invalidIndex ? invalidIndex : slots[parentSlot].dense);
+    slotOfDense.push_back(slot);
+
+    slots[slot].dense = dense;
+    slots[slot].firstChild = invalidIndex;
+    link(slot, parentSlot);
+
+    computeWorld(slot, worldPositions[dense], worldScales[dense]);
+
+    return {slot, slots[slot].generation};
+}
+
+void TransformHierarchy::destroy(const Handle handle)
+{
+    uint32_t slot = getSlot(handle);
+
+    //children keep their global transform like in the Transform destructor
+    while (slots[slot].firstChild != invalidIndex)
+    {
+        uint32_t child = slots[slot].firstChild;
+        changeParent({child, slots[child].generation}, invalidHandle);
+    }
+
+    unlink(slot);
+
+    //swap the last node into the freed place
+    uint32_t dense = slots[slot].dense;
+    uint32_t last = (uint32_t)localPositions.size() - 1;
+    if (dense != last)
+    {
+        uint32_t movedSlot = slotOfDense[last];
+
+        localPositions[dense] = localPositions[last];
+        localScales[dense] = localScales[last];
+        worldPositions[dense] = worldPositions[last];
+        worldScales[dense] = worldScales[last];
+        parents[dense] = parents[last];
+        slotOfDense[dense] = movedSlot;
+        slots[movedSlot].dense = dense;
+
+        //the moved node may now be before its parent
+        if (parents[dense] != invalidIndex && parents[dense] > dense)
+            orderDirty = true;
+
+        //its children have to point to the new place
+        for (uint32_t child = slots[movedSlot].firstChild; child != invalidIndex; child = slots[child].nextSibling)
+        {
+            parents[slots[child].dense] = dense;
+            if (slots[child].dense < dense)
+                orderDirty = true;
+        }
+    }
+
+    localPositions.pop_back();
+    localScales.pop_back();
+    worldPositions.pop_back();
+    worldScales.pop_back();
+    parents.pop_back();
+    slotOfDense.pop_back();
+
+    slots[slot].dense = invalidIndex;
+    slots[slot].generation++;
+    freeSlots.push_back(slot);
+}
+
+void TransformHierarchy::changeParent(const Handle handle, const Handle parent)
+{
+    uint32_t slot = getSlot(handle);
+    uint32_t parentSlot = parent == invalidHandle ? invalidIndex : getSlot(parent);
+
+    if (slots[slot].parent == parentSlot)
+        return;
+
+    for (uint32_t ancestor = parentSlot; ancestor != invalidIndex; ancestor = slots[ancestor].parent)
+    {
+        if (ancestor == slot)
+            throw std::invalid_argument("transform can not be parented to its own descendant");
+    }
+
+    //keep the global transform
+    Vector2 worldPosition, worldScale;
+    computeWorld(slot, worldPosition, worldScale);
+
+    Vector2 parentPosition(0, 0), parentScale(1, 1);
+    if (parentSlot != invalidIndex)
+        computeWorld(parentSlot, parentPosition, parentScale);
+
+    unlink(slot);
+    link(slot, parentSlot);
+
+    uint32_t dense = slots[slot].dense;
+    localPositions[dense] = Vector2((worldPosition.x - parentPosition.x) / parentScale.x, (worldPosition.y - parentPosition.y) / parentScale.y);
+    localScales[dense] = Vector2(worldScale.x / parentScale.x, worldScale.y / parentScale.y);
+
+    if (parentSlot == invalidIndex)
+    {
+        parents[dense] = invalidIndex;
+    }
+    else
+    {
+        parents[dense] = slots[parentSlot].dense;
+        if (parents[dense] > dense)
+            orderDirty = true;
+    }
+}
+
+TransformHierarchy::Handle TransformHierarchy::getParent(const Handle handle) const
+{
+    uint32_t parentSlot = slots[getSlot(handle)].parent;
+    if (parentSlot == invalidIndex)
+        return invalidHandle;
+
+    return {parentSlot, slots[parentSlot].generation};
+}
+
+Vector2 TransformHierarchy::getLocalPosition(const Handle handle) const { return localPositions[slots[getSlot(handle)].dense]; }
+Vector2 TransformHierarchy::getLocalScale(const Handle handle) const { return localScales[slots[getSlot(handle)].dense]; }
+
+void TransformHierarchy::setLocalPosition(const Handle handle, const Vector2& position) { localPositions[slots[getSlot(handle)].dense] = position; }
+void TransformHierarchy::setLocalScale(const Handle handle, const Vector2& scale) { localScales[slots[getSlot(handle)].dense] = scale; }
+
+Vector2 TransformHierarchy::getPosition(const Handle handle) const { return worldPositions[slots[getSlot(handle)].dense]; }
+Vector2 TransformHierarchy::getScale(const Handle handle) const { return worldScales[slots[getSlot(handle)].dense]; }
+
+void TransformHierarchy::restoreOrder()
+{
+    //preorder traversal of every tree, without an explicit stack
+    orderScratch.clear();
+    for (uint32_t i = 0; i < slotOfDense.size(); i++)
+    {
+        uint32_t root = slotOfDense[i];
+        if (slots[root].parent != invalidIndex)
+            continue;
+
+        uint32_t node = root;
+        while (true)
+        {
+            orderScratch.push_back(node);
+
+            if (slots[node].firstChild != invalidIndex)
+            {
+                node = slots[node].firstChild;
+                continue;
+            }
+
+            while (node != root && slots[node].nextSibling == invalidIndex)
+                node = slots[node].parent;
+
+            if (node == root)
+                break;
+
+            node = slots[node].nextSibling;
+        }
+    }
+
+    std::vector<Vector2> newLocalPositions(orderScratch.size());
+    std::vector<Vector2> newLocalScales(orderScratch.size());
+    std::vector<Vector2> newWorldPositions(orderScratch.size());
+    std::vector<Vector2> newWorldScales(orderScratch.size());
+
+    for (uint32_t i = 0; i < orderScratch.size(); i++)
+    {
+        uint32_t oldDense = slots[orderScratch[i]].dense;
+        newLocalPositions[i] = localPositions[oldDense];
+        newLocalScales[i] = localScales[oldDense];
+        newWorldPositions[i] = worldPositions[oldDense];
+        newWorldScales[i] = worldScales[oldDense];
+    }
+
+    for (uint32_t i = 0; i < orderScratch.size(); i++)
+    {
+        slots[orderScratch[i]].dense = i;
+        slotOfDense[i] = orderScratch[i];
+    }
+
+    for (uint32_t i = 0; i < orderScratch.size(); i++)
+    {
+        uint32_t parentSlot = slots[orderScratch[i]].parent;
+        parents[i] = parentSlot == invalidIndex ? invalidIndex : slots[parentSlot].dense;
+    }
+
+    localPositions.swap(newLocalPositions);
+    localScales.swap(newLocalScales);
+    worldPositions.swap(newWorldPositions);
+    worldScales.swap(newWorldScales);
+
+    orderDirty = false;
+}
+
+void TransformHierarchy::updateWorld()
+{
+    if (orderDirty)
+        restoreOrder();
+
+    //parents always come before their children, so one pass is enough
+    size_t count = localPositions.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t parent = parents[i];
+        if (parent == invalidIndex)
+        {
+            worldPositions[i] = localPositions[i];
+            worldScales[i] = localScales[i];
+        }
+        else
+        {
+            worldPositions[i] = worldPositions[parent] + multiply(worldScales[parent], localPositions[i]);
+            worldScales[i] = multiply(worldScales[parent], localScales[i]);
+        }
+    }
+}
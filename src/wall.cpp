@@ -1,11 +1,21 @@
-#ifndef CPORTA
 #include "wall.h"
 
-Wall::Wall(const Transform& transform, const Color& color, const double bounciness, const Vector2& colliderRatio, const std::vector<ColliderTag> colliderTags)
+#include "memtrace.h"
+
+Wall::Wall(const Transform& transform, const Color& color, const double bounciness, const Vector2& colliderRatio, const std::vector<ColliderTag>& colliderTags)
     : Transform(transform), 
-      renderer(Transform(this), color, UpdatePriority::WALL_RENDERER), 
+      #ifndef CPORTA
+      renderer(Transform(this), color), 
+      #endif
       collider(Transform(this, {0, 0}, {colliderRatio.x, colliderRatio.y}), ColliderType::INTERACTIVE, bounciness, colliderTags)
 {
-
+    #ifdef CPORTA
+    (void)color;
+    #endif
 }
-#endif
\ No newline at end of file
+
+#ifndef CPORTA
+StaticBoxRenderer& Wall::getRenderer() { return renderer; }
+#endif
+
+Collider& Wall::getCollider() { return collider; }
@@ -0,0 +1,438 @@
+#include "world.h"
+
+#include "framearena.h"
+#include "statehash.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "memtrace.h"
+
+thread_local World* World::current = nullptr;
+thread_local RenderSnapshot* World::phaseRenderTarget = nullptr;
+
+World::Scope::Scope(World& world)
+: previous(World::current)
+{
+    World::current = &world;
+}
+
+World::Scope::~Scope()
+{
+    World::current = previous;
+}
+
+World::World()
+: nextRegistrationOrder(0), transformChangeCount(0), colliderIndex(colliders, transformChangeCount), updateGraph(), updatePool(), deltaTime(0), targetFrameRate(60), targetPhysicsRate(50), stateHash(StateHasher().getHash()), stateHashLog(nullptr)
+{
+    //by default every phase waits for the previous priority, like a serial update
+    for (size_t phase = 0; phase < phaseCount; phase++)
+    {
+        phaseDependencies[phase] = phase > 0 ? 1u << (phase - 1) : 0;
+        parallelPhases[phase] = false;
+        phaseSnapshotCounts[phase] = 0;
+    }
+}
+
+World::~World()
+{
+    //the layer unregisters itself, so it has to go while the sets still exist
+    staticBoxLayer.reset();
+}
+
+World& World::getDefault()
+{
+    static World defaultWorld;
+    return defaultWorld;
+}
+
+World& World::getCurrent()
+{
+    return current != nullptr ? *current : getDefault();
+}
+
+void World::countTransformChange()
+{
+    //phases of one world may move objects on several threads at once
+    getCurrent().transformChangeCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void World::update()
+{
+    Scope scope(*this);
+    //the transient containers of the frame are released together at the end
+    FrameArena::Scope arenaScope;
+    if (updateGraph.getTaskCount() == 0)
+        buildUpdateGraph();
+
+    updateGraph.run(updatePool.get());
+
+    //the phases drew into their own frames, joined in priority order the result matches a serial update
+    if (camera.snapshot != nullptr)
+    {
+        for (size_t phase = 0; phase < phaseCount; phase++)
+        {
+            for (size_t part = 0; part < phaseSnapshotCounts[phase]; part++)
+                camera.snapshot->append(phaseSnapshots[phase][part]);
+        }
+    }
+}
+
+size_t World::getPhaseIndex(const UpdatePriority phase)
+{
+    size_t index = (size_t)phase;
+    if (index >= phaseCount)
+        throw std::out_of_range("update phase out of range");
+
+    return index;
+}
+
+void World::buildUpdateGraph()
+{
+    static const char* const phaseNames[phaseCount] = {"GAME_LOGIC", "PLAYER_RENDERER", "WALL_RENDERER", "UI_RENDERER", "OTHER"};
+
+    updateGraph.clear();
+    for (size_t phase = 0; phase < phaseCount; phase++)
+        updateGraph.addTask(phaseNames[phase], [this, phase]() { runPhase(phase); });
+
+    try
+    {
+        for (size_t phase = 0; phase < phaseCount; phase++)
+        {
+            for (size_t dependency = 0; dependency < phaseCount; dependency++)
+            {
+                if (phaseDependencies[phase] & (1u << dependency))
+                    updateGraph.addDependency(phase, dependency);
+            }
+        }
+    }
+    catch (...)
+    {
+        updateGraph.clear();
+        throw;
+    }
+}
+
+template <typename Iterator>
+void World::updateRange(Iterator begin, Iterator end, const UpdatePriority phase, RenderSnapshot* const target)
+{
+    //the parts may run on pool threads, each uses the arena of its own thread
+    FrameArena::Scope arenaScope;
+
+    //worlds may update each other on the same thread, so the previous target is restored
+    RenderSnapshot* previousTarget = phaseRenderTarget;
+    phaseRenderTarget = target;
+    try
+    {
+        for (Iterator it = begin; it != end && (*it)->getPriority() == phase; ++it)
+            (*it)->update();
+    }
+    catch (...)
+    {
+        phaseRenderTarget = previousTarget;
+        throw;
+    }
+    phaseRenderTarget = previousTarget;
+}
+
+void World::runPhase(const size_t phase)
+{
+    Scope scope(*this);
+    const UpdatePriority priority = (UpdatePriority)phase;
+    std::vector<RenderSnapshot>& snapshots = phaseSnapshots[phase];
+    const bool rendering = camera.snapshot != nullptr;
+
+    std::set<Updatable*, Updatable::Compare>::iterator first = std::find_if(updatables.begin(), updatables.end(),
+        [priority](const Updatable* updatable) { return updatable->getPriority() >= priority; });
+
+    if (!parallelPhases[phase] || updatePool == nullptr)
+    {
+        if (snapshots.empty())
+            snapshots.resize(1);
+        snapshots[0].clear();
+        phaseSnapshotCounts[phase] = 1;
+
+        //the set is walked directly, so the objects registered during the phase still update in it
+        updateRange(first, updatables.end(), priority, rendering ? &snapshots[0] : nullptr);
+        return;
+    }
+
+    std::vector<Updatable*>& members = phaseMembers[phase];
+    members.clear();
+    for (std::set<Updatable*, Updatable::Compare>::iterator it = first; it != updatables.end() && (*it)->getPriority() == priority; ++it)
+        members.push_back(*it);
+
+    //contiguous parts keep the drawing order of a serial update
+    const size_t partCount = std::min(members.size(), updatePool->getThreadCount() + 1);
+    if (snapshots.size() < partCount)
+        snapshots.resize(partCount);
+    phaseSnapshotCounts[phase] = partCount;
+
+    //the loop state is captured through one reference, so the body fits into the function without an allocation
+    struct Parts
+    {
+        World& world;
+        std::vector<Updatable*>& members;
+        std::vector<RenderSnapshot>& snapshots;
+        size_t count;
+        UpdatePriority priority;
+        bool rendering;
+    } parts = {*this, members, snapshots, partCount, priority, rendering};
+
+    updatePool->parallelFor(partCount, [&parts](size_t part)
+    {
+        Scope scope(parts.world);
+        parts.snapshots[part].clear();
+
+        std::vector<Updatable*>::iterator begin = parts.members.begin() + parts.members.size() * part / parts.count;
+        std::vector<Updatable*>::iterator end = parts.members.begin() + parts.members.size() * (part + 1) / parts.count;
+        parts.world.updateRange(begin, end, parts.priority, parts.rendering ? &parts.snapshots[part] : nullptr);
+    });
+}
+
+void World::setPhaseDependencies(const UpdatePriority phase, const std::vector<UpdatePriority>& dependencies)
+{
+    size_t index = getPhaseIndex(phase);
+    uint32_t mask = 0;
+    for (UpdatePriority dependency : dependencies)
+        mask |= 1u << getPhaseIndex(dependency);
+
+    uint32_t previous = phaseDependencies[index];
+    phaseDependencies[index] = mask;
+    try
+    {
+        buildUpdateGraph();
+    }
+    catch (const std::invalid_argument&)
+    {
+        phaseDependencies[index] = previous;
+        buildUpdateGraph();
+        throw;
+    }
+}
+
+void World::setPhaseParallel(const UpdatePriority phase, const bool parallel)
+{
+    parallelPhases[getPhaseIndex(phase)] = parallel;
+}
+
+void World::setUpdateThreadCount(const size_t threadCount)
+{
+    updatePool.reset(threadCount > 0 ? new ThreadPool(threadCount) : nullptr);
+}
+
+size_t World::getUpdateThreadCount() const
+{
+    return updatePool != nullptr ? updatePool->getThreadCount() : 0;
+}
+
+uint64_t World::getPhaseTime(const UpdatePriority phase) const
+{
+    size_t index = getPhaseIndex(phase);
+    return index < updateGraph.getTaskCount() ? updateGraph.getTaskTime(index) : 0;
+}
+
+RenderSnapshot* World::getRenderTarget() const
+{
+    return phaseRenderTarget != nullptr ? phaseRenderTarget : camera.snapshot;
+}
+
+void World::postUpdate()
+{
+    Scope scope(*this);
+    FrameArena::Scope arenaScope;
+    for (PhysicsUpdatable* updatable : physicsUpdatables)
+    {
+        updatable->postUpdate();
+    }
+}
+
+void World::physicsUpdate()
+{
+    Scope scope(*this);
+    //the query results of the tick are released together at the end
+    FrameArena::Scope arenaScope;
+    for (PhysicsUpdatable* updatable : physicsUpdatables)
+    {
+        updatable->prePhysicsUpdate();
+    }
+
+    for (PhysicsUpdatable* updatable : physicsUpdatables)
+    {
+        updatable->physicsUpdate();
+    }
+
+    stateHash = computeStateHash();
+    if (stateHashLog != nullptr)
+        stateHashLog->append(stateHash);
+}
+
+uint64_t World::computeStateHash() const
+{
+    StateHasher hasher;
+    for (const PhysicsUpdatable* updatable : physicsUpdatables)
+    {
+        updatable->hashState(hasher);
+    }
+    return hasher.getHash();
+}
+
+uint64_t World::getStateHash() const { return stateHash; }
+
+void World::setStateHashLog(StateHashLog* const log) { stateHashLog = log; }
+
+unsigned long long World::takeRegistrationOrder() { return nextRegistrationOrder++; }
+
+/**
+ * @brief A megtartott halmazcsúcsok legnagyobb száma halmazonként.
+ */
+static constexpr size_t spareNodeLimit = 1 << 16;
+
+/**
+ * @brief Beszúr egy elemet a halmazba, ha lehet, egy korábban eltávolított csúcs felhasználásával.
+ *
+ * A megtartott csúcsok listájának kapacitását a korlátig a halmaz méretével
+ * együtt növeli, így az eltávolításkor a csúcs mindig foglalás nélkül eltárolható.
+ */
+template <typename Set>
+static void insertReusingNode(Set& set, std::vector<typename Set::node_type>& spareNodes, const typename Set::value_type value)
+{
+    if (spareNodes.empty())
+    {
+        set.insert(value);
+    }
+    else
+    {
+        typename Set::node_type node = std::move(spareNodes.back());
+        spareNodes.pop_back();
+        node.value() = value;
+        set.insert(std::move(node));
+    }
+
+    size_t needed = std::min(set.size() + spareNodes.size(), spareNodeLimit);
+    if (spareNodes.capacity() < needed)
+        spareNodes.reserve(std::min(std::max(needed, 2 * spareNodes.capacity()), spareNodeLimit));
+}
+
+/**
+ * @brief Eltávolítja az elemet a halmazból, a csúcsát megtartja a későbbi beszúrásokhoz.
+ *
+ * A csúcs csak a lista lefoglalt kapacitásába kerül, azon felül felszabadul,
+ * így a metódus a destruktorokból hívva sem foglal memóriát és nem dob kivételt.
+ *
+ * @return Az eltávolított elemet követő elem.
+ */
+template <typename Set>
+static typename Set::iterator eraseKeepingNode(Set& set, std::vector<typename Set::node_type>& spareNodes, const typename Set::iterator position)
+{
+    typename Set::iterator next = std::next(position);
+    if (spareNodes.size() < spareNodes.capacity())
+        spareNodes.push_back(set.extract(position));
+    else
+        set.erase(position);
+    return next;
+}
+
+/**
+ * @brief A régi elem csúcsát az új elemmel ugyanarra a helyre teszi vissza, újrafoglalás nélkül.
+ */
+template <typename Set>
+static void replaceInPlace(Set& set, const typename Set::value_type oldValue, const typename Set::value_type newValue)
+{
+    auto pos = set.find(oldValue);
+    if (pos == set.end())
+        return;
+
+    auto hint = std::next(pos);
+    auto node = set.extract(pos);
+    node.value() = newValue;
+    set.insert(hint, std::move(node));
+}
+
+void World::registerForUpdate(Updatable* const updatable)
+{
+    insertReusingNode(updatables, spareUpdatableNodes, updatable);
+}
+
+void World::unregisterForUpdate(Updatable* const updatable)
+{
+    auto pos = updatables.find(updatable);
+    if (pos != updatables.end())
+        eraseKeepingNode(updatables, spareUpdatableNodes, pos);
+}
+
+void World::registerForUpdate(PhysicsUpdatable* const updatable)
+{
+    insertReusingNode(physicsUpdatables, sparePhysicsUpdatableNodes, updatable);
+}
+
+void World::unregisterForUpdate(PhysicsUpdatable* const updatable)
+{
+    auto pos = physicsUpdatables.find(updatable);
+    if (pos != physicsUpdatables.end())
+        eraseKeepingNode(physicsUpdatables, sparePhysicsUpdatableNodes, pos);
+}
+
+void World::replaceForUpdate(Updatable* const oldUpdatable, Updatable* const newUpdatable)
+{
+    replaceInPlace(updatables, oldUpdatable, newUpdatable);
+}
+
+void World::replaceForUpdate(PhysicsUpdatable* const oldUpdatable, PhysicsUpdatable* const newUpdatable)
+{
+    replaceInPlace(physicsUpdatables, oldUpdatable, newUpdatable);
+}
+
+void World::removeUnregisteredUpdatables()
+{
+    //erasing by iterator needs no lookup
+    for (auto it = updatables.begin(); it != updatables.end();)
+    {
+        if ((*it)->isRegistered())
+            ++it;
+        else
+            it = eraseKeepingNode(updatables, spareUpdatableNodes, it);
+    }
+}
+
+size_t World::getUpdatableCount() const { return updatables.size(); }
+
+size_t World::getPhysicsUpdatableCount() const { return physicsUpdatables.size(); }
+
+std::vector<Collider*>& World::getColliders() { return colliders; }
+
+ColliderIndex& World::getColliderIndex() { return colliderIndex; }
+
+SpatialGrid<StaticBoxRenderer>& World::getStaticBoxRenderers() { return staticBoxRenderers; }
+
+bool World::hasStaticBoxLayer() const { return staticBoxLayer != nullptr; }
+
+void World::setStaticBoxLayer(Updatable* const layer) { staticBoxLayer.reset(layer); }
+
+void World::setKeyPressed(const uint32_t key, const bool pressed)
+{
+    if (pressed)
+        pressedKeys.insert(key);
+    else
+        pressedKeys.erase(key);
+}
+
+bool World::isKeyPressed(const uint32_t key) const { return pressedKeys.count(key) != 0; }
+
+void World::releaseAllKeys() { pressedKeys.clear(); }
+
+World::Camera& World::getCamera() { return camera; }
+
+double World::getDeltaTime() const { return deltaTime; }
+
+void World::setDeltaTime(const double deltaTime) { this->deltaTime = deltaTime; }
+
+double World::getPhysicsDeltaTime() const { return 1 / targetPhysicsRate; }
+
+double World::getTargetFrameRate() const { return targetFrameRate; }
+
+void World::setTargetFrameRate(const double targetRate) { targetFrameRate = targetRate; }
+
+void World::setTargetPhysicsRate(const double targetRate) { targetPhysicsRate = targetRate; }